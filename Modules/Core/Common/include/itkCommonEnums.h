@@ -280,6 +280,28 @@ public:
 extern ITKCommon_EXPORT std::ostream &
                         operator<<(std::ostream & out, const ObjectFactoryEnums::InsertionPosition value);
 
+/** \class ImageBufferEnums
+ * \ingroup ITKCommon
+ */
+class ImageBufferEnums
+{
+public:
+  /** \ingroup ITKCommon
+   * How the pixel buffer of an image is allocated, see ImageBufferAllocator.
+   */
+  enum class AllocationPolicy : uint8_t
+  {
+    /** operator new[], without alignment guarantee beyond that of the element type */
+    New,
+    /** aligned to the 64 byte cache line, suitable for any SIMD load */
+    Aligned,
+    /** aligned to a 2 MiB huge page, and advised to be backed by transparent huge pages */
+    HugePages
+  };
+};
+extern ITKCommon_EXPORT std::ostream &
+                        operator<<(std::ostream & out, const ImageBufferEnums::AllocationPolicy value);
+
 } // namespace itk
 
 #endif // itkCommonEnums_h
@@ -489,6 +489,29 @@ public:
     return false;
   }
 
+  /** Determine whether the RequestedRegion of this DataObject is the same
+   * as the RequestedRegion of the DataObject passed in as a parameter.
+   * This is used by ProcessObject to check that the branches of a pipeline
+   * which it updates concurrently request the same region of the
+   * DataObjects they share. For DataObjects that do not support Regions,
+   * this method returns false, so that such shared DataObjects prevent the
+   * concurrent update. */
+  virtual bool
+  RequestedRegionIsEqualTo(const DataObject * itkNotUsed(data)) const
+  {
+    return false;
+  }
+
+  /** Estimate the size, in bytes, of the bulk data of the RequestedRegion.
+   * This is used to size the pieces of memory-budgeted streaming, see
+   * ProcessObject::EstimatePipelineMemoryFootprint(). For DataObjects
+   * whose size is unknown, this method returns 0. */
+  virtual SizeValueType
+  GetRequestedRegionMemorySize() const
+  {
+    return 0;
+  }
+
   /** Verify that the RequestedRegion is within the LargestPossibleRegion.
    *
    * If the RequestedRegion is not within the LargestPossibleRegion,
@@ -0,0 +1,85 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHardwareCounterProbe_h
+#define itkHardwareCounterProbe_h
+
+#include "itkResourceProbe.h"
+#include "itkHardwareCounters.h"
+#include "itkIntTypes.h"
+
+namespace itk
+{
+/** \class HardwareCounterProbe
+ *
+ *  \brief Counts the processor events of one hardware counter between two
+ *  points in code.
+ *
+ *   The events are those of the thread calling Start() and Stop(), plus
+ *   those of the work items run meanwhile by MultiThreaderBase on other
+ *   threads, see HardwareCounters. The values are zero when the counter is
+ *   not available. HardwareCounterProbesCollectorBase probes all the
+ *   counters at once.
+ *
+ * \sa HardwareCounters
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT HardwareCounterProbe : public ResourceProbe<OffsetValueType, double>
+{
+public:
+  using Superclass = ResourceProbe<OffsetValueType, double>;
+  using CounterEnum = HardwareCounters::CounterEnum;
+
+  explicit HardwareCounterProbe(CounterEnum counter = CounterEnum::Cycles);
+  ~HardwareCounterProbe() override;
+
+  /** A copy is not running, whether or not the original is. */
+  HardwareCounterProbe(const HardwareCounterProbe & other);
+  HardwareCounterProbe &
+  operator=(const HardwareCounterProbe & other);
+
+  /** Type for counting events. */
+  using CountType = OffsetValueType;
+
+  /** Returns the counter probed. */
+  CounterEnum
+  GetCounter() const
+  {
+    return m_Counter;
+  }
+
+  /** Returns whether the counter is counted on the calling thread. */
+  bool
+  IsAvailable() const;
+
+  void
+  Start() override;
+
+  void
+  Stop() override;
+
+protected:
+  CountType
+  GetInstantValue() const override;
+
+private:
+  CounterEnum m_Counter;
+  bool        m_Running{ false };
+};
+} // end namespace itk
+
+#endif // itkHardwareCounterProbe_h
@@ -0,0 +1,56 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHardwareCounterProbesCollectorBase_h
+#define itkHardwareCounterProbesCollectorBase_h
+
+#include "itkMacro.h"
+#include "itkHardwareCounterProbe.h"
+#include "itkResourceProbesCollectorBase.h"
+
+namespace itk
+{
+/** \class HardwareCounterProbesCollectorBase
+ *  \brief Aggregates a set of hardware counter probes.
+ *
+ *  Starting or stopping the probe named "id" starts or stops one
+ *  HardwareCounterProbe per counter, named "id (Cycles)",
+ *  "id (Instructions)", "id (LastLevelCacheMisses)", "id (BranchMisses)"
+ *  and "id (StalledCycles)", which Report() and JSONReport() list.
+ *
+ *  \sa HardwareCounterProbe
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT HardwareCounterProbesCollectorBase : public ResourceProbesCollectorBase<HardwareCounterProbe>
+{
+public:
+  ~HardwareCounterProbesCollectorBase() override;
+
+  void
+  Start(const char * id) override;
+
+  void
+  Stop(const char * id) override;
+
+  /** Returns the name of the probe of counter started by Start(id). */
+  static std::string
+  GetProbeName(const char * id, HardwareCounterProbe::CounterEnum counter);
+};
+} // end namespace itk
+
+#endif // itkHardwareCounterProbesCollectorBase_h
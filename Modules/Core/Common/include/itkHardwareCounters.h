@@ -0,0 +1,158 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHardwareCounters_h
+#define itkHardwareCounters_h
+
+#include "ITKCommonExport.h"
+#include "itkPipelineTracer.h"
+#include "itkSingletonMacro.h"
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+namespace itk
+{
+
+struct HardwareCountersGlobals;
+
+/** \class HardwareCountersEnums
+ *
+ * \brief enums for HardwareCounters
+ *
+ * \ingroup ITKCommon
+ */
+class HardwareCountersEnums
+{
+public:
+  /**
+   * \ingroup ITKCommon
+   * Processor events counted by HardwareCounters.
+   */
+  enum class Counter : uint8_t
+  {
+    Cycles = 0,
+    Instructions,
+    LastLevelCacheMisses,
+    BranchMisses,
+    StalledCycles
+  };
+};
+// Define how to print enumeration
+extern ITKCommon_EXPORT std::ostream &
+                        operator<<(std::ostream & out, HardwareCountersEnums::Counter value);
+
+/** \class HardwareCounters
+ * \brief Counts processor events of threads, with perf_event_open on Linux.
+ *
+ * The counters are the numbers of cycles, instructions, last level cache
+ * misses, branch misses and cycles stalled in the back end of the
+ * processor, counted in user space. Few instructions per cycle, together
+ * with many cache misses and stalled cycles, indicate code bound by memory
+ * bandwidth rather than by computation.
+ *
+ * The counters of a thread are opened by its first call to
+ * GetThreadValues(), and closed when the thread exits. Counters that the
+ * processor, the kernel or its perf_event_paranoid setting do not provide,
+ * as well as all counters on other systems, read as zero: IsAvailable()
+ * tells which are counted.
+ *
+ * The counters of a thread do not include the work done for it by the
+ * threads of a MultiThreaderBase. While collecting, that is while enabled
+ * or while a HardwareCounterProbe runs, each work item of
+ * MultiThreaderBase::ParallelizeImageRegion() is counted on the thread
+ * running it. Its counts are added to GetWorkItemValues(), unless a probe
+ * runs on that thread, and are attached to its PipelineTracer event when
+ * the work item is traced.
+ *
+ * \sa HardwareCounterProbe
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT HardwareCounters
+{
+public:
+  using CounterEnum = HardwareCountersEnums::Counter;
+
+  static constexpr unsigned int NumberOfCounters = 5;
+
+  /** Values of all counters, indexed by CounterEnum. */
+  using ValuesType = std::array<uint64_t, NumberOfCounters>;
+
+  /** Counts a work item, if collecting when the scope is constructed. */
+  class ITKCommon_EXPORT Scope
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_MOVE(Scope);
+
+    /** trace is the event of the work item, to which the counts are
+     * attached if it is active. */
+    explicit Scope(PipelineTracer::Scope & trace);
+
+    ~Scope();
+
+  private:
+    PipelineTracer::Scope & m_Trace;
+    bool                    m_Active;
+    ValuesType              m_StartValues{};
+  };
+
+  /** Returns whether counter is counted on the calling thread. */
+  static bool
+  IsAvailable(CounterEnum counter);
+
+  /** Returns the counts of the calling thread since its counters were
+   * opened. */
+  static ValuesType
+  GetThreadValues();
+
+  /** Returns the counts of the work items run, while collecting, on threads
+   * without a running probe. */
+  static ValuesType
+  GetWorkItemValues();
+
+  /** Returns the name of counter, as used in reports. */
+  static const char *
+  GetCounterName(CounterEnum counter);
+
+  /** Set/Get whether the work items are counted even if no probe runs,
+   * typically to attach their counts to a pipeline trace. Defaults to
+   * false, unless the environment variable ITK_HARDWARE_COUNTERS is set to
+   * a non-zero value. */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  GetEnabled();
+
+  /** Returns whether work items are counted. */
+  static bool
+  IsCollecting();
+
+  /** Called by HardwareCounterProbe when it starts and stops, on the
+   * thread it probes. */
+  static void
+  BeginProbe();
+  static void
+  EndProbe();
+
+private:
+  itkGetGlobalDeclarationMacro(HardwareCountersGlobals, PimplGlobals);
+  static HardwareCountersGlobals * m_PimplGlobals;
+};
+
+} // end namespace itk
+
+#endif
@@ -194,6 +194,13 @@ public:
   void
   Initialize() override;
 
+  /** Returns the size, in bytes, of the pixels of the requested region. */
+  SizeValueType
+  GetRequestedRegionMemorySize() const override
+  {
+    return this->GetRequestedRegion().GetNumberOfPixels() * sizeof(PixelType);
+  }
+
   /** Fill the image buffer with a value.  Be sure to call Allocate()
    * first. */
   void
@@ -19,6 +19,7 @@
 #define itkImageAlgorithm_h
 
 #include "itkImageRegionIterator.h"
+#include "itkSIMDPixelKernel.h"
 
 #include <type_traits>
 
@@ -187,7 +188,7 @@ private:
   struct StaticCast
   {
     TOutputType
-    operator()(const TInputType i)
+    operator()(const TInputType i) const
     {
       return static_cast<TOutputType>(i);
     }
@@ -210,6 +211,15 @@ private:
   static TOutputType *
   CopyHelper(const TInputType * first, const TInputType * last, TOutputType * result)
   {
+    if constexpr (std::is_arithmetic_v<TInputType> && std::is_arithmetic_v<TOutputType>)
+    {
+      if (SIMDPixelKernel::IsEnabled())
+      {
+        const auto size = static_cast<SizeValueType>(last - first);
+        SIMDPixelKernel::Transform(first, result, size, StaticCast<TInputType, TOutputType>());
+        return result + size;
+      }
+    }
     return std::transform(first, last, result, StaticCast<TInputType, TOutputType>());
   }
   /// \endcond
@@ -775,6 +775,13 @@ public:
   bool
   RequestedRegionIsOutsideOfTheBufferedRegion() override;
 
+  /** Determine whether the RequestedRegion of this image is the same as
+   * the RequestedRegion of the data object passed in as a parameter,
+   * which must be castable to an ImageBase. This method implements the
+   * API from DataObject. */
+  bool
+  RequestedRegionIsEqualTo(const DataObject * data) const override;
+
   /** Verify that the RequestedRegion is within the
    * LargestPossibleRegion.  If the RequestedRegion is not within the
    * LargestPossibleRegion, then the filter cannot possible satisfy
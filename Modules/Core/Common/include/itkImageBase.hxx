@@ -360,6 +360,16 @@ ImageBase<VImageDimension>::RequestedRegionIsOutsideOfTheBufferedRegion()
 }
 
 
+template <unsigned int VImageDimension>
+bool
+ImageBase<VImageDimension>::RequestedRegionIsEqualTo(const DataObject * data) const
+{
+  const auto * const imgData = dynamic_cast<const ImageBase *>(data);
+
+  return imgData != nullptr && imgData->GetRequestedRegion() == this->GetRequestedRegion();
+}
+
+
 template <unsigned int VImageDimension>
 bool
 ImageBase<VImageDimension>::VerifyRequestedRegion()
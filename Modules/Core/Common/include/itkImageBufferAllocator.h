@@ -0,0 +1,185 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferAllocator_h
+#define itkImageBufferAllocator_h
+
+#include "ITKCommonExport.h"
+#include "itkCommonEnums.h"
+#include "itkIntTypes.h"
+#include "itkSingletonMacro.h"
+#include <cstddef>
+
+namespace itk
+{
+
+struct ImageBufferAllocatorGlobals;
+
+/** \class ImageBufferAllocator
+ * \brief Allocates the pixel buffers of images.
+ *
+ * This class provides the non-templated memory management used by
+ * ImportImageContainer, which is the pixel container of Image and
+ * VectorImage. Buffers are allocated according to an
+ * ImageBufferEnums::AllocationPolicy:
+ *  - New uses operator new[], as ITK always did;
+ *  - Aligned aligns the buffer to a 64 byte cache line, so that vectorized
+ *    loops may use aligned loads from the first pixel on;
+ *  - HugePages aligns the buffer to a 2 MiB page and, where the operating
+ *    system supports it, advises it to be backed by transparent huge pages,
+ *    which reduces TLB misses when traversing large volumes.
+ *
+ * Independently of the policy, buffers may be first touched in parallel.
+ * Operating systems commonly place a page on the NUMA node of the thread
+ * which first writes it. Allocation followed by a single-threaded
+ * initialization therefore places the whole image on one node, and threads
+ * on the other nodes pay remote accesses for their whole lifetime. The
+ * parallel first touch splits the buffer into one contiguous piece per work
+ * unit of the default multi-threader, the same way the default
+ * ImageRegionSplitterSlowDimension used by
+ * MultiThreaderBase::ParallelizeImageRegion() splits an image, so that each
+ * page lands close to the threads which later process it.
+ *
+ * The global defaults are used by every newly created ImportImageContainer,
+ * and can be overridden per container, see
+ * ImportImageContainer::SetAllocationPolicy() and
+ * ImportImageContainer::SetParallelFirstTouch().
+ *
+ * Re-executed pipelines free and allocate the same intermediate images on
+ * every update, paying for the allocation and, more importantly, for the
+ * page faults of fresh memory. When the buffer pool is enabled, released
+ * buffers are kept in a process-wide cache, bucketed by size and policy,
+ * and handed out again to later allocations of the same bucket. Buckets
+ * are spaced at most 25% apart, every buffer allocated while the pool is
+ * enabled getting the size of its bucket. Only these buffers are kept:
+ * those allocated while the pool was disabled, with their exact size, are
+ * freed. The cache holds at most BufferPoolMaximumSize bytes; buffers
+ * released while the cache is full are freed. While the pool is disabled,
+ * allocations neither round their size up nor take a lock.
+ *
+ * \ingroup ITKCommon
+ */
+struct ITKCommon_EXPORT ImageBufferAllocator
+{
+  using AllocationPolicyEnum = ImageBufferEnums::AllocationPolicy;
+
+  /** Counters of the buffer pool, see GetBufferPoolStatistics(). */
+  struct BufferPoolStatistics
+  {
+    /** Allocations served from the pool. */
+    SizeValueType Hits{ 0 };
+    /** Allocations which found no buffer in the pool, while it was enabled. */
+    SizeValueType Misses{ 0 };
+    /** Released buffers kept in the pool. */
+    SizeValueType Returns{ 0 };
+    /** Released buffers freed because the pool was full. */
+    SizeValueType Evictions{ 0 };
+    /** Number and total size of the buffers currently in the pool. */
+    SizeValueType CachedBuffers{ 0 };
+    size_t        CachedBytes{ 0 };
+    /** Largest total size the pool has reached. */
+    size_t PeakCachedBytes{ 0 };
+  };
+
+  /** Alignment, in bytes, of buffers allocated with the Aligned policy. */
+  static constexpr size_t CacheLineAlignment = 64;
+
+  /** Alignment, in bytes, of buffers allocated with the HugePages policy. */
+  static constexpr size_t HugePageAlignment = size_t{ 2 } * 1024 * 1024;
+
+  /** Set/Get the allocation policy of newly created pixel containers.
+   * Defaults to New. */
+  static void
+  SetGlobalDefaultAllocationPolicy(AllocationPolicyEnum policy);
+  static AllocationPolicyEnum
+  GetGlobalDefaultAllocationPolicy();
+
+  /** Set/Get whether newly created pixel containers first touch their
+   * buffers in parallel. Defaults to false. */
+  static void
+  SetGlobalDefaultParallelFirstTouch(bool parallelFirstTouch);
+  static bool
+  GetGlobalDefaultParallelFirstTouch();
+
+  /** Returns the alignment, in bytes, guaranteed by the policy. The New
+   * policy only guarantees the alignment of the element type, and returns 0. */
+  static size_t
+  GetAlignment(AllocationPolicyEnum policy);
+
+  /** Allocates uninitialized memory according to the policy, possibly
+   * taken from the buffer pool. Memory allocated with the New policy comes
+   * from operator new[], so that applications which take over a buffer
+   * of trivial elements may still release it with delete[]. Returns nullptr
+   * on failure. The memory must be released by Deallocate() with the same
+   * size and policy. */
+  static void *
+  Allocate(size_t numberOfBytes, AllocationPolicyEnum policy);
+
+  /** Releases memory obtained from Allocate(), returning it to the buffer
+   * pool when it is enabled and not full. */
+  static void
+  Deallocate(void * buffer, size_t numberOfBytes, AllocationPolicyEnum policy);
+
+  /** Set/Get whether released buffers are kept for reuse. Defaults to
+   * false. Disabling the pool frees the buffers it holds. */
+  static void
+  SetBufferPoolEnabled(bool enabled);
+  static bool
+  GetBufferPoolEnabled();
+
+  /** Set/Get the maximum total size, in bytes, of the buffers kept in the
+   * pool. Defaults to 1 GiB. Lowering the maximum frees buffers until the
+   * pool fits. */
+  static void
+  SetBufferPoolMaximumSize(size_t numberOfBytes);
+  static size_t
+  GetBufferPoolMaximumSize();
+
+  /** Frees all the buffers held by the pool. */
+  static void
+  ClearBufferPool();
+
+  /** Returns the counters of the buffer pool. */
+  static BufferPoolStatistics
+  GetBufferPoolStatistics();
+
+  /** Resets the counters of the buffer pool, except those describing its
+   * current content. */
+  static void
+  ResetBufferPoolStatistics();
+
+  /** Returns the size of the bucket a request for numberOfBytes falls into,
+   * which is the size actually allocated while the pool is enabled. */
+  static size_t
+  GetBufferPoolBucketSize(size_t numberOfBytes);
+
+  /** Writes every page of the buffer from the work units of the default
+   * multi-threader, each work unit handling one contiguous piece. If
+   * zeroFill is true, the whole buffer is set to zero, otherwise a single
+   * byte per page is written. Small buffers are handled by the calling
+   * thread. */
+  static void
+  ParallelFirstTouch(void * buffer, size_t numberOfBytes, bool zeroFill);
+
+private:
+  itkGetGlobalDeclarationMacro(ImageBufferAllocatorGlobals, PimplGlobals);
+  static ImageBufferAllocatorGlobals * m_PimplGlobals;
+};
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,136 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageRegionSplitterTiled_h
+#define itkImageRegionSplitterTiled_h
+
+#include "itkImageRegionSplitterBase.h"
+#include "itkSize.h"
+
+#include <vector>
+
+namespace itk
+{
+/** \class ImageRegionSplitterTiled
+ * \brief Divide a region into cache-sized tiles.
+ *
+ * ImageRegionSplitterTiled divides an ImageRegion into tiles which are
+ * small enough for the input footprint of a neighborhood operation to fit
+ * in the cache of one core. The tile size is derived from the cache size,
+ * the number of bytes accessed per pixel, and the radius of the
+ * neighborhood, so that each tile together with its halo of radius pixels
+ * on each side occupies at most CacheSizeInBytes. Tiles are kept as long as
+ * possible along the fastest dimension, so that inner loops remain
+ * contiguous.
+ *
+ * Unlike the slab splitters, the number of pieces is determined by the
+ * tile size. The requested number of pieces is only used as an upper bound:
+ * if the region holds more tiles than requested, neighboring tiles are
+ * merged. To make full use of the tiles, use a multi-threader with dynamic
+ * scheduling, see MultiThreaderBase::SetDynamicScheduling().
+ *
+ * The pieces are enumerated in a locality-preserving order, obtained by
+ * recursively bisecting the grid of tiles (a Morton-like order which
+ * supports any number of tiles), so that consecutive pieces share most of
+ * their input and threads working on neighboring pieces share cache lines.
+ *
+ * \ingroup ITKSystemObjects
+ * \ingroup DataProcessing
+ * \ingroup ITKCommon
+ */
+
+class ITKCommon_EXPORT ImageRegionSplitterTiled : public ImageRegionSplitterBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageRegionSplitterTiled);
+
+  /** Standard class type aliases. */
+  using Self = ImageRegionSplitterTiled;
+  using Superclass = ImageRegionSplitterBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ImageRegionSplitterTiled);
+
+  /** Set/Get the number of bytes a tile, including its halo, may occupy.
+   * Defaults to 256 KiB, a conservative estimate of the L2 cache per core. */
+  itkSetMacro(CacheSizeInBytes, SizeValueType);
+  itkGetConstMacro(CacheSizeInBytes, SizeValueType);
+
+  /** Set/Get the number of bytes accessed per pixel, typically the size of
+   * the input pixel plus the size of the output pixel. Defaults to 8. */
+  itkSetMacro(BytesPerPixel, SizeValueType);
+  itkGetConstMacro(BytesPerPixel, SizeValueType);
+
+  /** Set/Get the radius of the neighborhood which is read for each output
+   * pixel. Dimensions without a radius are assumed to have radius 0. */
+  template <unsigned int VDimension>
+  void
+  SetRadius(const Size<VDimension> & radius)
+  {
+    const std::vector<SizeValueType> newRadius(radius.begin(), radius.end());
+    if (newRadius != m_Radius)
+    {
+      m_Radius = newRadius;
+      this->Modified();
+    }
+  }
+  const std::vector<SizeValueType> &
+  GetRadius() const
+  {
+    return m_Radius;
+  }
+
+protected:
+  ImageRegionSplitterTiled();
+
+  unsigned int
+  GetNumberOfSplitsInternal(unsigned int         dim,
+                            const IndexValueType regionIndex[],
+                            const SizeValueType  regionSize[],
+                            unsigned int         requestedNumber) const override;
+
+  unsigned int
+  GetSplitInternal(unsigned int   dim,
+                   unsigned int   splitI,
+                   unsigned int   numberOfPieces,
+                   IndexValueType regionIndex[],
+                   SizeValueType  regionSize[]) const override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Computes the number of tiles along each dimension, at most
+   * requestedNumber in total, and returns the total number of tiles. */
+  unsigned int
+  ComputeTiles(unsigned int        dim,
+               unsigned int        requestedNumber,
+               const SizeValueType regionSize[],
+               unsigned int        tiles[]) const;
+
+  SizeValueType              m_CacheSizeInBytes{ 256 * 1024 };
+  SizeValueType              m_BytesPerPixel{ 8 };
+  std::vector<SizeValueType> m_Radius{};
+};
+} // end namespace itk
+
+#endif
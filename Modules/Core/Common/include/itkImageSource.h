@@ -248,6 +248,10 @@ protected:
   void
   GenerateData() override;
 
+  /** Returns the number of pixels in the requested region of the output. */
+  SizeValueType
+  GetNumberOfPixelsInRequestedRegion() const override;
+
   /** Many filters do special management of image buffer and threading,
    *  so this method provides just the multi-threaded invocation part
    *  of GenerateData() method. */
@@ -399,7 +403,18 @@ protected:
   itkSetMacro(DynamicMultiThreading, bool);
   itkBooleanMacro(DynamicMultiThreading);
 
+  /** Whether dynamic multi-threading hands out the pieces of the requested
+   * region one at a time (OFF by default), see
+   * MultiThreaderBase::SetDynamicScheduling(). Dynamic multi-threading also
+   * uses derived class' ImageRegionSplitter. Filters which override
+   * GetImageRegionSplitter() to return a splitter with a fixed piece size,
+   * such as ImageRegionSplitterTiled, should turn this on. */
+  itkGetConstMacro(DynamicScheduling, bool);
+  itkSetMacro(DynamicScheduling, bool);
+  itkBooleanMacro(DynamicScheduling);
+
   bool m_DynamicMultiThreading{ true };
+  bool m_DynamicScheduling{ false };
 };
 } // end namespace itk
 
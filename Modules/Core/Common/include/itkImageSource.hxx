@@ -31,6 +31,7 @@
 #include "itkOutputDataObjectIterator.h"
 #include "itkImageRegionSplitterBase.h"
 #include "itkMultiThreaderBase.h"
+#include "itkPipelineTracer.h"
 
 #include "itkMath.h"
 
@@ -199,6 +200,14 @@ ImageSource<TOutputImage>::ClassicMultiThread(ThreadFunctionType callbackFunctio
   this->GetMultiThreader()->SetSingleMethodAndExecute(callbackFunction, &str);
 }
 
+template <typename TOutputImage>
+SizeValueType
+ImageSource<TOutputImage>::GetNumberOfPixelsInRequestedRegion() const
+{
+  const OutputImageType * const outputPtr = this->GetOutput();
+  return outputPtr ? outputPtr->GetRequestedRegion().GetNumberOfPixels() : 0;
+}
+
 template <typename TOutputImage>
 void
 ImageSource<TOutputImage>::GenerateData()
@@ -220,6 +229,8 @@ ImageSource<TOutputImage>::GenerateData()
   {
     this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
     this->GetMultiThreader()->SetUpdateProgress(this->GetThreaderUpdateProgress());
+    this->GetMultiThreader()->SetImageRegionSplitter(this->GetImageRegionSplitter());
+    this->GetMultiThreader()->SetDynamicScheduling(m_DynamicScheduling);
     this->GetMultiThreader()->template ParallelizeImageRegion<OutputImageDimension>(
       this->GetOutput()->GetRequestedRegion(),
       [this](const OutputImageRegionType & outputRegionForThread) {
@@ -281,6 +292,8 @@ ImageSource<TOutputImage>::ThreaderCallback(void * arg)
 
   if (workUnitID < total)
   {
+    PipelineTracer::Scope workItemTrace("WorkItem", str->Filter.GetPointer());
+    workItemTrace.AddArgument("pixels", splitRegion.GetNumberOfPixels());
     str->Filter->ThreadedGenerateData(splitRegion, workUnitID);
   }
   // else don't use this thread. Threads were not split conveniently.
@@ -293,6 +306,7 @@ ImageSource<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
   itkPrintSelfBooleanMacro(DynamicMultiThreading);
+  itkPrintSelfBooleanMacro(DynamicScheduling);
 }
 
 } // end namespace itk
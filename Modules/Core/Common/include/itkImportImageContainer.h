@@ -20,6 +20,7 @@
 
 #include "itkObject.h"
 #include "itkObjectFactory.h"
+#include "itkImageBufferAllocator.h"
 #include <utility>
 
 namespace itk
@@ -31,6 +32,10 @@ namespace itk
  * conforms to the ImageContainerInterface. This is a full-fledged Object,
  * so there is modification time, debug, and reference count information.
  *
+ * The memory allocated by the container follows its AllocationPolicy, is
+ * optionally first touched in parallel, and is recycled through the buffer
+ * pool when enabled, see ImageBufferAllocator.
+ *
  * \tparam TElementIdentifier An INTEGRAL type for use in indexing the
  * imported buffer.
  *
@@ -57,6 +62,8 @@ public:
   using ElementIdentifier = TElementIdentifier;
   using Element = TElement;
 
+  using AllocationPolicyEnum = ImageBufferAllocator::AllocationPolicyEnum;
+
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
@@ -159,6 +166,22 @@ public:
   itkGetConstMacro(ContainerManageMemory, bool);
   itkBooleanMacro(ContainerManageMemory);
 
+  /** Set/Get how Reserve() and Squeeze() allocate memory. Defaults to
+   * ImageBufferAllocator::GetGlobalDefaultAllocationPolicy(). Changing the
+   * policy does not affect memory which is already allocated. */
+  itkSetEnumMacro(AllocationPolicy, AllocationPolicyEnum);
+  itkGetEnumMacro(AllocationPolicy, AllocationPolicyEnum);
+
+  /** Set/Get whether newly allocated memory is first touched by the work
+   * units of the default multi-threader, so that its pages are spread over
+   * the NUMA nodes of the threads which later process the image. Only
+   * applies to elements which are trivially constructible, as constructors
+   * touch the memory themselves. Defaults to
+   * ImageBufferAllocator::GetGlobalDefaultParallelFirstTouch(). */
+  itkSetMacro(ParallelFirstTouch, bool);
+  itkGetConstMacro(ParallelFirstTouch, bool);
+  itkBooleanMacro(ParallelFirstTouch);
+
 protected:
   ImportImageContainer() = default;
   ~ImportImageContainer() override;
@@ -210,6 +233,14 @@ private:
   TElementIdentifier m_Size{};
   TElementIdentifier m_Capacity{};
   bool               m_ContainerManageMemory{ true };
+
+  AllocationPolicyEnum m_AllocationPolicy{ ImageBufferAllocator::GetGlobalDefaultAllocationPolicy() };
+  bool                 m_ParallelFirstTouch{ ImageBufferAllocator::GetGlobalDefaultParallelFirstTouch() };
+
+  /** How m_ImportPointer was allocated, when managed by the container: with
+   * new[] by the application, or by ImageBufferAllocator with a policy. */
+  bool                 m_ImportedBuffer{ false };
+  AllocationPolicyEnum m_BufferAllocationPolicy{ AllocationPolicyEnum::New };
 };
 } // end namespace itk
 
@@ -29,6 +29,9 @@
 #define itkImportImageContainer_hxx
 
 #include <algorithm> // For copy_n.
+#include <limits>
+#include <memory> // For uninitialized_default_construct_n and destroy_n.
+#include <type_traits>
 
 namespace itk
 {
@@ -61,6 +64,8 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
 
       m_ImportPointer = temp;
       m_ContainerManageMemory = true;
+      m_BufferAllocationPolicy = m_AllocationPolicy;
+      m_ImportedBuffer = false;
       m_Capacity = size;
       m_Size = size;
       this->Modified();
@@ -77,6 +82,8 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
     m_Capacity = size;
     m_Size = size;
     m_ContainerManageMemory = true;
+    m_BufferAllocationPolicy = m_AllocationPolicy;
+    m_ImportedBuffer = false;
     this->Modified();
   }
 }
@@ -101,6 +108,8 @@ ImportImageContainer<TElementIdentifier, TElement>::Squeeze()
 
       m_ImportPointer = temp;
       m_ContainerManageMemory = true;
+      m_BufferAllocationPolicy = m_AllocationPolicy;
+      m_ImportedBuffer = false;
       m_Capacity = size;
       m_Size = size;
 
@@ -144,6 +153,8 @@ ImportImageContainer<TElementIdentifier, TElement>::SetImportPointer(TElement *
   DeallocateManagedMemory();
   m_ImportPointer = ptr;
   m_ContainerManageMemory = LetContainerManageMemory;
+  // A pointer handed over to the container is released by delete[].
+  m_ImportedBuffer = true;
   m_Capacity = num;
   m_Size = num;
 
@@ -155,29 +166,46 @@ TElement *
 ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIdentifier size,
                                                                      bool              UseValueInitialization) const
 {
-  TElement * data;
+  // Elements which need no construction are initialized by the first touch, if any.
+  constexpr bool isTrivial =
+    std::is_trivially_default_constructible_v<TElement> && std::is_trivially_destructible_v<TElement>;
+  const bool parallelFirstTouch = isTrivial && m_ParallelFirstTouch;
 
-  try
+  TElement * data = nullptr;
+
+  if (static_cast<size_t>(size) <= std::numeric_limits<size_t>::max() / sizeof(TElement))
   {
-    if (UseValueInitialization)
-    {
-      data = new TElement[size]();
-    }
-    else
+    data = static_cast<TElement *>(ImageBufferAllocator::Allocate(size * sizeof(TElement), m_AllocationPolicy));
+    if (data && !parallelFirstTouch)
     {
-      data = new TElement[size];
+      try
+      {
+        if (UseValueInitialization)
+        {
+          std::uninitialized_value_construct_n(data, size);
+        }
+        else
+        {
+          std::uninitialized_default_construct_n(data, size);
+        }
+      }
+      catch (...)
+      {
+        ImageBufferAllocator::Deallocate(data, size * sizeof(TElement), m_AllocationPolicy);
+        data = nullptr;
+      }
     }
   }
-  catch (...)
-  {
-    data = nullptr;
-  }
   if (!data)
   {
     // We cannot construct an error string here because we may be out
     // of memory.  Do not use the exception macro.
     throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
   }
+  if (parallelFirstTouch)
+  {
+    ImageBufferAllocator::ParallelFirstTouch(data, size * sizeof(TElement), UseValueInitialization);
+  }
   return data;
 }
 
@@ -188,7 +216,16 @@ ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
   // Encapsulate all image memory deallocation here
   if (m_ContainerManageMemory)
   {
-    delete[] m_ImportPointer;
+    if (m_ImportedBuffer)
+    {
+      delete[] m_ImportPointer;
+    }
+    else if (m_ImportPointer)
+    {
+      std::destroy_n(m_ImportPointer, m_Capacity);
+      ImageBufferAllocator::Deallocate(
+        m_ImportPointer, static_cast<size_t>(m_Capacity) * sizeof(TElement), m_BufferAllocationPolicy);
+    }
   }
   m_ImportPointer = nullptr;
   m_Capacity = 0;
@@ -205,6 +242,8 @@ ImportImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os,
   os << indent << "Container manages memory: " << (m_ContainerManageMemory ? "true" : "false") << std::endl;
   os << indent << "Size: " << m_Size << std::endl;
   os << indent << "Capacity: " << m_Capacity << std::endl;
+  os << indent << "AllocationPolicy: " << m_AllocationPolicy << std::endl;
+  itkPrintSelfBooleanMacro(ParallelFirstTouch);
 }
 } // end namespace itk
 
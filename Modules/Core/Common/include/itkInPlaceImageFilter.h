@@ -170,6 +170,13 @@ protected:
   void
   ReleaseInputs() override;
 
+  /** Returns whether the filter may run in place, overwriting its input. */
+  bool
+  CanOverwriteInputs() const override
+  {
+    return this->GetInPlace() && this->CanRunInPlace();
+  }
+
   /** This methods should only be called during the GenerateData phase
    *  of the pipeline. This method return true if the input image's
    *  bulk data is the same as the output image's data.
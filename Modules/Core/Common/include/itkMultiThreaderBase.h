@@ -34,6 +34,10 @@
 #include "itkIntTypes.h"
 #include "itkImageRegion.h"
 #include "itkImageIORegion.h"
+#include "itkImageRegionSplitterBase.h"
+#include "itkPipelineTracer.h"
+#include "itkHardwareCounters.h"
+#include "itkWorkUnitStatistics.h"
 #include "itkSingletonMacro.h"
 #include <atomic>
 #include <functional>
@@ -64,7 +68,8 @@ public:
     First = Platform,
     Pool,
     TBB,
-    Last = TBB,
+    WorkStealing,
+    Last = WorkStealing,
     Unknown = -1
   };
 
@@ -139,6 +144,23 @@ public:
   SetUpdateProgress(bool updates);
   itkGetConstMacro(UpdateProgress, bool);
 
+  /** Set/Get the splitter which ParallelizeImageRegion uses to divide a region
+   * into pieces. If no splitter is set, ImageSourceCommon::GetGlobalDefaultSplitter()
+   * is used. */
+  itkSetConstObjectMacro(ImageRegionSplitter, ImageRegionSplitterBase);
+  const ImageRegionSplitterBase *
+  GetImageRegionSplitter() const;
+
+  /** Set/Get whether ParallelizeImageRegion hands out the pieces dynamically.
+   * With dynamic scheduling, the region is divided into as many pieces as the
+   * splitter provides, e.g. all the tiles of an ImageRegionSplitterTiled, and
+   * each thread repeatedly takes the next unprocessed piece, in the order
+   * defined by the splitter. Otherwise, the region is divided into at most
+   * one piece per work unit. Off by default. */
+  itkSetMacro(DynamicScheduling, bool);
+  itkGetConstMacro(DynamicScheduling, bool);
+  itkBooleanMacro(DynamicScheduling);
+
   /** Set/Get the maximum number of threads to use when multithreading.  It
    * will be clamped to the range [ 1, ITK_MAX_THREADS ] because several arrays
    * are already statically allocated using the ITK_MAX_THREADS number.
@@ -164,6 +186,7 @@ public:
   static constexpr ThreaderEnum First = ThreaderEnum::First;
   static constexpr ThreaderEnum Pool = ThreaderEnum::Pool;
   static constexpr ThreaderEnum TBB = ThreaderEnum::TBB;
+  static constexpr ThreaderEnum WorkStealing = ThreaderEnum::WorkStealing;
   static constexpr ThreaderEnum Last = ThreaderEnum::Last;
   static constexpr ThreaderEnum Unknown = ThreaderEnum::Unknown;
 #endif
@@ -184,6 +207,8 @@ public:
         return "Pool";
       case ThreaderEnum::TBB:
         return "TBB";
+      case ThreaderEnum::WorkStealing:
+        return "WorkStealing";
       case ThreaderEnum::Unknown:
       default:
         return "Unknown";
@@ -323,7 +348,9 @@ ITK_GCC_PRAGMA_DIAG_POP()
   using ArrayThreadingFunctorType = std::function<void(SizeValueType)>;
 
   /** Parallelize an operation over an array. If filter argument is not nullptr,
-   * this function will update its progress as each index is completed.
+   * this function will update its progress as each index is completed, unless
+   * UpdateProgress is off. The work units are recorded if the filter records
+   * them, see WorkUnitStatistics, whether or not progress is updated.
    *
    * This implementation simply delegates parallelization to the old interface
    * SetSingleMethod+SingleMethodExecute. This method is meant to be overloaded! */
@@ -337,7 +364,8 @@ ITK_GCC_PRAGMA_DIAG_POP()
    * chunk, having the region of the chunk as argument. The type of such a chuck region is `ImageRegion<VDimension>`.
    * Each such `funcP(region)` call must be thread-safe.
    * If filter argument is not nullptr, this function will update its progress
-   * as each work unit is completed. Delegates work to non-templated version. */
+   * as each work unit is completed, and record the work units if the filter
+   * records them. Delegates work to non-templated version. */
   template <unsigned int VDimension, typename TFunction>
   ITK_TEMPLATE_EXPORT void
   ParallelizeImageRegion(const ImageRegion<VDimension> & requestedRegion, TFunction funcP, ProcessObject * filter)
@@ -346,13 +374,17 @@ ITK_GCC_PRAGMA_DIAG_POP()
       VDimension,
       requestedRegion.GetIndex().m_InternalArray,
       requestedRegion.GetSize().m_InternalArray,
-      [&funcP](const IndexValueType index[], const SizeValueType size[]) {
+      [&funcP, filter](const IndexValueType index[], const SizeValueType size[]) {
         ImageRegion<VDimension> region;
         for (unsigned int d = 0; d < VDimension; ++d)
         {
           region.SetIndex(d, index[d]);
           region.SetSize(d, size[d]);
         }
+        PipelineTracer::Scope workItemTrace("WorkItem", filter);
+        workItemTrace.AddArgument("pixels", region.GetNumberOfPixels());
+        const HardwareCounters::Scope   workItemCounters(workItemTrace);
+        const WorkUnitStatistics::Scope workUnit(filter, region.GetNumberOfPixels());
         funcP(region);
       },
       filter);
@@ -394,7 +426,8 @@ ITK_GCC_PRAGMA_DIAG_POP()
         SplitDimension,
         splitIndex.m_InternalArray,
         splitSize.m_InternalArray,
-        [restrictedDirection, &requestedRegion, &funcP](const IndexValueType index[], const SizeValueType size[]) {
+        [restrictedDirection, &requestedRegion, &funcP, filter](const IndexValueType index[],
+                                                                const SizeValueType  size[]) {
           ImageRegion<VDimension> restrictedRequestedRegion;
           restrictedRequestedRegion.SetIndex(restrictedDirection, requestedRegion.GetIndex(restrictedDirection));
           restrictedRequestedRegion.SetSize(restrictedDirection, requestedRegion.GetSize(restrictedDirection));
@@ -407,6 +440,10 @@ ITK_GCC_PRAGMA_DIAG_POP()
               ++splitDimension;
             }
           }
+          PipelineTracer::Scope workItemTrace("WorkItem", filter);
+          workItemTrace.AddArgument("pixels", restrictedRequestedRegion.GetNumberOfPixels());
+          const HardwareCounters::Scope   workItemCounters(workItemTrace);
+          const WorkUnitStatistics::Scope workUnit(filter, restrictedRequestedRegion.GetNumberOfPixels());
           funcP(restrictedRequestedRegion);
         },
         filter);
@@ -434,6 +471,7 @@ protected:
     const SizeValueType       firstIndex;
     const SizeValueType       lastIndexPlus1;
     ProcessObject *           filter;
+    ProcessObject *           progressFilter;
   };
 
   static ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
@@ -441,16 +479,26 @@ protected:
 
   struct RegionAndCallback
   {
-    ThreadingFunctorType   functor;
-    unsigned int           dimension;
-    const IndexValueType * index;
-    const SizeValueType *  size;
-    ProcessObject *        filter;
+    ThreadingFunctorType            functor;
+    unsigned int                    dimension;
+    const IndexValueType *          index;
+    const SizeValueType *           size;
+    ProcessObject *                 filter;
+    const ImageRegionSplitterBase * splitter;
   };
 
   static ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
   ParallelizeImageRegionHelper(void * arg);
 
+  /** Implements ParallelizeImageRegion for dynamic scheduling, on top of
+   * ParallelizeArray. Derived classes call it when GetDynamicScheduling() is true. */
+  void
+  ParallelizeImageRegionDynamically(unsigned int         dimension,
+                                    const IndexValueType index[],
+                                    const SizeValueType  size[],
+                                    ThreadingFunctorType funcP,
+                                    ProcessObject *      filter);
+
   /** The number of work units to create. */
   ThreadIdType m_NumberOfWorkUnits{};
 
@@ -490,6 +538,10 @@ private:
 
   std::atomic<bool> m_UpdateProgress{ true };
 
+  ImageRegionSplitterBase::ConstPointer m_ImageRegionSplitter{};
+
+  bool m_DynamicScheduling{ false };
+
   static MultiThreaderBaseGlobals * m_PimplGlobals;
   /** Friends of Multithreader.
    * ProcessObject is a friend so that it can call PrintSelf() on its
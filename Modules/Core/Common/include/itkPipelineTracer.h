@@ -0,0 +1,169 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineTracer_h
+#define itkPipelineTracer_h
+
+#include "ITKCommonExport.h"
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+#include "itkSingletonMacro.h"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+
+class ProcessObject;
+struct PipelineTracerGlobals;
+
+/** \class PipelineTracer
+ * \brief Records a timeline of pipeline execution, written as Chrome trace JSON.
+ *
+ * When tracing is enabled, every ProcessObject::UpdateOutputData() call,
+ * every GenerateData() call and every work item run by
+ * MultiThreaderBase::ParallelizeImageRegion() is recorded as a complete
+ * event, carrying the thread it ran on, its start time and its duration:
+ *  - an UpdateOutputData event spans the update of a filter, including the
+ *    update of its inputs, and is named after the class of the filter;
+ *  - a GenerateData event spans the execution of the filter itself, and
+ *    records the number of pixels of the requested region of the primary
+ *    output and the number of bytes of image buffers allocated meanwhile
+ *    by the calling thread, see ImageBufferAllocator;
+ *  - a WorkItem event spans one piece of the region processed by a thread,
+ *    and records its number of pixels and, while HardwareCounters collect,
+ *    its processor event counts.
+ *
+ * The events are written in the Trace Event Format of the Chrome tracing
+ * tool, which the Perfetto UI (https://ui.perfetto.dev) and
+ * chrome://tracing display as one track per thread. The wall time of each
+ * filter, the busy time of each thread and the load imbalance between the
+ * work items of a filter can be read from the timeline.
+ *
+ * Tracing is off by default, and costs a single check per instrumented
+ * call. It can be switched on without recompiling by setting the
+ * environment variable ITK_PIPELINE_TRACE to the name of a file, to which
+ * the trace is written when the program exits. Applications may also
+ * enable it with SetEnabled(), and write the trace with WriteChromeTrace().
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PipelineTracer
+{
+public:
+  /** A recorded complete event. Times are in microseconds since the
+   * first use of the tracer. */
+  struct Event
+  {
+    std::string                                        Name{};
+    std::string                                        Category{};
+    double                                             Timestamp{ 0.0 };
+    double                                             Duration{ 0.0 };
+    unsigned int                                       ThreadIndex{ 0 };
+    std::vector<std::pair<std::string, SizeValueType>> Arguments{};
+  };
+
+  /** Records an event spanning the lifetime of the scope, if tracing is
+   * enabled when the scope is constructed. */
+  class ITKCommon_EXPORT Scope
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_MOVE(Scope);
+
+    Scope(const char * category, const char * name);
+
+    /** Names the event after the class, and object name if any, of the
+     * filter, which may be nullptr. */
+    Scope(const char * category, const ProcessObject * filter);
+
+    ~Scope();
+
+    /** Returns whether the scope records an event. */
+    bool
+    IsActive() const
+    {
+      return m_Active;
+    }
+
+    /** Attaches a value to the event. Ignored if the scope is not active. */
+    void
+    AddArgument(const char * key, SizeValueType value);
+
+    /** Attaches the number of bytes of image buffers allocated by the
+     * calling thread during the lifetime of the scope to the event. */
+    void
+    AddAllocatedBytesArgument();
+
+  private:
+    bool          m_Active{ false };
+    Event         m_Event{};
+    SizeValueType m_AllocatedBytesAtStart{ 0 };
+    bool          m_AddAllocatedBytes{ false };
+  };
+
+  /** Set/Get whether pipeline execution is recorded. Defaults to false,
+   * unless ITK_PIPELINE_TRACE is set. */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  GetEnabled();
+
+  /** Set/Get the name of the file to which the trace is written when the
+   * program exits. Empty, the default, writes no file. Initialized from
+   * ITK_PIPELINE_TRACE. */
+  static void
+  SetOutputFileName(const std::string & fileName);
+  static std::string
+  GetOutputFileName();
+
+  /** Returns a copy of the events recorded so far. */
+  static std::vector<Event>
+  GetEvents();
+
+  /** Discards the events recorded so far. */
+  static void
+  ClearEvents();
+
+  /** Writes the events recorded so far as Chrome trace JSON. */
+  static void
+  WriteChromeTrace(std::ostream & os);
+  static void
+  WriteChromeTrace(const std::string & fileName);
+
+  /** Adds to the number of bytes of image buffers allocated by the calling
+   * thread. Called by ImageBufferAllocator. */
+  static void
+  AddAllocatedBytes(size_t numberOfBytes);
+
+  /** Returns the time, in microseconds, since the first use of the tracer. */
+  static double
+  GetTimestamp();
+
+private:
+  static void
+  RecordEvent(Event && event);
+
+  itkGetGlobalDeclarationMacro(PipelineTracerGlobals, PimplGlobals);
+  static PipelineTracerGlobals * m_PimplGlobals;
+};
+
+} // end namespace itk
+
+#endif
@@ -33,10 +33,13 @@
 #include "itkNumericTraits.h"
 #include "itkThreadSupport.h"
 #include "itkIntTypes.h"
+#include "itkWorkUnitStatistics.h"
 #include <vector>
 #include <map>
 #include <set>
 #include <algorithm>
+#include <functional>
+#include <future>
 #include <thread>
 
 namespace itk
@@ -386,6 +389,74 @@ public:
   virtual void
   UpdateLargestPossibleRegion();
 
+  /** Update the pipeline from another thread, as Update() does, and return
+   * a future which becomes ready when the update has completed, or which
+   * rethrows the exception thrown by the update. The process object is
+   * kept alive until then. The pipeline must neither be modified nor
+   * updated by other means while the update is in progress. */
+  std::future<void>
+  UpdateAsync();
+
+  /** Turn on/off the concurrent update of the inputs of this process
+   * object. By default, the inputs of a process object are updated one
+   * after another. When this flag is on, independent upstream branches
+   * are updated concurrently, each from its own thread, while the
+   * parallel loops of their filters share the thread pools of the
+   * multi-threaders. Upstream data objects shared by several branches
+   * are updated first, one branch after another, as the serial update
+   * would do. The inputs are updated serially, as if the flag was off,
+   * unless all of these hold:
+   *  - all the branches request the same region of the data objects
+   *    they share;
+   *  - the release data flag of no shared data object is on;
+   *  - no filter may overwrite a shared data object by running in place.
+   * Observers of the upstream filters may be invoked from several threads
+   * at the same time. Off by default. */
+  itkSetMacro(ConcurrentInputUpdate, bool);
+  itkGetConstMacro(ConcurrentInputUpdate, bool);
+  itkBooleanMacro(ConcurrentInputUpdate);
+
+  /** Set/Get whether the work units which the multi-threaders run for this
+   * process object are timed, see WorkUnitStatistics. Off by default. */
+  itkSetMacro(RecordWorkUnitStatistics, bool);
+  itkGetConstMacro(RecordWorkUnitStatistics, bool);
+  itkBooleanMacro(RecordWorkUnitStatistics);
+
+  /** Get the work units recorded during the last execution of
+   * GenerateData(), when RecordWorkUnitStatistics is on. */
+  const WorkUnitStatistics &
+  GetWorkUnitStatistics() const
+  {
+    return m_WorkUnitStatistics;
+  }
+
+  /** Estimate the memory, in bytes per pixel of the requested region of the
+   * primary output, which the process object needs besides the bulk data
+   * of its inputs and outputs, e.g. for internal images. Filters which
+   * allocate sizable temporaries should override this method, so that
+   * memory-budgeted streaming accounts for them. Returns 0 by default. */
+  virtual double
+  GetAdditionalMemoryPerOutputPixel() const
+  {
+    return 0.0;
+  }
+
+  /** Estimate the memory, in bytes, needed to generate the requested
+   * regions of the outputs: the bulk data of the requested regions of the
+   * outputs and of the inputs, which include their enlargement, e.g. by the
+   * radius of a neighborhood, plus the additional memory of the process
+   * object. Only meaningful once the requested region has been propagated. */
+  SizeValueType
+  EstimateMemoryFootprint() const;
+
+  /** Estimate the memory, in bytes, needed by the pipeline upstream of, and
+   * including, the data object to generate its requested region: the bulk
+   * data of the requested regions of all the data objects of the pipeline,
+   * each counted once, plus the additional memory of all its process
+   * objects. Only meaningful once the requested region has been propagated. */
+  static SizeValueType
+  EstimatePipelineMemoryFootprint(const DataObject * dataObject);
+
   /** \brief Update the information describing the output data.
    *
    * This method
@@ -845,6 +916,39 @@ protected:
   GenerateData()
   {}
 
+  /** Returns the number of pixels in the requested region of the primary
+   * output, which is recorded with GenerateData() in the pipeline trace,
+   * see PipelineTracer. Returns 0, the default, for outputs without pixels. */
+  virtual SizeValueType
+  GetNumberOfPixelsInRequestedRegion() const
+  {
+    return 0;
+  }
+
+  /** Returns whether the process object may overwrite, or take over, the
+   * bulk data of one of its inputs, as in-place filters do. Returns false,
+   * the default, for process objects which leave their inputs untouched. */
+  virtual bool
+  CanOverwriteInputs() const
+  {
+    return false;
+  }
+
+  /** Returns the number of stream divisions for which generating one piece
+   * of the requested region of the input is estimated, by
+   * EstimatePipelineMemoryFootprint(), to fit in memoryBudget bytes.
+   * requestPiece(n) must split the region into about n pieces, set the
+   * requested region of the input to a representative piece, preferably one
+   * away from the borders, where requests are enlarged the most, and return
+   * the actual number of pieces. When the footprint stops decreasing with
+   * more pieces, e.g. because an upstream filter always requests its largest
+   * possible region, the number of pieces reaching the lowest footprint is
+   * returned. */
+  static unsigned int
+  ComputeNumberOfStreamDivisions(DataObject *                                      input,
+                                 SizeValueType                                     memoryBudget,
+                                 const std::function<unsigned int(unsigned int)> & requestPiece);
+
   /** Called to allocate the input array.  Copies old inputs. */
   /** Propagate a call to ResetPipeline() up the pipeline. Called only from
    * DataObject. */
@@ -949,6 +1053,12 @@ private:
   DataObjectPointerArraySizeType
   MakeIndexFromName(const DataObjectIdentifierType &) const;
 
+  /** Updates the inputs concurrently, see SetConcurrentInputUpdate().
+   * Returns false, leaving the update of the inputs to the caller, when
+   * they cannot safely be updated concurrently. */
+  bool
+  UpdateInputsConcurrently();
+
   /** STL map to store the named inputs and outputs */
   using DataObjectPointerMap = std::map<DataObjectIdentifierType, DataObjectPointer>;
 
@@ -979,6 +1089,11 @@ private:
 
   std::thread::id m_UpdateThreadID{};
 
+  bool m_ConcurrentInputUpdate{ false };
+
+  bool               m_RecordWorkUnitStatistics{ false };
+  WorkUnitStatistics m_WorkUnitStatistics{};
+
   /** Support processing data in multiple threads. Used by subclasses
    * (e.g., ImageSource). */
   itk::SmartPointer<MultiThreaderType> m_MultiThreader;
@@ -994,6 +1109,7 @@ private:
 
   friend class ProgressReporter;
   friend class TotalProgressReporter;
+  friend class WorkUnitStatistics::Scope;
 
   friend class DataObjectConstIterator;
   friend class InputDataObjectConstIterator;
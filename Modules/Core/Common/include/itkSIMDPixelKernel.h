@@ -0,0 +1,335 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSIMDPixelKernel_h
+#define itkSIMDPixelKernel_h
+
+#include "itkImageRegion.h"
+#include "itkSingletonMacro.h"
+
+#include <array>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#  define ITK_SIMD_PIXEL_KERNEL_DISPATCH
+#endif
+
+namespace itk
+{
+
+template <unsigned int VImageDimension>
+class ImageBase;
+template <typename TPixel, unsigned int VImageDimension>
+class Image;
+template <typename TPixel, unsigned int VImageDimension>
+class VectorImage;
+template <typename TValue>
+class VariableLengthVector;
+
+struct SIMDPixelKernelGlobals;
+
+/** \class SIMDPixelKernelEnums
+ *
+ * \brief enums for SIMDPixelKernel
+ *
+ * \ingroup ITKCommon
+ */
+class SIMDPixelKernelEnums
+{
+public:
+  /**
+   * \ingroup ITKCommon
+   * Instruction sets the pixel-wise loops are compiled for, from the
+   * narrowest to the widest vectors.
+   */
+  enum class InstructionSet : uint8_t
+  {
+    Baseline = 0,
+    SSE4,
+    AVX2,
+    AVX512
+  };
+};
+/** Define how to print enumerations */
+extern ITKCommon_EXPORT std::ostream &
+                        operator<<(std::ostream & out, const SIMDPixelKernelEnums::InstructionSet value);
+
+/** \class SIMDPixelComponentFunctor
+ *
+ * \brief Maps a pixel functor of VariableLengthVector pixels to the
+ * functor it applies to each component.
+ *
+ * Only functors which compute each component of their result from the
+ * same component of their arguments may specialize this template, which
+ * lets SIMDPixelKernel process the buffers of VectorImage as arrays of
+ * components. The specializations define the type of the component
+ * functor, and how to get it from the pixel functor:
+ * \code
+ * using Type = ...;
+ * static Type Get(const TPixelFunctor &);
+ * \endcode
+ *
+ * \ingroup ITKCommon
+ */
+template <typename TPixelFunctor>
+struct SIMDPixelComponentFunctor
+{};
+
+namespace SIMDPixelKernelDetail
+{
+template <typename TImage>
+struct IsArithmeticImage : std::false_type
+{};
+template <typename TPixel, unsigned int VImageDimension>
+struct IsArithmeticImage<Image<TPixel, VImageDimension>> : std::is_arithmetic<TPixel>
+{};
+
+template <typename TImage>
+struct IsArithmeticVectorImage : std::false_type
+{};
+template <typename TPixel, unsigned int VImageDimension>
+struct IsArithmeticVectorImage<VectorImage<TPixel, VImageDimension>> : std::is_arithmetic<TPixel>
+{};
+
+template <typename TFunctor, typename = void>
+struct HasComponentFunctor : std::false_type
+{};
+template <typename TFunctor>
+struct HasComponentFunctor<TFunctor, std::void_t<typename SIMDPixelComponentFunctor<TFunctor>::Type>>
+  : std::true_type
+{};
+} // namespace SIMDPixelKernelDetail
+
+/** \class SIMDPixelKernel
+ * \brief Runs pixel-wise loops over contiguous buffers with the widest
+ * vector instructions the processor supports.
+ *
+ * Pixel-wise filters evaluate a functor per pixel through iterators,
+ * which the compiler rarely vectorizes. SIMDPixelKernel runs such loops
+ * over raw buffers instead. Each loop is compiled once per instruction
+ * set, with the functor inlined, so that the compiler vectorizes it for
+ * that instruction set, and the widest version supported by the processor
+ * is selected at run time. Run time dispatch is available with GCC and
+ * Clang on x86; elsewhere the loops are compiled for the instruction set
+ * of the build only. The loops are only vectorized when the build
+ * enables auto-vectorization, e.g. at -O3.
+ *
+ * TransformImages() applies a functor to the pixels of images of
+ * arithmetic pixels, Image, or of arithmetic components, VectorImage,
+ * provided that the functor has a SIMDPixelComponentFunctor. Filters test
+ * CanTransformImages at compile time, and IsEnabled() at run time, and
+ * fall back to their iterator loops otherwise.
+ *
+ * The ITK_SIMD_INSTRUCTION_SET environment variable, set to Baseline,
+ * SSE4, AVX2 or AVX512, limits the instruction set used, and setting it
+ * to OFF disables the kernels.
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT SIMDPixelKernel
+{
+public:
+  using InstructionSetEnum = SIMDPixelKernelEnums::InstructionSet;
+
+  /** Enable or disable the kernels, for all the filters. Enabled by default. */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  IsEnabled();
+
+  /** The widest instruction set supported by both the processor and the
+   * build. */
+  static InstructionSetEnum
+  GetSupportedInstructionSet();
+
+  /** Set/Get the widest instruction set the kernels may use. Defaults to
+   * AVX512, i.e. the widest one supported. */
+  static void
+  SetMaximumInstructionSet(InstructionSetEnum instructionSet);
+  static InstructionSetEnum
+  GetMaximumInstructionSet();
+
+  /** The instruction set the kernels use. */
+  static InstructionSetEnum
+  GetInstructionSet();
+
+  /** Calls function(arguments...), compiled for the instruction set the
+   * kernels use, along with everything it calls which can be inlined. The
+   * arguments are passed by value, rather than captured, so that the
+   * compiler knows that the stores of the loops do not modify them. */
+  template <typename TFunction, typename... TArguments>
+  static void
+  Dispatch(const TFunction & function, TArguments... arguments)
+  {
+#ifdef ITK_SIMD_PIXEL_KERNEL_DISPATCH
+    switch (GetInstructionSet())
+    {
+      case InstructionSetEnum::AVX512:
+        DispatchAVX512(function, arguments...);
+        return;
+      case InstructionSetEnum::AVX2:
+        DispatchAVX2(function, arguments...);
+        return;
+      case InstructionSetEnum::SSE4:
+        DispatchSSE4(function, arguments...);
+        return;
+      default:
+        break;
+    }
+#endif
+    DispatchBaseline(function, arguments...);
+  }
+
+  /** output[i] = functor(input[i]), for i in [0, size). */
+  template <typename TInput, typename TOutput, typename TFunctor>
+  static void
+  Transform(const TInput * input, TOutput * output, SizeValueType size, const TFunctor & functor)
+  {
+    Dispatch(
+      [](const TInput * in, TOutput * out, SizeValueType n, TFunctor f) {
+        for (SizeValueType i = 0; i < n; ++i)
+        {
+          out[i] = f(in[i]);
+        }
+      },
+      input,
+      output,
+      size,
+      functor);
+  }
+
+  /** output[i] = functor(input1[i], input2[i]), for i in [0, size). */
+  template <typename TInput1, typename TInput2, typename TOutput, typename TFunctor>
+  static void
+  Transform(const TInput1 *  input1,
+            const TInput2 *  input2,
+            TOutput *        output,
+            SizeValueType    size,
+            const TFunctor & functor)
+  {
+    Dispatch(
+      [](const TInput1 * in1, const TInput2 * in2, TOutput * out, SizeValueType n, TFunctor f) {
+        for (SizeValueType i = 0; i < n; ++i)
+        {
+          out[i] = f(in1[i], in2[i]);
+        }
+      },
+      input1,
+      input2,
+      output,
+      size,
+      functor);
+  }
+
+  /** Calls function(size, offsets) for each chunk of the region which is
+   * contiguous in the buffers of all the images, where size is the number
+   * of pixels of the chunk, and offsets the offsets of its first pixel in
+   * the buffers of the images. The region must be buffered by all the
+   * images. */
+  template <unsigned int VImageDimension, size_t VNumberOfImages, typename TFunction>
+  static void
+  ForEachContiguousChunk(const ImageRegion<VImageDimension> &                              region,
+                         const std::array<const ImageBase<VImageDimension> *, VNumberOfImages> & images,
+                         const TFunction &                                                  function);
+
+  /** Whether all the images are Image of arithmetic pixels. */
+  template <typename... TImages>
+  static constexpr bool AreArithmeticImages = (SIMDPixelKernelDetail::IsArithmeticImage<TImages>::value && ...);
+
+  /** Whether TransformImages() can apply a functor of type TFunctor to
+   * images of the given types. */
+  template <typename TFunctor, typename TOutputImage, typename... TInputImages>
+  static constexpr bool CanTransformImages =
+    AreArithmeticImages<TOutputImage, TInputImages...> ||
+    ((SIMDPixelKernelDetail::IsArithmeticVectorImage<TOutputImage>::value && ... &&
+      SIMDPixelKernelDetail::IsArithmeticVectorImage<TInputImages>::value) &&
+     SIMDPixelKernelDetail::HasComponentFunctor<TFunctor>::value);
+
+  /** Sets the pixels of the region of the output to the result of the
+   * functor on the pixels of the same region of the input. Returns false,
+   * doing nothing, when the images have different numbers of components. */
+  template <typename TFunctor, typename TOutputImage, typename TInputImage>
+  static bool
+  TransformImages(const TFunctor &                           functor,
+                  const typename TOutputImage::RegionType & region,
+                  TOutputImage *                             output,
+                  const TInputImage *                        input);
+
+  /** Sets the pixels of the region of the output to the result of the
+   * functor on the pixels of the same region of the inputs. Returns false,
+   * doing nothing, when the images have different numbers of components. */
+  template <typename TFunctor, typename TOutputImage, typename TInputImage1, typename TInputImage2>
+  static bool
+  TransformImages(const TFunctor &                           functor,
+                  const typename TOutputImage::RegionType & region,
+                  TOutputImage *                             output,
+                  const TInputImage1 *                       input1,
+                  const TInputImage2 *                       input2);
+
+private:
+  /** The functor to apply to the components of the buffer of TImage. */
+  template <typename TImage, typename TFunctor>
+  static decltype(auto)
+  GetComponentFunctor(const TFunctor & functor);
+
+#ifdef ITK_SIMD_PIXEL_KERNEL_DISPATCH
+  template <typename TFunction, typename... TArguments>
+  __attribute__((target("sse4.2"), flatten)) static void
+  DispatchSSE4(const TFunction & function, TArguments... arguments)
+  {
+    function(arguments...);
+  }
+
+  template <typename TFunction, typename... TArguments>
+  __attribute__((target("avx2"), flatten)) static void
+  DispatchAVX2(const TFunction & function, TArguments... arguments)
+  {
+    function(arguments...);
+  }
+
+  template <typename TFunction, typename... TArguments>
+  __attribute__((target("avx512f,avx512bw,avx512vl"), flatten)) static void
+  DispatchAVX512(const TFunction & function, TArguments... arguments)
+  {
+    function(arguments...);
+  }
+
+  template <typename TFunction, typename... TArguments>
+  __attribute__((flatten)) static void
+  DispatchBaseline(const TFunction & function, TArguments... arguments)
+  {
+    function(arguments...);
+  }
+#else
+  template <typename TFunction, typename... TArguments>
+  static void
+  DispatchBaseline(const TFunction & function, TArguments... arguments)
+  {
+    function(arguments...);
+  }
+#endif
+
+  itkGetGlobalDeclarationMacro(SIMDPixelKernelGlobals, PimplGlobals);
+  static SIMDPixelKernelGlobals * m_PimplGlobals;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkSIMDPixelKernel.hxx"
+#endif
+
+#endif
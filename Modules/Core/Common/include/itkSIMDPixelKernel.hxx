@@ -0,0 +1,161 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSIMDPixelKernel_hxx
+#define itkSIMDPixelKernel_hxx
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <unsigned int VImageDimension, size_t VNumberOfImages, typename TFunction>
+void
+SIMDPixelKernel::ForEachContiguousChunk(const ImageRegion<VImageDimension> &                              region,
+                                        const std::array<const ImageBase<VImageDimension> *, VNumberOfImages> & images,
+                                        const TFunction &                                                  function)
+{
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // The chunks extend over the dimensions along which the region covers
+  // the whole buffered region of all the images.
+  SizeValueType numberOfPixels = region.GetSize(0);
+  unsigned int  movingDirection = 1;
+  const auto    coversBufferedRegion = [&region, &movingDirection](const ImageBase<VImageDimension> * image) {
+    return region.GetSize(movingDirection - 1) == image->GetBufferedRegion().GetSize(movingDirection - 1);
+  };
+  while (movingDirection < VImageDimension && std::all_of(images.begin(), images.end(), coversBufferedRegion))
+  {
+    numberOfPixels *= region.GetSize(movingDirection);
+    ++movingDirection;
+  }
+
+  typename ImageRegion<VImageDimension>::IndexType index = region.GetIndex();
+  std::array<OffsetValueType, VNumberOfImages>     offsets;
+  while (true)
+  {
+    for (size_t i = 0; i < VNumberOfImages; ++i)
+    {
+      offsets[i] = images[i]->ComputeOffset(index);
+    }
+    function(numberOfPixels, offsets);
+
+    // Move to the next chunk, carrying to higher dimensions at the end of
+    // the region.
+    unsigned int dim = movingDirection;
+    for (; dim < VImageDimension; ++dim)
+    {
+      ++index[dim];
+      if (static_cast<SizeValueType>(index[dim] - region.GetIndex(dim)) < region.GetSize(dim))
+      {
+        break;
+      }
+      index[dim] = region.GetIndex(dim);
+    }
+    if (dim == VImageDimension)
+    {
+      return;
+    }
+  }
+}
+
+
+template <typename TImage, typename TFunctor>
+decltype(auto)
+SIMDPixelKernel::GetComponentFunctor(const TFunctor & functor)
+{
+  if constexpr (SIMDPixelKernelDetail::IsArithmeticImage<TImage>::value)
+  {
+    return functor;
+  }
+  else
+  {
+    return SIMDPixelComponentFunctor<TFunctor>::Get(functor);
+  }
+}
+
+
+template <typename TFunctor, typename TOutputImage, typename TInputImage>
+bool
+SIMDPixelKernel::TransformImages(const TFunctor &                           functor,
+                                 const typename TOutputImage::RegionType & region,
+                                 TOutputImage *                             output,
+                                 const TInputImage *                        input)
+{
+  static_assert(CanTransformImages<TFunctor, TOutputImage, TInputImage>, "Unsupported functor or image types.");
+
+  const SizeValueType numberOfComponents = output->GetNumberOfComponentsPerPixel();
+  if (input->GetNumberOfComponentsPerPixel() != numberOfComponents)
+  {
+    return false;
+  }
+
+  const auto &                                      componentFunctor = GetComponentFunctor<TOutputImage>(functor);
+  const typename TInputImage::InternalPixelType * const inputBuffer = input->GetBufferPointer();
+  typename TOutputImage::InternalPixelType * const      outputBuffer = output->GetBufferPointer();
+
+  ForEachContiguousChunk<TOutputImage::ImageDimension, 2>(
+    region, { { output, input } }, [&](SizeValueType size, const std::array<OffsetValueType, 2> & offsets) {
+      Transform(inputBuffer + offsets[1] * numberOfComponents,
+                outputBuffer + offsets[0] * numberOfComponents,
+                size * numberOfComponents,
+                componentFunctor);
+    });
+  return true;
+}
+
+
+template <typename TFunctor, typename TOutputImage, typename TInputImage1, typename TInputImage2>
+bool
+SIMDPixelKernel::TransformImages(const TFunctor &                           functor,
+                                 const typename TOutputImage::RegionType & region,
+                                 TOutputImage *                             output,
+                                 const TInputImage1 *                       input1,
+                                 const TInputImage2 *                       input2)
+{
+  static_assert(CanTransformImages<TFunctor, TOutputImage, TInputImage1, TInputImage2>,
+                "Unsupported functor or image types.");
+
+  const SizeValueType numberOfComponents = output->GetNumberOfComponentsPerPixel();
+  if (input1->GetNumberOfComponentsPerPixel() != numberOfComponents ||
+      input2->GetNumberOfComponentsPerPixel() != numberOfComponents)
+  {
+    return false;
+  }
+
+  const auto &                                       componentFunctor = GetComponentFunctor<TOutputImage>(functor);
+  const typename TInputImage1::InternalPixelType * const input1Buffer = input1->GetBufferPointer();
+  const typename TInputImage2::InternalPixelType * const input2Buffer = input2->GetBufferPointer();
+  typename TOutputImage::InternalPixelType * const       outputBuffer = output->GetBufferPointer();
+
+  ForEachContiguousChunk<TOutputImage::ImageDimension, 3>(
+    region, { { output, input1, input2 } }, [&](SizeValueType size, const std::array<OffsetValueType, 3> & offsets) {
+      Transform(input1Buffer + offsets[1] * numberOfComponents,
+                input2Buffer + offsets[2] * numberOfComponents,
+                outputBuffer + offsets[0] * numberOfComponents,
+                size * numberOfComponents,
+                componentFunctor);
+    });
+  return true;
+}
+
+} // end namespace itk
+
+#endif
@@ -36,6 +36,13 @@ namespace itk
  * This filter will produce the entire output as one image, but the upstream
  * filters will do their processing in pieces.
  *
+ * Instead of a number of divisions, a memory budget may be given. The
+ * number of divisions and the region splitter are then chosen so that the
+ * upstream pipeline is estimated to fit in the budget, besides the output
+ * of this filter, while generating each piece. The estimate accounts for
+ * the enlargement of the requested regions by upstream filters, see
+ * ProcessObject::EstimatePipelineMemoryFootprint().
+ *
  * \ingroup ITKSystemObjects
  * \ingroup DataProcessing
  * \ingroup ITKCommon
@@ -90,6 +97,19 @@ public:
   itkSetObjectMacro(RegionSplitter, SplitterType);
   itkGetModifiableObjectMacro(RegionSplitter, SplitterType);
 
+  /** Set/Get the memory budget, in bytes. When it is not 0, the number of
+   * stream divisions is chosen automatically, and NumberOfStreamDivisions
+   * is ignored. Either the RegionSplitter or, when it needs fewer
+   * divisions, an ImageRegionSplitterMultidimensional is used, as
+   * splitting the slowest dimension only makes the enlargement of the
+   * requested regions weigh more as the pieces get thinner. Defaults to 0. */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstMacro(MemoryBudget, SizeValueType);
+
+  /** Get the number of pieces, and the splitter, used by the last update. */
+  itkGetConstMacro(ActualNumberOfStreamDivisions, unsigned int);
+  itkGetConstObjectMacro(ActualRegionSplitter, SplitterType);
+
   /** Override UpdateOutputData() from ProcessObject to divide upstream
    * updates into pieces. This filter does not have a GenerateData()
    * or ThreadedGenerateData() method.  Instead, all the work is done
@@ -117,6 +137,9 @@ protected:
 private:
   unsigned int          m_NumberOfStreamDivisions{};
   RegionSplitterPointer m_RegionSplitter{};
+  SizeValueType         m_MemoryBudget{ 0 };
+  unsigned int          m_ActualNumberOfStreamDivisions{ 0 };
+  RegionSplitterPointer m_ActualRegionSplitter{};
 };
 } // end namespace itk
 
@@ -19,6 +19,7 @@
 #define itkStreamingImageFilter_hxx
 #include "itkCommand.h"
 #include "itkImageAlgorithm.h"
+#include "itkImageRegionSplitterMultidimensional.h"
 #include "itkImageRegionSplitterSlowDimension.h"
 
 namespace itk
@@ -48,6 +49,10 @@ StreamingImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, In
   os << indent << "Number of stream divisions: " << m_NumberOfStreamDivisions << std::endl;
 
   itkPrintSelfObjectMacro(RegionSplitter);
+
+  os << indent << "MemoryBudget: " << m_MemoryBudget << std::endl;
+  os << indent << "ActualNumberOfStreamDivisions: " << m_ActualNumberOfStreamDivisions << std::endl;
+  itkPrintSelfObjectMacro(ActualRegionSplitter);
 }
 
 /**
@@ -148,16 +153,46 @@ StreamingImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * i
 
   /**
    * Determine of number of pieces to divide the input.  This will be the
-   * minimum of what the user specified via SetNumberOfStreamDivisions()
-   * and what the Splitter thinks is a reasonable value.
+   * minimum of what the user specified via SetNumberOfStreamDivisions(),
+   * or what fits in the memory budget, and what the Splitter thinks is a
+   * reasonable value.
    */
-  unsigned int       numDivisions = m_NumberOfStreamDivisions;
-  const unsigned int numDivisionsFromSplitter =
-    m_RegionSplitter->GetNumberOfSplits(outputRegion, m_NumberOfStreamDivisions);
+  RegionSplitterPointer splitter = m_RegionSplitter;
+  unsigned int          numDivisions = m_NumberOfStreamDivisions;
+  if (m_MemoryBudget > 0)
+  {
+    // The output of this filter is allocated whole, the rest of the budget
+    // is left to the upstream pipeline.
+    const SizeValueType outputSize = outputPtr->GetRequestedRegionMemorySize();
+    const SizeValueType upstreamBudget = m_MemoryBudget > outputSize ? m_MemoryBudget - outputSize : 1;
+
+    const auto computeNumberOfDivisions = [inputPtr, &outputRegion, upstreamBudget](const SplitterType * candidate) {
+      return ProcessObject::ComputeNumberOfStreamDivisions(
+        inputPtr, upstreamBudget, [inputPtr, &outputRegion, candidate](unsigned int numberOfPieces) {
+          const unsigned int   actualNumberOfPieces = candidate->GetNumberOfSplits(outputRegion, numberOfPieces);
+          InputImageRegionType streamRegion = outputRegion;
+          candidate->GetSplit(actualNumberOfPieces / 2, actualNumberOfPieces, streamRegion);
+          inputPtr->SetRequestedRegion(streamRegion);
+          return actualNumberOfPieces;
+        });
+    };
+    numDivisions = computeNumberOfDivisions(m_RegionSplitter);
+
+    const RegionSplitterPointer multidimensionalSplitter = ImageRegionSplitterMultidimensional::New();
+    const unsigned int          multidimensionalNumDivisions = computeNumberOfDivisions(multidimensionalSplitter);
+    if (multidimensionalNumDivisions < numDivisions)
+    {
+      splitter = multidimensionalSplitter;
+      numDivisions = multidimensionalNumDivisions;
+    }
+  }
+  const unsigned int numDivisionsFromSplitter = splitter->GetNumberOfSplits(outputRegion, numDivisions);
   if (numDivisionsFromSplitter < numDivisions)
   {
     numDivisions = numDivisionsFromSplitter;
   }
+  m_ActualNumberOfStreamDivisions = numDivisions;
+  m_ActualRegionSplitter = splitter;
 
   /**
    * Loop over the number of pieces, execute the upstream pipeline on each
@@ -167,7 +202,7 @@ StreamingImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * i
   for (; piece < numDivisions && !this->GetAbortGenerateData(); ++piece)
   {
     InputImageRegionType streamRegion = outputRegion;
-    m_RegionSplitter->GetSplit(piece, numDivisions, streamRegion);
+    splitter->GetSplit(piece, numDivisions, streamRegion);
 
     inputPtr->SetRequestedRegion(streamRegion);
     inputPtr->PropagateRequestedRegion();
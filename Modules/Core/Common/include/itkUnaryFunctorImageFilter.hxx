@@ -19,6 +19,7 @@
 #define itkUnaryFunctorImageFilter_hxx
 
 #include "itkImageScanlineIterator.h"
+#include "itkSIMDPixelKernel.h"
 #include "itkTotalProgressReporter.h"
 
 namespace itk
@@ -86,6 +87,17 @@ UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::DynamicThreadedGe
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if constexpr (TInputImage::ImageDimension == TOutputImage::ImageDimension &&
+                SIMDPixelKernel::CanTransformImages<TFunction, TOutputImage, TInputImage>)
+  {
+    if (inputRegionForThread == outputRegionForThread && SIMDPixelKernel::IsEnabled() &&
+        SIMDPixelKernel::TransformImages(m_Functor, outputRegionForThread, outputPtr, inputPtr))
+    {
+      progress.Completed(outputRegionForThread.GetNumberOfPixels());
+      return;
+    }
+  }
+
   ImageScanlineConstIterator inputIt(inputPtr, inputRegionForThread);
   ImageScanlineIterator      outputIt(outputPtr, outputRegionForThread);
 
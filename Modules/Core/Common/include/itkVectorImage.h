@@ -210,6 +210,13 @@ public:
   void
   Initialize() override;
 
+  /** Returns the size, in bytes, of the pixels of the requested region. */
+  SizeValueType
+  GetRequestedRegionMemorySize() const override
+  {
+    return this->GetRequestedRegion().GetNumberOfPixels() * m_VectorLength * sizeof(InternalPixelType);
+  }
+
   /** Fill the image buffer with a value.  Be sure to call Allocate()
    * first. */
   void
@@ -63,8 +63,15 @@ VectorImage<TPixel, VImageDimension>::Initialize()
 
   // Replace the handle to the buffer. This is the safest thing to do,
   // since the same container can be shared by multiple images (e.g.
-  // Grafted outputs and in place filters).
-  m_Buffer = PixelContainer::New();
+  // Grafted outputs and in place filters). The allocation settings of the
+  // previous buffer are kept.
+  const PixelContainerPointer buffer = PixelContainer::New();
+  if (m_Buffer)
+  {
+    buffer->SetAllocationPolicy(m_Buffer->GetAllocationPolicy());
+    buffer->SetParallelFirstTouch(m_Buffer->GetParallelFirstTouch());
+  }
+  m_Buffer = buffer;
 }
 
 template <typename TPixel, unsigned int VImageDimension>
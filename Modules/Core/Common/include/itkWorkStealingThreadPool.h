@@ -0,0 +1,183 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWorkStealingThreadPool_h
+#define itkWorkStealingThreadPool_h
+
+#include "itkConfigure.h"
+#include "itkIntTypes.h"
+#include "itkThreadSupport.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkSingletonMacro.h"
+
+
+namespace itk
+{
+
+/**
+ * \class WorkStealingThreadPool
+ * \brief Thread pool which balances load by letting idle workers steal tasks.
+ *
+ * Each worker thread owns a bounded Chase-Lev deque. A worker pushes and
+ * pops tasks at the bottom of its own deque without locking, while idle
+ * workers steal from the top of the deques of the other workers. Tasks
+ * submitted from threads that do not belong to the pool are placed in a
+ * shared injection queue.
+ *
+ * Work is submitted through ParallelFor(), which hands out the loop indices
+ * dynamically through an atomic counter, so that fast threads simply
+ * process more indices than slow ones. The calling thread takes part in the
+ * loop, and keeps executing pending tasks while it waits for the helper
+ * tasks to finish. Nested ParallelFor() calls from within a loop body
+ * therefore neither deadlock nor start additional threads.
+ *
+ * The pool is a process-wide singleton used by WorkStealingMultiThreader.
+ *
+ * \ingroup OSSystemObjects
+ * \ingroup ITKCommon
+ */
+
+struct WorkStealingThreadPoolGlobals;
+
+class ITKCommon_EXPORT WorkStealingThreadPool : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WorkStealingThreadPool);
+
+  /** Standard class type aliases. */
+  using Self = WorkStealingThreadPool;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(WorkStealingThreadPool);
+
+  /** Returns the global instance */
+  static Pointer
+  New();
+
+  /** Returns the global singleton instance of the WorkStealingThreadPool */
+  static Pointer
+  GetInstance();
+
+  using LoopBodyType = std::function<void(SizeValueType)>;
+
+  /** Call body(i) for every i in [0, count), using at most
+   * maximumNumberOfThreads threads, the calling thread included.
+   * Indices are handed out one at a time, in increasing order.
+   * If body throws, no further indices are handed out, and the first
+   * caught exception is rethrown once all participating threads are done. */
+  void
+  ParallelFor(SizeValueType count, const LoopBodyType & body, ThreadIdType maximumNumberOfThreads);
+
+  /** Can call this method if we want to add extra threads to the pool.
+   * The pool never grows beyond ITK_MAX_THREADS workers. */
+  void
+  AddThreads(ThreadIdType count);
+
+  ThreadIdType
+  GetMaximumNumberOfThreads() const;
+
+  /** Whether the calling thread is one of the workers of this pool. */
+  static bool
+  IsWorkerThread();
+
+protected:
+  WorkStealingThreadPool();
+
+  /** Stop the pool and release threads. To be called by the destructor and atfork. */
+  void
+  CleanUp();
+
+  ~WorkStealingThreadPool() override;
+
+  static void
+  PrepareForFork();
+  static void
+  ResumeFromFork();
+
+private:
+  struct LoopState;
+  class WorkerDeque;
+
+  /** Only used to synchronize the global variable across static libraries.*/
+  itkGetGlobalDeclarationMacro(WorkStealingThreadPoolGlobals, PimplGlobals);
+
+  /** Make a task available to the other threads. */
+  void
+  Submit(LoopState * task);
+
+  /** Take a task from the deque of the calling worker, from the injection
+   * queue, or steal one from another worker. Returns nullptr if no task
+   * could be found. */
+  LoopState *
+  FindTask();
+
+  /** Run the loop of a task on behalf of its submitter. */
+  static void
+  ExecuteTask(LoopState * task);
+
+  /** Wait until all helpers of the loop are finished, executing other
+   * pending tasks in the meantime. */
+  void
+  WaitForHelpers(LoopState & state);
+
+  /** The continuously running thread function */
+  void
+  ThreadExecute(ThreadIdType workerID);
+
+  /** One deque per possible worker, allocated up front so that thieves can
+   * inspect them while the pool grows. */
+  std::unique_ptr<WorkerDeque[]> m_Deques;
+
+  /** Tasks submitted by threads which are not workers of this pool. */
+  std::deque<LoopState *> m_InjectionQueue; // guarded by m_PimplGlobals->m_Mutex
+
+  /** Idle workers wait on m_Condition until a task is submitted. */
+  std::condition_variable m_Condition;
+
+  /** Vector to hold all thread handles.
+   * Thread handles are used to delete (join) the threads. */
+  std::vector<std::thread> m_Threads; // guarded by m_PimplGlobals->m_Mutex
+
+  /** Number of started workers, read without locking by thieves. */
+  std::atomic<ThreadIdType> m_NumberOfWorkers{ 0 };
+
+  /** Number of submitted tasks which have not been taken yet. */
+  std::atomic<int64_t> m_QueuedTasks{ 0 };
+
+  /* Has destruction started? */
+  bool m_Stopping{ false }; // guarded by m_PimplGlobals->m_Mutex
+
+  /** To lock on the internal variables */
+  static WorkStealingThreadPoolGlobals * m_PimplGlobals;
+};
+
+} // namespace itk
+#endif
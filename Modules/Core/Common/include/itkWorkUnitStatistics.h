@@ -0,0 +1,151 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWorkUnitStatistics_h
+#define itkWorkUnitStatistics_h
+
+#include "ITKCommonExport.h"
+#include "itkIndent.h"
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace itk
+{
+
+class ProcessObject;
+
+/** \class WorkUnitStatistics
+ * \brief Times the work units run by a MultiThreaderBase for a filter, to
+ * measure the load imbalance between threads.
+ *
+ * When the RecordWorkUnitStatistics flag of a ProcessObject is on, each
+ * work unit run for it by MultiThreaderBase::ParallelizeImageRegion() or
+ * MultiThreaderBase::ParallelizeArray() records its start and end times,
+ * the thread it ran on and its number of items: pixels for image regions,
+ * indices for arrays. The records of the last execution of the filter are
+ * available from ProcessObject::GetWorkUnitStatistics() after Update().
+ *
+ * The busy time of a thread is the sum of the durations of its work units,
+ * and the wall time spans from the start of the first work unit to the end
+ * of the last one. The idle fraction is the part of the wall time of the
+ * threads which ran work units that they did not spend in work units: it
+ * is close to zero when the load is balanced, and close to one when a
+ * single thread out of many does most of the work. Threads which ran no
+ * work unit are not taken into account.
+ *
+ * Times are in seconds.
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT WorkUnitStatistics
+{
+public:
+  struct WorkUnit
+  {
+    double          StartTime{ 0.0 };
+    double          EndTime{ 0.0 };
+    SizeValueType   NumberOfItems{ 0 };
+    std::thread::id ThreadId{};
+  };
+
+  /** Records a work unit spanning the lifetime of the scope, if the
+   * filter, which may be nullptr, records its work units. A scope nested
+   * in a recording scope of the same filter on the same thread adds its
+   * items to the enclosing one instead. */
+  class ITKCommon_EXPORT Scope
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_MOVE(Scope);
+
+    Scope(ProcessObject * filter, SizeValueType numberOfItems);
+
+    ~Scope();
+
+  private:
+    WorkUnitStatistics * m_Statistics{ nullptr };
+    Scope *              m_Enclosing{ nullptr };
+    Scope *              m_Outer{ nullptr };
+    double               m_StartTime{ 0.0 };
+    SizeValueType        m_NumberOfItems;
+    SizeValueType        m_NumberOfNestedItems{ 0 };
+  };
+
+  WorkUnitStatistics() = default;
+
+  /** Copies the records; the mutex is not copied. */
+  WorkUnitStatistics(const WorkUnitStatistics & other);
+  WorkUnitStatistics &
+  operator=(const WorkUnitStatistics & other);
+
+  /** Discards the records. */
+  void
+  Clear();
+
+  /** Adds a record. Thread safe. */
+  void
+  AddWorkUnit(const WorkUnit & workUnit);
+
+  /** Returns a copy of the records, in the order their work units ended. */
+  std::vector<WorkUnit>
+  GetWorkUnits() const;
+
+  SizeValueType
+  GetNumberOfWorkUnits() const;
+
+  /** Number of distinct threads which ran work units. */
+  unsigned int
+  GetNumberOfThreads() const;
+
+  /** Sum of the numbers of items of the work units. */
+  SizeValueType
+  GetNumberOfItems() const;
+
+  double
+  GetWallTime() const;
+
+  double
+  GetMaximumBusyTime() const;
+
+  double
+  GetMeanBusyTime() const;
+
+  double
+  GetIdleFraction() const;
+
+  void
+  Print(std::ostream & os, Indent indent) const;
+
+  /** Returns the time, in seconds, used by the records. */
+  static double
+  GetTime();
+
+private:
+  /** Busy time of each thread which ran work units. */
+  std::vector<double>
+  GetBusyTimes() const;
+
+  mutable std::mutex    m_Mutex{};
+  std::vector<WorkUnit> m_WorkUnits{};
+};
+
+} // end namespace itk
+
+#endif
@@ -305,4 +305,23 @@ operator<<(std::ostream & out, const ObjectFactoryEnums::InsertionPosition value
     }
   }();
 }
+
+/** Print enum values */
+std::ostream &
+operator<<(std::ostream & out, const ImageBufferEnums::AllocationPolicy value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case ImageBufferEnums::AllocationPolicy::New:
+        return "itk::ImageBufferEnums::AllocationPolicy::New";
+      case ImageBufferEnums::AllocationPolicy::Aligned:
+        return "itk::ImageBufferEnums::AllocationPolicy::Aligned";
+      case ImageBufferEnums::AllocationPolicy::HugePages:
+        return "itk::ImageBufferEnums::AllocationPolicy::HugePages";
+      default:
+        return "INVALID VALUE FOR itk::ImageBufferEnums::AllocationPolicy";
+    }
+  }();
+}
 } // namespace itk
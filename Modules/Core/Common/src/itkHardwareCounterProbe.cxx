@@ -0,0 +1,86 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHardwareCounterProbe.h"
+
+namespace itk
+{
+HardwareCounterProbe::HardwareCounterProbe(CounterEnum counter)
+  : Superclass("HardwareCounter", "events")
+  , m_Counter(counter)
+{
+  this->SetNameOfProbe(HardwareCounters::GetCounterName(counter));
+}
+
+HardwareCounterProbe::~HardwareCounterProbe()
+{
+  if (m_Running)
+  {
+    HardwareCounters::EndProbe();
+  }
+}
+
+HardwareCounterProbe::HardwareCounterProbe(const HardwareCounterProbe & other)
+  : Superclass(other)
+  , m_Counter(other.m_Counter)
+{}
+
+HardwareCounterProbe &
+HardwareCounterProbe::operator=(const HardwareCounterProbe & other)
+{
+  this->Superclass::operator=(other);
+  m_Counter = other.m_Counter;
+  return *this;
+}
+
+bool
+HardwareCounterProbe::IsAvailable() const
+{
+  return HardwareCounters::IsAvailable(m_Counter);
+}
+
+void
+HardwareCounterProbe::Start()
+{
+  // Work items are counted from now on, and before the start value is read.
+  if (!m_Running)
+  {
+    HardwareCounters::BeginProbe();
+    m_Running = true;
+  }
+  this->Superclass::Start();
+}
+
+void
+HardwareCounterProbe::Stop()
+{
+  this->Superclass::Stop();
+  if (m_Running)
+  {
+    HardwareCounters::EndProbe();
+    m_Running = false;
+  }
+}
+
+HardwareCounterProbe::CountType
+HardwareCounterProbe::GetInstantValue() const
+{
+  const auto counter = static_cast<unsigned int>(m_Counter);
+  return static_cast<CountType>(HardwareCounters::GetThreadValues()[counter] +
+                                HardwareCounters::GetWorkItemValues()[counter]);
+}
+} // end namespace itk
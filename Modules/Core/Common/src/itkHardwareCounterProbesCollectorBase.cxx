@@ -0,0 +1,60 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHardwareCounterProbesCollectorBase.h"
+
+namespace itk
+{
+HardwareCounterProbesCollectorBase::~HardwareCounterProbesCollectorBase() = default;
+
+void
+HardwareCounterProbesCollectorBase::Start(const char * id)
+{
+  for (unsigned int i = 0; i < HardwareCounters::NumberOfCounters; ++i)
+  {
+    const auto        counter = static_cast<HardwareCounterProbe::CounterEnum>(i);
+    const std::string name = GetProbeName(id, counter);
+
+    // if the probe does not exist yet, it is created.
+    HardwareCounterProbe & probe = this->m_Probes.try_emplace(name, counter).first->second;
+    probe.SetNameOfProbe(name.c_str());
+    probe.Start();
+  }
+}
+
+void
+HardwareCounterProbesCollectorBase::Stop(const char * id)
+{
+  for (unsigned int i = 0; i < HardwareCounters::NumberOfCounters; ++i)
+  {
+    const std::string name = GetProbeName(id, static_cast<HardwareCounterProbe::CounterEnum>(i));
+
+    auto pos = this->m_Probes.find(name);
+    if (pos == this->m_Probes.end())
+    {
+      itkGenericExceptionMacro("The probe \"" << id << "\" does not exist. It can not be stopped.");
+    }
+    pos->second.Stop();
+  }
+}
+
+std::string
+HardwareCounterProbesCollectorBase::GetProbeName(const char * id, HardwareCounterProbe::CounterEnum counter)
+{
+  return std::string(id) + " (" + HardwareCounters::GetCounterName(counter) + ')';
+}
+} // end namespace itk
@@ -0,0 +1,326 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHardwareCounters.h"
+#include "itkSingleton.h"
+#include "itksys/SystemTools.hxx"
+
+#include <atomic>
+#include <cstdlib>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#  define ITK_HAS_PERF_EVENT_OPEN
+#  include <linux/perf_event.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  include <cstring>
+#endif
+
+namespace itk
+{
+
+/** Print enum values */
+std::ostream &
+operator<<(std::ostream & out, const HardwareCountersEnums::Counter value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case HardwareCountersEnums::Counter::Cycles:
+        return "itk::HardwareCountersEnums::Counter::Cycles";
+      case HardwareCountersEnums::Counter::Instructions:
+        return "itk::HardwareCountersEnums::Counter::Instructions";
+      case HardwareCountersEnums::Counter::LastLevelCacheMisses:
+        return "itk::HardwareCountersEnums::Counter::LastLevelCacheMisses";
+      case HardwareCountersEnums::Counter::BranchMisses:
+        return "itk::HardwareCountersEnums::Counter::BranchMisses";
+      case HardwareCountersEnums::Counter::StalledCycles:
+        return "itk::HardwareCountersEnums::Counter::StalledCycles";
+      default:
+        return "INVALID VALUE FOR itk::HardwareCountersEnums::Counter";
+    }
+  }();
+}
+
+namespace
+{
+using ValuesType = HardwareCounters::ValuesType;
+
+// The counters of the calling thread, read together as one group.
+class ThreadCounters
+{
+public:
+  ThreadCounters()
+  {
+    m_Positions.fill(-1);
+#ifdef ITK_HAS_PERF_EVENT_OPEN
+    constexpr uint64_t configs[HardwareCounters::NumberOfCounters] = { PERF_COUNT_HW_CPU_CYCLES,
+                                                                       PERF_COUNT_HW_INSTRUCTIONS,
+                                                                       PERF_COUNT_HW_CACHE_MISSES,
+                                                                       PERF_COUNT_HW_BRANCH_MISSES,
+                                                                       PERF_COUNT_HW_STALLED_CYCLES_BACKEND };
+    int numberOfOpenCounters = 0;
+    for (unsigned int i = 0; i < HardwareCounters::NumberOfCounters; ++i)
+    {
+      perf_event_attr attributes;
+      std::memset(&attributes, 0, sizeof(attributes));
+      attributes.type = PERF_TYPE_HARDWARE;
+      attributes.size = sizeof(attributes);
+      attributes.config = configs[i];
+      attributes.exclude_kernel = 1;
+      attributes.exclude_hv = 1;
+      attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      // Counts the calling thread, on any processor.
+      const auto fd =
+        static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, m_GroupFd, PERF_FLAG_FD_CLOEXEC));
+      if (fd >= 0)
+      {
+        if (m_GroupFd < 0)
+        {
+          m_GroupFd = fd;
+        }
+        m_Fds[numberOfOpenCounters] = fd;
+        m_Positions[i] = numberOfOpenCounters++;
+      }
+    }
+#endif
+  }
+
+  ~ThreadCounters()
+  {
+#ifdef ITK_HAS_PERF_EVENT_OPEN
+    for (const int fd : m_Fds)
+    {
+      if (fd >= 0)
+      {
+        close(fd);
+      }
+    }
+#endif
+  }
+
+  ITK_DISALLOW_COPY_AND_MOVE(ThreadCounters);
+
+  bool
+  IsOpen(unsigned int counter) const
+  {
+    return m_Positions[counter] >= 0;
+  }
+
+  ValuesType
+  Read() const
+  {
+    ValuesType values{};
+#ifdef ITK_HAS_PERF_EVENT_OPEN
+    if (m_GroupFd < 0)
+    {
+      return values;
+    }
+
+    // The number of counters, the times the group was enabled and running,
+    // and the value of each counter.
+    uint64_t buffer[3 + HardwareCounters::NumberOfCounters];
+    if (read(m_GroupFd, buffer, sizeof(buffer)) < static_cast<ssize_t>(3 * sizeof(uint64_t)))
+    {
+      return values;
+    }
+    const uint64_t enabled = buffer[1];
+    const uint64_t running = buffer[2];
+    if (running == 0)
+    {
+      return values;
+    }
+
+    // Extrapolate, should the kernel have multiplexed the group with others.
+    const double scale = static_cast<double>(enabled) / static_cast<double>(running);
+    for (unsigned int i = 0; i < HardwareCounters::NumberOfCounters; ++i)
+    {
+      if (m_Positions[i] >= 0 && static_cast<uint64_t>(m_Positions[i]) < buffer[0])
+      {
+        const uint64_t value = buffer[3 + m_Positions[i]];
+        values[i] = running < enabled ? static_cast<uint64_t>(static_cast<double>(value) * scale) : value;
+      }
+    }
+#endif
+    return values;
+  }
+
+private:
+  int                                                 m_GroupFd{ -1 };
+  std::array<int, HardwareCounters::NumberOfCounters> m_Fds{ { -1, -1, -1, -1, -1 } };
+  std::array<int, HardwareCounters::NumberOfCounters> m_Positions{};
+};
+
+ThreadCounters &
+GetThreadCounters()
+{
+  thread_local ThreadCounters counters;
+  return counters;
+}
+
+// Number of probes running on each thread.
+thread_local unsigned int threadNumberOfRunningProbes = 0;
+
+bool
+GetEnabledFromEnvironment()
+{
+  std::string value;
+  return itksys::SystemTools::GetEnv("ITK_HARDWARE_COUNTERS", value) && !value.empty() && value != "0";
+}
+} // namespace
+
+struct HardwareCountersGlobals
+{
+  std::atomic<bool>                                                     m_Enabled{ GetEnabledFromEnvironment() };
+  std::atomic<unsigned int>                                             m_NumberOfRunningProbes{ 0 };
+  std::array<std::atomic<uint64_t>, HardwareCounters::NumberOfCounters> m_WorkItemValues{};
+};
+
+itkGetGlobalSimpleMacro(HardwareCounters, HardwareCountersGlobals, PimplGlobals);
+
+HardwareCountersGlobals * HardwareCounters::m_PimplGlobals;
+
+HardwareCounters::Scope::Scope(PipelineTracer::Scope & trace)
+  : m_Trace(trace)
+  , m_Active(HardwareCounters::IsCollecting())
+{
+  if (m_Active)
+  {
+    m_StartValues = HardwareCounters::GetThreadValues();
+  }
+}
+
+HardwareCounters::Scope::~Scope()
+{
+  if (!m_Active)
+  {
+    return;
+  }
+
+  ValuesType values = HardwareCounters::GetThreadValues();
+  for (unsigned int i = 0; i < NumberOfCounters; ++i)
+  {
+    values[i] -= m_StartValues[i];
+  }
+
+  // A probe running on this thread counts the work item already.
+  if (threadNumberOfRunningProbes == 0)
+  {
+    for (unsigned int i = 0; i < NumberOfCounters; ++i)
+    {
+      m_PimplGlobals->m_WorkItemValues[i] += values[i];
+    }
+  }
+
+  if (m_Trace.IsActive())
+  {
+    static constexpr const char * argumentNames[NumberOfCounters] = {
+      "cycles", "instructions", "lastLevelCacheMisses", "branchMisses", "stalledCycles"
+    };
+    for (unsigned int i = 0; i < NumberOfCounters; ++i)
+    {
+      if (GetThreadCounters().IsOpen(i))
+      {
+        m_Trace.AddArgument(argumentNames[i], values[i]);
+      }
+    }
+  }
+}
+
+bool
+HardwareCounters::IsAvailable(CounterEnum counter)
+{
+  return GetThreadCounters().IsOpen(static_cast<unsigned int>(counter));
+}
+
+auto
+HardwareCounters::GetThreadValues() -> ValuesType
+{
+  return GetThreadCounters().Read();
+}
+
+auto
+HardwareCounters::GetWorkItemValues() -> ValuesType
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  ValuesType values;
+  for (unsigned int i = 0; i < NumberOfCounters; ++i)
+  {
+    values[i] = m_PimplGlobals->m_WorkItemValues[i];
+  }
+  return values;
+}
+
+const char *
+HardwareCounters::GetCounterName(CounterEnum counter)
+{
+  switch (counter)
+  {
+    case CounterEnum::Cycles:
+      return "Cycles";
+    case CounterEnum::Instructions:
+      return "Instructions";
+    case CounterEnum::LastLevelCacheMisses:
+      return "LastLevelCacheMisses";
+    case CounterEnum::BranchMisses:
+      return "BranchMisses";
+    case CounterEnum::StalledCycles:
+      return "StalledCycles";
+    default:
+      return "Unknown";
+  }
+}
+
+void
+HardwareCounters::SetEnabled(bool enabled)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_Enabled = enabled;
+}
+
+bool
+HardwareCounters::GetEnabled()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_Enabled;
+}
+
+bool
+HardwareCounters::IsCollecting()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_Enabled || m_PimplGlobals->m_NumberOfRunningProbes > 0;
+}
+
+void
+HardwareCounters::BeginProbe()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  ++threadNumberOfRunningProbes;
+  ++m_PimplGlobals->m_NumberOfRunningProbes;
+}
+
+void
+HardwareCounters::EndProbe()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  --threadNumberOfRunningProbes;
+  --m_PimplGlobals->m_NumberOfRunningProbes;
+}
+
+} // end namespace itk
@@ -0,0 +1,392 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferAllocator.h"
+#include "itkMultiThreaderBase.h"
+#include "itkPipelineTracer.h"
+#include "itkSingleton.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <new>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#  include <malloc.h>
+#else
+#  include <sys/mman.h>
+#endif
+
+namespace itk
+{
+
+namespace
+{
+void *
+AllocateFromSystem(size_t numberOfBytes, ImageBufferAllocator::AllocationPolicyEnum policy)
+{
+  if (policy == ImageBufferAllocator::AllocationPolicyEnum::New)
+  {
+    return ::operator new[](numberOfBytes, std::nothrow);
+  }
+
+  const size_t alignment = ImageBufferAllocator::GetAlignment(policy);
+#if defined(_WIN32)
+  return _aligned_malloc(numberOfBytes, alignment);
+#else
+  void * buffer = nullptr;
+  if (posix_memalign(&buffer, alignment, numberOfBytes) != 0)
+  {
+    return nullptr;
+  }
+#  if defined(MADV_HUGEPAGE)
+  if (policy == ImageBufferAllocator::AllocationPolicyEnum::HugePages)
+  {
+    // Only a hint: the buffer remains usable when transparent huge pages are
+    // disabled, so the result is deliberately ignored.
+    madvise(buffer, numberOfBytes, MADV_HUGEPAGE);
+  }
+#  endif
+  return buffer;
+#endif
+}
+
+void
+DeallocateToSystem(void * buffer, ImageBufferAllocator::AllocationPolicyEnum policy)
+{
+  if (policy == ImageBufferAllocator::AllocationPolicyEnum::New)
+  {
+    ::operator delete[](buffer);
+    return;
+  }
+#if defined(_WIN32)
+  _aligned_free(buffer);
+#else
+  free(buffer);
+#endif
+}
+} // namespace
+
+struct ImageBufferAllocatorGlobals
+{
+  using BucketKeyType = std::pair<size_t, ImageBufferAllocator::AllocationPolicyEnum>;
+
+  ~ImageBufferAllocatorGlobals() { this->ShrinkBufferPool(0); }
+
+  /** Frees cached buffers until no more than maximumSize bytes are cached.
+   * m_BufferPoolMutex must be held by the caller. */
+  void
+  ShrinkBufferPool(size_t maximumSize)
+  {
+    for (auto bucket = m_BufferPool.begin();
+         bucket != m_BufferPool.end() && m_BufferPoolStatistics.CachedBytes > maximumSize;)
+    {
+      while (!bucket->second.empty() && m_BufferPoolStatistics.CachedBytes > maximumSize)
+      {
+        DeallocateToSystem(bucket->second.back(), bucket->first.second);
+        m_BucketSizedBuffers.erase(bucket->second.back());
+        bucket->second.pop_back();
+        m_BufferPoolStatistics.CachedBytes -= bucket->first.first;
+        --m_BufferPoolStatistics.CachedBuffers;
+      }
+      bucket = bucket->second.empty() ? m_BufferPool.erase(bucket) : std::next(bucket);
+    }
+  }
+
+  ImageBufferAllocator::AllocationPolicyEnum m_GlobalDefaultAllocationPolicy{
+    ImageBufferAllocator::AllocationPolicyEnum::New
+  };
+  bool m_GlobalDefaultParallelFirstTouch{ false };
+
+  // Read without the mutex, so that allocations do not contend while the
+  // pool is disabled. Only changed with the mutex held.
+  std::atomic<bool> m_BufferPoolEnabled{ false };
+
+  std::mutex                                   m_BufferPoolMutex{};
+  size_t                                       m_BufferPoolMaximumSize{ size_t{ 1024 } * 1024 * 1024 };
+  std::map<BucketKeyType, std::vector<void *>> m_BufferPool{};
+  ImageBufferAllocator::BufferPoolStatistics   m_BufferPoolStatistics{};
+
+  // Buffers allocated with the size of their bucket while the pool was
+  // enabled, in use or cached. Only these may be cached, since buffers
+  // allocated while the pool was disabled have the exact requested size.
+  std::unordered_set<void *> m_BucketSizedBuffers{};
+};
+
+itkGetGlobalSimpleMacro(ImageBufferAllocator, ImageBufferAllocatorGlobals, PimplGlobals);
+ImageBufferAllocatorGlobals * ImageBufferAllocator::m_PimplGlobals;
+
+namespace
+{
+// Granularity of the first touch. Pages of the operating system are at least
+// this large, so writing once per this many bytes touches every page.
+constexpr size_t firstTouchPageSize = 4096;
+
+// Below this size, starting the threads costs more than touching the pages.
+constexpr size_t minimumParallelFirstTouchSize = size_t{ 1024 } * 1024;
+} // namespace
+
+void
+ImageBufferAllocator::SetGlobalDefaultAllocationPolicy(AllocationPolicyEnum policy)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_GlobalDefaultAllocationPolicy = policy;
+}
+
+ImageBufferAllocator::AllocationPolicyEnum
+ImageBufferAllocator::GetGlobalDefaultAllocationPolicy()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_GlobalDefaultAllocationPolicy;
+}
+
+void
+ImageBufferAllocator::SetGlobalDefaultParallelFirstTouch(bool parallelFirstTouch)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_GlobalDefaultParallelFirstTouch = parallelFirstTouch;
+}
+
+bool
+ImageBufferAllocator::GetGlobalDefaultParallelFirstTouch()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_GlobalDefaultParallelFirstTouch;
+}
+
+size_t
+ImageBufferAllocator::GetAlignment(AllocationPolicyEnum policy)
+{
+  switch (policy)
+  {
+    case AllocationPolicyEnum::Aligned:
+      return CacheLineAlignment;
+    case AllocationPolicyEnum::HugePages:
+      return HugePageAlignment;
+    default:
+      return 0;
+  }
+}
+
+void *
+ImageBufferAllocator::Allocate(size_t numberOfBytes, AllocationPolicyEnum policy)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  PipelineTracer::AddAllocatedBytes(numberOfBytes);
+
+  if (!m_PimplGlobals->m_BufferPoolEnabled)
+  {
+    return AllocateFromSystem(numberOfBytes, policy);
+  }
+
+  // While the pool is enabled, buffers get the size of their bucket, so
+  // that any buffer of a bucket can serve any request falling into it.
+  const size_t                      bucketSize = GetBufferPoolBucketSize(numberOfBytes);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_BufferPoolMutex);
+  if (!m_PimplGlobals->m_BufferPoolEnabled)
+  {
+    return AllocateFromSystem(numberOfBytes, policy);
+  }
+  BufferPoolStatistics & statistics = m_PimplGlobals->m_BufferPoolStatistics;
+  const auto             bucket = m_PimplGlobals->m_BufferPool.find({ bucketSize, policy });
+  if (bucket != m_PimplGlobals->m_BufferPool.end() && !bucket->second.empty())
+  {
+    // The most recently released buffer is the most likely to be cached.
+    void * const buffer = bucket->second.back();
+    bucket->second.pop_back();
+    statistics.CachedBytes -= bucketSize;
+    --statistics.CachedBuffers;
+    ++statistics.Hits;
+    return buffer;
+  }
+  ++statistics.Misses;
+  void * const buffer = AllocateFromSystem(bucketSize, policy);
+  if (buffer != nullptr)
+  {
+    m_PimplGlobals->m_BucketSizedBuffers.insert(buffer);
+  }
+  return buffer;
+}
+
+void
+ImageBufferAllocator::Deallocate(void * buffer, size_t numberOfBytes, AllocationPolicyEnum policy)
+{
+  if (buffer == nullptr)
+  {
+    return;
+  }
+  itkInitGlobalsMacro(PimplGlobals);
+
+  if (m_PimplGlobals->m_BufferPoolEnabled)
+  {
+    const size_t                      bucketSize = GetBufferPoolBucketSize(numberOfBytes);
+    const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_BufferPoolMutex);
+    const auto                        bucketSized = m_PimplGlobals->m_BucketSizedBuffers.find(buffer);
+    if (bucketSized != m_PimplGlobals->m_BucketSizedBuffers.end())
+    {
+      BufferPoolStatistics & statistics = m_PimplGlobals->m_BufferPoolStatistics;
+      if (statistics.CachedBytes + bucketSize <= m_PimplGlobals->m_BufferPoolMaximumSize)
+      {
+        m_PimplGlobals->m_BufferPool[{ bucketSize, policy }].push_back(buffer);
+        statistics.CachedBytes += bucketSize;
+        ++statistics.CachedBuffers;
+        statistics.PeakCachedBytes = std::max(statistics.PeakCachedBytes, statistics.CachedBytes);
+        ++statistics.Returns;
+        return;
+      }
+      m_PimplGlobals->m_BucketSizedBuffers.erase(bucketSized);
+      ++statistics.Evictions;
+    }
+  }
+  DeallocateToSystem(buffer, policy);
+}
+
+void
+ImageBufferAllocator::SetBufferPoolEnabled(bool enabled)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_BufferPoolMutex);
+  m_PimplGlobals->m_BufferPoolEnabled = enabled;
+  if (!enabled)
+  {
+    // Buffers still in use are freed with their actual size whatever the
+    // size passed to Deallocate(), so they need no tracking anymore.
+    m_PimplGlobals->ShrinkBufferPool(0);
+    m_PimplGlobals->m_BucketSizedBuffers.clear();
+  }
+}
+
+bool
+ImageBufferAllocator::GetBufferPoolEnabled()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_BufferPoolEnabled;
+}
+
+void
+ImageBufferAllocator::SetBufferPoolMaximumSize(size_t numberOfBytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_BufferPoolMutex);
+  m_PimplGlobals->m_BufferPoolMaximumSize = numberOfBytes;
+  m_PimplGlobals->ShrinkBufferPool(numberOfBytes);
+}
+
+size_t
+ImageBufferAllocator::GetBufferPoolMaximumSize()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_BufferPoolMutex);
+  return m_PimplGlobals->m_BufferPoolMaximumSize;
+}
+
+void
+ImageBufferAllocator::ClearBufferPool()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_BufferPoolMutex);
+  m_PimplGlobals->ShrinkBufferPool(0);
+}
+
+ImageBufferAllocator::BufferPoolStatistics
+ImageBufferAllocator::GetBufferPoolStatistics()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_BufferPoolMutex);
+  return m_PimplGlobals->m_BufferPoolStatistics;
+}
+
+void
+ImageBufferAllocator::ResetBufferPoolStatistics()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_BufferPoolMutex);
+  BufferPoolStatistics & statistics = m_PimplGlobals->m_BufferPoolStatistics;
+  BufferPoolStatistics   reset;
+  reset.CachedBuffers = statistics.CachedBuffers;
+  reset.CachedBytes = statistics.CachedBytes;
+  reset.PeakCachedBytes = statistics.CachedBytes;
+  statistics = reset;
+}
+
+size_t
+ImageBufferAllocator::GetBufferPoolBucketSize(size_t numberOfBytes)
+{
+  // Four buckets per power of two, and at least a cache line apart. Zero
+  // sized requests still get a unique buffer, like operator new[].
+  size_t powerOfTwo = 1;
+  while (powerOfTwo <= numberOfBytes / 2)
+  {
+    powerOfTwo *= 2;
+  }
+  const size_t granularity = std::max<size_t>(CacheLineAlignment, powerOfTwo / 4);
+  if (numberOfBytes > std::numeric_limits<size_t>::max() - granularity)
+  {
+    return numberOfBytes; // cannot be allocated anyway
+  }
+  return std::max<size_t>(1, (numberOfBytes + granularity - 1) / granularity) * granularity;
+}
+
+void
+ImageBufferAllocator::ParallelFirstTouch(void * buffer, size_t numberOfBytes, bool zeroFill)
+{
+  auto * const bytes = static_cast<char *>(buffer);
+
+  const auto touchPages = [bytes, numberOfBytes, zeroFill](size_t firstPage, size_t endPage) {
+    const size_t begin = firstPage * firstTouchPageSize;
+    const size_t end = std::min(endPage * firstTouchPageSize, numberOfBytes);
+    if (zeroFill)
+    {
+      std::memset(bytes + begin, 0, end - begin);
+    }
+    else
+    {
+      for (size_t offset = begin; offset < end; offset += firstTouchPageSize)
+      {
+        bytes[offset] = 0;
+      }
+    }
+  };
+
+  const size_t numberOfPages = (numberOfBytes + firstTouchPageSize - 1) / firstTouchPageSize;
+  if (numberOfBytes < minimumParallelFirstTouchSize)
+  {
+    touchPages(0, numberOfPages);
+    return;
+  }
+
+  // One contiguous piece per work unit, as the slow dimension splitter would
+  // produce for an image stored in this buffer.
+  const MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  const SizeValueType              numberOfPieces = threader->GetNumberOfWorkUnits();
+  threader->ParallelizeArray(
+    0,
+    numberOfPieces,
+    [numberOfPages, numberOfPieces, &touchPages](SizeValueType piece) {
+      touchPages(numberOfPages * piece / numberOfPieces, numberOfPages * (piece + 1) / numberOfPieces);
+    },
+    nullptr);
+}
+
+} // end namespace itk
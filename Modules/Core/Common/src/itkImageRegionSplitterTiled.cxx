@@ -0,0 +1,193 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageRegionSplitterTiled.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+ImageRegionSplitterTiled::ImageRegionSplitterTiled() = default;
+
+void
+ImageRegionSplitterTiled::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "CacheSizeInBytes: " << m_CacheSizeInBytes << std::endl;
+  os << indent << "BytesPerPixel: " << m_BytesPerPixel << std::endl;
+  os << indent << "Radius: [";
+  for (const SizeValueType radius : m_Radius)
+  {
+    os << ' ' << radius;
+  }
+  os << " ]" << std::endl;
+}
+
+unsigned int
+ImageRegionSplitterTiled::GetNumberOfSplitsInternal(unsigned int         dim,
+                                                    const IndexValueType itkNotUsed(regionIndex)[],
+                                                    const SizeValueType  regionSize[],
+                                                    unsigned int         requestedNumber) const
+{
+  // number of tiles in each dimension
+  std::vector<unsigned int> tiles(dim); // Note: stack allocation preferred
+
+  return this->ComputeTiles(dim, requestedNumber, regionSize, tiles.data());
+}
+
+unsigned int
+ImageRegionSplitterTiled::GetSplitInternal(unsigned int   dim,
+                                           unsigned int   splitI,
+                                           unsigned int   numberOfPieces,
+                                           IndexValueType regionIndex[],
+                                           SizeValueType  regionSize[]) const
+{
+  // number of tiles in each dimension
+  std::vector<unsigned int> tiles(dim); // Note: stack allocation preferred
+
+  numberOfPieces = this->ComputeTiles(dim, numberOfPieces, regionSize, tiles.data());
+  if (splitI >= numberOfPieces)
+  {
+    return numberOfPieces;
+  }
+
+  // Locate the tile by recursively bisecting the grid of tiles along its
+  // longest side, until a single tile is left. The pieces in each half are
+  // numbered consecutively, which keeps consecutive pieces close together.
+  std::vector<unsigned int> lower(dim, 0); // Note: stack allocation preferred
+  std::vector<unsigned int> upper(tiles);
+  unsigned int              remaining = splitI;
+  while (true)
+  {
+    unsigned int bisectedDim = 0;
+    for (unsigned int i = 1; i < dim; ++i)
+    {
+      if (upper[i] - lower[i] >= upper[bisectedDim] - lower[bisectedDim])
+      {
+        bisectedDim = i;
+      }
+    }
+    if (upper[bisectedDim] - lower[bisectedDim] <= 1)
+    {
+      break;
+    }
+
+    const unsigned int middle = lower[bisectedDim] + (upper[bisectedDim] - lower[bisectedDim]) / 2;
+    unsigned int       lowerHalfCount = 1;
+    for (unsigned int i = 0; i < dim; ++i)
+    {
+      lowerHalfCount *= (i == bisectedDim) ? middle - lower[i] : upper[i] - lower[i];
+    }
+
+    if (remaining < lowerHalfCount)
+    {
+      upper[bisectedDim] = middle;
+    }
+    else
+    {
+      remaining -= lowerHalfCount;
+      lower[bisectedDim] = middle;
+    }
+  }
+
+  // Assign the output split region to the input region in-place
+  for (unsigned int i = 0; i < dim; ++i)
+  {
+    const SizeValueType first = (regionSize[i] * lower[i]) / tiles[i];
+    const SizeValueType afterLast = (regionSize[i] * (lower[i] + 1)) / tiles[i];
+    regionIndex[i] += static_cast<IndexValueType>(first);
+    regionSize[i] = afterLast - first;
+  }
+
+  return numberOfPieces;
+}
+
+unsigned int
+ImageRegionSplitterTiled::ComputeTiles(unsigned int        dim,
+                                       unsigned int        requestedNumber,
+                                       const SizeValueType regionSize[],
+                                       unsigned int        tiles[]) const
+{
+  const SizeValueType budget =
+    std::max<SizeValueType>(1, m_CacheSizeInBytes / std::max<SizeValueType>(1, m_BytesPerPixel));
+
+  // extent of a tile in each dimension
+  std::vector<SizeValueType> tileSize(regionSize, regionSize + dim); // Note: stack allocation preferred
+
+  const auto footprint = [this, dim, &tileSize]() {
+    double numberOfPixels = 1.0;
+    for (unsigned int i = 0; i < dim; ++i)
+    {
+      const SizeValueType radius = i < m_Radius.size() ? m_Radius[i] : 0;
+      numberOfPixels *= static_cast<double>(tileSize[i] + 2 * radius);
+    }
+    return numberOfPixels;
+  };
+
+  while (footprint() > static_cast<double>(budget))
+  {
+    // Halve the largest extent. The fastest dimension is weighted down, so
+    // that the rows of a tile stay long and contiguous in memory.
+    unsigned int  halvedDim = dim;
+    SizeValueType largestWeightedSize = 0;
+    for (unsigned int i = 0; i < dim; ++i)
+    {
+      const SizeValueType weightedSize = (i == 0) ? (tileSize[i] + 3) / 4 : tileSize[i];
+      if (tileSize[i] > 1 && weightedSize >= largestWeightedSize)
+      {
+        halvedDim = i;
+        largestWeightedSize = weightedSize;
+      }
+    }
+    if (halvedDim == dim)
+    {
+      break; // single pixel tiles, the halo alone exceeds the budget
+    }
+    tileSize[halvedDim] = (tileSize[halvedDim] + 1) / 2;
+  }
+
+  SizeValueType numberOfTiles = 1;
+  for (unsigned int i = 0; i < dim; ++i)
+  {
+    tiles[i] = (regionSize[i] == 0) ? 1 : static_cast<unsigned int>((regionSize[i] + tileSize[i] - 1) / tileSize[i]);
+    numberOfTiles *= tiles[i];
+  }
+
+  // Merge neighboring tiles, along the dimension with the most tiles,
+  // until no more than the requested number of pieces is left.
+  requestedNumber = std::max(1u, requestedNumber);
+  while (numberOfTiles > requestedNumber)
+  {
+    unsigned int mergedDim = 0;
+    for (unsigned int i = 1; i < dim; ++i)
+    {
+      if (tiles[i] > tiles[mergedDim])
+      {
+        mergedDim = i;
+      }
+    }
+    numberOfTiles /= tiles[mergedDim];
+    tiles[mergedDim] = (tiles[mergedDim] + 1) / 2;
+    numberOfTiles *= tiles[mergedDim];
+  }
+
+  return static_cast<unsigned int>(numberOfTiles);
+}
+
+} // end namespace itk
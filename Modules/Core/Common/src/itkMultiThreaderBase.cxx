@@ -30,6 +30,7 @@
 
 #if defined(ITK_USE_POOL_MULTI_THREADER)
 #  include "itkPoolMultiThreader.h"
+#  include "itkWorkStealingMultiThreader.h"
 #endif
 #include "itkNumericTraits.h"
 #include <mutex>
@@ -207,6 +208,10 @@ MultiThreaderBase::ThreaderTypeFromString(std::string threaderString)
   {
     return ThreaderEnum::TBB;
   }
+  else if (threaderString == "WORKSTEALING")
+  {
+    return ThreaderEnum::WorkStealing;
+  }
   else
   {
     return ThreaderEnum::Unknown;
@@ -262,6 +267,16 @@ MultiThreaderBase::SetUpdateProgress(bool updates)
   this->m_UpdateProgress = updates;
 }
 
+const ImageRegionSplitterBase *
+MultiThreaderBase::GetImageRegionSplitter() const
+{
+  if (m_ImageRegionSplitter)
+  {
+    return m_ImageRegionSplitter;
+  }
+  return ImageSourceCommon::GetGlobalDefaultSplitter();
+}
+
 ThreadIdType
 MultiThreaderBase::GetGlobalDefaultNumberOfThreads()
 {
@@ -404,6 +419,12 @@ MultiThreaderBase::New()
         return TBBMultiThreader::New();
 #else
         itkGenericExceptionMacro("ITK has been built without TBB support!");
+#endif
+      case ThreaderEnum::WorkStealing:
+#if defined(ITK_USE_POOL_MULTI_THREADER)
+        return WorkStealingMultiThreader::New();
+#else
+        itkGenericExceptionMacro("ITK has been built without WorkStealingMultiThreader support!");
 #endif
       default:
         itkGenericExceptionMacro("MultiThreaderBase::GetGlobalDefaultThreader returned Unknown!");
@@ -472,20 +493,18 @@ MultiThreaderBase::ParallelizeArray(SizeValueType             firstIndex,
   // This implementation simply delegates parallelization to the old interface
   // SetSingleMethod+SingleMethodExecute. This method is meant to be overloaded!
 
-  if (!this->GetUpdateProgress())
-  {
-    filter = nullptr;
-  }
+  ProcessObject * const progressFilter = this->GetUpdateProgress() ? filter : nullptr;
   // Upon destruction, progress will be set to 1.0
-  const ProgressReporter progress(filter, 0, 1);
+  const ProgressReporter progress(progressFilter, 0, 1);
 
   if (firstIndex + 1 < lastIndexPlus1)
   {
-    struct ArrayCallback acParams{ aFunc, firstIndex, lastIndexPlus1, filter };
+    struct ArrayCallback acParams{ aFunc, firstIndex, lastIndexPlus1, filter, progressFilter };
     this->SetSingleMethodAndExecute(&MultiThreaderBase::ParallelizeArrayHelper, &acParams);
   }
   else if (firstIndex + 1 == lastIndexPlus1)
   {
+    const WorkUnitStatistics::Scope workUnit(filter, 1);
     aFunc(firstIndex);
   }
   // else nothing needs to be executed
@@ -509,8 +528,9 @@ MultiThreaderBase::ParallelizeArrayHelper(void * arg)
     afterLast = acParams->lastIndexPlus1;
   }
 
-  TotalProgressReporter reporter(acParams->filter, range);
+  TotalProgressReporter reporter(acParams->progressFilter, range);
 
+  const WorkUnitStatistics::Scope workUnit(acParams->filter, afterLast - first);
   for (SizeValueType i = first; i < afterLast; ++i)
   {
     acParams->functor(i);
@@ -531,13 +551,18 @@ MultiThreaderBase::ParallelizeImageRegion(unsigned int
 {
   // This implementation simply delegates parallelization to the old interface
   // SetSingleMethod+SingleMethodExecute. This method is meant to be overloaded!
+  if (m_DynamicScheduling)
+  {
+    this->ParallelizeImageRegionDynamically(dimension, index, size, funcP, filter);
+    return;
+  }
   if (!this->GetUpdateProgress())
   {
     filter = nullptr;
   }
   const ProgressReporter progress(filter, 0, 1);
 
-  struct RegionAndCallback rnc{ funcP, dimension, index, size, filter };
+  struct RegionAndCallback rnc{ funcP, dimension, index, size, filter, this->GetImageRegionSplitter() };
   this->SetSingleMethodAndExecute(&MultiThreaderBase::ParallelizeImageRegionHelper, &rnc);
 }
 
@@ -549,7 +574,7 @@ MultiThreaderBase::ParallelizeImageRegionHelper(void * arg)
   const ThreadIdType workUnitCount = workUnitInfo->NumberOfWorkUnits;
   auto *             rnc = static_cast<struct RegionAndCallback *>(workUnitInfo->UserData);
 
-  const ImageRegionSplitterBase * splitter = ImageSourceCommon::GetGlobalDefaultSplitter();
+  const ImageRegionSplitterBase * splitter = rnc->splitter;
   ImageIORegion                   region(rnc->dimension);
   for (unsigned int d = 0; d < rnc->dimension; ++d)
   {
@@ -570,6 +595,52 @@ MultiThreaderBase::ParallelizeImageRegionHelper(void * arg)
   return ITK_THREAD_RETURN_DEFAULT_VALUE;
 }
 
+void
+MultiThreaderBase::ParallelizeImageRegionDynamically(unsigned int                            dimension,
+                                                     const IndexValueType                    index[],
+                                                     const SizeValueType                     size[],
+                                                     MultiThreaderBase::ThreadingFunctorType funcP,
+                                                     ProcessObject *                         filter)
+{
+  if (!this->GetUpdateProgress())
+  {
+    filter = nullptr;
+  }
+  const ProgressReporter progressStartEnd(filter, 0, 1);
+
+  ImageIORegion region(dimension);
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    region.SetIndex(d, index[d]);
+    region.SetSize(d, size[d]);
+  }
+
+  const ImageRegionSplitterBase * splitter = this->GetImageRegionSplitter();
+  const unsigned int              pieceCount = splitter->GetNumberOfSplits(region, NumericTraits<unsigned int>::max());
+  const SizeValueType             totalCount = region.GetNumberOfPixels();
+
+  // Each work unit keeps taking the next unprocessed piece, so that work units
+  // which get cheap pieces do not sit idle.
+  std::atomic<unsigned int> nextPiece{ 0 };
+  this->ParallelizeArray(
+    0,
+    std::min<SizeValueType>(pieceCount, m_NumberOfWorkUnits),
+    [&region, splitter, pieceCount, totalCount, &nextPiece, &funcP, filter](SizeValueType) {
+      TotalProgressReporter progress(filter, totalCount, 100);
+      for (unsigned int piece = nextPiece++; piece < pieceCount; piece = nextPiece++)
+      {
+        progress.CheckAbortGenerateData();
+
+        ImageIORegion pieceRegion = region;
+        splitter->GetSplit(piece, pieceCount, pieceRegion);
+        funcP(&pieceRegion.GetIndex()[0], &pieceRegion.GetSize()[0]);
+
+        progress.Completed(pieceRegion.GetNumberOfPixels());
+      }
+    },
+    nullptr);
+}
+
 // Print method for the multithreader
 void
 MultiThreaderBase::PrintSelf(std::ostream & os, Indent indent) const
@@ -581,6 +652,8 @@ MultiThreaderBase::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "Global Maximum Number Of Threads: " << m_PimplGlobals->m_GlobalMaximumNumberOfThreads << std::endl;
   os << indent << "Global Default Number Of Threads: " << m_PimplGlobals->m_GlobalDefaultNumberOfThreads << std::endl;
   os << indent << "Global Default Threader Type: " << m_PimplGlobals->m_GlobalDefaultThreader << std::endl;
+  os << indent << "ImageRegionSplitter: " << m_ImageRegionSplitter.GetPointer() << std::endl;
+  itkPrintSelfBooleanMacro(DynamicScheduling);
   os << indent << "SingleMethod: " << m_SingleMethod << std::endl;
   os << indent << "SingleData: " << m_SingleData << std::endl;
 }
@@ -602,6 +675,8 @@ operator<<(std::ostream & out, const MultiThreaderBaseEnums::Threader value)
         return "itk::MultiThreaderBaseEnums::Threader::Pool";
       case MultiThreaderBaseEnums::Threader::TBB:
         return "itk::MultiThreaderBaseEnums::Threader::TBB";
+      case MultiThreaderBaseEnums::Threader::WorkStealing:
+        return "itk::MultiThreaderBaseEnums::Threader::WorkStealing";
         //      TODO    case MultiThreaderBaseEnums::Threader::Last:
         //                    return "itk::MultiThreaderBaseEnums::Threader::Last";
       case MultiThreaderBaseEnums::Threader::Unknown:
@@ -0,0 +1,323 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineTracer.h"
+#include "itkProcessObject.h"
+#include "itkSingleton.h"
+#include "itksys/SystemTools.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+#if defined(_WIN32)
+#  include <process.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+
+namespace
+{
+// Number of bytes of image buffers allocated by each thread.
+thread_local SizeValueType threadAllocatedBytes = 0;
+
+// Index of each thread in the trace, assigned on its first event.
+thread_local unsigned int threadIndex = 0;
+thread_local bool         threadIndexAssigned = false;
+
+void
+WriteJSONString(std::ostream & os, const std::string & str)
+{
+  os << '"';
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      os << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+    }
+    else
+    {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+int
+GetCurrentProcessId()
+{
+#if defined(_WIN32)
+  return _getpid();
+#else
+  return static_cast<int>(getpid());
+#endif
+}
+
+void
+WriteChromeTraceEvents(std::ostream & os, const std::vector<PipelineTracer::Event> & events)
+{
+  const int processId = GetCurrentProcessId();
+
+  // Formatted separately, so that the state of os is left untouched.
+  std::ostringstream trace;
+  trace << std::fixed << std::setprecision(3);
+  trace << "{\"traceEvents\":[";
+
+  std::set<unsigned int> threadIndices;
+  bool                   first = true;
+  for (const PipelineTracer::Event & event : events)
+  {
+    trace << (first ? "\n" : ",\n");
+    first = false;
+
+    trace << "{\"name\":";
+    WriteJSONString(trace, event.Name);
+    trace << ",\"cat\":";
+    WriteJSONString(trace, event.Category);
+    trace << ",\"ph\":\"X\",\"ts\":" << event.Timestamp << ",\"dur\":" << event.Duration << ",\"pid\":" << processId
+          << ",\"tid\":" << event.ThreadIndex;
+    if (!event.Arguments.empty())
+    {
+      trace << ",\"args\":{";
+      for (size_t i = 0; i < event.Arguments.size(); ++i)
+      {
+        trace << (i == 0 ? "" : ",");
+        WriteJSONString(trace, event.Arguments[i].first);
+        trace << ':' << event.Arguments[i].second;
+      }
+      trace << '}';
+    }
+    trace << '}';
+    threadIndices.insert(event.ThreadIndex);
+  }
+
+  // Name the tracks of the threads.
+  for (const unsigned int index : threadIndices)
+  {
+    trace << (first ? "\n" : ",\n");
+    first = false;
+    trace << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << processId << ",\"tid\":" << index
+          << ",\"args\":{\"name\":\"ITK thread " << index << "\"}}";
+  }
+
+  trace << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  os << trace.str();
+}
+} // namespace
+
+struct PipelineTracerGlobals
+{
+  PipelineTracerGlobals()
+  {
+    std::string fileName;
+    if (itksys::SystemTools::GetEnv("ITK_PIPELINE_TRACE", fileName) && !fileName.empty())
+    {
+      m_OutputFileName = fileName;
+      m_Enabled = true;
+    }
+  }
+
+  ~PipelineTracerGlobals()
+  {
+    if (!m_OutputFileName.empty())
+    {
+      // Failures are silently ignored, nothing sensible can be done at exit.
+      std::ofstream file(m_OutputFileName.c_str());
+      WriteChromeTraceEvents(file, m_Events);
+    }
+  }
+
+  std::atomic<bool>                           m_Enabled{ false };
+  const std::chrono::steady_clock::time_point m_Origin{ std::chrono::steady_clock::now() };
+  std::atomic<unsigned int>                   m_NextThreadIndex{ 0 };
+
+  std::mutex                         m_Mutex{};
+  std::string                        m_OutputFileName{};
+  std::vector<PipelineTracer::Event> m_Events{};
+};
+
+itkGetGlobalSimpleMacro(PipelineTracer, PipelineTracerGlobals, PimplGlobals);
+
+PipelineTracerGlobals * PipelineTracer::m_PimplGlobals;
+
+PipelineTracer::Scope::Scope(const char * category, const char * name)
+  : m_Active(PipelineTracer::GetEnabled())
+{
+  if (m_Active)
+  {
+    m_Event.Name = name;
+    m_Event.Category = category;
+    m_AllocatedBytesAtStart = threadAllocatedBytes;
+    m_Event.Timestamp = PipelineTracer::GetTimestamp();
+  }
+}
+
+PipelineTracer::Scope::Scope(const char * category, const ProcessObject * filter)
+  : m_Active(PipelineTracer::GetEnabled())
+{
+  if (m_Active)
+  {
+    if (filter == nullptr)
+    {
+      m_Event.Name = "ParallelizeImageRegion";
+    }
+    else
+    {
+      m_Event.Name = filter->GetNameOfClass();
+      const std::string & objectName = filter->GetObjectName();
+      if (!objectName.empty())
+      {
+        m_Event.Name += " (" + objectName + ')';
+      }
+    }
+    m_Event.Category = category;
+    m_AllocatedBytesAtStart = threadAllocatedBytes;
+    m_Event.Timestamp = PipelineTracer::GetTimestamp();
+  }
+}
+
+PipelineTracer::Scope::~Scope()
+{
+  if (m_Active)
+  {
+    m_Event.Duration = PipelineTracer::GetTimestamp() - m_Event.Timestamp;
+    if (m_AddAllocatedBytes)
+    {
+      m_Event.Arguments.emplace_back("allocatedBytes", threadAllocatedBytes - m_AllocatedBytesAtStart);
+    }
+    PipelineTracer::RecordEvent(std::move(m_Event));
+  }
+}
+
+void
+PipelineTracer::Scope::AddArgument(const char * key, SizeValueType value)
+{
+  if (m_Active)
+  {
+    m_Event.Arguments.emplace_back(key, value);
+  }
+}
+
+void
+PipelineTracer::Scope::AddAllocatedBytesArgument()
+{
+  m_AddAllocatedBytes = true;
+}
+
+void
+PipelineTracer::SetEnabled(bool enabled)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_Enabled = enabled;
+}
+
+bool
+PipelineTracer::GetEnabled()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_Enabled;
+}
+
+void
+PipelineTracer::SetOutputFileName(const std::string & fileName)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_OutputFileName = fileName;
+}
+
+std::string
+PipelineTracer::GetOutputFileName()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_OutputFileName;
+}
+
+std::vector<PipelineTracer::Event>
+PipelineTracer::GetEvents()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_Events;
+}
+
+void
+PipelineTracer::ClearEvents()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_Events.clear();
+}
+
+void
+PipelineTracer::WriteChromeTrace(std::ostream & os)
+{
+  WriteChromeTraceEvents(os, GetEvents());
+}
+
+void
+PipelineTracer::WriteChromeTrace(const std::string & fileName)
+{
+  std::ofstream file(fileName.c_str());
+  if (!file)
+  {
+    itkGenericExceptionMacro("Could not open " << fileName << " to write the pipeline trace.");
+  }
+  WriteChromeTrace(file);
+}
+
+void
+PipelineTracer::AddAllocatedBytes(size_t numberOfBytes)
+{
+  threadAllocatedBytes += numberOfBytes;
+}
+
+double
+PipelineTracer::GetTimestamp()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_PimplGlobals->m_Origin).count();
+}
+
+void
+PipelineTracer::RecordEvent(Event && event)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  if (!threadIndexAssigned)
+  {
+    threadIndex = m_PimplGlobals->m_NextThreadIndex++;
+    threadIndexAssigned = true;
+  }
+  event.ThreadIndex = threadIndex;
+
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_Events.push_back(std::move(event));
+}
+
+} // end namespace itk
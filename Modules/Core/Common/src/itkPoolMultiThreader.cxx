@@ -157,10 +157,7 @@ PoolMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
                                     ArrayThreadingFunctorType aFunc,
                                     ProcessObject *           filter)
 {
-  if (!this->GetUpdateProgress())
-  {
-    filter = nullptr;
-  }
+  ProcessObject * const progressFilter = this->GetUpdateProgress() ? filter : nullptr;
 
   if (firstIndex + 1 < lastIndexPlus1)
   {
@@ -170,7 +167,8 @@ PoolMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
       ++chunkSize; // we want slightly bigger chunks to be processed first
     }
 
-    auto lambda = [aFunc](SizeValueType start, SizeValueType end) {
+    auto lambda = [aFunc, filter](SizeValueType start, SizeValueType end) {
+      const WorkUnitStatistics::Scope workUnit(filter, end - start);
       for (SizeValueType ii = start; ii < end; ++ii)
       {
         aFunc(ii);
@@ -186,7 +184,7 @@ PoolMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
     }
     itkAssertOrThrowMacro(workUnit <= m_NumberOfWorkUnits, "Number of work units was somehow miscounted!");
 
-    ProgressReporter reporter(filter, 0, workUnit);
+    ProgressReporter reporter(progressFilter, 0, workUnit);
 
     // execute this thread's share
     ExceptionHandler exceptionHandler;
@@ -198,14 +196,14 @@ PoolMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
     // now wait for the other computations to finish
     for (SizeValueType i = 1; i < workUnit; ++i)
     {
-      exceptionHandler.TryAndCatch([this, i, &reporter, &filter] {
+      exceptionHandler.TryAndCatch([this, i, &reporter, progressFilter] {
         std::future_status status;
         do
         {
           status = m_ThreadInfoArray[i].Future.wait_for(threadCompletionPollingInterval);
-          if (filter && status == std::future_status::timeout)
+          if (progressFilter && status == std::future_status::timeout)
           {
-            filter->IncrementProgress(0);
+            progressFilter->IncrementProgress(0);
           }
         } while (status != std::future_status::ready);
         reporter.CompletedPixel();
@@ -216,6 +214,7 @@ PoolMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
   }
   else if (firstIndex + 1 == lastIndexPlus1)
   {
+    const WorkUnitStatistics::Scope workUnit(filter, 1);
     aFunc(firstIndex);
   }
   // else nothing needs to be executed
@@ -228,6 +227,12 @@ PoolMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
                                           ThreadingFunctorType funcP,
                                           ProcessObject *      filter)
 {
+  if (this->GetDynamicScheduling())
+  {
+    this->ParallelizeImageRegionDynamically(dimension, index, size, funcP, filter);
+    return;
+  }
+
   if (!this->GetUpdateProgress())
   {
     filter = nullptr;
@@ -253,7 +258,7 @@ PoolMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
     }
     else
     {
-      const ImageRegionSplitterBase * splitter = ImageSourceCommon::GetGlobalDefaultSplitter();
+      const ImageRegionSplitterBase * splitter = this->GetImageRegionSplitter();
       const ThreadIdType              splitCount = splitter->GetNumberOfSplits(region, m_NumberOfWorkUnits);
       ProgressReporter                reporter(filter, 0, splitCount);
       itkAssertOrThrowMacro(splitCount <= m_NumberOfWorkUnits, "Split count is greater than number of work units!");
@@ -31,7 +31,10 @@
 #include <cstdio>
 #include <sstream>
 #include <algorithm>
+#include <cmath>
+#include <exception>
 #include "itkMultiThreaderBase.h"
+#include "itkPipelineTracer.h"
 
 namespace itk
 {
@@ -1269,6 +1272,13 @@ ProcessObject::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "NumberOfRequiredOutputs: " << m_NumberOfRequiredOutputs << std::endl;
   os << indent << "NumberOfWorkUnits: " << m_NumberOfWorkUnits << std::endl;
   itkPrintSelfBooleanMacro(ReleaseDataBeforeUpdateFlag);
+  itkPrintSelfBooleanMacro(ConcurrentInputUpdate);
+  itkPrintSelfBooleanMacro(RecordWorkUnitStatistics);
+  if (m_RecordWorkUnitStatistics)
+  {
+    os << indent << "WorkUnitStatistics: " << std::endl;
+    m_WorkUnitStatistics.Print(os, indent.GetNextIndent());
+  }
   itkPrintSelfBooleanMacro(AbortGenerateData);
   os << indent << "Progress: " << progressFixedToFloat(m_Progress) << std::endl;
   os << indent << "Multithreader: " << std::endl;
@@ -1631,6 +1641,7 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
     return;
   }
 
+  const PipelineTracer::Scope updateTrace("UpdateOutputData", this);
 
   /**
    * Prepare all the outputs. This may deallocate previous bulk data.
@@ -1653,7 +1664,7 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
       this->GetPrimaryInput()->UpdateOutputData();
     }
   }
-  else
+  else if (!m_ConcurrentInputUpdate || !this->UpdateInputsConcurrently())
   {
     for (auto & input : m_Inputs)
     {
@@ -1686,9 +1697,19 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
    */
   m_AbortGenerateData = false;
   m_Progress = 0u;
+  if (m_RecordWorkUnitStatistics)
+  {
+    m_WorkUnitStatistics.Clear();
+  }
 
   try
   {
+    PipelineTracer::Scope generateDataTrace("GenerateData", this);
+    if (generateDataTrace.IsActive())
+    {
+      generateDataTrace.AddArgument("requestedPixels", this->GetNumberOfPixelsInRequestedRegion());
+      generateDataTrace.AddAllocatedBytesArgument();
+    }
     this->GenerateData();
   }
   catch (const ProcessAborted &)
@@ -1746,6 +1767,180 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
 }
 
 
+bool
+ProcessObject::UpdateInputsConcurrently()
+{
+  // Each distinct input is the head of a branch, made of the data objects
+  // upstream of it.
+  std::vector<DataObject *>           heads;
+  std::vector<std::set<DataObject *>> branches;
+  for (auto & input : m_Inputs)
+  {
+    if (input.second && std::find(heads.begin(), heads.end(), input.second.GetPointer()) == heads.end())
+    {
+      heads.push_back(input.second);
+      branches.emplace_back();
+
+      std::vector<DataObject *> pending{ input.second };
+      while (!pending.empty())
+      {
+        DataObject * const dataObject = pending.back();
+        pending.pop_back();
+        if (branches.back().insert(dataObject).second && dataObject->GetSource())
+        {
+          for (auto & sourceInput : dataObject->GetSource()->m_Inputs)
+          {
+            if (sourceInput.second)
+            {
+              pending.push_back(sourceInput.second);
+            }
+          }
+        }
+      }
+    }
+  }
+  if (heads.size() < 2)
+  {
+    return false;
+  }
+
+  // Data objects of several branches, and all the outputs of sources of
+  // several branches, are shared: updating them from each branch would run
+  // their source on several threads at once. Shared data objects may not be
+  // released nor overwritten by one branch while another one reads them.
+  std::map<DataObject *, unsigned int>          numberOfBranches;
+  std::map<const ProcessObject *, unsigned int> numberOfSourceBranches;
+  for (const auto & branch : branches)
+  {
+    std::set<const ProcessObject *> sources;
+    for (DataObject * const dataObject : branch)
+    {
+      ++numberOfBranches[dataObject];
+      if (const ProcessObject * const source = dataObject->GetSource().GetPointer())
+      {
+        sources.insert(source);
+      }
+    }
+    for (const ProcessObject * const source : sources)
+    {
+      ++numberOfSourceBranches[source];
+    }
+  }
+  std::set<DataObject *> shared;
+  for (const auto & dataObjectAndCount : numberOfBranches)
+  {
+    const ProcessObject * const source = dataObjectAndCount.first->GetSource().GetPointer();
+    if (dataObjectAndCount.second > 1 || (source && numberOfSourceBranches[source] > 1))
+    {
+      if (dataObjectAndCount.first->ShouldIReleaseData())
+      {
+        return false;
+      }
+      shared.insert(dataObjectAndCount.first);
+    }
+  }
+  for (const auto & dataObjectAndCount : numberOfBranches)
+  {
+    const ProcessObject * const source = dataObjectAndCount.first->GetSource();
+    if (source && source->CanOverwriteInputs())
+    {
+      for (const auto & sourceInput : source->m_Inputs)
+      {
+        if (shared.count(sourceInput.second.GetPointer()) > 0)
+        {
+          return false;
+        }
+      }
+    }
+  }
+
+  // Update the shared data objects first, one branch after another.
+  for (size_t i = 0; i < heads.size(); ++i)
+  {
+    heads[i]->PropagateRequestedRegion();
+    for (DataObject * const dataObject : branches[i])
+    {
+      if (shared.count(dataObject) > 0)
+      {
+        dataObject->UpdateOutputData();
+      }
+    }
+  }
+
+  // Propagate the requested regions of the branches again, checking that
+  // they all request the same region of the shared data objects, which
+  // therefore remain up to date while the branches are updated.
+  std::map<DataObject *, DataObject::Pointer> requestedRegions;
+  for (size_t i = 0; i < heads.size(); ++i)
+  {
+    heads[i]->PropagateRequestedRegion();
+    for (DataObject * const dataObject : branches[i])
+    {
+      if (shared.count(dataObject) == 0)
+      {
+        continue;
+      }
+      if (dataObject->RequestedRegionIsOutsideOfTheBufferedRegion())
+      {
+        return false;
+      }
+      DataObject::Pointer & requestedRegion = requestedRegions[dataObject];
+      if (requestedRegion.IsNull())
+      {
+        requestedRegion = dynamic_cast<DataObject *>(dataObject->CreateAnother().GetPointer());
+        if (requestedRegion.IsNull())
+        {
+          return false;
+        }
+        requestedRegion->SetRequestedRegion(dataObject);
+      }
+      else if (!dataObject->RequestedRegionIsEqualTo(requestedRegion))
+      {
+        return false;
+      }
+    }
+  }
+
+  // Update the first branch from this thread, and the others from threads
+  // of their own. Their parallel loops share the thread pools of the
+  // multi-threaders; running the branches on pool threads instead could
+  // leave no thread to run the loops.
+  std::vector<std::future<void>> branchUpdates;
+  for (size_t i = 1; i < heads.size(); ++i)
+  {
+    branchUpdates.push_back(std::async(std::launch::async, [head = heads[i]] { head->UpdateOutputData(); }));
+  }
+  std::exception_ptr exception;
+  try
+  {
+    heads[0]->UpdateOutputData();
+  }
+  catch (...)
+  {
+    exception = std::current_exception();
+  }
+  for (auto & branchUpdate : branchUpdates)
+  {
+    try
+    {
+      branchUpdate.get();
+    }
+    catch (...)
+    {
+      if (!exception)
+      {
+        exception = std::current_exception();
+      }
+    }
+  }
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+  return true;
+}
+
+
 void
 ProcessObject::CacheInputReleaseDataFlags()
 {
@@ -1819,6 +2014,116 @@ ProcessObject::UpdateLargestPossibleRegion()
 }
 
 
+std::future<void>
+ProcessObject::UpdateAsync()
+{
+  const Pointer self(this);
+  return std::async(std::launch::async, [self] { self->Update(); });
+}
+
+
+SizeValueType
+ProcessObject::EstimateMemoryFootprint() const
+{
+  auto footprint = static_cast<SizeValueType>(this->GetAdditionalMemoryPerOutputPixel() *
+                                               static_cast<double>(this->GetNumberOfPixelsInRequestedRegion()));
+  for (const auto & input : m_Inputs)
+  {
+    if (input.second)
+    {
+      footprint += input.second->GetRequestedRegionMemorySize();
+    }
+  }
+  for (const auto & output : m_Outputs)
+  {
+    if (output.second)
+    {
+      footprint += output.second->GetRequestedRegionMemorySize();
+    }
+  }
+  return footprint;
+}
+
+
+SizeValueType
+ProcessObject::EstimatePipelineMemoryFootprint(const DataObject * dataObject)
+{
+  SizeValueType                   footprint = 0;
+  std::set<const DataObject *>    visitedDataObjects;
+  std::set<const ProcessObject *> visitedProcessObjects;
+  std::vector<const DataObject *> pending{ dataObject };
+  while (!pending.empty())
+  {
+    const DataObject * const current = pending.back();
+    pending.pop_back();
+    if (current == nullptr || !visitedDataObjects.insert(current).second)
+    {
+      continue;
+    }
+    footprint += current->GetRequestedRegionMemorySize();
+
+    const ProcessObject * const source = current->GetSource();
+    if (source != nullptr && visitedProcessObjects.insert(source).second)
+    {
+      footprint += static_cast<SizeValueType>(source->GetAdditionalMemoryPerOutputPixel() *
+                                              static_cast<double>(source->GetNumberOfPixelsInRequestedRegion()));
+      for (const auto & input : source->m_Inputs)
+      {
+        pending.push_back(input.second);
+      }
+    }
+  }
+  return footprint;
+}
+
+
+unsigned int
+ProcessObject::ComputeNumberOfStreamDivisions(DataObject *                                      input,
+                                              SizeValueType                                     memoryBudget,
+                                              const std::function<unsigned int(unsigned int)> & requestPiece)
+{
+  unsigned int  bestNumberOfDivisions = 1;
+  SizeValueType bestFootprint = NumericTraits<SizeValueType>::max();
+  unsigned int  numberOfDivisions = 1;
+  while (true)
+  {
+    const unsigned int actualNumberOfDivisions = requestPiece(numberOfDivisions);
+    input->PropagateRequestedRegion();
+    const SizeValueType footprint = EstimatePipelineMemoryFootprint(input);
+    const bool          decreased = footprint < bestFootprint;
+    if (decreased)
+    {
+      bestNumberOfDivisions = actualNumberOfDivisions;
+      bestFootprint = footprint;
+      if (footprint <= memoryBudget)
+      {
+        return actualNumberOfDivisions;
+      }
+    }
+    else if (actualNumberOfDivisions > bestNumberOfDivisions)
+    {
+      // More pieces do not reduce the footprint any more.
+      return bestNumberOfDivisions;
+    }
+    if (numberOfDivisions == NumericTraits<unsigned int>::max())
+    {
+      return bestNumberOfDivisions;
+    }
+
+    // The footprint is roughly proportional to the size of the pieces, the
+    // enlargement of the requested regions aside. When the splitter did not
+    // produce more pieces, ask for twice as many.
+    const double scale =
+      decreased ? static_cast<double>(footprint) / static_cast<double>(std::max<SizeValueType>(memoryBudget, 1)) : 2.0;
+    const double scaledNumberOfDivisions = std::ceil(numberOfDivisions * scale);
+    numberOfDivisions =
+      scaledNumberOfDivisions >= static_cast<double>(NumericTraits<unsigned int>::max())
+        ? NumericTraits<unsigned int>::max()
+        : std::max(numberOfDivisions + 1, static_cast<unsigned int>(scaledNumberOfDivisions));
+  }
+}
+
+
 void
 ProcessObject::SetNumberOfRequiredInputs(DataObjectPointerArraySizeType nb)
 {
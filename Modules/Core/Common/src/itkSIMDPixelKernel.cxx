@@ -0,0 +1,152 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkSIMDPixelKernel.h"
+#include "itkSingleton.h"
+#include "itksys/SystemTools.hxx"
+
+#include <atomic>
+
+namespace itk
+{
+
+namespace
+{
+SIMDPixelKernelEnums::InstructionSet
+DetectInstructionSet()
+{
+#ifdef ITK_SIMD_PIXEL_KERNEL_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+  {
+    return SIMDPixelKernelEnums::InstructionSet::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2"))
+  {
+    return SIMDPixelKernelEnums::InstructionSet::AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.2"))
+  {
+    return SIMDPixelKernelEnums::InstructionSet::SSE4;
+  }
+#endif
+  return SIMDPixelKernelEnums::InstructionSet::Baseline;
+}
+} // namespace
+
+struct SIMDPixelKernelGlobals
+{
+  SIMDPixelKernelGlobals()
+  {
+    std::string instructionSet;
+    if (itksys::SystemTools::GetEnv("ITK_SIMD_INSTRUCTION_SET", instructionSet))
+    {
+      instructionSet = itksys::SystemTools::UpperCase(instructionSet);
+      if (instructionSet == "OFF")
+      {
+        m_Enabled = false;
+      }
+      else if (instructionSet == "BASELINE")
+      {
+        m_MaximumInstructionSet = SIMDPixelKernelEnums::InstructionSet::Baseline;
+      }
+      else if (instructionSet == "SSE4")
+      {
+        m_MaximumInstructionSet = SIMDPixelKernelEnums::InstructionSet::SSE4;
+      }
+      else if (instructionSet == "AVX2")
+      {
+        m_MaximumInstructionSet = SIMDPixelKernelEnums::InstructionSet::AVX2;
+      }
+    }
+  }
+
+  const SIMDPixelKernelEnums::InstructionSet        m_SupportedInstructionSet{ DetectInstructionSet() };
+  std::atomic<SIMDPixelKernelEnums::InstructionSet> m_MaximumInstructionSet{
+    SIMDPixelKernelEnums::InstructionSet::AVX512
+  };
+  std::atomic<bool> m_Enabled{ true };
+};
+
+itkGetGlobalSimpleMacro(SIMDPixelKernel, SIMDPixelKernelGlobals, PimplGlobals);
+
+SIMDPixelKernelGlobals * SIMDPixelKernel::m_PimplGlobals;
+
+void
+SIMDPixelKernel::SetEnabled(bool enabled)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_Enabled = enabled;
+}
+
+bool
+SIMDPixelKernel::IsEnabled()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_Enabled;
+}
+
+auto
+SIMDPixelKernel::GetSupportedInstructionSet() -> InstructionSetEnum
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_SupportedInstructionSet;
+}
+
+void
+SIMDPixelKernel::SetMaximumInstructionSet(InstructionSetEnum instructionSet)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_MaximumInstructionSet = instructionSet;
+}
+
+auto
+SIMDPixelKernel::GetMaximumInstructionSet() -> InstructionSetEnum
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_MaximumInstructionSet;
+}
+
+auto
+SIMDPixelKernel::GetInstructionSet() -> InstructionSetEnum
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return std::min(m_PimplGlobals->m_SupportedInstructionSet, m_PimplGlobals->m_MaximumInstructionSet.load());
+}
+
+/** Print enum values */
+std::ostream &
+operator<<(std::ostream & out, const SIMDPixelKernelEnums::InstructionSet value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case SIMDPixelKernelEnums::InstructionSet::Baseline:
+        return "itk::SIMDPixelKernelEnums::InstructionSet::Baseline";
+      case SIMDPixelKernelEnums::InstructionSet::SSE4:
+        return "itk::SIMDPixelKernelEnums::InstructionSet::SSE4";
+      case SIMDPixelKernelEnums::InstructionSet::AVX2:
+        return "itk::SIMDPixelKernelEnums::InstructionSet::AVX2";
+      case SIMDPixelKernelEnums::InstructionSet::AVX512:
+        return "itk::SIMDPixelKernelEnums::InstructionSet::AVX512";
+      default:
+        return "INVALID VALUE FOR itk::SIMDPixelKernelEnums::InstructionSet";
+    }
+  }();
+}
+
+} // end namespace itk
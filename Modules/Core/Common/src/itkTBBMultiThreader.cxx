@@ -119,11 +119,8 @@ TBBMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
                                    ArrayThreadingFunctorType aFunc,
                                    ProcessObject *           filter)
 {
-  if (!this->GetUpdateProgress())
-  {
-    filter = nullptr;
-  }
-  ProgressReporter progressStartEnd(filter, 0, 1);
+  ProcessObject * const progressFilter = this->GetUpdateProgress() ? filter : nullptr;
+  ProgressReporter      progressStartEnd(progressFilter, 0, 1);
 
   if (firstIndex + 1 < lastIndexPlus1)
   {
@@ -139,9 +136,10 @@ TBBMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
         // Make sure that TBB did not call us with a block of "threads"
         // but rather with only one "thread" to handle
         itkAssertInDebugAndIgnoreInReleaseMacro(r.begin() + 1 == r.end());
-        TotalProgressReporter progress(filter, count, 100);
+        TotalProgressReporter progress(progressFilter, count, 100);
         progress.CheckAbortGenerateData();
 
+        const WorkUnitStatistics::Scope workUnit(filter, 1);
         aFunc(r.begin()); // invoke the function
 
         progress.CompletedPixel();
@@ -150,6 +148,7 @@ TBBMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
   }
   else if (firstIndex + 1 == lastIndexPlus1)
   {
+    const WorkUnitStatistics::Scope workUnit(filter, 1);
     aFunc(firstIndex);
   }
 }
@@ -243,6 +242,12 @@ TBBMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
                                          ThreadingFunctorType funcP,
                                          ProcessObject *      filter)
 {
+  if (this->GetDynamicScheduling())
+  {
+    this->ParallelizeImageRegionDynamically(dimension, index, size, funcP, filter);
+    return;
+  }
+
   if (!this->GetUpdateProgress())
   {
     filter = nullptr;
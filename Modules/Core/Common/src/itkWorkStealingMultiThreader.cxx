@@ -0,0 +1,190 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWorkStealingMultiThreader.h"
+#include "itkNumericTraits.h"
+#include "itkProcessObject.h"
+#include "itkTotalProgressReporter.h"
+#include <algorithm>
+#include <iostream>
+
+namespace itk
+{
+
+WorkStealingMultiThreader::WorkStealingMultiThreader()
+  : m_ThreadPool(WorkStealingThreadPool::GetInstance())
+{
+  const ThreadIdType defaultThreads = std::max(1u, GetGlobalDefaultNumberOfThreads());
+  if (defaultThreads > 1) // one work unit for only one thread
+  {
+    m_NumberOfWorkUnits = 16 * defaultThreads;
+  }
+  m_MaximumNumberOfThreads = m_ThreadPool->GetMaximumNumberOfThreads();
+}
+
+WorkStealingMultiThreader::~WorkStealingMultiThreader() = default;
+
+void
+WorkStealingMultiThreader::SetSingleMethod(ThreadFunctionType f, void * data)
+{
+  m_SingleMethod = std::move(f);
+  m_SingleData = data;
+}
+
+void
+WorkStealingMultiThreader::SetNumberOfWorkUnits(ThreadIdType numberOfWorkUnits)
+{
+  m_NumberOfWorkUnits = std::max(1u, numberOfWorkUnits);
+}
+
+void
+WorkStealingMultiThreader::SetMaximumNumberOfThreads(ThreadIdType numberOfThreads)
+{
+  Superclass::SetMaximumNumberOfThreads(numberOfThreads);
+  const ThreadIdType threadCount = m_ThreadPool->GetMaximumNumberOfThreads();
+  if (threadCount < m_MaximumNumberOfThreads)
+  {
+    m_ThreadPool->AddThreads(m_MaximumNumberOfThreads - threadCount);
+  }
+  m_MaximumNumberOfThreads = m_ThreadPool->GetMaximumNumberOfThreads();
+}
+
+void
+WorkStealingMultiThreader::SingleMethodExecute()
+{
+  if (!m_SingleMethod)
+  {
+    itkExceptionMacro("No single method set!");
+  }
+
+  m_ThreadPool->ParallelFor(
+    m_NumberOfWorkUnits,
+    [this](SizeValueType workUnit) {
+      WorkUnitInfo workUnitInfo;
+      workUnitInfo.WorkUnitID = static_cast<ThreadIdType>(workUnit);
+      workUnitInfo.NumberOfWorkUnits = m_NumberOfWorkUnits;
+      workUnitInfo.UserData = m_SingleData;
+      m_SingleMethod(&workUnitInfo);
+    },
+    m_MaximumNumberOfThreads);
+}
+
+void
+WorkStealingMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
+                                            SizeValueType             lastIndexPlus1,
+                                            ArrayThreadingFunctorType aFunc,
+                                            ProcessObject *           filter)
+{
+  ProcessObject * const  progressFilter = this->GetUpdateProgress() ? filter : nullptr;
+  const ProgressReporter progressStartEnd(progressFilter, 0, 1);
+
+  if (firstIndex + 1 < lastIndexPlus1)
+  {
+    const SizeValueType range = lastIndexPlus1 - firstIndex;
+    const SizeValueType chunkCount = std::min<SizeValueType>(range, m_NumberOfWorkUnits);
+
+    m_ThreadPool->ParallelFor(
+      chunkCount,
+      [firstIndex, range, chunkCount, &aFunc, filter, progressFilter](SizeValueType chunk) {
+        TotalProgressReporter progress(progressFilter, range, 100);
+        progress.CheckAbortGenerateData();
+
+        const SizeValueType             first = firstIndex + (range * chunk) / chunkCount;
+        const SizeValueType             afterLast = firstIndex + (range * (chunk + 1)) / chunkCount;
+        const WorkUnitStatistics::Scope workUnit(filter, afterLast - first);
+        for (SizeValueType i = first; i < afterLast; ++i)
+        {
+          aFunc(i);
+        }
+
+        progress.Completed(afterLast - first);
+      },
+      m_MaximumNumberOfThreads);
+  }
+  else if (firstIndex + 1 == lastIndexPlus1)
+  {
+    const WorkUnitStatistics::Scope workUnit(filter, 1);
+    aFunc(firstIndex);
+  }
+  // else nothing needs to be executed
+}
+
+void
+WorkStealingMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
+                                                  const IndexValueType index[],
+                                                  const SizeValueType  size[],
+                                                  ThreadingFunctorType funcP,
+                                                  ProcessObject *      filter)
+{
+  if (this->GetDynamicScheduling())
+  {
+    this->ParallelizeImageRegionDynamically(dimension, index, size, funcP, filter);
+    return;
+  }
+
+  if (!this->GetUpdateProgress())
+  {
+    filter = nullptr;
+  }
+  const ProgressReporter progressStartEnd(filter, 0, 1);
+
+  if (m_NumberOfWorkUnits == 1) // no multi-threading wanted
+  {
+    funcP(index, size); // process whole region
+    return;
+  }
+
+  ImageIORegion region(dimension);
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    region.SetIndex(d, index[d]);
+    region.SetSize(d, size[d]);
+  }
+  if (region.GetNumberOfPixels() <= 1)
+  {
+    funcP(index, size); // process whole region
+    return;
+  }
+
+  const ImageRegionSplitterBase * splitter = this->GetImageRegionSplitter();
+  const ThreadIdType              splitCount = splitter->GetNumberOfSplits(region, m_NumberOfWorkUnits);
+  const SizeValueType             totalCount = region.GetNumberOfPixels();
+
+  m_ThreadPool->ParallelFor(
+    splitCount,
+    [&region, splitter, splitCount, totalCount, &funcP, filter](SizeValueType piece) {
+      TotalProgressReporter progress(filter, totalCount, 100);
+      progress.CheckAbortGenerateData();
+
+      ImageIORegion pieceRegion = region;
+      splitter->GetSplit(static_cast<unsigned int>(piece), splitCount, pieceRegion);
+      funcP(&pieceRegion.GetIndex()[0], &pieceRegion.GetSize()[0]);
+
+      progress.Completed(pieceRegion.GetNumberOfPixels());
+    },
+    m_MaximumNumberOfThreads);
+}
+
+void
+WorkStealingMultiThreader::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "ThreadPool: " << m_ThreadPool.GetPointer() << std::endl;
+}
+
+} // namespace itk
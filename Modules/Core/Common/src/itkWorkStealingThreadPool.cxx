@@ -0,0 +1,449 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWorkStealingThreadPool.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSingleton.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <exception>
+
+
+namespace itk
+{
+
+namespace
+{
+std::chrono::milliseconds helperCompletionPollingInterval = std::chrono::milliseconds(1);
+
+// Index of the worker running on this thread, or ITK_MAX_THREADS for threads outside of the pool.
+thread_local ThreadIdType currentWorkerID = ITK_MAX_THREADS;
+} // namespace
+
+struct WorkStealingThreadPoolGlobals
+{
+  WorkStealingThreadPoolGlobals() = default;
+
+  // To lock on the various internal variables.
+  std::mutex m_Mutex;
+
+  // To allow singleton creation of WorkStealingThreadPool.
+  std::once_flag m_ThreadPoolOnceFlag;
+
+  // The singleton instance of WorkStealingThreadPool.
+  WorkStealingThreadPool::Pointer m_ThreadPoolInstance;
+};
+
+itkGetGlobalSimpleMacro(WorkStealingThreadPool, WorkStealingThreadPoolGlobals, PimplGlobals);
+
+
+struct WorkStealingThreadPool::LoopState
+{
+  LoopState(const LoopBodyType & body, SizeValueType count)
+    : m_Body(body)
+    , m_Count(count)
+  {}
+
+  void
+  RunLoop()
+  {
+    for (SizeValueType i = m_NextIndex++; i < m_Count; i = m_NextIndex++)
+    {
+      try
+      {
+        m_Body(i);
+      }
+      catch (...)
+      {
+        m_NextIndex = m_Count; // stop handing out indices
+        const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+        if (m_FirstCaughtException == nullptr)
+        {
+          m_FirstCaughtException = std::current_exception();
+        }
+      }
+    }
+  }
+
+  const LoopBodyType &       m_Body;
+  const SizeValueType        m_Count;
+  std::atomic<SizeValueType> m_NextIndex{ 0 };
+
+  std::mutex              m_Mutex;
+  std::condition_variable m_Condition;
+  ThreadIdType            m_PendingHelpers{ 0 };    // guarded by m_Mutex
+  std::exception_ptr      m_FirstCaughtException{}; // guarded by m_Mutex
+};
+
+
+/** Bounded single-owner deque following Chase and Lev, "Dynamic circular
+ * work-stealing deque" (2005), with the memory orderings of Le et al.,
+ * "Correct and efficient work-stealing for weak memory models" (2013).
+ * Only the owning worker calls Push() and Pop(), any thread may call Steal(). */
+class WorkStealingThreadPool::WorkerDeque
+{
+public:
+  bool
+  Push(LoopState * task)
+  {
+    const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+    const int64_t top = m_Top.load(std::memory_order_acquire);
+    if (bottom - top >= Capacity)
+    {
+      return false;
+    }
+    m_Buffer[bottom & Mask].store(task, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  LoopState *
+  Pop()
+  {
+    const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+    m_Bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = m_Top.load(std::memory_order_relaxed);
+    if (top > bottom) // empty
+    {
+      m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    LoopState * task = m_Buffer[bottom & Mask].load(std::memory_order_relaxed);
+    if (top == bottom) // last element, race against thieves
+    {
+      if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      {
+        task = nullptr;
+      }
+      m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return task;
+  }
+
+  LoopState *
+  Steal()
+  {
+    int64_t top = m_Top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+    if (top >= bottom)
+    {
+      return nullptr;
+    }
+    LoopState * task = m_Buffer[top & Mask].load(std::memory_order_relaxed);
+    if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+      return nullptr; // lost the race against another thief or the owner
+    }
+    return task;
+  }
+
+private:
+  static constexpr int64_t Capacity = 256;
+  static constexpr int64_t Mask = Capacity - 1;
+
+  alignas(64) std::atomic<int64_t> m_Top{ 0 };
+  alignas(64) std::atomic<int64_t> m_Bottom{ 0 };
+  std::atomic<LoopState *> m_Buffer[Capacity]{};
+};
+
+
+WorkStealingThreadPool::Pointer
+WorkStealingThreadPool::New()
+{
+  return Self::GetInstance();
+}
+
+
+WorkStealingThreadPool::Pointer
+WorkStealingThreadPool::GetInstance()
+{
+  // This is called once, on-demand to ensure that m_PimplGlobals is
+  // initialized.
+  itkInitGlobalsMacro(PimplGlobals);
+
+  // Create a singleton WorkStealingThreadPool.
+  std::call_once(m_PimplGlobals->m_ThreadPoolOnceFlag, []() {
+    m_PimplGlobals->m_ThreadPoolInstance = ObjectFactory<Self>::Create();
+    if (m_PimplGlobals->m_ThreadPoolInstance.IsNull())
+    {
+      new WorkStealingThreadPool(); // constructor sets m_PimplGlobals->m_ThreadPoolInstance
+    }
+#if defined(ITK_USE_PTHREADS)
+    pthread_atfork(WorkStealingThreadPool::PrepareForFork,
+                   WorkStealingThreadPool::ResumeFromFork,
+                   WorkStealingThreadPool::ResumeFromFork);
+#endif
+  });
+
+  return m_PimplGlobals->m_ThreadPoolInstance;
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool()
+  : m_Deques(new WorkerDeque[ITK_MAX_THREADS])
+{
+  // m_PimplGlobals->m_Mutex not needed to be acquired here because construction only occurs via GetInstance which is
+  // protected by call_once.
+
+  m_PimplGlobals->m_ThreadPoolInstance = this;        // threads need this
+  m_PimplGlobals->m_ThreadPoolInstance->UnRegister(); // Remove extra reference
+  this->AddThreads(MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+  this->CleanUp();
+}
+
+void
+WorkStealingThreadPool::AddThreads(ThreadIdType count)
+{
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  count = std::min<ThreadIdType>(count, ITK_MAX_THREADS - static_cast<ThreadIdType>(m_Threads.size()));
+  m_Threads.reserve(m_Threads.size() + count);
+  for (ThreadIdType i = 0; i < count; ++i)
+  {
+    m_Threads.emplace_back(&WorkStealingThreadPool::ThreadExecute, this, static_cast<ThreadIdType>(m_Threads.size()));
+  }
+  m_NumberOfWorkers = static_cast<ThreadIdType>(m_Threads.size());
+}
+
+ThreadIdType
+WorkStealingThreadPool::GetMaximumNumberOfThreads() const
+{
+  return m_NumberOfWorkers;
+}
+
+bool
+WorkStealingThreadPool::IsWorkerThread()
+{
+  return currentWorkerID < ITK_MAX_THREADS;
+}
+
+void
+WorkStealingThreadPool::CleanUp()
+{
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+    m_Stopping = true;
+  }
+  m_Condition.notify_all();
+
+  for (auto & thread : m_Threads)
+  {
+    assert(thread.joinable());
+    thread.join();
+  }
+}
+
+void
+WorkStealingThreadPool::PrepareForFork()
+{
+  m_PimplGlobals->m_ThreadPoolInstance->CleanUp();
+}
+
+void
+WorkStealingThreadPool::ResumeFromFork()
+{
+  WorkStealingThreadPool * instance = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
+  const ThreadIdType       threadCount = instance->m_Threads.size();
+  instance->m_Threads.clear();
+  instance->m_NumberOfWorkers = 0;
+  instance->m_Stopping = false;
+  instance->AddThreads(threadCount);
+}
+
+void
+WorkStealingThreadPool::ParallelFor(SizeValueType count, const LoopBodyType & body, ThreadIdType maximumNumberOfThreads)
+{
+  if (count == 0)
+  {
+    return;
+  }
+
+  LoopState state(body, count);
+
+  ThreadIdType helperCount = 0;
+  if (count > 1 && maximumNumberOfThreads > 1)
+  {
+    helperCount = static_cast<ThreadIdType>(
+      std::min<SizeValueType>({ maximumNumberOfThreads - 1, count - 1, m_NumberOfWorkers.load() }));
+  }
+
+  if (helperCount > 0)
+  {
+    state.m_PendingHelpers = helperCount;
+    for (ThreadIdType i = 0; i < helperCount; ++i)
+    {
+      this->Submit(&state);
+    }
+    {
+      // Pairs with the predicate check of idle workers, so that no wake-up is lost.
+      const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+    }
+    if (helperCount == 1)
+    {
+      m_Condition.notify_one();
+    }
+    else
+    {
+      m_Condition.notify_all();
+    }
+  }
+
+  // execute this thread's share
+  state.RunLoop();
+
+  if (helperCount > 0)
+  {
+    this->WaitForHelpers(state);
+  }
+
+  if (state.m_FirstCaughtException != nullptr)
+  {
+    std::rethrow_exception(state.m_FirstCaughtException);
+  }
+}
+
+void
+WorkStealingThreadPool::Submit(LoopState * task)
+{
+  ++m_QueuedTasks;
+  if (IsWorkerThread() && m_Deques[currentWorkerID].Push(task))
+  {
+    return;
+  }
+  // Not a worker, or its deque is full.
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  m_InjectionQueue.push_back(task);
+}
+
+WorkStealingThreadPool::LoopState *
+WorkStealingThreadPool::FindTask()
+{
+  if (m_QueuedTasks.load() <= 0)
+  {
+    return nullptr;
+  }
+
+  LoopState *        task = nullptr;
+  const ThreadIdType workerCount = m_NumberOfWorkers;
+  const bool         isWorker = IsWorkerThread();
+
+  if (isWorker)
+  {
+    task = m_Deques[currentWorkerID].Pop();
+  }
+  if (task == nullptr)
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+    if (!m_InjectionQueue.empty())
+    {
+      task = m_InjectionQueue.front();
+      m_InjectionQueue.pop_front();
+    }
+  }
+  if (task == nullptr && workerCount > 0)
+  {
+    // Start with the neighbor, so that thieves spread over the victims.
+    const ThreadIdType first = isWorker ? currentWorkerID + 1 : 0;
+    for (ThreadIdType i = 0; i < workerCount && task == nullptr; ++i)
+    {
+      const ThreadIdType victim = (first + i) % workerCount;
+      if (!isWorker || victim != currentWorkerID)
+      {
+        task = m_Deques[victim].Steal();
+      }
+    }
+  }
+
+  if (task != nullptr)
+  {
+    --m_QueuedTasks;
+  }
+  return task;
+}
+
+void
+WorkStealingThreadPool::ExecuteTask(LoopState * task)
+{
+  task->RunLoop();
+
+  // The submitter may destroy the task as soon as the count drops to zero,
+  // so notify while holding the lock and do not touch the task afterwards.
+  const std::lock_guard<std::mutex> lockGuard(task->m_Mutex);
+  --task->m_PendingHelpers;
+  task->m_Condition.notify_all();
+}
+
+void
+WorkStealingThreadPool::WaitForHelpers(LoopState & state)
+{
+  while (true)
+  {
+    {
+      const std::lock_guard<std::mutex> lockGuard(state.m_Mutex);
+      if (state.m_PendingHelpers == 0)
+      {
+        return;
+      }
+    }
+
+    // Help out instead of blocking. This also executes the helpers of this
+    // loop which have not been picked up by any other thread yet.
+    if (LoopState * task = this->FindTask())
+    {
+      ExecuteTask(task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> mutexHolder(state.m_Mutex);
+    state.m_Condition.wait_for(
+      mutexHolder, helperCompletionPollingInterval, [&state] { return state.m_PendingHelpers == 0; });
+  }
+}
+
+void
+WorkStealingThreadPool::ThreadExecute(ThreadIdType workerID)
+{
+  currentWorkerID = workerID;
+
+  while (true)
+  {
+    if (LoopState * task = this->FindTask())
+    {
+      ExecuteTask(task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> mutexHolder(m_PimplGlobals->m_Mutex);
+    m_Condition.wait(mutexHolder, [this] { return m_Stopping || m_QueuedTasks.load() > 0; });
+    if (m_Stopping)
+    {
+      return;
+    }
+  }
+}
+
+WorkStealingThreadPoolGlobals * WorkStealingThreadPool::m_PimplGlobals;
+
+} // namespace itk
@@ -0,0 +1,219 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWorkUnitStatistics.h"
+#include "itkProcessObject.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <numeric>
+
+namespace itk
+{
+
+namespace
+{
+// The innermost recording scope of each thread.
+thread_local WorkUnitStatistics::Scope * threadRecordingScope = nullptr;
+} // namespace
+
+WorkUnitStatistics::Scope::Scope(ProcessObject * filter, SizeValueType numberOfItems)
+  : m_NumberOfItems(numberOfItems)
+{
+  if (filter == nullptr || !filter->GetRecordWorkUnitStatistics())
+  {
+    return;
+  }
+
+  WorkUnitStatistics * statistics = &filter->m_WorkUnitStatistics;
+  if (threadRecordingScope != nullptr && threadRecordingScope->m_Statistics == statistics)
+  {
+    m_Outer = threadRecordingScope;
+    return;
+  }
+
+  m_Statistics = statistics;
+  m_Enclosing = threadRecordingScope;
+  threadRecordingScope = this;
+  m_StartTime = WorkUnitStatistics::GetTime();
+}
+
+WorkUnitStatistics::Scope::~Scope()
+{
+  if (m_Outer != nullptr)
+  {
+    m_Outer->m_NumberOfNestedItems += m_NumberOfItems;
+  }
+  else if (m_Statistics != nullptr)
+  {
+    threadRecordingScope = m_Enclosing;
+
+    WorkUnit workUnit;
+    workUnit.StartTime = m_StartTime;
+    workUnit.EndTime = WorkUnitStatistics::GetTime();
+    workUnit.NumberOfItems = m_NumberOfNestedItems > 0 ? m_NumberOfNestedItems : m_NumberOfItems;
+    workUnit.ThreadId = std::this_thread::get_id();
+    m_Statistics->AddWorkUnit(workUnit);
+  }
+}
+
+WorkUnitStatistics::WorkUnitStatistics(const WorkUnitStatistics & other)
+  : m_WorkUnits(other.GetWorkUnits())
+{}
+
+WorkUnitStatistics &
+WorkUnitStatistics::operator=(const WorkUnitStatistics & other)
+{
+  if (this != &other)
+  {
+    std::vector<WorkUnit>             workUnits = other.GetWorkUnits();
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    m_WorkUnits = std::move(workUnits);
+  }
+  return *this;
+}
+
+void
+WorkUnitStatistics::Clear()
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_WorkUnits.clear();
+}
+
+void
+WorkUnitStatistics::AddWorkUnit(const WorkUnit & workUnit)
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_WorkUnits.push_back(workUnit);
+}
+
+auto
+WorkUnitStatistics::GetWorkUnits() const -> std::vector<WorkUnit>
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_WorkUnits;
+}
+
+SizeValueType
+WorkUnitStatistics::GetNumberOfWorkUnits() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_WorkUnits.size();
+}
+
+unsigned int
+WorkUnitStatistics::GetNumberOfThreads() const
+{
+  return static_cast<unsigned int>(this->GetBusyTimes().size());
+}
+
+SizeValueType
+WorkUnitStatistics::GetNumberOfItems() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  SizeValueType                     numberOfItems = 0;
+  for (const WorkUnit & workUnit : m_WorkUnits)
+  {
+    numberOfItems += workUnit.NumberOfItems;
+  }
+  return numberOfItems;
+}
+
+double
+WorkUnitStatistics::GetWallTime() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  if (m_WorkUnits.empty())
+  {
+    return 0.0;
+  }
+  double start = m_WorkUnits.front().StartTime;
+  double end = m_WorkUnits.front().EndTime;
+  for (const WorkUnit & workUnit : m_WorkUnits)
+  {
+    start = std::min(start, workUnit.StartTime);
+    end = std::max(end, workUnit.EndTime);
+  }
+  return end - start;
+}
+
+double
+WorkUnitStatistics::GetMaximumBusyTime() const
+{
+  const std::vector<double> busyTimes = this->GetBusyTimes();
+  return busyTimes.empty() ? 0.0 : *std::max_element(busyTimes.cbegin(), busyTimes.cend());
+}
+
+double
+WorkUnitStatistics::GetMeanBusyTime() const
+{
+  const std::vector<double> busyTimes = this->GetBusyTimes();
+  return busyTimes.empty() ? 0.0 : std::accumulate(busyTimes.cbegin(), busyTimes.cend(), 0.0) / busyTimes.size();
+}
+
+double
+WorkUnitStatistics::GetIdleFraction() const
+{
+  const double wallTime = this->GetWallTime();
+  if (wallTime <= 0.0)
+  {
+    return 0.0;
+  }
+  return std::clamp(1.0 - this->GetMeanBusyTime() / wallTime, 0.0, 1.0);
+}
+
+void
+WorkUnitStatistics::Print(std::ostream & os, Indent indent) const
+{
+  os << indent << "NumberOfWorkUnits: " << this->GetNumberOfWorkUnits() << std::endl;
+  os << indent << "NumberOfThreads: " << this->GetNumberOfThreads() << std::endl;
+  os << indent << "NumberOfItems: " << this->GetNumberOfItems() << std::endl;
+  os << indent << "WallTime: " << this->GetWallTime() << std::endl;
+  os << indent << "MaximumBusyTime: " << this->GetMaximumBusyTime() << std::endl;
+  os << indent << "MeanBusyTime: " << this->GetMeanBusyTime() << std::endl;
+  os << indent << "IdleFraction: " << this->GetIdleFraction() << std::endl;
+}
+
+double
+WorkUnitStatistics::GetTime()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::vector<double>
+WorkUnitStatistics::GetBusyTimes() const
+{
+  std::map<std::thread::id, double> busyTimes;
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    for (const WorkUnit & workUnit : m_WorkUnits)
+    {
+      busyTimes[workUnit.ThreadId] += workUnit.EndTime - workUnit.StartTime;
+    }
+  }
+
+  std::vector<double> times;
+  times.reserve(busyTimes.size());
+  for (const auto & threadBusyTime : busyTimes)
+  {
+    times.push_back(threadBusyTime.second);
+  }
+  return times;
+}
+
+} // end namespace itk
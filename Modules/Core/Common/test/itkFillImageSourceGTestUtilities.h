@@ -0,0 +1,66 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkFillImageSourceGTestUtilities_h
+#define itkFillImageSourceGTestUtilities_h
+
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageSource.h"
+
+namespace itk
+{
+// Source of GoogleTest unit tests of the multi-threaded execution: fills its
+// 64x64x16 output with ones, one work unit per piece of the region.
+// Note: This class is only for internal (testing) purposes.
+// It is not part of the public API of ITK.
+class FillImageSource : public ImageSource<Image<float, 3>>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FillImageSource);
+
+  using Self = FillImageSource;
+  using Superclass = ImageSource<Image<float, 3>>;
+  using Pointer = SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(FillImageSource);
+
+  static constexpr SizeValueType NumberOfPixels = 64 * 64 * 16;
+
+protected:
+  FillImageSource() = default;
+
+  void
+  GenerateOutputInformation() override
+  {
+    this->GetOutput()->SetLargestPossibleRegion(OutputImageRegionType(OutputImageType::SizeType{ { 64, 64, 16 } }));
+  }
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override
+  {
+    for (ImageRegionIterator<OutputImageType> it(this->GetOutput(), outputRegionForThread); !it.IsAtEnd(); ++it)
+    {
+      it.Set(1.0f);
+    }
+  }
+};
+} // namespace itk
+
+#endif
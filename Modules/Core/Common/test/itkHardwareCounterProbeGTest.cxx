@@ -0,0 +1,151 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkHardwareCounterProbesCollectorBase.h"
+#include "itkFillImageSourceGTestUtilities.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+
+namespace
+{
+using CounterEnum = itk::HardwareCounters::CounterEnum;
+} // namespace
+
+
+TEST(HardwareCounterProbe, CollectsOnlyWhileProbing)
+{
+  if (itk::HardwareCounters::GetEnabled())
+  {
+    GTEST_SKIP() << "Collecting is enabled by ITK_HARDWARE_COUNTERS.";
+  }
+  EXPECT_FALSE(itk::HardwareCounters::IsCollecting());
+
+  itk::HardwareCounterProbe probe(CounterEnum::Instructions);
+  EXPECT_EQ(probe.GetCounter(), CounterEnum::Instructions);
+  EXPECT_EQ(probe.GetNameOfProbe(), "Instructions");
+
+  probe.Start();
+  EXPECT_TRUE(itk::HardwareCounters::IsCollecting());
+  {
+    // A copy of a running probe is not running.
+    const itk::HardwareCounterProbe copy(probe);
+  }
+  EXPECT_TRUE(itk::HardwareCounters::IsCollecting());
+  probe.Stop();
+  EXPECT_FALSE(itk::HardwareCounters::IsCollecting());
+
+  itk::HardwareCounters::SetEnabled(true);
+  EXPECT_TRUE(itk::HardwareCounters::IsCollecting());
+  itk::HardwareCounters::SetEnabled(false);
+}
+
+
+TEST(HardwareCounterProbe, CountsWorkItemsOfOtherThreads)
+{
+  const auto source = itk::FillImageSource::New();
+  source->SetNumberOfWorkUnits(4);
+
+  itk::HardwareCounterProbe probe(CounterEnum::Instructions);
+  probe.Start();
+  source->Update();
+  probe.Stop();
+
+  EXPECT_EQ(probe.GetNumberOfIteration(), 1u);
+  if (!probe.IsAvailable())
+  {
+    EXPECT_EQ(probe.GetTotal(), 0);
+    GTEST_SKIP() << "The instructions are not counted on this system.";
+  }
+
+  // Filling the pixels takes at least one instruction per pixel, whichever
+  // threads the work items ran on.
+  EXPECT_GE(probe.GetTotal(), static_cast<itk::OffsetValueType>(itk::FillImageSource::NumberOfPixels));
+}
+
+
+TEST(HardwareCounterProbe, CollectorReportsAllCounters)
+{
+  const auto source = itk::FillImageSource::New();
+
+  itk::HardwareCounterProbesCollectorBase collector;
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    collector.Start("Fill");
+    source->Modified();
+    source->Update();
+    collector.Stop("Fill");
+  }
+  EXPECT_THROW(collector.Stop("Unknown"), itk::ExceptionObject);
+
+  std::ostringstream report;
+  collector.Report(report);
+  std::ostringstream json;
+  collector.JSONReport(json);
+
+  for (const CounterEnum counter : { CounterEnum::Cycles,
+                                     CounterEnum::Instructions,
+                                     CounterEnum::LastLevelCacheMisses,
+                                     CounterEnum::BranchMisses,
+                                     CounterEnum::StalledCycles })
+  {
+    const std::string name = itk::HardwareCounterProbesCollectorBase::GetProbeName("Fill", counter);
+    const auto &      probe = collector.GetProbe(name.c_str());
+    EXPECT_EQ(probe.GetCounter(), counter);
+    EXPECT_EQ(probe.GetNumberOfIteration(), 2u);
+    EXPECT_NE(report.str().find(name), std::string::npos);
+    EXPECT_NE(json.str().find("\"Name\": \"" + name + '"'), std::string::npos);
+  }
+  EXPECT_EQ(itk::HardwareCounterProbesCollectorBase::GetProbeName("Fill", CounterEnum::LastLevelCacheMisses),
+            "Fill (LastLevelCacheMisses)");
+}
+
+
+TEST(HardwareCounterProbe, AttachesCountsToTracedWorkItems)
+{
+  itk::PipelineTracer::ClearEvents();
+  itk::PipelineTracer::SetEnabled(true);
+  itk::HardwareCounters::SetEnabled(true);
+
+  const auto source = itk::FillImageSource::New();
+  source->SetNumberOfWorkUnits(2);
+  source->Update();
+
+  itk::HardwareCounters::SetEnabled(false);
+  itk::PipelineTracer::SetEnabled(false);
+
+  const bool   available = itk::HardwareCounters::IsAvailable(CounterEnum::Cycles);
+  unsigned int numberOfWorkItems = 0;
+  for (const itk::PipelineTracer::Event & event : itk::PipelineTracer::GetEvents())
+  {
+    if (event.Category == "WorkItem")
+    {
+      ++numberOfWorkItems;
+      bool hasCycles = false;
+      for (const auto & argument : event.Arguments)
+      {
+        hasCycles = hasCycles || argument.first == "cycles";
+      }
+      EXPECT_EQ(hasCycles, available);
+    }
+  }
+  EXPECT_GE(numberOfWorkItems, 1u);
+  itk::PipelineTracer::ClearEvents();
+}
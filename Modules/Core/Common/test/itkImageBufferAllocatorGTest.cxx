@@ -0,0 +1,260 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkImageBufferAllocator.h"
+#include "itkImage.h"
+#include "itkImportImageContainer.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+
+namespace
+{
+using AllocationPolicyEnum = itk::ImageBufferAllocator::AllocationPolicyEnum;
+
+bool
+IsAligned(const void * pointer, size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+
+// Restores the global defaults when going out of scope.
+class GlobalDefaultsGuard
+{
+public:
+  ~GlobalDefaultsGuard()
+  {
+    itk::ImageBufferAllocator::SetGlobalDefaultAllocationPolicy(m_AllocationPolicy);
+    itk::ImageBufferAllocator::SetGlobalDefaultParallelFirstTouch(m_ParallelFirstTouch);
+    itk::ImageBufferAllocator::SetBufferPoolEnabled(m_BufferPoolEnabled);
+    itk::ImageBufferAllocator::SetBufferPoolMaximumSize(m_BufferPoolMaximumSize);
+  }
+
+private:
+  AllocationPolicyEnum m_AllocationPolicy{ itk::ImageBufferAllocator::GetGlobalDefaultAllocationPolicy() };
+  bool                 m_ParallelFirstTouch{ itk::ImageBufferAllocator::GetGlobalDefaultParallelFirstTouch() };
+  bool                 m_BufferPoolEnabled{ itk::ImageBufferAllocator::GetBufferPoolEnabled() };
+  size_t               m_BufferPoolMaximumSize{ itk::ImageBufferAllocator::GetBufferPoolMaximumSize() };
+};
+} // namespace
+
+
+TEST(ImageBufferAllocator, AllocatesAlignedBuffers)
+{
+  using ImageType = itk::Image<float, 3>;
+
+  for (const auto policy : { AllocationPolicyEnum::Aligned, AllocationPolicyEnum::HugePages })
+  {
+    for (const bool parallelFirstTouch : { false, true })
+    {
+      const auto image = ImageType::New();
+      image->SetRegions(ImageType::SizeType{ { 131, 67, 33 } });
+      image->GetPixelContainer()->SetAllocationPolicy(policy);
+      image->GetPixelContainer()->SetParallelFirstTouch(parallelFirstTouch);
+      image->AllocateInitialized();
+
+      const float * const buffer = image->GetBufferPointer();
+      EXPECT_TRUE(IsAligned(buffer, itk::ImageBufferAllocator::GetAlignment(policy))) << policy;
+
+      const itk::SizeValueType numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+      EXPECT_TRUE(std::all_of(buffer, buffer + numberOfPixels, [](float pixel) { return pixel == 0.0f; }))
+        << policy << ", parallel first touch " << parallelFirstTouch;
+    }
+  }
+}
+
+
+TEST(ImageBufferAllocator, ParallelFirstTouchZeroFills)
+{
+  // Large enough to be touched by multiple work units.
+  const size_t numberOfBytes = size_t{ 5 } * 1024 * 1024 + 123;
+  void * const buffer = itk::ImageBufferAllocator::Allocate(numberOfBytes, AllocationPolicyEnum::HugePages);
+  ASSERT_NE(buffer, nullptr);
+
+  auto * const bytes = static_cast<unsigned char *>(buffer);
+  std::fill_n(bytes, numberOfBytes, 0xFF);
+  itk::ImageBufferAllocator::ParallelFirstTouch(buffer, numberOfBytes, true);
+  EXPECT_EQ(std::count(bytes, bytes + numberOfBytes, 0), static_cast<std::ptrdiff_t>(numberOfBytes));
+
+  itk::ImageBufferAllocator::Deallocate(buffer, numberOfBytes, AllocationPolicyEnum::HugePages);
+}
+
+
+TEST(ImageBufferAllocator, GlobalDefaultsApplyToNewContainers)
+{
+  const GlobalDefaultsGuard guard;
+  using ImageType = itk::Image<short, 2>;
+
+  itk::ImageBufferAllocator::SetGlobalDefaultAllocationPolicy(AllocationPolicyEnum::Aligned);
+  itk::ImageBufferAllocator::SetGlobalDefaultParallelFirstTouch(true);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetGlobalDefaultAllocationPolicy(), AllocationPolicyEnum::Aligned);
+  EXPECT_TRUE(itk::ImageBufferAllocator::GetGlobalDefaultParallelFirstTouch());
+
+  const auto image = ImageType::New();
+  EXPECT_EQ(image->GetPixelContainer()->GetAllocationPolicy(), AllocationPolicyEnum::Aligned);
+  EXPECT_TRUE(image->GetPixelContainer()->GetParallelFirstTouch());
+
+  // A per image choice survives the replacement of the buffer by Initialize().
+  image->GetPixelContainer()->SetAllocationPolicy(AllocationPolicyEnum::HugePages);
+  image->GetPixelContainer()->ParallelFirstTouchOff();
+  image->Initialize();
+  EXPECT_EQ(image->GetPixelContainer()->GetAllocationPolicy(), AllocationPolicyEnum::HugePages);
+  EXPECT_FALSE(image->GetPixelContainer()->GetParallelFirstTouch());
+}
+
+
+TEST(ImageBufferAllocator, ConstructsAndCopiesNonTrivialElements)
+{
+  using ContainerType = itk::ImportImageContainer<itk::SizeValueType, std::string>;
+
+  const auto container = ContainerType::New();
+  container->SetAllocationPolicy(AllocationPolicyEnum::Aligned);
+  container->ParallelFirstTouchOn();
+  container->Reserve(3, true);
+  EXPECT_TRUE(IsAligned(container->GetBufferPointer(), itk::ImageBufferAllocator::CacheLineAlignment));
+  EXPECT_TRUE((*container)[2].empty());
+
+  for (itk::SizeValueType i = 0; i < 3; ++i)
+  {
+    (*container)[i] = std::string(100, static_cast<char>('a' + i));
+  }
+
+  // Growing copies the elements into a buffer allocated with the new policy.
+  container->SetAllocationPolicy(AllocationPolicyEnum::HugePages);
+  container->Reserve(1000);
+  EXPECT_TRUE(IsAligned(container->GetBufferPointer(), itk::ImageBufferAllocator::HugePageAlignment));
+  EXPECT_EQ((*container)[1], std::string(100, 'b'));
+
+  container->SetAllocationPolicy(AllocationPolicyEnum::New);
+  container->Reserve(3);
+  container->Squeeze();
+  EXPECT_EQ(container->Capacity(), 3u);
+  EXPECT_EQ((*container)[2], std::string(100, 'c'));
+
+  // Memory handed over by the application is released by delete[].
+  container->SetImportPointer(new std::string[5], 5, true);
+  container->Initialize();
+  EXPECT_EQ(container->GetBufferPointer(), nullptr);
+}
+
+
+TEST(ImageBufferAllocator, BucketSizes)
+{
+  EXPECT_EQ(itk::ImageBufferAllocator::GetBufferPoolBucketSize(0), 64u);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetBufferPoolBucketSize(1), 64u);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetBufferPoolBucketSize(65), 128u);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetBufferPoolBucketSize(1024 * 1024), 1024u * 1024u);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetBufferPoolBucketSize(1024 * 1024 + 1), 1280u * 1024u);
+
+  for (size_t numberOfBytes = 1; numberOfBytes < (size_t{ 1 } << 40); numberOfBytes = numberOfBytes * 3 + 1)
+  {
+    const size_t bucketSize = itk::ImageBufferAllocator::GetBufferPoolBucketSize(numberOfBytes);
+    EXPECT_GE(bucketSize, numberOfBytes);
+    EXPECT_LE(bucketSize - numberOfBytes, std::max<size_t>(64, numberOfBytes / 4));
+    EXPECT_EQ(itk::ImageBufferAllocator::GetBufferPoolBucketSize(bucketSize), bucketSize);
+  }
+}
+
+
+TEST(ImageBufferAllocator, BufferPoolRecyclesImageBuffers)
+{
+  const GlobalDefaultsGuard guard;
+  using ImageType = itk::Image<float, 3>;
+  const ImageType::SizeType size{ { 64, 64, 32 } };
+  const size_t              numberOfBytes = 64 * 64 * 32 * sizeof(float);
+
+  itk::ImageBufferAllocator::SetBufferPoolEnabled(true);
+  itk::ImageBufferAllocator::ClearBufferPool();
+  itk::ImageBufferAllocator::ResetBufferPoolStatistics();
+
+  const float * firstBuffer = nullptr;
+  {
+    const auto image = ImageType::New();
+    image->SetRegions(size);
+    image->Allocate();
+    firstBuffer = image->GetBufferPointer();
+
+    // Releasing the data returns the buffer to the pool.
+    image->ReleaseData();
+  }
+  auto statistics = itk::ImageBufferAllocator::GetBufferPoolStatistics();
+  EXPECT_EQ(statistics.Misses, 1u);
+  EXPECT_EQ(statistics.Returns, 1u);
+  EXPECT_EQ(statistics.CachedBuffers, 1u);
+  EXPECT_EQ(statistics.CachedBytes, itk::ImageBufferAllocator::GetBufferPoolBucketSize(numberOfBytes));
+
+  {
+    // A slightly smaller image falls into the same bucket, and gets the same buffer, zero-initialized.
+    const auto image = ImageType::New();
+    image->SetRegions(ImageType::SizeType{ { 64, 63, 32 } });
+    image->AllocateInitialized();
+    EXPECT_EQ(image->GetBufferPointer(), firstBuffer);
+    EXPECT_EQ(image->GetPixel({ { 63, 62, 31 } }), 0.0f);
+  }
+  statistics = itk::ImageBufferAllocator::GetBufferPoolStatistics();
+  EXPECT_EQ(statistics.Hits, 1u);
+  EXPECT_EQ(statistics.Returns, 2u);
+
+  // Buffers which do not fit are freed.
+  itk::ImageBufferAllocator::SetBufferPoolMaximumSize(numberOfBytes / 2);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetBufferPoolStatistics().CachedBytes, 0u);
+  {
+    const auto image = ImageType::New();
+    image->SetRegions(size);
+    image->Allocate();
+  }
+  statistics = itk::ImageBufferAllocator::GetBufferPoolStatistics();
+  EXPECT_EQ(statistics.Evictions, 1u);
+  EXPECT_EQ(statistics.CachedBuffers, 0u);
+  EXPECT_GE(statistics.PeakCachedBytes, numberOfBytes);
+
+  // Disabling the pool empties it.
+  itk::ImageBufferAllocator::SetBufferPoolMaximumSize(numberOfBytes * 4);
+  {
+    const auto image = ImageType::New();
+    image->SetRegions(size);
+    image->Allocate();
+  }
+  EXPECT_EQ(itk::ImageBufferAllocator::GetBufferPoolStatistics().CachedBuffers, 1u);
+  itk::ImageBufferAllocator::SetBufferPoolEnabled(false);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetBufferPoolStatistics().CachedBuffers, 0u);
+}
+
+
+TEST(ImageBufferAllocator, BufferPoolKeepsOnlyBucketSizedBuffers)
+{
+  const GlobalDefaultsGuard guard;
+  using ImageType = itk::Image<float, 3>;
+
+  // Allocated while the pool is disabled, with a size which is not that of its bucket.
+  itk::ImageBufferAllocator::SetBufferPoolEnabled(false);
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 64, 63, 32 } });
+  image->Allocate();
+
+  itk::ImageBufferAllocator::SetBufferPoolEnabled(true);
+  itk::ImageBufferAllocator::ResetBufferPoolStatistics();
+  image->ReleaseData();
+
+  const auto statistics = itk::ImageBufferAllocator::GetBufferPoolStatistics();
+  EXPECT_EQ(statistics.Returns, 0u);
+  EXPECT_EQ(statistics.CachedBuffers, 0u);
+}
@@ -0,0 +1,197 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkImageRegionSplitterTiled.h"
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkPlatformMultiThreader.h"
+#include "itkPoolMultiThreader.h"
+#include "itkWorkStealingMultiThreader.h"
+#ifdef ITK_USE_TBB
+#  include "itkTBBMultiThreader.h"
+#endif
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+
+namespace
+{
+using ImageType = itk::Image<unsigned int, 3>;
+using RegionType = ImageType::RegionType;
+
+// Returns an image over the region, counting how often each pixel is covered by a piece.
+ImageType::Pointer
+CountCoverage(const itk::ImageRegionSplitterBase & splitter, const RegionType & region, unsigned int requestedNumber)
+{
+  const auto image = ImageType::New();
+  image->SetRegions(region);
+  image->AllocateInitialized();
+
+  const unsigned int numberOfPieces = splitter.GetNumberOfSplits(region, requestedNumber);
+  for (unsigned int i = 0; i < numberOfPieces; ++i)
+  {
+    RegionType piece = region;
+    EXPECT_EQ(splitter.GetSplit(i, numberOfPieces, piece), numberOfPieces);
+    EXPECT_TRUE(region.IsInside(piece));
+    for (itk::ImageRegionIterator<ImageType> it(image, piece); !it.IsAtEnd(); ++it)
+    {
+      it.Set(it.Get() + 1);
+    }
+  }
+  return image;
+}
+
+void
+ExpectCoveredOnce(const ImageType * image)
+{
+  for (itk::ImageRegionConstIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(it.Get(), 1u) << "pixel " << it.GetIndex();
+  }
+}
+} // namespace
+
+
+TEST(ImageRegionSplitterTiled, PiecesPartitionRegion)
+{
+  const auto splitter = itk::ImageRegionSplitterTiled::New();
+  splitter->SetCacheSizeInBytes(4096);
+  splitter->SetRadius(itk::Size<3>{ { 2, 1, 1 } });
+
+  const RegionType region({ { 3, -2, 1 } }, { { 37, 21, 13 } });
+  for (const unsigned int requestedNumber : { 1u, 2u, 7u, 64u, 100000u })
+  {
+    const unsigned int numberOfPieces = splitter->GetNumberOfSplits(region, requestedNumber);
+    EXPECT_GE(numberOfPieces, 1u);
+    EXPECT_LE(numberOfPieces, requestedNumber);
+    ExpectCoveredOnce(CountCoverage(*splitter, region, requestedNumber));
+  }
+}
+
+
+TEST(ImageRegionSplitterTiled, TilesFitInCache)
+{
+  const auto splitter = itk::ImageRegionSplitterTiled::New();
+  splitter->SetCacheSizeInBytes(32 * 1024);
+  splitter->SetBytesPerPixel(4);
+  const itk::Size<3> radius{ { 3, 2, 1 } };
+  splitter->SetRadius(radius);
+
+  const RegionType   region({ { 0, 0, 0 } }, { { 200, 150, 40 } });
+  const unsigned int numberOfPieces = splitter->GetNumberOfSplits(region, 100000);
+  EXPECT_GT(numberOfPieces, 1u);
+
+  for (unsigned int i = 0; i < numberOfPieces; ++i)
+  {
+    RegionType piece = region;
+    splitter->GetSplit(i, numberOfPieces, piece);
+    RegionType footprint = piece;
+    footprint.PadByRadius(radius);
+    EXPECT_LE(footprint.GetNumberOfPixels() * splitter->GetBytesPerPixel(), splitter->GetCacheSizeInBytes())
+      << "piece " << i << ": " << piece;
+  }
+
+  // Without a radius, a region which fits in the cache is not split.
+  splitter->SetRadius(itk::Size<3>{});
+  EXPECT_EQ(splitter->GetNumberOfSplits(RegionType({ { 0, 0, 0 } }, { { 16, 16, 16 } }), 100), 1u);
+}
+
+
+TEST(ImageRegionSplitterTiled, ConsecutivePiecesAreNeighbors)
+{
+  const auto splitter = itk::ImageRegionSplitterTiled::New();
+  splitter->SetCacheSizeInBytes(8 * 8 * 8);
+  splitter->SetBytesPerPixel(1);
+
+  // Rows are kept whole, giving a grid of 1 x 8 x 8 tiles of 32 x 4 x 4 pixels.
+  // Each aligned group of 16 consecutive pieces should form a compact block of
+  // 1 x 4 x 4 tiles, rather than two rows of tiles as in row-major order.
+  const RegionType   region({ { 0, 0, 0 } }, { { 32, 32, 32 } });
+  const unsigned int numberOfPieces = splitter->GetNumberOfSplits(region, 100000);
+  ASSERT_EQ(numberOfPieces, 64u);
+
+  for (unsigned int first = 0; first < numberOfPieces; first += 16)
+  {
+    RegionType block;
+    for (unsigned int i = first; i < first + 16; ++i)
+    {
+      RegionType piece = region;
+      splitter->GetSplit(i, numberOfPieces, piece);
+      EXPECT_EQ(piece.GetSize(), itk::Size<3>({ { 32, 4, 4 } }));
+      if (i == first)
+      {
+        block = piece;
+      }
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        const auto lower = std::min(block.GetIndex(d), piece.GetIndex(d));
+        const auto upper = std::max(block.GetUpperIndex()[d], piece.GetUpperIndex()[d]);
+        block.SetIndex(d, lower);
+        block.SetSize(d, upper - lower + 1);
+      }
+    }
+    EXPECT_EQ(block.GetSize(), itk::Size<3>({ { 32, 16, 16 } })) << "pieces " << first << " to " << first + 15;
+  }
+}
+
+
+TEST(ImageRegionSplitterTiled, DynamicSchedulingCoversRegion)
+{
+  const auto splitter = itk::ImageRegionSplitterTiled::New();
+  splitter->SetCacheSizeInBytes(2048);
+
+  const RegionType region({ { 3, -2, 1 } }, { { 37, 21, 13 } });
+  const unsigned int numberOfPieces = splitter->GetNumberOfSplits(region, 100000);
+
+  // The templated overload of ParallelizeImageRegion is declared by the base class.
+  std::vector<itk::MultiThreaderBase::Pointer> threaders{ itk::PlatformMultiThreader::New().GetPointer(),
+                                                          itk::PoolMultiThreader::New().GetPointer(),
+                                                          itk::WorkStealingMultiThreader::New().GetPointer() };
+#ifdef ITK_USE_TBB
+  threaders.push_back(itk::TBBMultiThreader::New().GetPointer());
+#endif
+
+  for (const auto & threader : threaders)
+  {
+    threader->SetImageRegionSplitter(splitter);
+    threader->DynamicSchedulingOn();
+
+    const auto image = ImageType::New();
+    image->SetRegions(region);
+    image->AllocateInitialized();
+    std::atomic<unsigned int> pieceCount{ 0 };
+
+    threader->ParallelizeImageRegion(
+      region,
+      [&image, &pieceCount](const RegionType & piece) {
+        // Distinct pieces do not overlap, so each pixel is written by one thread only.
+        for (itk::ImageRegionIterator<ImageType> it(image, piece); !it.IsAtEnd(); ++it)
+        {
+          it.Set(it.Get() + 1);
+        }
+        ++pieceCount;
+      },
+      nullptr);
+
+    EXPECT_EQ(pieceCount.load(), numberOfPieces) << threader->GetNameOfClass();
+    ExpectCoveredOnce(image);
+  }
+}
@@ -154,6 +154,7 @@ itkMultiThreaderBaseTest(int argc, char * argv[])
     //            itk::MultiThreaderBaseEnums::Threader::First,
     itk::MultiThreaderBaseEnums::Threader::Pool,
     itk::MultiThreaderBaseEnums::Threader::TBB,
+    itk::MultiThreaderBaseEnums::Threader::WorkStealing,
     //            itk::MultiThreaderBaseEnums::Threader::Last,
     itk::MultiThreaderBaseEnums::Threader::Unknown
   };
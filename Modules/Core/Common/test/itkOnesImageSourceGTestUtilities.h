@@ -0,0 +1,64 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkOnesImageSourceGTestUtilities_h
+#define itkOnesImageSourceGTestUtilities_h
+
+#include "itkImage.h"
+#include "itkImageSource.h"
+
+namespace itk
+{
+// Source of GoogleTest unit tests of the pipeline: fills its 64x64 output,
+// of 16 KiB, with ones, counting its executions.
+// Note: This class is only for internal (testing) purposes.
+// It is not part of the public API of ITK.
+class OnesImageSource : public ImageSource<Image<int, 2>>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(OnesImageSource);
+
+  using Self = OnesImageSource;
+  using Superclass = ImageSource<Image<int, 2>>;
+  using Pointer = SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(OnesImageSource);
+
+  unsigned int m_NumberOfExecutions{ 0 };
+
+protected:
+  OnesImageSource() = default;
+
+  void
+  GenerateOutputInformation() override
+  {
+    this->GetOutput()->SetLargestPossibleRegion(OutputImageRegionType(OutputImageType::SizeType{ { 64, 64 } }));
+  }
+
+  void
+  GenerateData() override
+  {
+    ++m_NumberOfExecutions;
+    this->AllocateOutputs();
+    this->GetOutput()->FillBuffer(1);
+  }
+};
+} // namespace itk
+
+#endif
@@ -0,0 +1,123 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkPipelineTracer.h"
+#include "itkFillImageSourceGTestUtilities.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+
+namespace
+{
+// Disables the tracer, and discards its events, when going out of scope.
+class TracerGuard
+{
+public:
+  TracerGuard() { itk::PipelineTracer::ClearEvents(); }
+  ~TracerGuard()
+  {
+    itk::PipelineTracer::SetEnabled(false);
+    itk::PipelineTracer::ClearEvents();
+  }
+};
+
+itk::SizeValueType
+GetArgument(const itk::PipelineTracer::Event & event, const std::string & key)
+{
+  for (const auto & argument : event.Arguments)
+  {
+    if (argument.first == key)
+    {
+      return argument.second;
+    }
+  }
+  ADD_FAILURE() << "No argument " << key << " in event " << event.Name;
+  return 0;
+}
+} // namespace
+
+
+TEST(PipelineTracer, RecordsNothingWhenDisabled)
+{
+  const TracerGuard guard;
+  itk::PipelineTracer::SetEnabled(false);
+
+  const auto source = itk::FillImageSource::New();
+  source->Update();
+
+  EXPECT_TRUE(itk::PipelineTracer::GetEvents().empty());
+}
+
+
+TEST(PipelineTracer, RecordsUpdateGenerateDataAndWorkItems)
+{
+  const TracerGuard guard;
+  itk::PipelineTracer::SetEnabled(true);
+
+  const auto source = itk::FillImageSource::New();
+  source->SetNumberOfWorkUnits(4);
+  source->Update();
+
+  unsigned int       updateCount = 0;
+  unsigned int       generateDataCount = 0;
+  itk::SizeValueType workItemPixels = 0;
+  for (const itk::PipelineTracer::Event & event : itk::PipelineTracer::GetEvents())
+  {
+    EXPECT_EQ(event.Name, "FillImageSource");
+    EXPECT_GE(event.Duration, 0.0);
+    if (event.Category == "UpdateOutputData")
+    {
+      ++updateCount;
+    }
+    else if (event.Category == "GenerateData")
+    {
+      ++generateDataCount;
+      EXPECT_EQ(GetArgument(event, "requestedPixels"), itk::FillImageSource::NumberOfPixels);
+      EXPECT_GE(GetArgument(event, "allocatedBytes"), itk::FillImageSource::NumberOfPixels * sizeof(float));
+    }
+    else
+    {
+      EXPECT_EQ(event.Category, "WorkItem");
+      workItemPixels += GetArgument(event, "pixels");
+    }
+  }
+  EXPECT_EQ(updateCount, 1u);
+  EXPECT_EQ(generateDataCount, 1u);
+  EXPECT_EQ(workItemPixels, itk::FillImageSource::NumberOfPixels);
+}
+
+
+TEST(PipelineTracer, WritesChromeTrace)
+{
+  const TracerGuard guard;
+  itk::PipelineTracer::SetEnabled(true);
+  {
+    const itk::PipelineTracer::Scope scope("Test", "Quoted \"name\"");
+  }
+  itk::PipelineTracer::SetEnabled(false);
+
+  std::ostringstream trace;
+  itk::PipelineTracer::WriteChromeTrace(trace);
+
+  const std::string json = trace.str();
+  EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+  EXPECT_NE(json.find("\"name\":\"Quoted \\\"name\\\"\",\"cat\":\"Test\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(json.find("\"ph\":\"M\""), std::string::npos);
+}
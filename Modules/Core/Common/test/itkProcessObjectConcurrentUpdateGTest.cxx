@@ -0,0 +1,206 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkProcessObject.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageSource.h"
+#include "itkOnesImageSourceGTestUtilities.h"
+#include "itkImageToImageFilter.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+
+namespace
+{
+using ImageType = itk::Image<int, 2>;
+
+// Fills its two outputs with ones and twos, counting its executions and
+// those which overlapped another one.
+class TwoOutputsImageSource : public itk::ImageSource<ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(TwoOutputsImageSource);
+
+  using Self = TwoOutputsImageSource;
+  using Superclass = itk::ImageSource<ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(TwoOutputsImageSource);
+
+  std::atomic<unsigned int> m_NumberOfExecutions{ 0 };
+  std::atomic<unsigned int> m_NumberOfOverlappingExecutions{ 0 };
+
+protected:
+  TwoOutputsImageSource()
+  {
+    this->SetNumberOfRequiredOutputs(2);
+    this->SetNthOutput(1, this->MakeOutput(1));
+  }
+
+  void
+  GenerateOutputInformation() override
+  {
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      this->GetOutput(i)->SetLargestPossibleRegion(ImageType::RegionType(ImageType::SizeType{ { 64, 64 } }));
+    }
+  }
+
+  void
+  GenerateData() override
+  {
+    if (++m_NumberOfExecutions - m_NumberOfFinishedExecutions > 1)
+    {
+      ++m_NumberOfOverlappingExecutions;
+    }
+    // Leaves time to a concurrent execution to start.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    this->AllocateOutputs();
+    this->GetOutput(0)->FillBuffer(1);
+    this->GetOutput(1)->FillBuffer(2);
+    ++m_NumberOfFinishedExecutions;
+  }
+
+private:
+  std::atomic<unsigned int> m_NumberOfFinishedExecutions{ 0 };
+};
+
+// Adds its inputs, pixel by pixel, recording the thread it ran on.
+class SumImageFilter : public itk::ImageToImageFilter<ImageType, ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SumImageFilter);
+
+  using Self = SumImageFilter;
+  using Superclass = itk::ImageToImageFilter<ImageType, ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(SumImageFilter);
+
+  std::thread::id m_Thread{};
+
+protected:
+  SumImageFilter() = default;
+
+  void
+  GenerateData() override
+  {
+    m_Thread = std::this_thread::get_id();
+    this->AllocateOutputs();
+    ImageType * const output = this->GetOutput();
+    output->FillBuffer(0);
+    for (unsigned int i = 0; i < this->GetNumberOfIndexedInputs(); ++i)
+    {
+      itk::ImageRegionConstIterator<ImageType> in(this->GetInput(i), output->GetRequestedRegion());
+      for (itk::ImageRegionIterator<ImageType> out(output, output->GetRequestedRegion()); !out.IsAtEnd(); ++out, ++in)
+      {
+        out.Set(out.Get() + in.Get());
+      }
+    }
+  }
+};
+
+// source -> branch1 ----> sum
+//        -> branch2 -/
+struct Pipeline
+{
+  Pipeline()
+  {
+    branch1->SetInput(source->GetOutput());
+    branch2->SetInput(source->GetOutput());
+    sum->SetInput(0, branch1->GetOutput());
+    sum->SetInput(1, branch2->GetOutput());
+    sum->ConcurrentInputUpdateOn();
+  }
+
+  const itk::OnesImageSource::Pointer source{ itk::OnesImageSource::New() };
+  const SumImageFilter::Pointer       branch1{ SumImageFilter::New() };
+  const SumImageFilter::Pointer       branch2{ SumImageFilter::New() };
+  const SumImageFilter::Pointer       sum{ SumImageFilter::New() };
+};
+} // namespace
+
+
+TEST(ProcessObject, UpdatesIndependentBranchesConcurrently)
+{
+  Pipeline pipeline;
+  pipeline.sum->Update();
+
+  EXPECT_EQ(pipeline.source->m_NumberOfExecutions, 1u);
+  EXPECT_EQ(pipeline.sum->m_Thread, std::this_thread::get_id());
+  EXPECT_NE(pipeline.branch1->m_Thread, pipeline.branch2->m_Thread);
+  EXPECT_EQ(pipeline.sum->GetOutput()->GetPixel({ { 5, 7 } }), 2);
+
+  // An up to date pipeline is not executed again.
+  pipeline.branch1->m_Thread = {};
+  pipeline.sum->Update();
+  EXPECT_EQ(pipeline.source->m_NumberOfExecutions, 1u);
+  EXPECT_EQ(pipeline.branch1->m_Thread, std::thread::id());
+}
+
+
+TEST(ProcessObject, UpdatesSourceOfSeveralBranchesOnce)
+{
+  // source -output 0-> branch1 ----> sum
+  //        -output 1-> branch2 -/
+  const auto source = TwoOutputsImageSource::New();
+  const auto branch1 = SumImageFilter::New();
+  const auto branch2 = SumImageFilter::New();
+  const auto sum = SumImageFilter::New();
+  branch1->SetInput(source->GetOutput(0));
+  branch2->SetInput(source->GetOutput(1));
+  sum->SetInput(0, branch1->GetOutput());
+  sum->SetInput(1, branch2->GetOutput());
+  sum->ConcurrentInputUpdateOn();
+  sum->Update();
+
+  EXPECT_EQ(source->m_NumberOfExecutions, 1u);
+  EXPECT_EQ(source->m_NumberOfOverlappingExecutions, 0u);
+  EXPECT_NE(branch1->m_Thread, branch2->m_Thread);
+  EXPECT_EQ(sum->GetOutput()->GetPixel({ { 5, 7 } }), 3);
+}
+
+
+TEST(ProcessObject, UpdatesBranchesSeriallyWhenSharedDataIsReleased)
+{
+  Pipeline pipeline;
+  pipeline.source->ReleaseDataFlagOn();
+  pipeline.sum->Update();
+
+  EXPECT_EQ(pipeline.branch1->m_Thread, std::this_thread::get_id());
+  EXPECT_EQ(pipeline.branch2->m_Thread, std::this_thread::get_id());
+  EXPECT_EQ(pipeline.sum->GetOutput()->GetPixel({ { 5, 7 } }), 2);
+}
+
+
+TEST(ProcessObject, UpdateAsync)
+{
+  Pipeline pipeline;
+  std::future<void> update = pipeline.sum->UpdateAsync();
+  update.get();
+
+  EXPECT_EQ(pipeline.source->m_NumberOfExecutions, 1u);
+  EXPECT_EQ(pipeline.sum->GetOutput()->GetPixel({ { 63, 63 } }), 2);
+}
@@ -0,0 +1,192 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkStreamingImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionSplitterMultidimensional.h"
+#include "itkOnesImageSourceGTestUtilities.h"
+#include "itkImageToImageFilter.h"
+#include <gtest/gtest.h>
+
+
+namespace
+{
+using ImageType = itk::Image<int, 2>;
+
+// Adds one to its input, which it requests enlarged by a radius, and
+// declares some additional memory.
+class IncrementImageFilter : public itk::ImageToImageFilter<ImageType, ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(IncrementImageFilter);
+
+  using Self = IncrementImageFilter;
+  using Superclass = itk::ImageToImageFilter<ImageType, ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(IncrementImageFilter);
+
+  ImageType::SizeValueType m_Radius{ 0 };
+  double                   m_AdditionalMemoryPerOutputPixel{ 0.0 };
+
+  double
+  GetAdditionalMemoryPerOutputPixel() const override
+  {
+    return m_AdditionalMemoryPerOutputPixel;
+  }
+
+protected:
+  IncrementImageFilter() = default;
+
+  void
+  GenerateInputRequestedRegion() override
+  {
+    ImageType::RegionType region = this->GetOutput()->GetRequestedRegion();
+    region.PadByRadius(m_Radius);
+    region.Crop(this->GetInput()->GetLargestPossibleRegion());
+    const_cast<ImageType *>(this->GetInput())->SetRequestedRegion(region);
+  }
+
+  void
+  GenerateData() override
+  {
+    this->AllocateOutputs();
+    ImageType * const                        output = this->GetOutput();
+    itk::ImageRegionConstIterator<ImageType> in(this->GetInput(), output->GetRequestedRegion());
+    for (itk::ImageRegionIterator<ImageType> out(output, output->GetRequestedRegion()); !out.IsAtEnd(); ++out, ++in)
+    {
+      out.Set(in.Get() + 1);
+    }
+  }
+};
+
+constexpr itk::SizeValueType imageSize = 64 * 64 * sizeof(int);
+
+// source -> increment -> streamer
+struct Pipeline
+{
+  Pipeline()
+  {
+    increment->SetInput(source->GetOutput());
+    streamer->SetInput(increment->GetOutput());
+    streamer->SetRegionSplitter(itk::ImageRegionSplitterMultidimensional::New());
+  }
+
+  void
+  ExpectOutputIsCorrect() const
+  {
+    const ImageType * const output = streamer->GetOutput();
+    EXPECT_EQ(output->GetBufferedRegion(), output->GetLargestPossibleRegion());
+    for (itk::ImageRegionConstIterator<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      ASSERT_EQ(it.Get(), 2);
+    }
+  }
+
+  const itk::OnesImageSource::Pointer                            source{ itk::OnesImageSource::New() };
+  const IncrementImageFilter::Pointer                            increment{ IncrementImageFilter::New() };
+  const itk::StreamingImageFilter<ImageType, ImageType>::Pointer streamer{
+    itk::StreamingImageFilter<ImageType, ImageType>::New()
+  };
+};
+} // namespace
+
+
+TEST(StreamingImageFilterMemoryBudget, EstimatePipelineMemoryFootprint)
+{
+  Pipeline pipeline;
+  pipeline.increment->m_AdditionalMemoryPerOutputPixel = 2.0;
+  pipeline.increment->Update();
+
+  EXPECT_EQ(pipeline.increment->EstimateMemoryFootprint(), 2 * imageSize + imageSize / 2);
+  EXPECT_EQ(itk::ProcessObject::EstimatePipelineMemoryFootprint(pipeline.increment->GetOutput()),
+            2 * imageSize + imageSize / 2);
+  EXPECT_EQ(itk::ProcessObject::EstimatePipelineMemoryFootprint(pipeline.source->GetOutput()), imageSize);
+}
+
+
+TEST(StreamingImageFilterMemoryBudget, WithoutBudget)
+{
+  Pipeline pipeline;
+  pipeline.streamer->SetNumberOfStreamDivisions(4);
+  pipeline.streamer->Update();
+
+  EXPECT_EQ(pipeline.streamer->GetActualNumberOfStreamDivisions(), 4u);
+  pipeline.ExpectOutputIsCorrect();
+}
+
+
+TEST(StreamingImageFilterMemoryBudget, DividesToFitTheBudget)
+{
+  Pipeline pipeline;
+  // The output of the streamer, and a quarter of the upstream pipeline.
+  pipeline.streamer->SetMemoryBudget(imageSize + 2 * imageSize / 4);
+  pipeline.streamer->Update();
+
+  EXPECT_EQ(pipeline.streamer->GetActualNumberOfStreamDivisions(), 4u);
+  pipeline.ExpectOutputIsCorrect();
+
+  // Everything fits.
+  pipeline.streamer->SetMemoryBudget(3 * imageSize);
+  pipeline.streamer->Update();
+
+  EXPECT_EQ(pipeline.streamer->GetActualNumberOfStreamDivisions(), 1u);
+  pipeline.ExpectOutputIsCorrect();
+}
+
+
+TEST(StreamingImageFilterMemoryBudget, AccountsForEnlargementAndAdditionalMemory)
+{
+  Pipeline pipeline;
+  pipeline.streamer->SetMemoryBudget(imageSize + 2 * imageSize / 4);
+  pipeline.increment->m_Radius = 4;
+  pipeline.increment->m_AdditionalMemoryPerOutputPixel = 4.0;
+  pipeline.increment->Modified();
+  pipeline.streamer->Update();
+
+  EXPECT_GT(pipeline.streamer->GetActualNumberOfStreamDivisions(), 4u);
+  pipeline.ExpectOutputIsCorrect();
+
+  // A piece away from the borders fits in the budget.
+  const unsigned int    numberOfPieces = pipeline.streamer->GetActualNumberOfStreamDivisions();
+  ImageType::RegionType piece = pipeline.streamer->GetOutput()->GetLargestPossibleRegion();
+  pipeline.streamer->GetActualRegionSplitter()->GetSplit(numberOfPieces / 2, numberOfPieces, piece);
+  pipeline.increment->GetOutput()->SetRequestedRegion(piece);
+  pipeline.increment->GetOutput()->PropagateRequestedRegion();
+  EXPECT_LE(itk::ProcessObject::EstimatePipelineMemoryFootprint(pipeline.increment->GetOutput()),
+            pipeline.streamer->GetMemoryBudget() - imageSize);
+}
+
+
+TEST(StreamingImageFilterMemoryBudget, StopsWhenDividingDoesNotHelp)
+{
+  Pipeline pipeline;
+  // Not even a single pixel fits.
+  pipeline.streamer->SetMemoryBudget(imageSize + 1);
+  pipeline.increment->m_Radius = 64;
+  pipeline.increment->Modified();
+  pipeline.streamer->Update();
+
+  // The whole input is needed by any piece, only the output of the
+  // increment filter shrinks.
+  EXPECT_GT(pipeline.streamer->GetActualNumberOfStreamDivisions(), 1u);
+  pipeline.ExpectOutputIsCorrect();
+}
@@ -0,0 +1,108 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkWorkStealingMultiThreader.h"
+#include "itkImage.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+
+TEST(WorkStealingMultiThreader, ParallelizeArrayVisitsEachIndexOnce)
+{
+  const auto threader = itk::WorkStealingMultiThreader::New();
+
+  for (const itk::ThreadIdType workUnits : { 1u, 3u, 64u, 1000u })
+  {
+    threader->SetNumberOfWorkUnits(workUnits);
+    EXPECT_EQ(threader->GetNumberOfWorkUnits(), workUnits);
+
+    std::vector<std::atomic<int>> visits(777);
+    threader->ParallelizeArray(5, visits.size(), [&visits](itk::SizeValueType i) { ++visits[i]; }, nullptr);
+    for (size_t i = 0; i < visits.size(); ++i)
+    {
+      EXPECT_EQ(visits[i].load(), i < 5 ? 0 : 1) << "index " << i << ", work units " << workUnits;
+    }
+  }
+}
+
+
+TEST(WorkStealingMultiThreader, ParallelizeImageRegionCoversRegion)
+{
+  using RegionType = itk::ImageRegion<3>;
+  // The templated overload is declared by the base class.
+  const itk::MultiThreaderBase::Pointer threader = itk::WorkStealingMultiThreader::New();
+
+  const RegionType region({ { 3, -2, 1 } }, { { 17, 11, 29 } });
+  std::atomic<itk::SizeValueType> pixelCount{ 0 };
+  std::atomic<unsigned int>       pieceCount{ 0 };
+
+  threader->ParallelizeImageRegion(
+    region,
+    [&region, &pixelCount, &pieceCount](const RegionType & piece) {
+      EXPECT_TRUE(region.IsInside(piece));
+      pixelCount += piece.GetNumberOfPixels();
+      ++pieceCount;
+    },
+    nullptr);
+
+  EXPECT_EQ(pixelCount.load(), region.GetNumberOfPixels());
+  EXPECT_LE(pieceCount.load(), threader->GetNumberOfWorkUnits());
+}
+
+
+TEST(WorkStealingMultiThreader, NestedParallelismDoesNotDeadlock)
+{
+  const auto outer = itk::WorkStealingMultiThreader::New();
+  const auto inner = itk::WorkStealingMultiThreader::New();
+
+  std::atomic<itk::SizeValueType> sum{ 0 };
+  outer->ParallelizeArray(
+    0,
+    100,
+    [&inner, &sum](itk::SizeValueType) {
+      inner->ParallelizeArray(0, 100, [&sum](itk::SizeValueType j) { sum += j; }, nullptr);
+    },
+    nullptr);
+
+  EXPECT_EQ(sum.load(), itk::SizeValueType{ 100 * (99 * 100 / 2) });
+}
+
+
+TEST(WorkStealingMultiThreader, RethrowsExceptionOfWorkUnit)
+{
+  const auto threader = itk::WorkStealingMultiThreader::New();
+  EXPECT_THROW(threader->ParallelizeArray(
+                 0,
+                 1000,
+                 [](itk::SizeValueType i) {
+                   if (i == 500)
+                   {
+                     throw std::runtime_error("work unit failure");
+                   }
+                 },
+                 nullptr),
+               std::runtime_error);
+
+  // The pool must still be usable afterwards.
+  std::atomic<int> count{ 0 };
+  threader->ParallelizeArray(0, 10, [&count](itk::SizeValueType) { ++count; }, nullptr);
+  EXPECT_EQ(count.load(), 10);
+}
@@ -0,0 +1,107 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkWorkUnitStatistics.h"
+#include "itkFillImageSourceGTestUtilities.h"
+#include "itkMultiThreaderBase.h"
+#include <gtest/gtest.h>
+#include <atomic>
+
+
+TEST(WorkUnitStatistics, SummarizesWorkUnits)
+{
+  itk::WorkUnitStatistics statistics;
+  EXPECT_EQ(statistics.GetNumberOfWorkUnits(), 0u);
+  EXPECT_EQ(statistics.GetWallTime(), 0.0);
+  EXPECT_EQ(statistics.GetIdleFraction(), 0.0);
+
+  // Two threads over a wall time of 4 seconds: one busy for 4, one for 1.
+  std::thread           thread([] {});
+  const std::thread::id other = thread.get_id();
+  thread.join();
+  statistics.AddWorkUnit({ 10.0, 12.0, 100, std::this_thread::get_id() });
+  statistics.AddWorkUnit({ 12.0, 14.0, 100, std::this_thread::get_id() });
+  statistics.AddWorkUnit({ 10.0, 11.0, 50, other });
+
+  EXPECT_EQ(statistics.GetNumberOfWorkUnits(), 3u);
+  EXPECT_EQ(statistics.GetNumberOfThreads(), 2u);
+  EXPECT_EQ(statistics.GetNumberOfItems(), 250u);
+  EXPECT_DOUBLE_EQ(statistics.GetWallTime(), 4.0);
+  EXPECT_DOUBLE_EQ(statistics.GetMaximumBusyTime(), 4.0);
+  EXPECT_DOUBLE_EQ(statistics.GetMeanBusyTime(), 2.5);
+  EXPECT_DOUBLE_EQ(statistics.GetIdleFraction(), 0.375);
+
+  const itk::WorkUnitStatistics copy(statistics);
+  EXPECT_EQ(copy.GetNumberOfWorkUnits(), 3u);
+
+  statistics.Clear();
+  EXPECT_EQ(statistics.GetNumberOfWorkUnits(), 0u);
+  EXPECT_EQ(copy.GetNumberOfWorkUnits(), 3u);
+}
+
+
+TEST(WorkUnitStatistics, RecordsImageRegionWorkUnitsOfFilter)
+{
+  const auto source = itk::FillImageSource::New();
+  source->SetNumberOfWorkUnits(4);
+  EXPECT_FALSE(source->GetRecordWorkUnitStatistics());
+
+  source->Update();
+  EXPECT_EQ(source->GetWorkUnitStatistics().GetNumberOfWorkUnits(), 0u);
+
+  source->RecordWorkUnitStatisticsOn();
+  source->Modified();
+  source->Update();
+
+  const itk::WorkUnitStatistics & statistics = source->GetWorkUnitStatistics();
+  EXPECT_GE(statistics.GetNumberOfWorkUnits(), 1u);
+  EXPECT_GE(statistics.GetNumberOfThreads(), 1u);
+  EXPECT_EQ(statistics.GetNumberOfItems(), source->GetOutput()->GetBufferedRegion().GetNumberOfPixels());
+  EXPECT_GT(statistics.GetWallTime(), 0.0);
+  EXPECT_LE(statistics.GetMaximumBusyTime(), statistics.GetWallTime());
+  EXPECT_LE(statistics.GetMeanBusyTime(), statistics.GetMaximumBusyTime());
+  EXPECT_GE(statistics.GetIdleFraction(), 0.0);
+  EXPECT_LE(statistics.GetIdleFraction(), 1.0);
+
+  // The records are those of the last execution only.
+  source->Modified();
+  source->Update();
+  EXPECT_EQ(source->GetWorkUnitStatistics().GetNumberOfItems(),
+            source->GetOutput()->GetBufferedRegion().GetNumberOfPixels());
+}
+
+
+TEST(WorkUnitStatistics, RecordsArrayWorkUnitsOfFilter)
+{
+  const auto source = itk::FillImageSource::New();
+  source->RecordWorkUnitStatisticsOn();
+
+  const auto                      multiThreader = itk::MultiThreaderBase::New();
+  std::atomic<itk::SizeValueType> count{ 0 };
+  multiThreader->ParallelizeArray(0, 1000, [&count](itk::SizeValueType) { ++count; }, source);
+
+  EXPECT_EQ(count, 1000u);
+  EXPECT_GE(source->GetWorkUnitStatistics().GetNumberOfWorkUnits(), 1u);
+  EXPECT_EQ(source->GetWorkUnitStatistics().GetNumberOfItems(), 1000u);
+
+  // Once the filter stops recording, its records are left unchanged.
+  source->RecordWorkUnitStatisticsOff();
+  multiThreader->ParallelizeArray(0, 1000, [&count](itk::SizeValueType) { ++count; }, source);
+  EXPECT_EQ(source->GetWorkUnitStatistics().GetNumberOfItems(), 1000u);
+}
@@ -22,6 +22,7 @@
 #include "itkFixedArray.h"
 #include "itkNeighborhoodIterator.h"
 #include "itkNeighborhood.h"
+#include "itkImageRegionSplitterTiled.h"
 
 namespace itk
 {
@@ -199,6 +200,11 @@ protected:
   void
   GenerateInputRequestedRegion() override;
 
+  /** Override to return a splitter that divides the output into tiles
+   * whose input neighborhood fits in cache. */
+  const ImageRegionSplitterBase *
+  GetImageRegionSplitter() const override;
+
 private:
   /** The standard deviation of the gaussian blurring kernel in the image
       range. Units are intensity. */
@@ -226,6 +232,8 @@ private:
   double              m_DynamicRange{};
   double              m_DynamicRangeUsed{};
   std::vector<double> m_RangeGaussianTable{};
+
+  ImageRegionSplitterTiled::Pointer m_ImageRegionSplitter{};
 };
 } // end namespace itk
 
@@ -43,7 +43,9 @@ BilateralImageFilter<TInputImage, TOutputImage>::BilateralImageFilter()
   this->m_DomainMu = 2.5; // keep small to keep kernels small
   this->m_RangeMu = 4.0;  // can be bigger then DomainMu since we only
                           // index into a single table
+  this->m_ImageRegionSplitter = ImageRegionSplitterTiled::New();
   this->DynamicMultiThreadingOn();
+  this->DynamicSchedulingOn();
   this->ThreaderUpdateProgressOff();
 }
 
@@ -118,6 +120,13 @@ BilateralImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
   throw e;
 }
 
+template <typename TInputImage, typename TOutputImage>
+const ImageRegionSplitterBase *
+BilateralImageFilter<TInputImage, TOutputImage>::GetImageRegionSplitter() const
+{
+  return this->m_ImageRegionSplitter.GetPointer();
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 BilateralImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
@@ -178,6 +187,10 @@ BilateralImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
   // copy this small Gaussian image into a neighborhood
   m_GaussianKernel.SetRadius(radius);
 
+  // tile the output so that each tile and its kernel halo fit in cache
+  m_ImageRegionSplitter->SetRadius(radius);
+  m_ImageRegionSplitter->SetBytesPerPixel(sizeof(InputPixelType) + sizeof(OutputPixelType));
+
   KernelIteratorType                     kernel_it;
   ImageRegionIterator<GaussianImageType> git(gaussianImage->GetOutput(),
                                              gaussianImage->GetOutput()->GetBufferedRegion());
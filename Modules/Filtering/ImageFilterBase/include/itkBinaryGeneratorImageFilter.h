@@ -39,6 +39,8 @@ namespace itk
  * - C++11 lambda functions, with closures
  * - C++ std::function
  * - C-style function pointers
+ * - Functor::PixelwiseChain, fusing a chain of such operations into a
+ *   single pass without intermediate images
  *
  * The constant must be of the same type as the pixel type of the corresponding
  * image. It is wrapped in a SimpleDataObjectDecorator so it can be updated through
@@ -19,6 +19,7 @@
 #define itkBinaryGeneratorImageFilter_hxx
 
 #include "itkImageScanlineIterator.h"
+#include "itkSIMDPixelKernel.h"
 #include "itkTotalProgressReporter.h"
 
 
@@ -188,6 +189,16 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
   if (inputPtr1 && inputPtr2)
   {
+    if constexpr (SIMDPixelKernel::CanTransformImages<TFunctor, TOutputImage, TInputImage1, TInputImage2>)
+    {
+      if (SIMDPixelKernel::IsEnabled() &&
+          SIMDPixelKernel::TransformImages(functor, outputRegionForThread, outputPtr, inputPtr1, inputPtr2))
+      {
+        progress.Completed(outputRegionForThread.GetNumberOfPixels());
+        return;
+      }
+    }
+
     ImageScanlineConstIterator inputIt1(inputPtr1, outputRegionForThread);
     ImageScanlineConstIterator inputIt2(inputPtr2, outputRegionForThread);
     ImageScanlineIterator      outputIt(outputPtr, outputRegionForThread);
@@ -215,6 +226,19 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
     const Input2ImagePixelType & input2Value = this->GetConstant2();
 
+    const auto functorOfInput1 = [&functor, input2Value](const Input1ImagePixelType & input1Value) {
+      return functor(input1Value, input2Value);
+    };
+    if constexpr (SIMDPixelKernel::CanTransformImages<decltype(functorOfInput1), TOutputImage, TInputImage1>)
+    {
+      if (SIMDPixelKernel::IsEnabled() &&
+          SIMDPixelKernel::TransformImages(functorOfInput1, outputRegionForThread, outputPtr, inputPtr1))
+      {
+        progress.Completed(outputRegionForThread.GetNumberOfPixels());
+        return;
+      }
+    }
+
     while (!inputIt1.IsAtEnd())
     {
       while (!inputIt1.IsAtEndOfLine())
@@ -235,6 +259,19 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
     const Input1ImagePixelType & input1Value = this->GetConstant1();
 
+    const auto functorOfInput2 = [&functor, input1Value](const Input2ImagePixelType & input2Value) {
+      return functor(input1Value, input2Value);
+    };
+    if constexpr (SIMDPixelKernel::CanTransformImages<decltype(functorOfInput2), TOutputImage, TInputImage2>)
+    {
+      if (SIMDPixelKernel::IsEnabled() &&
+          SIMDPixelKernel::TransformImages(functorOfInput2, outputRegionForThread, outputPtr, inputPtr2))
+      {
+        progress.Completed(outputRegionForThread.GetNumberOfPixels());
+        return;
+      }
+    }
+
     while (!inputIt2.IsAtEnd())
     {
       while (!inputIt2.IsAtEndOfLine())
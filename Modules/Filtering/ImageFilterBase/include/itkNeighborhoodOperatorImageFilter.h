@@ -22,6 +22,7 @@
 #include "itkNeighborhoodOperator.h"
 #include "itkImage.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
+#include "itkImageRegionSplitterTiled.h"
 
 namespace itk
 {
@@ -105,6 +106,7 @@ public:
   SetOperator(const OutputNeighborhoodType & p)
   {
     m_Operator = p;
+    m_ImageRegionSplitter->SetRadius(m_Operator.GetRadius());
     this->Modified();
   }
 
@@ -153,7 +155,10 @@ protected:
   NeighborhoodOperatorImageFilter()
   {
     m_BoundsCondition = static_cast<ImageBoundaryConditionPointerType>(&m_DefaultBoundaryCondition);
+    m_ImageRegionSplitter = ImageRegionSplitterTiled::New();
+    m_ImageRegionSplitter->SetBytesPerPixel(sizeof(InputPixelType) + sizeof(OutputPixelType));
     this->DynamicMultiThreadingOn();
+    this->DynamicSchedulingOn();
     this->ThreaderUpdateProgressOff();
   }
   ~NeighborhoodOperatorImageFilter() override = default;
@@ -172,6 +177,13 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  /** Override to return a splitter that divides the output into tiles
+   * whose input neighborhood, given by the operator radius, fits in cache. */
+  const ImageRegionSplitterBase *
+  GetImageRegionSplitter() const override
+  {
+    return m_ImageRegionSplitter.GetPointer();
+  }
 
   void
   PrintSelf(std::ostream & os, Indent indent) const override
@@ -189,6 +201,9 @@ private:
 
   /** Default boundary condition */
   DefaultBoundaryCondition m_DefaultBoundaryCondition{};
+
+  /** Splitter dividing the output into cache-sized tiles. */
+  ImageRegionSplitterTiled::Pointer m_ImageRegionSplitter{};
 };
 } // end namespace itk
 
@@ -0,0 +1,177 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPixelwiseFunctorChain_h
+#define itkPixelwiseFunctorChain_h
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+namespace itk
+{
+namespace Functor
+{
+/** \class ChainInputStage
+ * \brief Marks a stage of a PixelwiseChain which reads an additional input.
+ *
+ * The wrapped functor is called with the value computed by the previous
+ * stages and the pixel of the next additional input. Use ChainInput() to
+ * create it.
+ *
+ * \sa PixelwiseChain
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TFunctor>
+class ChainInputStage
+{
+public:
+  explicit ChainInputStage(const TFunctor & functor)
+    : m_Functor(functor)
+  {}
+
+  template <typename TValue, typename TInput>
+  auto
+  operator()(const TValue & value, const TInput & input) const
+  {
+    return m_Functor(value, input);
+  }
+
+private:
+  TFunctor m_Functor;
+};
+
+/** Wraps a binary functor, such as Functor::Add2 or Functor::MaskInput, to
+ * be used as a stage of a PixelwiseChain which reads an additional input. */
+template <typename TFunctor>
+ChainInputStage<TFunctor>
+ChainInput(const TFunctor & functor)
+{
+  return ChainInputStage<TFunctor>(functor);
+}
+
+/** Whether a stage of a PixelwiseChain reads an additional input. */
+template <typename TStage>
+struct IsChainInputStage : std::false_type
+{};
+template <typename TFunctor>
+struct IsChainInputStage<ChainInputStage<TFunctor>> : std::true_type
+{};
+
+/** \class PixelwiseChain
+ * \brief Fuses a chain of pixel-wise operations into a single functor.
+ *
+ * Pipelines such as Cast, ShiftScale, Clamp, Mask and Add are commonly
+ * built from one pixel-wise filter per operation. Each filter makes a full
+ * pass over memory and allocates a full intermediate image, although the
+ * operations themselves are cheap, so the chain is bound by memory
+ * bandwidth. PixelwiseChain composes the operations instead, so that a
+ * single UnaryGeneratorImageFilter, BinaryGeneratorImageFilter or
+ * TernaryGeneratorImageFilter evaluates the whole chain in one
+ * multi-threaded pass, without intermediate images.
+ *
+ * The stages are applied in order to the pixel of the first input. A plain
+ * stage is a unary functor, lambda or function taking the current value.
+ * A stage wrapped by ChainInput() is a binary functor, taking the current
+ * value and the pixel of the next additional input: the first such stage
+ * reads the second input of the filter, the second one its third input.
+ * Each stage may change the type of the value, the type returned by the
+ * last stage must be convertible to the output pixel type.
+ *
+ * \code
+ * Functor::Clamp<float> clamp;
+ * clamp.SetBounds(0.0f, 1.0f);
+ * const auto chain = Functor::MakePixelwiseChain(
+ *   [](short value) { return static_cast<float>(value); },
+ *   [](float value) { return (value + 1024.0f) / 4096.0f; },
+ *   clamp,
+ *   Functor::ChainInput(Functor::MaskInput<float, unsigned char>()),
+ *   Functor::ChainInput(Functor::Add2<float, float, float>()));
+ *
+ * auto filter = TernaryGeneratorImageFilter<ShortImageType, MaskImageType, FloatImageType, FloatImageType>::New();
+ * filter->SetInput1(image);
+ * filter->SetInput2(mask);
+ * filter->SetInput3(offset);
+ * filter->SetFunctor(chain);
+ * \endcode
+ *
+ * The functors of the stages are copied into the chain, so later changes
+ * to the originals have no effect. Like any functor given to the generator
+ * filters, the stages must be safe to call concurrently.
+ *
+ * \sa UnaryGeneratorImageFilter BinaryGeneratorImageFilter TernaryGeneratorImageFilter
+ * \ingroup ITKImageFilterBase
+ */
+template <typename... TStages>
+class PixelwiseChain
+{
+public:
+  /** Number of inputs of the chain: the first input, and one per stage
+   * created by ChainInput(). */
+  static constexpr unsigned int NumberOfInputs =
+    (1 + ... + static_cast<unsigned int>(IsChainInputStage<TStages>::value));
+
+  explicit PixelwiseChain(const TStages &... stages)
+    : m_Stages(stages...)
+  {}
+
+  template <typename TValue, typename... TInputs>
+  auto
+  operator()(const TValue & value, const TInputs &... inputs) const
+  {
+    static_assert(sizeof...(TInputs) + 1 == NumberOfInputs,
+                  "The number of pixels must match the number of inputs of the chain.");
+    return this->Apply<0, 0>(value, std::forward_as_tuple(inputs...));
+  }
+
+private:
+  template <std::size_t VStage, std::size_t VInput, typename TValue, typename TInputTuple>
+  auto
+  Apply(const TValue & value, const TInputTuple & inputs) const
+  {
+    if constexpr (VStage == sizeof...(TStages))
+    {
+      return value;
+    }
+    else
+    {
+      const auto & stage = std::get<VStage>(m_Stages);
+      if constexpr (IsChainInputStage<std::tuple_element_t<VStage, std::tuple<TStages...>>>::value)
+      {
+        return this->Apply<VStage + 1, VInput + 1>(stage(value, std::get<VInput>(inputs)), inputs);
+      }
+      else
+      {
+        return this->Apply<VStage + 1, VInput>(stage(value), inputs);
+      }
+    }
+  }
+
+  std::tuple<TStages...> m_Stages;
+};
+
+/** Creates a PixelwiseChain applying the stages in order. */
+template <typename... TStages>
+PixelwiseChain<TStages...>
+MakePixelwiseChain(const TStages &... stages)
+{
+  return PixelwiseChain<TStages...>(stages...);
+}
+} // namespace Functor
+} // namespace itk
+
+#endif
@@ -38,6 +38,8 @@ namespace itk
  * - C++11 lambda functions, with closures
  * - C++ std::function
  * - C-style function pointers
+ * - Functor::PixelwiseChain, fusing a chain of such operations into a
+ *   single pass without intermediate images
  *
  * A constant must be of the same type as the pixel type of the corresponding
  * input image. It is wrapped in a SimpleDataObjectDecorator so it can be updated through
@@ -39,6 +39,8 @@ namespace itk
  * - C++11 lambda functions, with closures
  * - C++ std::function
  * - C-style function pointers
+ * - Functor::PixelwiseChain, fusing a chain of such operations into a
+ *   single pass without intermediate images
  *
  * UnaryGeneratorImageFilter allows the output dimension of the filter
  * to be larger than the input dimension. Thus subclasses of the
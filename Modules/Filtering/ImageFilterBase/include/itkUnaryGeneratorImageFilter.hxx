@@ -20,6 +20,7 @@
 
 #include "itkImageScanlineIterator.h"
 #include "itkProgressReporter.h"
+#include "itkSIMDPixelKernel.h"
 #include "itkTotalProgressReporter.h"
 
 namespace itk
@@ -93,6 +94,17 @@ UnaryGeneratorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDat
 
   this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
 
+  if constexpr (TInputImage::ImageDimension == TOutputImage::ImageDimension &&
+                SIMDPixelKernel::CanTransformImages<TFunctor, TOutputImage, TInputImage>)
+  {
+    if (inputRegionForThread == outputRegionForThread && SIMDPixelKernel::IsEnabled() &&
+        SIMDPixelKernel::TransformImages(functor, outputRegionForThread, outputPtr, inputPtr))
+    {
+      progress.Completed(outputRegionForThread.GetNumberOfPixels());
+      return;
+    }
+  }
+
   // Define the iterators
   ImageScanlineConstIterator inputIt(inputPtr, inputRegionForThread);
   ImageScanlineIterator      outputIt(outputPtr, outputRegionForThread);
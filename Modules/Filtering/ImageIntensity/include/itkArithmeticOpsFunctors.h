@@ -19,6 +19,8 @@
 #define itkArithmeticOpsFunctors_h
 
 #include "itkMath.h"
+#include "itkSIMDPixelKernel.h"
+#include "itkVariableLengthVector.h"
 
 namespace itk
 {
@@ -363,6 +365,36 @@ public:
   }
 };
 } // namespace Functor
+
+/** Add2 and Sub2 of VariableLengthVector pixels add and subtract each
+ * component, so that SIMDPixelKernel can process VectorImage buffers. */
+template <typename TInput1, typename TInput2, typename TOutput>
+struct SIMDPixelComponentFunctor<
+  Functor::Add2<VariableLengthVector<TInput1>, VariableLengthVector<TInput2>, VariableLengthVector<TOutput>>>
+{
+  using Type = Functor::Add2<TInput1, TInput2, TOutput>;
+
+  template <typename TPixelFunctor>
+  static Type
+  Get(const TPixelFunctor &)
+  {
+    return Type();
+  }
+};
+
+template <typename TInput1, typename TInput2, typename TOutput>
+struct SIMDPixelComponentFunctor<
+  Functor::Sub2<VariableLengthVector<TInput1>, VariableLengthVector<TInput2>, VariableLengthVector<TOutput>>>
+{
+  using Type = Functor::Sub2<TInput1, TInput2, TOutput>;
+
+  template <typename TPixelFunctor>
+  static Type
+  Get(const TPixelFunctor &)
+  {
+    return Type();
+  }
+};
 } // namespace itk
 
 #endif
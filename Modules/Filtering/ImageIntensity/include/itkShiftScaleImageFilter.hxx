@@ -20,6 +20,7 @@
 
 #include "itkImageScanlineIterator.h"
 #include "itkNumericTraits.h"
+#include "itkSIMDPixelKernel.h"
 #include "itkTotalProgressReporter.h"
 
 namespace itk
@@ -47,13 +48,69 @@ ShiftScaleImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   SizeValueType underflow = 0;
   SizeValueType overflow = 0;
 
-  ImageScanlineIterator      ot(outputPtr, outputRegion);
-  ImageScanlineConstIterator it(inputPtr, outputRegion);
-
   // support progress methods/callbacks
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if constexpr (SIMDPixelKernel::AreArithmeticImages<TOutputImage, TInputImage>)
+  {
+    if (SIMDPixelKernel::IsEnabled())
+    {
+      const InputImagePixelType * const inputBuffer = inputPtr->GetBufferPointer();
+      OutputImagePixelType * const      outputBuffer = outputPtr->GetBufferPointer();
+      const RealType                    shift = m_Shift;
+      const RealType                    scale = m_Scale;
+
+      SIMDPixelKernel::ForEachContiguousChunk<TOutputImage::ImageDimension, 2>(
+        outputRegion,
+        { { outputPtr, inputPtr } },
+        [&](SizeValueType size, const std::array<OffsetValueType, 2> & offsets) {
+          const InputImagePixelType * const input = inputBuffer + offsets[1];
+          OutputImagePixelType * const      output = outputBuffer + offsets[0];
+          SIMDPixelKernel::Dispatch(
+            [](const InputImagePixelType * in,
+               OutputImagePixelType *      out,
+               SizeValueType               n,
+               RealType                    shiftValue,
+               RealType                    scaleValue,
+               SizeValueType *             underflowCount,
+               SizeValueType *             overflowCount) {
+              constexpr OutputImagePixelType lowest = NumericTraits<OutputImagePixelType>::NonpositiveMin();
+              constexpr OutputImagePixelType highest = NumericTraits<OutputImagePixelType>::max();
+              SizeValueType                  chunkUnderflow = 0;
+              SizeValueType                  chunkOverflow = 0;
+              for (SizeValueType i = 0; i < n; ++i)
+              {
+                const RealType value = (static_cast<RealType>(in[i]) + shiftValue) * scaleValue;
+                chunkUnderflow += value < lowest;
+                chunkOverflow += value > static_cast<RealType>(highest);
+                out[i] = value < lowest                          ? lowest
+                         : value > static_cast<RealType>(highest) ? highest
+                                                                  : static_cast<OutputImagePixelType>(value);
+              }
+              *underflowCount += chunkUnderflow;
+              *overflowCount += chunkOverflow;
+            },
+            input,
+            output,
+            size,
+            shift,
+            scale,
+            &underflow,
+            &overflow);
+        });
+      progress.Completed(outputRegion.GetNumberOfPixels());
+
+      const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+      m_OverflowCount += overflow;
+      m_UnderflowCount += underflow;
+      return;
+    }
+  }
+
+  ImageScanlineIterator      ot(outputPtr, outputRegion);
+  ImageScanlineConstIterator it(inputPtr, outputRegion);
+
   // do the work
   while (!it.IsAtEnd())
   {
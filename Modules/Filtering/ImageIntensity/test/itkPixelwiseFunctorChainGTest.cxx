@@ -0,0 +1,148 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkPixelwiseFunctorChain.h"
+#include "itkAddImageFilter.h"
+#include "itkArithmeticOpsFunctors.h"
+#include "itkCastImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMaskImageFilter.h"
+#include "itkShiftScaleImageFilter.h"
+#include "itkTernaryGeneratorImageFilter.h"
+#include "itkUnaryGeneratorImageFilter.h"
+#include <gtest/gtest.h>
+
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(unsigned int seed)
+{
+  const auto image = TImage::New();
+  image->SetRegions(typename TImage::SizeType{ { 37, 23, 11 } });
+  image->Allocate();
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    seed = seed * 1103515245 + 12345;
+    it.Set(static_cast<typename TImage::PixelType>((seed >> 16) % 4000) - 2000);
+  }
+  return image;
+}
+} // namespace
+
+
+TEST(PixelwiseFunctorChain, CountsInputs)
+{
+  const auto negate = [](float value) { return -value; };
+  const auto add = itk::Functor::ChainInput(itk::Functor::Add2<float, float, float>());
+
+  EXPECT_EQ(decltype(itk::Functor::MakePixelwiseChain(negate))::NumberOfInputs, 1u);
+  EXPECT_EQ(decltype(itk::Functor::MakePixelwiseChain(negate, add, negate))::NumberOfInputs, 2u);
+  EXPECT_EQ(decltype(itk::Functor::MakePixelwiseChain(add, negate, add))::NumberOfInputs, 3u);
+
+  const auto chain = itk::Functor::MakePixelwiseChain(negate, add, negate, add);
+  EXPECT_EQ(chain(1.0f, 10.0f, 100.0f), 91.0f);
+}
+
+
+TEST(PixelwiseFunctorChain, MatchesPipelineOfFilters)
+{
+  using ShortImageType = itk::Image<short, 3>;
+  using MaskImageType = itk::Image<unsigned char, 3>;
+  using FloatImageType = itk::Image<float, 3>;
+
+  const auto image = MakeImage<ShortImageType>(1);
+  const auto offset = MakeImage<FloatImageType>(2);
+  const auto mask = MaskImageType::New();
+  mask->SetRegions(image->GetLargestPossibleRegion());
+  mask->Allocate();
+  unsigned char maskValue = 0;
+  for (itk::ImageRegionIterator<MaskImageType> it(mask, mask->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(maskValue++ % 3 == 0);
+  }
+
+  constexpr float shift = 100.0f;
+  constexpr float scale = 0.5f;
+
+  // One filter per operation.
+  const auto cast = itk::CastImageFilter<ShortImageType, FloatImageType>::New();
+  cast->SetInput(image);
+  const auto shiftScale = itk::ShiftScaleImageFilter<FloatImageType, FloatImageType>::New();
+  shiftScale->SetInput(cast->GetOutput());
+  shiftScale->SetShift(shift);
+  shiftScale->SetScale(scale);
+  const auto clamp = itk::ClampImageFilter<FloatImageType, FloatImageType>::New();
+  clamp->SetInput(shiftScale->GetOutput());
+  clamp->SetBounds(-250.0f, 400.0f);
+  const auto maskFilter = itk::MaskImageFilter<FloatImageType, MaskImageType, FloatImageType>::New();
+  maskFilter->SetInput(clamp->GetOutput());
+  maskFilter->SetMaskImage(mask);
+  const auto add = itk::AddImageFilter<FloatImageType, FloatImageType, FloatImageType>::New();
+  add->SetInput1(maskFilter->GetOutput());
+  add->SetInput2(offset);
+  add->Update();
+
+  // The same operations, fused in a single pass.
+  itk::Functor::Clamp<float> clampFunctor;
+  clampFunctor.SetBounds(-250.0f, 400.0f);
+  const auto chain = itk::Functor::MakePixelwiseChain(
+    [](short value) { return static_cast<float>(value); },
+    [](float value) { return (value + shift) * scale; },
+    clampFunctor,
+    itk::Functor::ChainInput(itk::Functor::MaskInput<float, unsigned char>()),
+    itk::Functor::ChainInput(itk::Functor::Add2<float, float, float>()));
+  const auto fused =
+    itk::TernaryGeneratorImageFilter<ShortImageType, MaskImageType, FloatImageType, FloatImageType>::New();
+  fused->SetInput1(image);
+  fused->SetInput2(mask);
+  fused->SetInput3(offset);
+  fused->SetFunctor(chain);
+  fused->Update();
+
+  itk::ImageRegionConstIterator<FloatImageType> expectedIt(add->GetOutput(), image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<FloatImageType> fusedIt(fused->GetOutput(), image->GetLargestPossibleRegion());
+  for (; !expectedIt.IsAtEnd(); ++expectedIt, ++fusedIt)
+  {
+    ASSERT_FLOAT_EQ(fusedIt.Get(), expectedIt.Get()) << "at " << expectedIt.GetIndex();
+  }
+}
+
+
+TEST(PixelwiseFunctorChain, WorksWithUnaryGeneratorImageFilter)
+{
+  using ImageType = itk::Image<float, 3>;
+
+  const auto image = MakeImage<ImageType>(3);
+  const auto filter = itk::UnaryGeneratorImageFilter<ImageType, ImageType>::New();
+  filter->SetInput(image);
+  filter->SetFunctor(itk::Functor::MakePixelwiseChain([](float value) { return value * 2.0f; },
+                                                      [](float value) { return value + 1.0f; }));
+  filter->Update();
+
+  itk::ImageRegionConstIterator<ImageType> inputIt(image, image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> outputIt(filter->GetOutput(), image->GetLargestPossibleRegion());
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++outputIt)
+  {
+    ASSERT_EQ(outputIt.Get(), inputIt.Get() * 2.0f + 1.0f);
+  }
+}
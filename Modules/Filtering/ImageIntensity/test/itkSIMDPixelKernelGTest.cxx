@@ -0,0 +1,232 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkSIMDPixelKernel.h"
+#include "itkAddImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMultiplyImageFilter.h"
+#include "itkShiftScaleImageFilter.h"
+#include "itkSubtractImageFilter.h"
+#include "itkVectorImage.h"
+#include <gtest/gtest.h>
+
+
+namespace
+{
+using InstructionSetEnum = itk::SIMDPixelKernel::InstructionSetEnum;
+
+constexpr InstructionSetEnum instructionSets[] = { InstructionSetEnum::Baseline,
+                                                   InstructionSetEnum::SSE4,
+                                                   InstructionSetEnum::AVX2,
+                                                   InstructionSetEnum::AVX512 };
+
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(unsigned int seed, const typename TImage::SizeType & size, unsigned int numberOfComponents = 1)
+{
+  const auto image = TImage::New();
+  image->SetRegions(size);
+  image->SetNumberOfComponentsPerPixel(numberOfComponents);
+  image->Allocate();
+  using ValueType = typename TImage::InternalPixelType;
+  ValueType * const   buffer = image->GetBufferPointer();
+  const itk::SizeValueType numberOfValues = image->GetPixelContainer()->Size();
+  for (itk::SizeValueType i = 0; i < numberOfValues; ++i)
+  {
+    seed = seed * 1103515245 + 12345;
+    buffer[i] = static_cast<ValueType>(static_cast<int>((seed >> 16) % 4000) - 2000) / ValueType{ 8 };
+  }
+  return image;
+}
+
+template <typename TImage>
+std::vector<typename TImage::InternalPixelType>
+GetValues(const TImage * image, const typename TImage::RegionType & region)
+{
+  std::vector<typename TImage::InternalPixelType> values;
+  for (itk::ImageRegionConstIterator<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const typename TImage::PixelType pixel = it.Get();
+    for (unsigned int k = 0; k < image->GetNumberOfComponentsPerPixel(); ++k)
+    {
+      values.push_back(itk::DefaultConvertPixelTraits<typename TImage::PixelType>::GetNthComponent(k, pixel));
+    }
+  }
+  return values;
+}
+
+// Updates the requested region of the output of the filter with the
+// kernels disabled, then with each supported instruction set, expecting
+// the same values.
+template <typename TFilter>
+void
+ExpectSameOutputWithAndWithoutKernels(TFilter * filter, const typename TFilter::OutputImageRegionType & region)
+{
+  filter->GetOutput()->SetRequestedRegion(region);
+  itk::SIMDPixelKernel::SetEnabled(false);
+  filter->Modified();
+  filter->Update();
+  const auto expected = GetValues(filter->GetOutput(), region);
+
+  itk::SIMDPixelKernel::SetEnabled(true);
+  for (const InstructionSetEnum instructionSet : instructionSets)
+  {
+    if (instructionSet > itk::SIMDPixelKernel::GetSupportedInstructionSet())
+    {
+      break;
+    }
+    itk::SIMDPixelKernel::SetMaximumInstructionSet(instructionSet);
+    EXPECT_EQ(itk::SIMDPixelKernel::GetInstructionSet(), instructionSet);
+    filter->Modified();
+    filter->Update();
+    EXPECT_EQ(GetValues(filter->GetOutput(), region), expected) << instructionSet;
+  }
+  itk::SIMDPixelKernel::SetMaximumInstructionSet(InstructionSetEnum::AVX512);
+}
+
+using ImageType = itk::Image<float, 3>;
+using ShortImageType = itk::Image<short, 3>;
+using UnsignedCharImageType = itk::Image<unsigned char, 3>;
+
+const ImageType::SizeType   imageSize{ { 37, 23, 11 } };
+const ImageType::RegionType wholeRegion(imageSize);
+// Not contiguous in the buffers of the inputs.
+const ImageType::RegionType innerRegion({ { 3, 2, 1 } }, { { 29, 17, 9 } });
+} // namespace
+
+
+TEST(SIMDPixelKernel, ForEachContiguousChunk)
+{
+  const auto image = MakeImage<ImageType>(1, imageSize);
+
+  std::vector<itk::SizeValueType> sizes;
+  itk::SIMDPixelKernel::ForEachContiguousChunk<3, 1>(
+    wholeRegion, { { image } }, [&sizes](itk::SizeValueType size, const std::array<itk::OffsetValueType, 1> & offsets) {
+      EXPECT_EQ(offsets[0], 0);
+      sizes.push_back(size);
+    });
+  EXPECT_EQ(sizes, std::vector<itk::SizeValueType>{ wholeRegion.GetNumberOfPixels() });
+
+  // Whole rows of the buffer are contiguous across the second dimension.
+  const ImageType::RegionType slabs({ { 0, 0, 4 } }, { { 37, 23, 2 } });
+  itk::OffsetValueType        expectedOffset = image->ComputeOffset(slabs.GetIndex());
+  sizes.clear();
+  itk::SIMDPixelKernel::ForEachContiguousChunk<3, 1>(
+    slabs, { { image } }, [&](itk::SizeValueType size, const std::array<itk::OffsetValueType, 1> & offsets) {
+      EXPECT_EQ(offsets[0], expectedOffset);
+      expectedOffset += size;
+      sizes.push_back(size);
+    });
+  EXPECT_EQ(sizes, std::vector<itk::SizeValueType>{ slabs.GetNumberOfPixels() });
+
+  itk::SizeValueType numberOfPixels = 0;
+  sizes.clear();
+  itk::SIMDPixelKernel::ForEachContiguousChunk<3, 1>(
+    innerRegion, { { image } }, [&](itk::SizeValueType size, const std::array<itk::OffsetValueType, 1> & offsets) {
+      EXPECT_TRUE(innerRegion.IsInside(image->ComputeIndex(offsets[0])));
+      EXPECT_EQ(size, innerRegion.GetSize(0));
+      numberOfPixels += size;
+    });
+  EXPECT_EQ(numberOfPixels, innerRegion.GetNumberOfPixels());
+}
+
+
+TEST(SIMDPixelKernel, AddImageFilter)
+{
+  using FilterType = itk::AddImageFilter<ShortImageType, ShortImageType, ImageType>;
+  const auto filter = FilterType::New();
+  filter->SetInput1(MakeImage<ShortImageType>(1, imageSize));
+  filter->SetInput2(MakeImage<ShortImageType>(2, imageSize));
+
+  ExpectSameOutputWithAndWithoutKernels(filter.GetPointer(), wholeRegion);
+  ExpectSameOutputWithAndWithoutKernels(filter.GetPointer(), innerRegion);
+
+  filter->SetConstant2(3);
+  ExpectSameOutputWithAndWithoutKernels(filter.GetPointer(), innerRegion);
+}
+
+
+TEST(SIMDPixelKernel, SubtractAndMultiplyImageFilters)
+{
+  const auto subtract = itk::SubtractImageFilter<ImageType>::New();
+  subtract->SetConstant1(10.5f);
+  subtract->SetInput2(MakeImage<ImageType>(1, imageSize));
+  subtract->InPlaceOff();
+  ExpectSameOutputWithAndWithoutKernels(subtract.GetPointer(), wholeRegion);
+
+  const auto multiply = itk::MultiplyImageFilter<ImageType>::New();
+  multiply->SetInput1(MakeImage<ImageType>(2, imageSize));
+  multiply->SetInput2(MakeImage<ImageType>(3, imageSize));
+  multiply->InPlaceOff();
+  ExpectSameOutputWithAndWithoutKernels(multiply.GetPointer(), innerRegion);
+}
+
+
+TEST(SIMDPixelKernel, ClampCastAndShiftScaleImageFilters)
+{
+  const auto input = MakeImage<ImageType>(1, imageSize);
+
+  const auto clamp = itk::ClampImageFilter<ImageType, ShortImageType>::New();
+  clamp->SetInput(input);
+  clamp->SetBounds(-100, 100);
+  ExpectSameOutputWithAndWithoutKernels(clamp.GetPointer(), innerRegion);
+
+  const auto cast = itk::CastImageFilter<ImageType, ShortImageType>::New();
+  cast->SetInput(input);
+  ExpectSameOutputWithAndWithoutKernels(cast.GetPointer(), wholeRegion);
+
+  const auto shiftScale = itk::ShiftScaleImageFilter<ImageType, UnsignedCharImageType>::New();
+  shiftScale->SetInput(input);
+  shiftScale->SetShift(100.0);
+  shiftScale->SetScale(2.0);
+  ExpectSameOutputWithAndWithoutKernels(shiftScale.GetPointer(), innerRegion);
+
+  const itk::SizeValueType underflowCount = shiftScale->GetUnderflowCount();
+  const itk::SizeValueType overflowCount = shiftScale->GetOverflowCount();
+  EXPECT_GT(underflowCount, 0u);
+  EXPECT_GT(overflowCount, 0u);
+  itk::SIMDPixelKernel::SetEnabled(false);
+  shiftScale->Modified();
+  shiftScale->Update();
+  itk::SIMDPixelKernel::SetEnabled(true);
+  EXPECT_EQ(shiftScale->GetUnderflowCount(), underflowCount);
+  EXPECT_EQ(shiftScale->GetOverflowCount(), overflowCount);
+}
+
+
+TEST(SIMDPixelKernel, VectorImage)
+{
+  using VectorImageType = itk::VectorImage<float, 3>;
+  using FilterType = itk::AddImageFilter<VectorImageType>;
+  static_assert(itk::SIMDPixelKernel::CanTransformImages<FilterType::FunctorType,
+                                                         VectorImageType,
+                                                         VectorImageType,
+                                                         VectorImageType>);
+
+  const auto filter = FilterType::New();
+  filter->SetInput1(MakeImage<VectorImageType>(1, imageSize, 3));
+  filter->SetInput2(MakeImage<VectorImageType>(2, imageSize, 3));
+  filter->InPlaceOff();
+  ExpectSameOutputWithAndWithoutKernels(filter.GetPointer(), innerRegion);
+}
+
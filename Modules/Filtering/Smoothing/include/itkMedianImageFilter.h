@@ -20,6 +20,7 @@
 
 #include "itkBoxImageFilter.h"
 #include "itkImage.h"
+#include "itkImageRegionSplitterTiled.h"
 
 namespace itk
 {
@@ -104,6 +105,18 @@ protected:
    *     ImageToImageFilter::GenerateData() */
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  /** Configure the tiled splitter for the current radius. */
+  void
+  BeforeThreadedGenerateData() override;
+
+  /** Override to return a splitter that divides the output into tiles
+   * whose input neighborhood fits in cache. */
+  const ImageRegionSplitterBase *
+  GetImageRegionSplitter() const override;
+
+private:
+  ImageRegionSplitterTiled::Pointer m_ImageRegionSplitter{};
 };
 } // end namespace itk
 
@@ -35,10 +35,29 @@ namespace itk
 template <typename TInputImage, typename TOutputImage>
 MedianImageFilter<TInputImage, TOutputImage>::MedianImageFilter()
 {
+  this->m_ImageRegionSplitter = ImageRegionSplitterTiled::New();
   this->DynamicMultiThreadingOn();
+  this->DynamicSchedulingOn();
   this->ThreaderUpdateProgressOff();
 }
 
+template <typename TInputImage, typename TOutputImage>
+const ImageRegionSplitterBase *
+MedianImageFilter<TInputImage, TOutputImage>::GetImageRegionSplitter() const
+{
+  return this->m_ImageRegionSplitter.GetPointer();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+MedianImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
+{
+  Superclass::BeforeThreadedGenerateData();
+
+  this->m_ImageRegionSplitter->SetRadius(this->GetRadius());
+  this->m_ImageRegionSplitter->SetBytesPerPixel(sizeof(InputPixelType) + sizeof(OutputPixelType));
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
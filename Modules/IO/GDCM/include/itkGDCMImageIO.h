@@ -124,6 +124,13 @@ public:
   bool
   CanReadFile(const char *) override;
 
+  /** Several clones may read different files at the same time. */
+  bool
+  CanReadConcurrently() override
+  {
+    return true;
+  }
+
   /** Read the spacing and dimension information for the current filename. */
   void
   ReadImageInformation() override;
@@ -234,6 +241,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copies the settings of this ImageIO to a new one of the same class. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   InternalReadImageInformation();
 
@@ -24,12 +24,6 @@
 #include <vector>
 #include "ITKIOGDCMExport.h"
 
-// forward declaration, to remove compile dependency on GDCM library
-namespace gdcm
-{
-class SerieHelper;
-}
-
 namespace itk
 {
 /**
@@ -51,6 +45,12 @@ namespace itk
  *    DICOM objects, you may want to try calling SetUseSeriesDetails(true)
  *    prior to calling SetDirectory().
  *
+ * The headers of the files are parsed in parallel, by up to
+ * NumberOfWorkUnits threads. When an IndexFileName is set, the DICOM
+ * attributes used to group and sort the files are kept in that file,
+ * keyed by file path, modification time and size, so that only the files
+ * which changed since are parsed again when the directory is next scanned.
+ *
  * \ingroup IOFilters
  *
  * \ingroup ITKIOGDCM
@@ -185,6 +185,15 @@ public:
   itkGetConstMacro(LoadPrivateTags, bool);
   itkBooleanMacro(LoadPrivateTags);
 
+  /** Set/Get the name of the file which indexes the DICOM attributes of
+   * the scanned files, to group and sort them without parsing their
+   * headers again. The index is created if it does not exist, and updated
+   * with the files which were added or changed. It may be shared by
+   * several directories. Empty, the default, does not use an index.
+   * Must be set before the call to SetInputDirectory(). */
+  itkSetStringMacro(IndexFileName);
+  itkGetStringMacro(IndexFileName);
+
 protected:
   GDCMSeriesFileNames();
   ~GDCMSeriesFileNames() override;
@@ -203,7 +212,13 @@ private:
   FileNamesContainerType m_OutputFileNames{};
 
   /** Internal structure to order series from one directory */
-  std::unique_ptr<gdcm::SerieHelper> m_SerieHelper;
+  class SerieHelper;
+  std::unique_ptr<SerieHelper> m_SerieHelper;
+
+  /** The tags added by AddSeriesRestriction(), which are kept in the index. */
+  std::vector<std::string> m_SeriesRestrictions{};
+
+  std::string m_IndexFileName{};
 
   /** Internal structure to keep the list of series UIDs */
   SeriesUIDContainerType m_SeriesUIDs{};
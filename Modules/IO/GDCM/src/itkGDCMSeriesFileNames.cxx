@@ -20,14 +20,250 @@
 #include "itksys/SystemTools.hxx"
 #include "itkProgressReporter.h"
 #include "itkPrintHelper.h"
+#include "itkMultiThreaderBase.h"
 #include "gdcmSerieHelper.h"
+#include "gdcmDirectory.h"
+#include "gdcmImageReader.h"
+#include "gdcmImplicitDataElement.h"
+#include "gdcmSwapper.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
 
 namespace itk
 {
 
+/** Exposes the addition of an already parsed file to a series. */
+class GDCMSeriesFileNames::SerieHelper : public gdcm::SerieHelper
+{
+public:
+  using gdcm::SerieHelper::AddFile;
+};
+
+namespace
+{
+const char IndexSignature[] = "ITK GDCMSeriesFileNames index 1";
+
+/** The attributes of a file which are needed to group it into a series and
+ * to sort it, encoded in implicit VR little endian. */
+struct IndexEntry
+{
+  int64_t     ModifiedTime{ 0 };
+  uint64_t    FileSize{ 0 };
+  bool        IsImage{ false };
+  std::string Attributes{};
+};
+
+using IndexType = std::map<std::string, IndexEntry>;
+
+/** The tags by which gdcm::SerieHelper identifies and sorts the files of a
+ * series, besides those of the series restrictions. */
+std::set<gdcm::Tag>
+GetIndexedTags(const std::vector<std::string> & seriesRestrictions)
+{
+  std::set<gdcm::Tag> tags{
+    gdcm::Tag(0x0002, 0x0002), // Media Storage SOP Class UID
+    gdcm::Tag(0x0008, 0x0016), // SOP Class UID
+    gdcm::Tag(0x0008, 0x0060), // Modality
+    gdcm::Tag(0x0018, 0x0024), // Sequence Name
+    gdcm::Tag(0x0018, 0x0050), // Slice Thickness
+    gdcm::Tag(0x0020, 0x000e), // Series Instance UID
+    gdcm::Tag(0x0020, 0x0011), // Series Number
+    gdcm::Tag(0x0020, 0x0013), // Instance Number
+    gdcm::Tag(0x0020, 0x0032), // Image Position (Patient)
+    gdcm::Tag(0x0020, 0x0037), // Image Orientation (Patient)
+    gdcm::Tag(0x0028, 0x0010), // Rows
+    gdcm::Tag(0x0028, 0x0011), // Columns
+    gdcm::Tag(0x0054, 0x0022), // Detector Information Sequence
+    gdcm::Tag(0x5200, 0x9229), // Shared Functional Groups Sequence
+    gdcm::Tag(0x5200, 0x9230)  // Per-frame Functional Groups Sequence
+  };
+  for (const std::string & restriction : seriesRestrictions)
+  {
+    gdcm::Tag tag;
+    if (tag.ReadFromPipeSeparatedString(restriction.c_str()))
+    {
+      tags.insert(tag);
+    }
+  }
+  return tags;
+}
+
+std::string
+TagsToString(const std::set<gdcm::Tag> & tags)
+{
+  std::string tagsString;
+  for (const gdcm::Tag & tag : tags)
+  {
+    tagsString += tag.PrintAsPipeSeparatedString() + ' ';
+  }
+  return tagsString;
+}
+
+/** Reads the file as the gdcm::SerieHelper does, keeping only the given
+ * attributes. Returns false if it is not a DICOM image. */
+bool
+ReadIndexedAttributes(const std::string & fileName, const std::set<gdcm::Tag> & tags, std::string & attributes)
+{
+  gdcm::ImageReader reader;
+  reader.SetFileName(fileName.c_str());
+  if (!reader.Read())
+  {
+    return false;
+  }
+  const gdcm::File & file = reader.GetFile();
+  gdcm::DataSet      indexed;
+  for (const gdcm::Tag & tag : tags)
+  {
+    const gdcm::DataSet & dataSet = (tag.GetGroup() == 0x0002 ? file.GetHeader() : file.GetDataSet());
+    if (dataSet.FindDataElement(tag))
+    {
+      indexed.Insert(dataSet.GetDataElement(tag));
+    }
+  }
+  std::ostringstream os;
+  indexed.Write<gdcm::ImplicitDataElement, gdcm::SwapperNoOp>(os);
+  attributes = os.str();
+  return true;
+}
+
+/** A file of which only the indexed attributes are known. */
+gdcm::File
+MakeIndexedFile(const std::string & attributes)
+{
+  gdcm::DataSet      indexed;
+  std::istringstream is(attributes);
+  indexed.Read<gdcm::ImplicitDataElement, gdcm::SwapperNoOp>(is);
+
+  gdcm::FileMetaInformation header;
+  gdcm::DataSet             dataSet;
+  for (const gdcm::DataElement & element : indexed.GetDES())
+  {
+    if (element.GetTag().GetGroup() == 0x0002)
+    {
+      header.Insert(element);
+    }
+    else
+    {
+      dataSet.Insert(element);
+    }
+  }
+  gdcm::File file;
+  file.SetHeader(header);
+  file.SetDataSet(dataSet);
+  return file;
+}
+
+template <typename T>
+void
+WriteIndexValue(std::ostream & os, const T & value)
+{
+  os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void
+WriteIndexString(std::ostream & os, const std::string & value)
+{
+  WriteIndexValue<uint64_t>(os, value.size());
+  os.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+template <typename T>
+bool
+ReadIndexValue(std::istream & is, T & value)
+{
+  return static_cast<bool>(is.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+bool
+ReadIndexString(std::istream & is, std::string & value)
+{
+  uint64_t size = 0;
+  if (!ReadIndexValue(is, size) || size > (uint64_t{ 1 } << 32))
+  {
+    return false;
+  }
+  value.resize(static_cast<size_t>(size));
+  return static_cast<bool>(is.read(&value[0], static_cast<std::streamsize>(size)));
+}
+
+/** Reads the entries of an index written for the same tags. An index
+ * which cannot be read is ignored, to be written anew. */
+IndexType
+ReadIndex(const std::string & indexFileName, const std::string & tags)
+{
+  IndexType     index;
+  std::ifstream is(indexFileName, std::ios::binary);
+  std::string   signature;
+  std::string   indexedTags;
+  uint64_t      numberOfEntries = 0;
+  if (!std::getline(is, signature) || signature != IndexSignature || !std::getline(is, indexedTags) ||
+      indexedTags != tags || !ReadIndexValue(is, numberOfEntries))
+  {
+    return index;
+  }
+  for (uint64_t i = 0; i < numberOfEntries; ++i)
+  {
+    std::string path;
+    IndexEntry  entry;
+    uint8_t     isImage = 0;
+    if (!ReadIndexString(is, path) || !ReadIndexValue(is, entry.ModifiedTime) || !ReadIndexValue(is, entry.FileSize) ||
+        !ReadIndexValue(is, isImage) || !ReadIndexString(is, entry.Attributes))
+    {
+      return IndexType{};
+    }
+    entry.IsImage = (isImage != 0);
+    index.emplace(std::move(path), std::move(entry));
+  }
+  return index;
+}
+
+/** Writes the index next to its destination first, so that an index is
+ * never left partially written. */
+bool
+WriteIndex(const std::string & indexFileName, const std::string & tags, const IndexType & index)
+{
+  const std::string temporaryFileName = indexFileName + ".tmp";
+  {
+    std::ofstream os(temporaryFileName, std::ios::binary | std::ios::trunc);
+    os << IndexSignature << '\n' << tags << '\n';
+    WriteIndexValue<uint64_t>(os, index.size());
+    for (const auto & pathAndEntry : index)
+    {
+      const IndexEntry & entry = pathAndEntry.second;
+      WriteIndexString(os, pathAndEntry.first);
+      WriteIndexValue(os, entry.ModifiedTime);
+      WriteIndexValue(os, entry.FileSize);
+      WriteIndexValue<uint8_t>(os, entry.IsImage);
+      WriteIndexString(os, entry.Attributes);
+    }
+    if (!os.flush())
+    {
+      itksys::SystemTools::RemoveFile(temporaryFileName);
+      return false;
+    }
+  }
+  if (std::rename(temporaryFileName.c_str(), indexFileName.c_str()) != 0)
+  {
+    // Renaming onto an existing file fails on some platforms.
+    itksys::SystemTools::RemoveFile(indexFileName);
+    if (std::rename(temporaryFileName.c_str(), indexFileName.c_str()) != 0)
+    {
+      itksys::SystemTools::RemoveFile(temporaryFileName);
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 
 GDCMSeriesFileNames::GDCMSeriesFileNames()
-  : m_SerieHelper{ new gdcm::SerieHelper() }
+  : m_SerieHelper{ new SerieHelper() }
 {}
 
 GDCMSeriesFileNames::~GDCMSeriesFileNames() = default;
@@ -48,6 +284,7 @@ void
 GDCMSeriesFileNames::AddSeriesRestriction(const std::string & tag)
 {
   m_SerieHelper->AddRestriction(tag);
+  m_SeriesRestrictions.push_back(tag);
 }
 
 void
@@ -72,7 +309,88 @@ GDCMSeriesFileNames::SetInputDirectory(const std::string & name)
   m_SerieHelper->Clear();
   m_SerieHelper->SetUseSeriesDetails(m_UseSeriesDetails);
   m_SerieHelper->SetLoadMode((m_LoadSequences ? 0 : gdcm::LD_NOSEQ) | (m_LoadPrivateTags ? 0 : gdcm::LD_NOSHADOW));
-  m_SerieHelper->SetDirectory(name, m_Recursive);
+
+  gdcm::Directory directory;
+  directory.Load(name, m_Recursive);
+  const gdcm::Directory::FilenamesType & fileNames = directory.GetFilenames();
+  const auto                             numberOfFiles = static_cast<SizeValueType>(fileNames.size());
+
+  const std::set<gdcm::Tag> tags = GetIndexedTags(m_SeriesRestrictions);
+  const std::string         tagsString = TagsToString(tags);
+  IndexType                 index;
+  if (!m_IndexFileName.empty())
+  {
+    index = ReadIndex(m_IndexFileName, tagsString);
+  }
+
+  // Only the files which are not indexed, or which changed since, are
+  // parsed, in parallel, each into an entry of its own.
+  std::vector<std::string> paths(numberOfFiles);
+  std::vector<IndexEntry>  entries(numberOfFiles);
+  std::vector<bool>        isIndexed(numberOfFiles, false);
+  for (SizeValueType i = 0; i < numberOfFiles; ++i)
+  {
+    paths[i] = itksys::SystemTools::CollapseFullPath(fileNames[i]);
+    entries[i].ModifiedTime = itksys::SystemTools::ModifiedTime(fileNames[i]);
+    entries[i].FileSize = itksys::SystemTools::FileLength(fileNames[i]);
+
+    const auto indexed = index.find(paths[i]);
+    if (indexed != index.end() && indexed->second.ModifiedTime == entries[i].ModifiedTime &&
+        indexed->second.FileSize == entries[i].FileSize)
+    {
+      entries[i] = std::move(indexed->second);
+      isIndexed[i] = true;
+    }
+  }
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfFiles,
+    [&](SizeValueType i) {
+      if (!isIndexed[i])
+      {
+        entries[i].IsImage = ReadIndexedAttributes(fileNames[i], tags, entries[i].Attributes);
+      }
+    },
+    nullptr);
+
+  // The files are added in the order of the directory, as the
+  // gdcm::SerieHelper would add them.
+  for (SizeValueType i = 0; i < numberOfFiles; ++i)
+  {
+    if (entries[i].IsImage)
+    {
+      gdcm::File                                   file = MakeIndexedFile(entries[i].Attributes);
+      const gdcm::SmartPointer<gdcm::FileWithName> f = new gdcm::FileWithName(file);
+      f->filename = fileNames[i];
+      m_SerieHelper->AddFile(*f);
+    }
+  }
+
+  if (!m_IndexFileName.empty())
+  {
+    // The entries of files out of this directory are kept, unless these
+    // files no longer exist.
+    IndexType updatedIndex;
+    for (SizeValueType i = 0; i < numberOfFiles; ++i)
+    {
+      updatedIndex[paths[i]] = std::move(entries[i]);
+    }
+    for (auto & pathAndEntry : index)
+    {
+      if (updatedIndex.count(pathAndEntry.first) == 0 && itksys::SystemTools::FileExists(pathAndEntry.first))
+      {
+        updatedIndex.insert(std::move(pathAndEntry));
+      }
+    }
+    if (!WriteIndex(m_IndexFileName, tagsString, updatedIndex))
+    {
+      itkWarningMacro("Could not write the index " << m_IndexFileName);
+    }
+  }
+
   // as a side effect it also execute
   this->Modified();
 }
@@ -273,6 +591,7 @@ GDCMSeriesFileNames::PrintSelf(std::ostream & os, Indent indent) const
   itkPrintSelfBooleanMacro(Recursive);
   itkPrintSelfBooleanMacro(LoadSequences);
   itkPrintSelfBooleanMacro(LoadPrivateTags);
+  os << indent << "IndexFileName: " << m_IndexFileName << std::endl;
 }
 
 void
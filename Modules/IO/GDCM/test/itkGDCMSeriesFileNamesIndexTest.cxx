@@ -0,0 +1,87 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkGDCMSeriesFileNames.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+#include <fstream>
+
+namespace
+{
+using SeriesFileNames = itk::GDCMSeriesFileNames;
+
+/** The series UIDs of the directory, followed by the file names of each
+ * series. */
+std::vector<std::string>
+ListSeries(const std::string & inputDirectory, const std::string & indexFileName)
+{
+  auto filenameGenerator = SeriesFileNames::New();
+  filenameGenerator->SetIndexFileName(indexFileName);
+  filenameGenerator->SetInputDirectory(inputDirectory);
+
+  const std::vector<std::string> seriesUIDs = filenameGenerator->GetSeriesUIDs();
+  std::vector<std::string>       series = seriesUIDs;
+  for (const std::string & uid : seriesUIDs)
+  {
+    const SeriesFileNames::FileNamesContainerType & fileNames = filenameGenerator->GetFileNames(uid);
+    series.insert(series.end(), fileNames.begin(), fileNames.end());
+  }
+  return series;
+}
+} // namespace
+
+int
+itkGDCMSeriesFileNamesIndexTest(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " DicomDirectory indexFile" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string inputDirectory = argv[1];
+  const std::string indexFileName = argv[2];
+
+  auto filenameGenerator = SeriesFileNames::New();
+  ITK_TEST_SET_GET_VALUE(std::string{}, filenameGenerator->GetIndexFileName());
+  filenameGenerator->SetIndexFileName(indexFileName);
+  ITK_TEST_SET_GET_VALUE(indexFileName, filenameGenerator->GetIndexFileName());
+
+  itksys::SystemTools::RemoveFile(indexFileName);
+  const std::vector<std::string> expected = ListSeries(inputDirectory, "");
+  ITK_TEST_EXPECT_TRUE(!expected.empty());
+  ITK_TEST_EXPECT_TRUE(!itksys::SystemTools::FileExists(indexFileName));
+
+  // The index is created, then used.
+  ITK_TEST_EXPECT_TRUE(ListSeries(inputDirectory, indexFileName) == expected);
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(indexFileName));
+  const unsigned long indexFileLength = itksys::SystemTools::FileLength(indexFileName);
+  ITK_TEST_EXPECT_TRUE(ListSeries(inputDirectory, indexFileName) == expected);
+  ITK_TEST_EXPECT_EQUAL(itksys::SystemTools::FileLength(indexFileName), indexFileLength);
+
+  // An index which cannot be read is written anew.
+  {
+    std::ofstream corrupted(indexFileName, std::ios::binary | std::ios::trunc);
+    corrupted << "not an index";
+  }
+  ITK_TEST_EXPECT_TRUE(ListSeries(inputDirectory, indexFileName) == expected);
+  ITK_TEST_EXPECT_EQUAL(itksys::SystemTools::FileLength(indexFileName), indexFileLength);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -80,6 +80,11 @@ namespace itk
  *                             in the MetaDataDictionary
  * re-arrangement.
  *
+ * The VoxelData dataset is stored in chunks, which hold one slice each
+ * by default (see SetChunkSize()), and which are compressed with deflate
+ * when UseCompression is on. Regions of the image are read and written
+ * as hyperslabs of the dataset, so that the image can be streamed, only
+ * the chunks intersecting a region being decoded or encoded.
  *
  */
 
@@ -138,6 +143,31 @@ public:
   void
   Write(const void * buffer) override;
 
+  /** Size of the chunks of the VoxelData dataset, fastest moving dimension
+   * first, not including the pixel components. */
+  using ChunkSizeType = std::vector<SizeValueType>;
+
+  /** Set/Get the size of the chunks of the written VoxelData dataset. Each
+   * entry is clamped to the image size along its dimension. Missing or zero
+   * entries stand for the image size, except along the slowest moving
+   * dimension where they stand for 1, so that by default each chunk holds
+   * one slice. When reading, the chunk size of the file is reported, or an
+   * empty size if the dataset is not chunked. */
+  void
+  SetChunkSize(const ChunkSizeType & chunkSize)
+  {
+    if (m_ChunkSize != chunkSize)
+    {
+      m_ChunkSize = chunkSize;
+      this->Modified();
+    }
+  }
+  const ChunkSizeType &
+  GetChunkSize() const
+  {
+    return m_ChunkSize;
+  }
+
 protected:
   HDF5ImageIO();
   ~HDF5ImageIO() override;
@@ -217,6 +247,7 @@ private:
   std::unique_ptr<H5::H5File>  m_H5File;
   std::unique_ptr<H5::DataSet> m_VoxelDataSet;
   bool                         m_ImageInformationWritten{ false };
+  ChunkSizeType                m_ChunkSize{};
 };
 } // end namespace itk
 
@@ -52,6 +52,12 @@ HDF5ImageIO::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
   // just prints out the pointer value.
   os << indent << "H5File: " << m_H5File.get() << std::endl;
+  os << indent << "ChunkSize:";
+  for (const auto size : m_ChunkSize)
+  {
+    os << ' ' << size;
+  }
+  os << std::endl;
 }
 
 //
@@ -69,6 +75,43 @@ const std::string VoxelType("/VoxelType");
 const std::string VoxelData("/VoxelData");
 const std::string MetaDataName("/MetaData");
 
+// The chunk cache of the VoxelData dataset holds a layer of chunks along the
+// slowest moving dimension, within 256 MiB, so that each chunk is decoded or
+// encoded only once while the image is streamed slice by slice.
+H5::DSetAccPropList
+ChunkCacheAccessList(const H5::DSetCreatPropList & plist, const H5::DataSpace & space, size_t componentSize)
+{
+  const H5::DSetAccPropList dapl;
+  if (plist.getLayout() != H5D_CHUNKED)
+  {
+    return dapl;
+  }
+  const int            rank = space.getSimpleExtentNdims();
+  std::vector<hsize_t> dims(rank);
+  std::vector<hsize_t> chunk(rank);
+  space.getSimpleExtentDims(dims.data());
+  plist.getChunk(rank, chunk.data());
+
+  size_t chunkBytes = componentSize;
+  size_t chunksPerLayer = 1;
+  for (int i = 0; i < rank; ++i)
+  {
+    chunkBytes *= chunk[i];
+    if (i > 0)
+    {
+      chunksPerLayer *= (dims[i] + chunk[i] - 1) / chunk[i];
+    }
+  }
+  constexpr size_t defaultCacheBytes = 1024 * 1024;
+  constexpr size_t maximumCacheBytes = 256 * 1024 * 1024;
+  const size_t     cacheBytes = std::clamp(chunkBytes * chunksPerLayer, defaultCacheBytes, maximumCacheBytes);
+  const size_t     cachedChunks = std::max<size_t>(1, cacheBytes / std::max<size_t>(1, chunkBytes));
+  // About 100 hash slots per cached chunk, as advised by HDF5, and chunks
+  // which were wholly read or written are evicted first.
+  dapl.setChunkCache(100 * cachedChunks + 1, cacheBytes, 1.0);
+  return dapl;
+}
+
 template <typename TScalar>
 H5::PredType
 GetType()
@@ -728,6 +771,25 @@ HDF5ImageIO::ReadImageInformation()
       }
     }
     //
+    // report the chunk size, and reopen the dataset with a chunk cache
+    // fitted to its chunks for the streamed reads
+    {
+      const H5::DSetCreatPropList plist = imageSet.getCreatePlist();
+      m_ChunkSize.clear();
+      if (plist.getLayout() == H5D_CHUNKED)
+      {
+        const int            nDims = imageSpace.getSimpleExtentNdims();
+        std::vector<hsize_t> chunk(nDims);
+        plist.getChunk(nDims, chunk.data());
+        for (int i = 0, j = numDims - 1; i < numDims; ++i, --j)
+        {
+          m_ChunkSize.push_back(chunk[j]);
+        }
+      }
+      *(m_VoxelDataSet) =
+        m_H5File->openDataSet(VoxelDataName, ChunkCacheAccessList(plist, imageSpace, imageVoxelType.getSize()));
+    }
+    //
     // read out metadata
     MetaDataDictionary & metaDict = this->GetMetaDataDictionary();
     // Necessary to clear dict if ImageIO object is re-used
@@ -1072,21 +1134,40 @@ HDF5ImageIO::WriteImageInformation()
     const H5::PredType  dataType = ComponentToPredType(this->GetComponentType());
 
     // set up properties for chunked, compressed writes.
-    // in this case, set the chunk size to be the N-1 dimension
-    // region
+    // by default, the chunk size is the N-1 dimension region
     const H5::DSetCreatPropList plist;
 
-    // we have implicit compression enabled here?
-    plist.setDeflate(this->GetCompressionLevel());
-
-    dims[0] = 1;
+    const int imageDims = this->GetNumberOfDimensions();
+    for (int i(0), j(imageDims - 1); i < imageDims; i++, j--)
+    {
+      const SizeValueType chunkSize = i < static_cast<int>(m_ChunkSize.size()) ? m_ChunkSize[i] : 0;
+      if (chunkSize > 0)
+      {
+        dims[j] = std::min<hsize_t>(dims[j], chunkSize);
+      }
+      else if (j == 0)
+      {
+        dims[j] = 1;
+      }
+    }
     plist.setChunk(numDims, dims.get());
     dims.reset();
 
+    if (this->GetUseCompression())
+    {
+      // shuffling the bytes of the components improves their compression
+      if (dataType.getSize() > 1)
+      {
+        plist.setShuffle();
+      }
+      plist.setDeflate(this->GetCompressionLevel());
+    }
+
     std::string VoxelDataName(ImageGroup);
     VoxelDataName += "/0";
     VoxelDataName += VoxelData;
-    *(m_VoxelDataSet) = m_H5File->createDataSet(VoxelDataName, dataType, imageSpace, plist);
+    *(m_VoxelDataSet) = m_H5File->createDataSet(
+      VoxelDataName, dataType, imageSpace, plist, ChunkCacheAccessList(plist, imageSpace, dataType.getSize()));
     std::string MetaDataGroupName(groupName);
     MetaDataGroupName += MetaDataName;
     m_H5File->createGroup(MetaDataGroupName);
@@ -15,6 +15,7 @@
  *  limitations under the License.
  *
  *=========================================================================*/
+#include "itkHDF5ImageIO.h"
 #include "itkHDF5ImageIOFactory.h"
 #include "itkIOTestHelper.h"
 #include "itkPipelineMonitorImageFilter.h"
@@ -231,6 +232,96 @@ HDF5ReadWriteTest2(const char * fileName)
   return EXIT_SUCCESS;
 }
 
+template <typename TPixel>
+int
+HDF5ChunkedReadWriteTest(const char * fileName)
+{
+  using ImageType = typename itk::Image<TPixel, 3>;
+
+  typename ImageType::SizeType size;
+  size[0] = 10;
+  size[1] = 9;
+  size[2] = 7;
+  const auto imageSource = itk::DemoImageSource<ImageType>::New();
+  imageSource->SetSize(size);
+
+  // Write chunked and compressed image with streaming.
+  const itk::HDF5ImageIO::ChunkSizeType chunkSize{ 4, 3, 2 };
+  auto                                  writerIO = itk::HDF5ImageIO::New();
+  writerIO->SetChunkSize(chunkSize);
+  using WriterType = typename itk::ImageFileWriter<ImageType>;
+  auto writer = WriterType::New();
+  writer->SetFileName(fileName);
+  writer->SetImageIO(writerIO);
+  writer->SetInput(imageSource->GetOutput());
+  writer->SetUseCompression(true);
+  writer->SetNumberOfStreamDivisions(7);
+  try
+  {
+    writer->Write();
+  }
+  catch (const itk::ExceptionObject & err)
+  {
+    std::cout << "itkHDF5ImageIOTest" << std::endl << "Exception Object caught: " << std::endl << err << std::endl;
+    return EXIT_FAILURE;
+  }
+  writer = typename WriterType::Pointer();
+
+  // Read a region of it.
+  typename ImageType::RegionType requestedRegion;
+  requestedRegion.SetIndex(0, 2);
+  requestedRegion.SetIndex(1, 1);
+  requestedRegion.SetIndex(2, 3);
+  requestedRegion.SetSize(0, 5);
+  requestedRegion.SetSize(1, 6);
+  requestedRegion.SetSize(2, 3);
+  auto readerIO = itk::HDF5ImageIO::New();
+  using ReaderType = typename itk::ImageFileReader<ImageType>;
+  auto reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(readerIO);
+  reader->SetUseStreaming(true);
+  try
+  {
+    reader->UpdateOutputInformation();
+    reader->GetOutput()->SetRequestedRegion(requestedRegion);
+    reader->Update();
+  }
+  catch (const itk::ExceptionObject & err)
+  {
+    std::cout << "itkHDF5ImageIOTest" << std::endl << "Exception Object caught: " << std::endl << err << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (readerIO->GetChunkSize() != chunkSize)
+  {
+    std::cout << "Chunk size of the read image doesn't match the written one" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const typename ImageType::Pointer image = reader->GetOutput();
+  if (image->GetBufferedRegion() != requestedRegion)
+  {
+    std::cout << "Read image buffered region: " << image->GetBufferedRegion()
+              << " doesn't match requested one: " << requestedRegion << std::endl;
+    return EXIT_FAILURE;
+  }
+  itk::ImageRegionIterator<ImageType> it(image, requestedRegion);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const typename ImageType::IndexType idx = it.GetIndex();
+    const TPixel                        origValue(idx[2] * 100 + idx[1] * 10 + idx[0]);
+    if (itk::Math::NotAlmostEquals(it.Get(), origValue))
+    {
+      std::cout << "Original Pixel (" << origValue << ") doesn't match read-in Pixel (" << it.Get() << ')' << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  itk::IOTestHelper::Remove(fileName);
+
+  return EXIT_SUCCESS;
+}
+
 int
 itkHDF5ImageIOStreamingReadWriteTest(int argc, char * argv[])
 {
@@ -247,5 +338,7 @@ itkHDF5ImageIOStreamingReadWriteTest(int argc, char * argv[])
   result += HDF5ReadWriteTest2<unsigned char>("StreamingUCharImage.hdf5");
   result += HDF5ReadWriteTest2<float>("StreamingFloatImage.hdf5");
   result += HDF5ReadWriteTest2<itk::RGBPixel<unsigned char>>("StreamingRGBImage.hdf5");
+  result += HDF5ChunkedReadWriteTest<short>("StreamingChunkedShortImage.hdf5");
+  result += HDF5ChunkedReadWriteTest<itk::RGBPixel<unsigned char>>("StreamingChunkedRGBImage.hdf5");
   return result != 0;
 }
@@ -50,10 +50,26 @@ public:
     ITK_FLOAT,
     ITK_DOUBLE
   };
+
+  /**
+   * \ingroup ITKIOImageBase
+   * How the pixel data of a file may be mapped into memory instead of being read
+   */
+  enum class MemoryMapping : uint8_t
+  {
+    /** The pixel data is always read into a buffer allocated by the reader */
+    Off,
+    /** The pixels are shared with the file, writing to them is not allowed */
+    ReadOnly,
+    /** The pixels may be modified, modified pages are private copies */
+    CopyOnWrite
+  };
 };
 // Define how to print enumeration
 extern ITKIOImageBase_EXPORT std::ostream &
                              operator<<(std::ostream & out, const IOCommonEnums::AtomicPixel value);
+extern ITKIOImageBase_EXPORT std::ostream &
+                             operator<<(std::ostream & out, const IOCommonEnums::MemoryMapping value);
 /** \class IOCommon
  * \brief Centralized functionality for IO classes.
  *
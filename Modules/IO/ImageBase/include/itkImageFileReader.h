@@ -22,11 +22,15 @@
 #include "ITKIOImageBaseExport.h"
 
 #include "itkImageIOBase.h"
+#include "itkIOCommon.h"
 #include "itkImageSource.h"
 #include "itkMacro.h"
 #include "itkImageRegion.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkSimpleDataObjectDecorator.h"
+#include <deque>
+#include <future>
+#include <memory>
 
 namespace itk
 {
@@ -118,6 +122,38 @@ public:
   itkGetConstReferenceMacro(UseStreaming, bool);
   itkBooleanMacro(UseStreaming);
 
+  using MemoryMappingEnum = IOCommonEnums::MemoryMapping;
+
+  /** Set/Get whether the pixels may be mapped into memory instead of being
+   * read. When enabled, the ImageIO reports the pixels to be stored raw (see
+   * ImageIOBase::GetRawPixelDataLocation()) at an offset suitably aligned for
+   * the pixel type, and no pixel conversion is needed, the pixel container
+   * of the output is a MemoryMappedImportImageContainer. Reading then takes
+   * no time until the pixels are accessed, and the pages of the file are
+   * shared with the page cache. Otherwise the pixels are read as usual.
+   *
+   * With MemoryMappingEnum::ReadOnly the output must not be modified, e.g.
+   * by a downstream filter running in place; use
+   * MemoryMappingEnum::CopyOnWrite when it may be. Default is
+   * MemoryMappingEnum::Off. */
+  itkSetEnumMacro(MemoryMapping, MemoryMappingEnum);
+  itkGetEnumMacro(MemoryMapping, MemoryMappingEnum);
+
+  /** Set/Get the number of regions read ahead while streaming. When the
+   * output is requested piece by piece (e.g. by StreamingImageFilter or a
+   * streaming ImageFileWriter), the reader predicts the following pieces from
+   * the last two it was asked for, and reads up to this many of them in the
+   * background, each with its own clone of the ImageIO (see
+   * ImageIOBase::Clone()), while the pipeline processes the current one. A
+   * piece that was read ahead is copied into the output instead of being read
+   * again; a mispredicted one is discarded. This bounds the memory held by
+   * the reader to this many pieces. Requires UseStreaming and an ImageIO
+   * that can both stream read and read concurrently (see
+   * ImageIOBase::CanReadConcurrently()); otherwise the pieces are read one
+   * at a time, when requested. Default is 0, no read-ahead. */
+  itkSetMacro(NumberOfRegionsToPrefetch, unsigned int);
+  itkGetConstMacro(NumberOfRegionsToPrefetch, unsigned int);
+
 protected:
   ImageFileReader();
   ~ImageFileReader() override = default;
@@ -153,6 +189,11 @@ protected:
   void
   GenerateData() override;
 
+  /** Map the pixels of the requested region into the output, if possible.
+   * Returns false when the pixels must be read. */
+  bool
+  MapPixelData();
+
   ImageIOBase::Pointer m_ImageIO{};
 
   bool m_UserSpecifiedImageIO{}; // keep track whether the
@@ -160,12 +201,34 @@ protected:
 
   bool m_UseStreaming{};
 
+  MemoryMappingEnum m_MemoryMapping{ MemoryMappingEnum::Off };
+
+  unsigned int m_NumberOfRegionsToPrefetch{ 0 };
+
 private:
+  /** Read m_ActualIORegion into the buffer, from a region read ahead if
+   * there is one, and start reading the following regions. */
+  void
+  ReadActualIORegion(void * buffer);
+
+  /** Start reading the regions predicted to follow m_ActualIORegion, up to
+   * m_NumberOfRegionsToPrefetch of them. */
+  void
+  PrefetchRegions();
+
   std::string m_ExceptionMessage{};
 
   // The region that the ImageIO class will return when we ask to
   // produce the requested region.
   ImageIORegion m_ActualIORegion{};
+
+  // The region read before m_ActualIORegion, from which the stride of
+  // the streamed regions is predicted.
+  ImageIORegion m_PreviousIORegion{};
+
+  // The regions being read ahead, in the order they are expected.
+  using PrefetchedRegionType = std::pair<ImageIORegion, std::future<std::unique_ptr<char[]>>>;
+  std::deque<PrefetchedRegionType> m_PrefetchedRegions{};
 };
 
 
@@ -24,10 +24,13 @@
 #include "itkPixelTraits.h"
 #include "itkVectorImage.h"
 #include "itkMetaDataObject.h"
+#include "itkMemoryMappedImportImageContainer.h"
+#include <algorithm>
 
 #include "itksys/SystemTools.hxx"
 #include "itkMakeUniqueForOverwrite.h"
 #include <fstream>
+#include <type_traits>
 
 namespace itk
 {
@@ -50,6 +53,8 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os,
 
   itkPrintSelfBooleanMacro(UserSpecifiedImageIO);
   itkPrintSelfBooleanMacro(UseStreaming);
+  os << indent << "MemoryMapping: " << m_MemoryMapping << std::endl;
+  os << indent << "NumberOfRegionsToPrefetch: " << m_NumberOfRegionsToPrefetch << std::endl;
 
   os << indent << "ExceptionMessage: " << m_ExceptionMessage << std::endl;
   os << indent << "ActualIORegion: " << m_ActualIORegion << std::endl;
@@ -76,6 +81,11 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateOutputInformation()
 
   itkDebugMacro("Reading file for GenerateOutputInformation()" << this->GetFileName());
 
+  // The regions read ahead may belong to another file, or to an older
+  // version of it; waits for the reads still running.
+  m_PrefetchedRegions.clear();
+  m_PreviousIORegion = ImageIORegion();
+
   // Check to see if we can read the file given the name or prefix
   //
   if (this->GetFileName().empty())
@@ -359,6 +369,12 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
                 << "Allocating the buffer with the EnlargedRequestedRegion \n"
                 << output->GetRequestedRegion() << '\n');
 
+  if (m_MemoryMapping != MemoryMappingEnum::Off && this->MapPixelData())
+  {
+    this->UpdateProgress(1.0f);
+    return;
+  }
+
   // allocated the output image to the size of the enlarge requested region
   this->AllocateOutputs();
 
@@ -403,7 +419,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
                   << m_ImageIO->GetNumberOfComponents());
 
     const auto loadBuffer = make_unique_for_overwrite<char[]>(sizeOfActualIORegion);
-    m_ImageIO->Read(static_cast<void *>(loadBuffer.get()));
+    this->ReadActualIORegion(loadBuffer.get());
 
     // See note below as to why the buffered region is needed and
     // not actualIORegion
@@ -421,7 +437,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
     OutputImagePixelType * outputBuffer = output->GetPixelContainer()->GetBufferPointer();
 
     const auto loadBuffer = make_unique_for_overwrite<char[]>(sizeOfActualIORegion);
-    m_ImageIO->Read(static_cast<void *>(loadBuffer.get()));
+    this->ReadActualIORegion(loadBuffer.get());
 
     // we use std::copy_n here as it should be optimized to memcpy for
     // plain old data, but still is object oriented programming
@@ -434,12 +450,218 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
     itkDebugMacro("No buffer conversion required.");
 
     OutputImagePixelType * outputBuffer = output->GetPixelContainer()->GetBufferPointer();
-    m_ImageIO->Read(outputBuffer);
+    this->ReadActualIORegion(outputBuffer);
   }
 
   this->UpdateProgress(1.0f);
 }
 
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::ReadActualIORegion(void * buffer)
+{
+  // The regions read ahead of the requested one were mispredicted, and are
+  // discarded (waiting for their reads to finish).
+  std::future<std::unique_ptr<char[]>> prefetched;
+  while (!m_PrefetchedRegions.empty() && !prefetched.valid())
+  {
+    if (m_PrefetchedRegions.front().first == m_ActualIORegion)
+    {
+      prefetched = std::move(m_PrefetchedRegions.front().second);
+    }
+    m_PrefetchedRegions.pop_front();
+  }
+
+  // Read the following regions while this one is copied or read.
+  this->PrefetchRegions();
+  m_PreviousIORegion = m_ActualIORegion;
+
+  if (prefetched.valid())
+  {
+    const size_t numberOfBytes =
+      m_ActualIORegion.GetNumberOfPixels() * (m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents());
+    try
+    {
+      const std::unique_ptr<char[]> data = prefetched.get();
+      std::copy_n(data.get(), numberOfBytes, static_cast<char *>(buffer));
+      return;
+    }
+    catch (const std::exception & error)
+    {
+      // Reading ahead failed; read again, so that a genuine error is
+      // reported by the ImageIO of the reader.
+      itkDebugMacro("Reading ahead " << m_ActualIORegion << " failed: " << error.what());
+    }
+  }
+  m_ImageIO->Read(buffer);
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::PrefetchRegions()
+{
+  if (m_NumberOfRegionsToPrefetch == 0 || !m_UseStreaming || !m_ImageIO->CanStreamRead() ||
+      !m_ImageIO->CanReadConcurrently())
+  {
+    return;
+  }
+
+  // The pieces are expected along the slowest dimension that is split.
+  const unsigned int imageDimension = m_ActualIORegion.GetImageDimension();
+  unsigned int       splitDimension = imageDimension;
+  for (unsigned int i = 0; i < imageDimension && i < m_ImageIO->GetNumberOfDimensions(); ++i)
+  {
+    if (m_ActualIORegion.GetSize(i) < m_ImageIO->GetDimensions(i))
+    {
+      splitDimension = i;
+    }
+  }
+  if (splitDimension == imageDimension)
+  {
+    return;
+  }
+  const auto extent = static_cast<IndexValueType>(m_ImageIO->GetDimensions(splitDimension));
+
+  // The stride is the distance between the ends of the last two regions, as
+  // the first and last pieces may be shorter, or else the size of the last.
+  auto       stride = static_cast<IndexValueType>(m_ActualIORegion.GetSize(splitDimension));
+  const auto end = m_ActualIORegion.GetIndex(splitDimension) + stride;
+  if (m_PreviousIORegion.GetImageDimension() == imageDimension)
+  {
+    const auto previousEnd = m_PreviousIORegion.GetIndex(splitDimension) +
+                             static_cast<IndexValueType>(m_PreviousIORegion.GetSize(splitDimension));
+    if (end > previousEnd)
+    {
+      stride = end - previousEnd;
+    }
+  }
+
+  ImageIORegion last = m_PrefetchedRegions.empty() ? m_ActualIORegion : m_PrefetchedRegions.back().first;
+  while (m_PrefetchedRegions.size() < m_NumberOfRegionsToPrefetch)
+  {
+    const IndexValueType index = last.GetIndex(splitDimension) + stride;
+    if (index >= extent)
+    {
+      break;
+    }
+    ImageIORegion next = last;
+    next.SetIndex(splitDimension, index);
+    next.SetSize(splitDimension,
+                 std::min(index + static_cast<IndexValueType>(last.GetSize(splitDimension)), extent) - index);
+    next = m_ImageIO->GenerateStreamableReadRegionFromRequestedRegion(next);
+    if (next.GetIndex(splitDimension) <= last.GetIndex(splitDimension))
+    {
+      break;
+    }
+
+    // The clone is made here, as the ImageIO of the reader is not thread
+    // safe; the header is read again, since the clones do not share the
+    // state of the opened file.
+    const ImageIOBase::Pointer imageIO = m_ImageIO->Clone();
+    const std::string          fileName = this->GetFileName();
+    const size_t               numberOfBytes =
+      next.GetNumberOfPixels() * (m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents());
+    auto read = [imageIO, fileName, next, numberOfBytes] {
+      imageIO->SetFileName(fileName);
+      imageIO->ReadImageInformation();
+      if (next.GetNumberOfPixels() * (imageIO->GetComponentSize() * imageIO->GetNumberOfComponents()) != numberOfBytes)
+      {
+        itkGenericExceptionMacro("The pixel type of " << fileName << " changed while reading ahead.");
+      }
+      imageIO->SetIORegion(next);
+      auto data = make_unique_for_overwrite<char[]>(numberOfBytes);
+      imageIO->Read(data.get());
+      return data;
+    };
+    m_PrefetchedRegions.emplace_back(next, std::async(std::launch::async, std::move(read)));
+    last = next;
+  }
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+bool
+ImageFileReader<TOutputImage, ConvertPixelTraits>::MapPixelData()
+{
+  using PixelContainerType = typename TOutputImage::PixelContainer;
+  using ElementIdentifier = typename PixelContainerType::ElementIdentifier;
+  using MappedPixelContainerType = MemoryMappedImportImageContainer<ElementIdentifier, OutputImagePixelType>;
+
+  // Only the pixel container of Image and VectorImage can be replaced by a mapping.
+  if constexpr (!std::is_same_v<PixelContainerType, ImportImageContainer<ElementIdentifier, OutputImagePixelType>> ||
+                !std::is_trivially_copyable_v<OutputImagePixelType>)
+  {
+    return false;
+  }
+  else
+  {
+    const typename TOutputImage::Pointer output = this->GetOutput();
+    const ImageRegionType                requestedRegion = output->GetRequestedRegion();
+
+    // The pixels must be used as they are stored: no conversion, and no
+    // additional dimensions to drop. The length of the pixels of a
+    // VectorImage is that of the file.
+    const IOComponentEnum ioType = ImageIOBase::MapPixelType<typename ConvertPixelTraits::ComponentType>::CType;
+    if (m_ImageIO->GetComponentType() != ioType ||
+        m_ImageIO->GetNumberOfComponents() != output->GetNumberOfComponentsPerPixel() ||
+        m_ActualIORegion.GetNumberOfPixels() != requestedRegion.GetNumberOfPixels() ||
+        requestedRegion.GetNumberOfPixels() == 0)
+    {
+      return false;
+    }
+
+    std::string           fileName;
+    ImageIOBase::SizeType fileOffset = 0;
+    if (!m_ImageIO->GetRawPixelDataLocation(fileName, fileOffset))
+    {
+      return false;
+    }
+
+    // The region must be a contiguous block of the file: all its dimensions
+    // following the first partial one have a size of one.
+    const SizeValueType pixelSize = m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents();
+    SizeValueType       firstPixel = 0;
+    SizeValueType       stride = 1;
+    bool                partial = false;
+    for (unsigned int i = 0; i < m_ActualIORegion.GetImageDimension(); ++i)
+    {
+      const SizeValueType dimension = i < m_ImageIO->GetNumberOfDimensions() ? m_ImageIO->GetDimensions(i) : 1;
+      if (partial && m_ActualIORegion.GetSize(i) != 1)
+      {
+        return false;
+      }
+      partial = partial || m_ActualIORegion.GetSize(i) != dimension;
+      firstPixel += static_cast<SizeValueType>(m_ActualIORegion.GetIndex(i)) * stride;
+      stride *= dimension;
+    }
+
+    const SizeValueType offset = static_cast<SizeValueType>(fileOffset) + firstPixel * pixelSize;
+    const SizeValueType numberOfBytes = m_ActualIORegion.GetNumberOfPixels() * pixelSize;
+    if (offset % alignof(OutputImagePixelType) != 0 || numberOfBytes % sizeof(OutputImagePixelType) != 0)
+    {
+      return false;
+    }
+
+    const auto mappedFile = MemoryMappedFile::New();
+    try
+    {
+      mappedFile->Map(fileName, offset, numberOfBytes, m_MemoryMapping);
+    }
+    catch (const ExceptionObject & err)
+    {
+      itkDebugMacro("Reading the pixels, as they cannot be mapped: " << err.GetDescription());
+      return false;
+    }
+
+    itkDebugMacro("Mapping " << numberOfBytes << " bytes at offset " << offset << " of " << fileName);
+
+    const auto pixelContainer = MappedPixelContainerType::New();
+    pixelContainer->SetMappedFile(mappedFile);
+    output->SetBufferedRegion(requestedRegion);
+    output->SetPixelContainer(pixelContainer);
+    return true;
+  }
+}
+
 template <typename TOutputImage, typename ConvertPixelTraits>
 void
 ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(const void * inputData, size_t numberOfPixels)
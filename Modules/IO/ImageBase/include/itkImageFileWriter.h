@@ -164,6 +164,27 @@ public:
   itkSetMacro(NumberOfStreamDivisions, unsigned int);
   itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
 
+  /** Set/Get the memory budget, in bytes, of the upstream pipeline. When it
+   * is not 0, the number of pieces is chosen so that the pipeline is
+   * estimated to fit in the budget while generating each piece, see
+   * ProcessObject::EstimatePipelineMemoryFootprint(), and
+   * NumberOfStreamDivisions is ignored. The ImageIO must support streamed
+   * writing for the image to be divided. Defaults to 0. */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstMacro(MemoryBudget, SizeValueType);
+
+  /** Set/Get the number of pieces that may be being written while the
+   * upstream pipeline generates the following ones. When it is not 0 and the
+   * image is written in several pieces, each piece is copied and written in
+   * the background, so that writing, including compression, overlaps the
+   * computation of the next piece. If the ImageIO can write regions
+   * concurrently (see ImageIOBase::CanStreamWriteConcurrently()), the pieces
+   * after the first are written concurrently, each by its own clone of the
+   * ImageIO; otherwise they are written in order. Defaults to 0, each piece
+   * being written before the next one is generated. */
+  itkSetMacro(NumberOfConcurrentWrites, unsigned int);
+  itkGetConstMacro(NumberOfConcurrentWrites, unsigned int);
+
   /** Aliased to the Write() method to be consistent with the rest of the
    * pipeline. */
   void
@@ -223,6 +244,8 @@ private:
 
   ImageIORegion m_PasteIORegion{ TInputImage::ImageDimension };
   unsigned int  m_NumberOfStreamDivisions{ 1 };
+  SizeValueType m_MemoryBudget{ 0 };
+  unsigned int  m_NumberOfConcurrentWrites{ 0 };
   bool          m_UserSpecifiedIORegion{ false };
 
   bool m_FactorySpecifiedImageIO{ false }; // did factory mechanism set the ImageIO?
@@ -32,6 +32,8 @@
 #include "itkMatrix.h"
 #include "itkImageAlgorithm.h"
 #include <complex>
+#include <deque>
+#include <future>
 
 namespace itk
 {
@@ -219,7 +221,7 @@ ImageFileWriter<TInputImage>::Write()
   // Notify start event observers
   this->InvokeEvent(StartEvent());
 
-  if (m_NumberOfStreamDivisions > 1 || m_UserSpecifiedIORegion)
+  if (m_NumberOfStreamDivisions > 1 || m_UserSpecifiedIORegion || m_MemoryBudget > 0)
   {
     m_ImageIO->SetUseStreamedWriting(true);
   }
@@ -251,8 +253,47 @@ ImageFileWriter<TInputImage>::Write()
   unsigned int numDivisions;
 
   // this may fail and throw an exception if the configuration is not supported
-  numDivisions =
-    m_ImageIO->GetActualNumberOfSplitsForWriting(m_NumberOfStreamDivisions, pasteIORegion, largestIORegion);
+  if (m_MemoryBudget > 0)
+  {
+    numDivisions = ProcessObject::ComputeNumberOfStreamDivisions(
+      nonConstInput,
+      m_MemoryBudget,
+      [this, nonConstInput, &pasteIORegion, &largestIORegion, &largestRegion](unsigned int numberOfPieces) {
+        const unsigned int actualNumberOfPieces =
+          m_ImageIO->GetActualNumberOfSplitsForWriting(numberOfPieces, pasteIORegion, largestIORegion);
+        InputImageRegionType streamRegion;
+        ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(
+          m_ImageIO->GetSplitRegionForWriting(
+            actualNumberOfPieces / 2, actualNumberOfPieces, pasteIORegion, largestIORegion),
+          streamRegion,
+          largestRegion.GetIndex());
+        nonConstInput->SetRequestedRegion(streamRegion);
+        return actualNumberOfPieces;
+      });
+  }
+  else
+  {
+    numDivisions =
+      m_ImageIO->GetActualNumberOfSplitsForWriting(m_NumberOfStreamDivisions, pasteIORegion, largestIORegion);
+  }
+
+  // The pieces are computed before any of them is written, as they may be
+  // written in the background.
+  std::vector<ImageIORegion> streamIORegions(numDivisions);
+  for (unsigned int piece = 0; piece < numDivisions; ++piece)
+  {
+    streamIORegions[piece] = m_ImageIO->GetSplitRegionForWriting(piece, numDivisions, pasteIORegion, largestIORegion);
+  }
+
+  // With concurrent writes, each piece is written in the background while the
+  // following ones are generated. The pieces after the first, which writes
+  // the header, are either written concurrently by clones of the ImageIO, or
+  // one after another by the ImageIO itself.
+  const bool pipelined = m_NumberOfConcurrentWrites > 0 && numDivisions > 1;
+  const ImageIOBase::Pointer prototypeIO =
+    pipelined && m_ImageIO->CanStreamWriteConcurrently() ? m_ImageIO->Clone() : nullptr;
+  std::deque<std::shared_future<void>> pendingWrites;
+  std::shared_future<void>             firstWrite;
 
   /**
    * Loop over the number of pieces, execute the upstream pipeline on each
@@ -262,8 +303,7 @@ ImageFileWriter<TInputImage>::Write()
   for (unsigned int piece = 0; piece < numDivisions && !this->GetAbortGenerateData(); ++piece)
   {
     // get the actual piece to write
-    ImageIORegion streamIORegion =
-      m_ImageIO->GetSplitRegionForWriting(piece, numDivisions, pasteIORegion, largestIORegion);
+    ImageIORegion streamIORegion = streamIORegions[piece];
 
     // Check whether the paste region is fully contained inside the
     // largest region or not.
@@ -307,14 +347,63 @@ ImageFileWriter<TInputImage>::Write()
       }
     }
 
-    m_ImageIO->SetIORegion(streamIORegion);
+    if (pipelined)
+    {
+      // The piece is copied, as the upstream pipeline reuses its buffer.
+      if (!input->GetBufferedRegion().IsInside(streamRegion))
+      {
+        itkExceptionMacro("Did not get requested region! Requested: " << streamRegion
+                                                                      << "Actual: " << input->GetBufferedRegion());
+      }
+      const InputImagePointer pieceImage = InputImageType::New();
+      pieceImage->CopyInformation(input);
+      pieceImage->SetBufferedRegion(streamRegion);
+      pieceImage->Allocate();
+      ImageAlgorithm::Copy(input, pieceImage.GetPointer(), streamRegion, streamRegion);
+
+      while (pendingWrites.size() >= m_NumberOfConcurrentWrites)
+      {
+        pendingWrites.front().get();
+        pendingWrites.pop_front();
+      }
 
-    // write the data
-    this->GenerateData();
+      // A piece waits for the first one, or for the previous one when they
+      // are written in order.
+      const bool                     concurrent = prototypeIO && piece > 0;
+      const ImageIOBase::Pointer     imageIO = concurrent ? prototypeIO->Clone() : m_ImageIO;
+      const std::shared_future<void> previous =
+        concurrent ? firstWrite : (pendingWrites.empty() ? std::shared_future<void>() : pendingWrites.back());
+      imageIO->SetFileName(m_FileName);
+      auto write = [imageIO, pieceImage, streamIORegion, previous] {
+        if (previous.valid())
+        {
+          previous.get();
+        }
+        imageIO->SetIORegion(streamIORegion);
+        imageIO->Write(pieceImage->GetBufferPointer());
+      };
+      pendingWrites.push_back(std::async(std::launch::async, std::move(write)).share());
+      if (piece == 0)
+      {
+        firstWrite = pendingWrites.back();
+      }
+    }
+    else
+    {
+      m_ImageIO->SetIORegion(streamIORegion);
+
+      // write the data
+      this->GenerateData();
+    }
 
     this->UpdateProgress(static_cast<float>(piece + 1) / static_cast<float>(numDivisions));
   }
 
+  for (const auto & pendingWrite : pendingWrites)
+  {
+    pendingWrite.get();
+  }
+
   // Notify end event observers
   this->InvokeEvent(EndEvent());
 
@@ -346,7 +435,7 @@ ImageFileWriter<TInputImage>::GenerateData()
   // before this test, bad stuff would happened when they don't match
   if (bufferedRegion != ioRegion)
   {
-    if (m_NumberOfStreamDivisions > 1 || m_UserSpecifiedIORegion)
+    if (m_NumberOfStreamDivisions > 1 || m_UserSpecifiedIORegion || m_MemoryBudget > 0)
     {
       itkDebugMacro("Requested stream region does not match generated output");
       itkDebugMacro("input filter may not support streaming well");
@@ -390,6 +479,8 @@ ImageFileWriter<TInputImage>::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "PasteIORegion: " << m_PasteIORegion << std::endl;
   os << indent << "NumberOfStreamDivisions: " << m_NumberOfStreamDivisions << std::endl;
+  os << indent << "MemoryBudget: " << m_MemoryBudget << std::endl;
+  os << indent << "NumberOfConcurrentWrites: " << m_NumberOfConcurrentWrites << std::endl;
   os << indent << "CompressionLevel: " << m_CompressionLevel << std::endl;
   itkPrintSelfBooleanMacro(UseCompression);
   itkPrintSelfBooleanMacro(UseInputMetaDataDictionary);
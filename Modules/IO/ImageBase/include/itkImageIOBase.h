@@ -88,6 +88,14 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(ImageIOBase);
 
+  /** Create an ImageIO of the same class and with the same settings, such
+   * as compression, streaming, and the image information given for file
+   * formats which do not store it. The file name is not copied. Several
+   * files can then be read concurrently, each by a clone of one ImageIO.
+   * ImageIO classes with settings of their own copy them by overriding
+   * InternalClone(). */
+  itkCloneMacro(Self);
+
   /** Set/Get the name of the file to be read. */
   itkSetStringMacro(FileName);
   itkGetStringMacro(FileName);
@@ -431,6 +439,17 @@ public:
     return false;
   }
 
+  /** Determine if several clones of this ImageIO (see Clone()) may each read
+   * a different file at the same time, i.e. if the library it uses is thread
+   * safe and a clone carries all the settings of this ImageIO. Default is
+   * false.
+   * \sa ImageSeriesReader::SetConcurrentSliceRead() */
+  virtual bool
+  CanReadConcurrently()
+  {
+    return false;
+  }
+
   /** Read the spacing and dimensions of the image.
    * Assumes SetFileName has been called with a valid file name. */
   virtual void
@@ -440,6 +459,20 @@ public:
   virtual void
   Read(void * buffer) = 0;
 
+  /** Determine whether the pixels of the file are stored raw: uncompressed,
+   * in a single contiguous block, in the byte order of this machine, and
+   * exactly as Read() would return them for the largest possible region. If
+   * so, the name of the file holding the pixels and the position of the
+   * first pixel in that file are returned, so that the pixels can be mapped
+   * into memory instead of being read. This is queried after
+   * ReadImageInformation(). Default is false.
+   * \sa ImageFileReader::SetMemoryMapping() */
+  virtual bool
+  GetRawPixelDataLocation(std::string & itkNotUsed(fileName), SizeType & itkNotUsed(offset))
+  {
+    return false;
+  }
+
   /*-------- This part of the interfaces deals with writing data ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -459,6 +492,17 @@ public:
     return false;
   }
 
+  /** Determine if, once the first streamed region of a file has been
+   * written, the other regions may be written concurrently, each by its own
+   * clone of this ImageIO (see Clone()), e.g. because their pixels are
+   * written in place in the file. Default is false.
+   * \sa ImageFileWriter::SetNumberOfConcurrentWrites() */
+  virtual bool
+  CanStreamWriteConcurrently()
+  {
+    return false;
+  }
+
   /** Writes the spacing and dimensions of the image.
    * Assumes SetFileName has been called with a valid file name. */
   virtual void
@@ -683,6 +727,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copies the settings of this ImageIO to a new one of the same class. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   virtual const ImageRegionSplitterBase *
   GetImageRegionSplitter() const;
 
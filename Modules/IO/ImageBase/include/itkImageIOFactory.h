@@ -57,6 +57,13 @@ public:
   static constexpr IOFileModeEnum WriteMode = IOFileModeEnum::WriteMode;
 #endif
   /** Create the appropriate ImageIO depending on the particulars of the file.
+   *
+   * For reading, the ImageIOs supporting the extension of the file, or
+   * recognizing the signature in its first bytes, are asked first whether
+   * they can read it (see ImageIOBase::CanReadFile()), so that only a few of
+   * them usually open the file. Every other ImageIO is asked next. Within
+   * each group, the ImageIOs are asked in the order of the registered
+   * factories.
    */
   static ImageIOBasePointer
   CreateImageIO(const char * path, IOFileModeEnum mode);
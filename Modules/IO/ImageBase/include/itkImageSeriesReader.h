@@ -35,6 +35,15 @@ namespace itk
  * the files, but the image data must have the same Size for all
  * dimensions.
  *
+ * When ConcurrentSliceRead is on, and the ImageIO can read concurrently
+ * (see ImageIOBase::CanReadConcurrently()), the files are read by up to
+ * NumberOfWorkUnits work units of the multi-threader, and no more than the
+ * global default number of threads. Each slice is decoded straight into
+ * its part of the output buffer, and each work unit reads with its own
+ * clone of the ImageIO (see ImageIOBase::Clone()). Without an ImageIO set,
+ * the ImageIO created for the first file is cloned, so all the files must
+ * then have its format. Otherwise the files are read one after another.
+ *
  * \sa GDCMSeriesFileNames
  * \sa NumericSeriesFileNames
  * \ingroup IOFilters
@@ -169,6 +178,11 @@ public:
   itkGetConstReferenceMacro(UseStreaming, bool);
   itkBooleanMacro(UseStreaming);
 
+  /** Set/Get whether the files may be read concurrently. Off by default. */
+  itkSetMacro(ConcurrentSliceRead, bool);
+  itkGetConstMacro(ConcurrentSliceRead, bool);
+  itkBooleanMacro(ConcurrentSliceRead);
+
   /** Set the relative threshold for issuing warnings about non-uniform sampling */
   itkSetMacro(SpacingWarningRelThreshold, double);
   itkGetConstMacro(SpacingWarningRelThreshold, double);
@@ -207,6 +221,8 @@ protected:
 
   bool m_UseStreaming{ true };
 
+  bool m_ConcurrentSliceRead{ false };
+
   bool m_SpacingDefined{ false };
 
   double m_SpacingWarningRelThreshold{ 1e-4 };
@@ -20,12 +20,15 @@
 
 
 #include "itkImageAlgorithm.h"
+#include "itkImageIOFactory.h"
 #include "itkArray.h"
 #include "itkVector.h"
 #include "itkMath.h"
-#include "itkProgressReporter.h"
 #include "itkMetaDataObject.h"
+#include <algorithm>
+#include <atomic>
 #include <cstddef> // For ptrdiff_t.
+#include <exception>
 #include <iomanip>
 
 namespace itk
@@ -39,6 +42,7 @@ ImageSeriesReader<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) con
   os << indent << "ReverseOrder: " << m_ReverseOrder << std::endl;
   os << indent << "ForceOrthogonalDirection: " << m_ForceOrthogonalDirection << std::endl;
   os << indent << "UseStreaming: " << m_UseStreaming << std::endl;
+  itkPrintSelfBooleanMacro(ConcurrentSliceRead);
 
   itkPrintSelfObjectMacro(ImageIO);
 
@@ -254,9 +258,6 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   output->SetBufferedRegion(requestedRegion);
   output->Allocate();
 
-  // progress reported on a per slice basis
-  ProgressReporter progress(this, 0, requestedRegion.GetSize(TOutputImage::ImageDimension - 1), 100);
-
   // We utilize the modified time of the output information to
   // know when the meta array needs to be updated, when the output
   // information is updated so should the meta array.
@@ -266,7 +267,6 @@ ImageSeriesReader<TOutputImage>::GenerateData()
     this->m_OutputInformationMTime > this->m_MetaDataDictionaryArrayMTime && m_MetaDataDictionaryArrayUpdate;
 
   typename TOutputImage::InternalPixelType * outputBuffer = output->GetBufferPointer();
-  IndexType                                  sliceStartIndex = requestedRegion.GetIndex();
   const auto                                 numberOfFiles = static_cast<int>(m_FileNames.size());
 
   typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
@@ -274,7 +274,25 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   double                             maxSpacingDeviation = 0.0;
   bool                               prevSliceIsValid = false;
 
-  m_InternalMetaDataDictionaries.reserve(static_cast<size_t>(numberOfFiles));
+  // The state of each slice, written by the one thread that reads it, so
+  // that the slices may be read concurrently without any locking.
+  struct SliceInformation
+  {
+    int                              SliceIndex{};
+    int                              FileNameIndex{};
+    IndexType                        StartIndex{};
+    bool                             InsideRequestedRegion{};
+    bool                             Read{ false };
+    typename TOutputImage::PointType Origin{};
+    bool                             HasMetaDataDictionary{ false };
+    MetaDataDictionary               Dictionary{};
+    std::exception_ptr               Exception{};
+  };
+
+  std::vector<SliceInformation> slices(static_cast<size_t>(numberOfFiles));
+  std::vector<size_t>           slicesToRead;
+  size_t                        numberOfSlicesInRequestedRegion = 0;
+  IndexType                     sliceStartIndex = requestedRegion.GetIndex();
 
   for (int i = 0; i != numberOfFiles; ++i)
   {
@@ -283,32 +301,40 @@ ImageSeriesReader<TOutputImage>::GenerateData()
       sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
     }
 
-    const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-    const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
-    bool       nonUniformSampling = false;
-    double     spacingDeviation = 0.0;
+    SliceInformation & slice = slices[i];
+    slice.SliceIndex = i;
+    slice.FileNameIndex = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
+    slice.StartIndex = sliceStartIndex;
+    slice.InsideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
+    numberOfSlicesInRequestedRegion += slice.InsideRequestedRegion;
 
     // check if we need this slice
-    if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
+    if (slice.InsideRequestedRegion || needToUpdateMetaDataDictionaryArray)
     {
-      continue;
+      slicesToRead.push_back(static_cast<size_t>(i));
     }
+  }
+
+  // progress reported on a per slice basis
+  const float progressPerSlice =
+    numberOfSlicesInRequestedRegion > 0 ? 1.0f / static_cast<float>(numberOfSlicesInRequestedRegion) : 0.0f;
 
+  const auto readSlice = [&](SliceInformation & slice, ImageIOBase * imageIO) {
     // configure reader
     auto reader = ReaderType::New();
-    reader->SetFileName(m_FileNames[iFileName].c_str());
+    reader->SetFileName(m_FileNames[slice.FileNameIndex].c_str());
 
     TOutputImage * readerOutput = reader->GetOutput();
 
-    if (m_ImageIO)
+    if (imageIO)
     {
-      reader->SetImageIO(m_ImageIO);
+      reader->SetImageIO(imageIO);
     }
     reader->SetUseStreaming(m_UseStreaming);
     readerOutput->SetRequestedRegion(sliceRegionToRequest);
 
     // update the data or info
-    if (!insideRequestedRegion)
+    if (!slice.InsideRequestedRegion)
     {
       reader->UpdateOutputInformation();
     }
@@ -325,7 +351,7 @@ ImageSeriesReader<TOutputImage>::GenerateData()
       if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
       {
         itkExceptionMacro("Size mismatch! The size of  "
-                          << m_FileNames[iFileName].c_str() << " is "
+                          << m_FileNames[slice.FileNameIndex].c_str() << " is "
                           << readerOutput->GetLargestPossibleRegion().GetSize()
                           << " and does not match the required size " << validSize << " from file "
                           << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
@@ -346,9 +372,10 @@ ImageSeriesReader<TOutputImage>::GenerateData()
         const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
 
 
-        const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-                                        ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
-                                        : 0;
+        const ptrdiff_t sliceOffset =
+          (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+            ? (slice.SliceIndex - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
+            : 0;
 
         const ptrdiff_t numberOfPixelComponentsUpToSlice =
           numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
@@ -382,7 +409,7 @@ ImageSeriesReader<TOutputImage>::GenerateData()
 
         // output of buffer copy
         ImageRegionType outRegion = requestedRegion;
-        outRegion.SetIndex(sliceStartIndex);
+        outRegion.SetIndex(slice.StartIndex);
 
         // set the moving dimension to a size of 1
         if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
@@ -393,17 +420,130 @@ ImageSeriesReader<TOutputImage>::GenerateData()
         ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
       }
 
+      slice.Origin = readerOutput->GetOrigin();
+
+      // report progress for read slices
+      this->IncrementProgress(progressPerSlice);
+    } // end !insideRequestedRegion
+
+    // The dictionary is copied on write, so keeping it is cheap.
+    if (reader->GetImageIO())
+    {
+      slice.Dictionary = reader->GetImageIO()->GetMetaDataDictionary();
+      slice.HasMetaDataDictionary = true;
+    }
+    slice.Read = true;
+  };
+
+  std::atomic<size_t> nextSliceToRead{ 0 };
+  const auto          readSlices = [&](ImageIOBase * imageIO) {
+    for (size_t n = nextSliceToRead++; n < slicesToRead.size() && !this->GetAbortGenerateData(); n = nextSliceToRead++)
+    {
+      SliceInformation & slice = slices[slicesToRead[n]];
+      try
+      {
+        readSlice(slice, imageIO);
+      }
+      catch (...)
+      {
+        slice.Exception = std::current_exception();
+      }
+    }
+  };
+
+  // Each slice is read straight into its own part of the output buffer, so
+  // the slices may be distributed over work units, each reading with its own
+  // clone of the ImageIO. At most the global default number of threads read,
+  // the calling thread being one of them, so that a thread of the pool
+  // remains for the parallel loops of the ImageIOs.
+  size_t               numberOfReaders = 1;
+  ImageIOBase::Pointer prototypeIO = m_ImageIO;
+  if (m_ConcurrentSliceRead && slicesToRead.size() > 1)
+  {
+    numberOfReaders = std::min({ static_cast<size_t>(std::max(this->GetNumberOfWorkUnits(), 1u)),
+                                 static_cast<size_t>(MultiThreaderBase::GetGlobalDefaultNumberOfThreads()),
+                                 slicesToRead.size() });
+    if (numberOfReaders > 1 && prototypeIO.IsNull())
+    {
+      prototypeIO = ImageIOFactory::CreateImageIO(m_FileNames[slices[slicesToRead.front()].FileNameIndex].c_str(),
+                                                  ImageIOFactory::IOFileModeEnum::ReadMode);
+    }
+    if (prototypeIO.IsNull() || !prototypeIO->CanReadConcurrently())
+    {
+      numberOfReaders = 1;
+    }
+  }
+
+  if (numberOfReaders <= 1)
+  {
+    readSlices(m_ImageIO);
+  }
+  else
+  {
+    std::vector<ImageIOBase::Pointer> imageIOs(numberOfReaders);
+    for (ImageIOBase::Pointer & imageIO : imageIOs)
+    {
+      imageIO = prototypeIO->Clone();
+    }
+
+    MultiThreaderBase * const multiThreader = this->GetMultiThreader();
+    multiThreader->SetNumberOfWorkUnits(static_cast<ThreadIdType>(numberOfReaders));
+    multiThreader->ParallelizeArray(
+      0, numberOfReaders, [&readSlices, &imageIOs](SizeValueType r) { readSlices(imageIOs[r]); }, nullptr);
+
+    // As after reading the files one after another, the ImageIO holds the
+    // information of the last file read.
+    if (m_ImageIO)
+    {
+      m_ImageIO->SetFileName(m_FileNames[slices[slicesToRead.back()].FileNameIndex]);
+      m_ImageIO->ReadImageInformation();
+    }
+  }
+
+  if (this->GetAbortGenerateData())
+  {
+    ProcessAborted e(__FILE__, __LINE__);
+    e.SetDescription("Object " + std::string(this->GetNameOfClass()) + ": AbortGenerateDataOn");
+    throw e;
+  }
+
+  // The spacing and the dictionaries are checked slice after slice, in order.
+  m_InternalMetaDataDictionaries.reserve(static_cast<size_t>(numberOfFiles));
+
+  for (SliceInformation & slice : slices)
+  {
+    if (slice.Exception)
+    {
+      std::rethrow_exception(slice.Exception);
+    }
+
+    if (!slice.Read)
+    {
+      if (!needToUpdateMetaDataDictionaryArray)
+      {
+        continue;
+      }
+      // A slice outside of the requested region, whose dictionary became
+      // needed by a non uniform sampling detected in a previous slice.
+      readSlice(slice, m_ImageIO);
+    }
+
+    bool   nonUniformSampling = false;
+    double spacingDeviation = 0.0;
+
+    if (slice.InsideRequestedRegion)
+    {
       // verify that slice spacing is the expected one
       // since we can be skipping some slices because they are outside of requested region
       // I am using additional variable
       if (prevSliceIsValid)
       {
-        typename TOutputImage::PointType sliceOrigin = readerOutput->GetOrigin();
         using SpacingScalarType = typename TOutputImage::SpacingValueType;
         Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
         for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
         {
-          dirN[j] = static_cast<SpacingScalarType>(sliceOrigin[j]) - static_cast<SpacingScalarType>(prevSliceOrigin[j]);
+          dirN[j] =
+            static_cast<SpacingScalarType>(slice.Origin[j]) - static_cast<SpacingScalarType>(prevSliceOrigin[j]);
         }
         const SpacingScalarType dirNnorm = dirN.GetNorm();
 
@@ -421,22 +561,19 @@ ImageSeriesReader<TOutputImage>::GenerateData()
 
           needToUpdateMetaDataDictionaryArray = true;
         }
-        prevSliceOrigin = sliceOrigin;
+        prevSliceOrigin = slice.Origin;
       }
       else
       {
-        prevSliceOrigin = readerOutput->GetOrigin();
+        prevSliceOrigin = slice.Origin;
         prevSliceIsValid = true;
       }
-
-      // report progress for read slices
-      progress.CompletedPixel();
-    } // end !insideRequestedRegion
+    }
 
     // Deep copy the MetaDataDictionary into the array
-    if (reader->GetImageIO() && needToUpdateMetaDataDictionaryArray)
+    if (slice.HasMetaDataDictionary && needToUpdateMetaDataDictionaryArray)
     {
-      MetaDataDictionary newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
+      MetaDataDictionary newDictionary = std::move(slice.Dictionary);
       if (nonUniformSampling)
       {
         // slice-specific information
@@ -0,0 +1,114 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedFile_h
+#define itkMemoryMappedFile_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkIOCommon.h"
+#include "itkLightObject.h"
+#include "itkObjectFactory.h"
+
+#include <string>
+
+namespace itk
+{
+/** \class MemoryMappedFile
+ * \brief A read-only or copy-on-write memory mapping of a part of a file.
+ *
+ * The mapping is established by Map() and released by Unmap(), or when the
+ * object is destroyed. The offset does not need to be aligned to the page
+ * size of the system: the mapping starts at the page holding the first byte,
+ * and GetData() points at the requested byte.
+ *
+ * With IOCommonEnums::MemoryMapping::ReadOnly the mapped pages are shared
+ * with the page cache, and so with other processes mapping the same file,
+ * but they must not be written. With IOCommonEnums::MemoryMapping::CopyOnWrite
+ * the pages may be written, a written page becomes a private copy and the
+ * file is never modified.
+ *
+ * \sa MemoryMappedImportImageContainer
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT MemoryMappedFile : public LightObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedFile);
+
+  /** Standard class type aliases. */
+  using Self = MemoryMappedFile;
+  using Superclass = LightObject;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using MemoryMappingEnum = IOCommonEnums::MemoryMapping;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(MemoryMappedFile);
+
+  /** Map numberOfBytes bytes of the file, starting at offset. An existing
+   * mapping is released first. An exception is thrown when the file cannot
+   * be opened or mapped, or when mode is MemoryMappingEnum::Off. */
+  void
+  Map(const std::string & fileName, SizeValueType offset, SizeValueType numberOfBytes, MemoryMappingEnum mode);
+
+  /** Release the mapping, if any. */
+  void
+  Unmap();
+
+  /** Pointer to the first mapped byte of the file, or nullptr when nothing is mapped. */
+  void *
+  GetData() const
+  {
+    return m_Data;
+  }
+
+  /** Number of mapped bytes of the file. */
+  SizeValueType
+  GetNumberOfBytes() const
+  {
+    return m_NumberOfBytes;
+  }
+
+  /** Mode of the current mapping, MemoryMappingEnum::Off when nothing is mapped. */
+  MemoryMappingEnum
+  GetMode() const
+  {
+    return m_Mode;
+  }
+
+protected:
+  MemoryMappedFile() = default;
+  ~MemoryMappedFile() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  void *            m_Data{ nullptr };
+  SizeValueType     m_NumberOfBytes{ 0 };
+  MemoryMappingEnum m_Mode{ MemoryMappingEnum::Off };
+
+  // Start and length of the mapping, which are aligned to the page granularity.
+  void *        m_MappedAddress{ nullptr };
+  SizeValueType m_MappedLength{ 0 };
+};
+} // end namespace itk
+
+#endif // itkMemoryMappedFile_h
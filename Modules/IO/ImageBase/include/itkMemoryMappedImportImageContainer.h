@@ -0,0 +1,92 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedImportImageContainer_h
+#define itkMemoryMappedImportImageContainer_h
+
+#include "itkImportImageContainer.h"
+#include "itkMemoryMappedFile.h"
+
+namespace itk
+{
+/** \class MemoryMappedImportImageContainer
+ * \brief An ImportImageContainer whose elements are a memory mapping of a file.
+ *
+ * The container keeps the MemoryMappedFile alive for as long as its elements
+ * are in use. The mapping is released when the container is destroyed, or
+ * when the elements are replaced, e.g. by Reserve() with a larger size or by
+ * SetImportPointer().
+ *
+ * A container mapped with IOCommonEnums::MemoryMapping::ReadOnly must not be
+ * written to, so an image using it must not be modified, e.g. by a filter
+ * running in place. Writing to it results in an access violation.
+ *
+ * \sa ImageFileReader::SetMemoryMapping()
+ * \ingroup ITKIOImageBase
+ */
+template <typename TElementIdentifier, typename TElement>
+class ITK_TEMPLATE_EXPORT MemoryMappedImportImageContainer : public ImportImageContainer<TElementIdentifier, TElement>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedImportImageContainer);
+
+  /** Standard class type aliases. */
+  using Self = MemoryMappedImportImageContainer;
+  using Superclass = ImportImageContainer<TElementIdentifier, TElement>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(MemoryMappedImportImageContainer);
+
+  /** Use the bytes mapped by mappedFile as the elements of the container.
+   * The number of elements is the number of mapped bytes divided by the
+   * size of an element. */
+  void
+  SetMappedFile(MemoryMappedFile * mappedFile);
+
+  /** The mapping holding the elements, or nullptr when the elements are not mapped. */
+  const MemoryMappedFile *
+  GetMappedFile() const
+  {
+    return m_MappedFile.GetPointer();
+  }
+
+protected:
+  MemoryMappedImportImageContainer() = default;
+  ~MemoryMappedImportImageContainer() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Release the mapping together with the elements. */
+  void
+  DeallocateManagedMemory() override;
+
+private:
+  MemoryMappedFile::Pointer m_MappedFile{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkMemoryMappedImportImageContainer.hxx"
+#endif
+
+#endif
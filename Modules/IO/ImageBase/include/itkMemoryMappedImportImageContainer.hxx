@@ -0,0 +1,57 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedImportImageContainer_hxx
+#define itkMemoryMappedImportImageContainer_hxx
+
+namespace itk
+{
+template <typename TElementIdentifier, typename TElement>
+void
+MemoryMappedImportImageContainer<TElementIdentifier, TElement>::SetMappedFile(MemoryMappedFile * mappedFile)
+{
+  if (mappedFile == nullptr || mappedFile->GetData() == nullptr)
+  {
+    itkExceptionMacro("The file is not mapped.");
+  }
+
+  // Releases the previous elements, and with them the previous mapping.
+  this->SetImportPointer(static_cast<TElement *>(mappedFile->GetData()),
+                         static_cast<TElementIdentifier>(mappedFile->GetNumberOfBytes() / sizeof(TElement)),
+                         false);
+  m_MappedFile = mappedFile;
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+MemoryMappedImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
+{
+  Superclass::DeallocateManagedMemory();
+  m_MappedFile = nullptr;
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+MemoryMappedImportImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(MappedFile);
+}
+} // end namespace itk
+
+#endif
@@ -160,4 +160,22 @@ operator<<(std::ostream & out, const IOCommonEnums::AtomicPixel value)
     }
   }();
 }
+
+std::ostream &
+operator<<(std::ostream & out, const IOCommonEnums::MemoryMapping value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case IOCommonEnums::MemoryMapping::Off:
+        return "itk::IOCommonEnums::MemoryMapping::Off";
+      case IOCommonEnums::MemoryMapping::ReadOnly:
+        return "itk::IOCommonEnums::MemoryMapping::ReadOnly";
+      case IOCommonEnums::MemoryMapping::CopyOnWrite:
+        return "itk::IOCommonEnums::MemoryMapping::CopyOnWrite";
+      default:
+        return "INVALID VALUE FOR itk::IOCommonEnums::MemoryMapping";
+    }
+  }();
+}
 } // namespace itk
@@ -17,8 +17,14 @@
  *=========================================================================*/
 
 #include "itkImageIOFactory.h"
+#include "itksys/SystemTools.hxx"
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <mutex>
+#include <string_view>
+#include <vector>
 
 
 namespace itk
@@ -27,37 +33,145 @@ namespace itk
 namespace
 {
 std::mutex createImageIOMutex;
-}
 
-ImageIOBase::Pointer
-ImageIOFactory::CreateImageIO(const char * path, IOFileModeEnum mode)
+// The bytes identifying the files of an ImageIO, at an offset from the
+// start of the file.
+struct FileSignature
 {
-  std::list<ImageIOBase::Pointer> possibleImageIO;
+  const char *     ImageIOName;
+  size_t           Offset;
+  std::string_view Bytes;
+};
 
-  const std::lock_guard<std::mutex> lockGuard(createImageIOMutex);
+using namespace std::string_view_literals;
+
+constexpr FileSignature fileSignatures[] = {
+  { "PNGImageIO", 0, "\x89PNG\r\n\x1a\n"sv },
+  { "JPEGImageIO", 0, "\xff\xd8\xff"sv },
+  { "TIFFImageIO", 0, "II*\0"sv },
+  { "TIFFImageIO", 0, "MM\0*"sv },
+  { "TIFFImageIO", 0, "II+\0"sv },
+  { "TIFFImageIO", 0, "MM\0+"sv },
+  { "BMPImageIO", 0, "BM"sv },
+  { "NrrdImageIO", 0, "NRRD"sv },
+  { "NiftiImageIO", 344, "n+1\0"sv },
+  { "NiftiImageIO", 344, "ni1\0"sv },
+  { "NiftiImageIO", 4, "n+2\0"sv },
+  { "GDCMImageIO", 128, "DICM"sv },
+  { "DCMTKImageIO", 128, "DICM"sv },
+  { "HDF5ImageIO", 0, "\x89HDF\r\n\x1a\n"sv },
+  { "JPEG2000ImageIO", 0, "\xff\x4f\xff\x51"sv },
+  { "JPEG2000ImageIO", 0, "\0\0\0\x0cjP  \r\n\x87\n"sv },
+  { "VTKImageIO", 0, "# vtk DataFile"sv },
+  { "MRCImageIO", 208, "MAP "sv },
+};
+
+// The size of the block read from the start of a file to match the signatures.
+constexpr size_t fileSignatureBlockSize = 512;
 
+// An instance of each registered ImageIO, in the order of the registered
+// factories. They are created on every request, so that the enable flags
+// and the overrides of the factories are always taken into account.
+std::vector<ImageIOBase::Pointer>
+CreateAllImageIOs()
+{
+  std::vector<ImageIOBase::Pointer> imageIOs;
   for (auto & allobject : ObjectFactoryBase::CreateAllInstance("itkImageIOBase"))
   {
     auto * io = dynamic_cast<ImageIOBase *>(allobject.GetPointer());
     if (io)
     {
-      possibleImageIO.emplace_back(io);
+      imageIOs.emplace_back(io);
     }
     else
     {
       std::cerr << "Error ImageIO factory did not return an ImageIOBase: " << allobject->GetNameOfClass() << std::endl;
     }
   }
-  for (auto & k : possibleImageIO)
+  return imageIOs;
+}
+
+bool
+HasReadExtension(const ImageIOBase * io, const std::string & lowerCasePath)
+{
+  for (const auto & extension : io->GetSupportedReadExtensions())
+  {
+    if (!extension.empty() && lowerCasePath.size() > extension.size() &&
+        std::equal(extension.rbegin(), extension.rend(), lowerCasePath.rbegin()))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+HasSignature(const ImageIOBase * io, const std::string & block)
+{
+  for (const auto & signature : fileSignatures)
+  {
+    if (strcmp(io->GetNameOfClass(), signature.ImageIOName) == 0 &&
+        block.size() >= signature.Offset + signature.Bytes.size() &&
+        block.compare(signature.Offset, signature.Bytes.size(), signature.Bytes) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+ImageIOBase::Pointer
+CreateImageIOForReading(const char * path)
+{
+  const std::vector<ImageIOBase::Pointer> imageIOs = CreateAllImageIOs();
+
+  const std::string lowerCasePath = itksys::SystemTools::LowerCase(path);
+
+  std::string block(fileSignatureBlockSize, '\0');
+  {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    file.read(block.data(), static_cast<std::streamsize>(block.size()));
+    block.resize(file ? block.size() : static_cast<size_t>(std::max<std::streamsize>(file.gcount(), 0)));
+  }
+
+  // The ImageIOs supporting the extension or recognizing the signature at the
+  // start of the file, and then every other ImageIO.
+  std::vector<bool> probed(imageIOs.size(), false);
+  for (size_t i = 0; i < imageIOs.size(); ++i)
   {
-    if (mode == IOFileModeEnum::ReadMode)
+    if (HasReadExtension(imageIOs[i], lowerCasePath) || HasSignature(imageIOs[i], block))
     {
-      if (k->CanReadFile(path))
+      probed[i] = true;
+      if (imageIOs[i]->CanReadFile(path))
       {
-        return k;
+        return imageIOs[i];
       }
     }
-    else if (mode == IOFileModeEnum::WriteMode)
+  }
+  for (size_t i = 0; i < imageIOs.size(); ++i)
+  {
+    if (!probed[i] && imageIOs[i]->CanReadFile(path))
+    {
+      return imageIOs[i];
+    }
+  }
+  return nullptr;
+}
+} // namespace
+
+ImageIOBase::Pointer
+ImageIOFactory::CreateImageIO(const char * path, IOFileModeEnum mode)
+{
+  const std::lock_guard<std::mutex> lockGuard(createImageIOMutex);
+
+  if (mode == IOFileModeEnum::ReadMode)
+  {
+    return CreateImageIOForReading(path);
+  }
+
+  for (auto & k : CreateAllImageIOs())
+  {
+    if (mode == IOFileModeEnum::WriteMode)
     {
       if (k->CanWriteFile(path))
       {
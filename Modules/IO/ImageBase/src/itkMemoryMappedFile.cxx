@@ -0,0 +1,163 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMemoryMappedFile.h"
+#include "itksys/SystemTools.hxx"
+
+#if defined(_WIN32)
+#  include "itksys/Encoding.hxx"
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+
+MemoryMappedFile::~MemoryMappedFile() { this->Unmap(); }
+
+void
+MemoryMappedFile::Map(const std::string & fileName,
+                      SizeValueType       offset,
+                      SizeValueType       numberOfBytes,
+                      MemoryMappingEnum   mode)
+{
+  this->Unmap();
+
+  if (mode == MemoryMappingEnum::Off)
+  {
+    itkExceptionMacro("Cannot map " << fileName << " with mode " << mode);
+  }
+  if (numberOfBytes == 0)
+  {
+    itkExceptionMacro("Cannot map zero bytes of " << fileName);
+  }
+
+#if defined(_WIN32)
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  const SizeValueType granularity = systemInfo.dwAllocationGranularity;
+#else
+  const auto          granularity = static_cast<SizeValueType>(sysconf(_SC_PAGESIZE));
+#endif
+  const SizeValueType alignedOffset = offset - offset % granularity;
+  const SizeValueType mappedLength = numberOfBytes + (offset - alignedOffset);
+
+#if defined(_WIN32)
+  const std::wstring wideFileName = itksys::Encoding::ToWindowsExtendedPath(fileName);
+  const HANDLE       file = CreateFileW(wideFileName.c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL,
+                                  nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    itkExceptionMacro("Cannot open " << fileName << " for mapping: " << itksys::SystemTools::GetLastSystemError());
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || static_cast<SizeValueType>(fileSize.QuadPart) < offset + numberOfBytes)
+  {
+    CloseHandle(file);
+    itkExceptionMacro("The file " << fileName << " holds fewer than " << offset + numberOfBytes << " bytes");
+  }
+  // A copy-on-write view must be created from a mapping with read access only.
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr)
+  {
+    itkExceptionMacro("Cannot map " << fileName << ": " << itksys::SystemTools::GetLastSystemError());
+  }
+  void * address = MapViewOfFile(mapping,
+                                 mode == MemoryMappingEnum::ReadOnly ? FILE_MAP_READ : FILE_MAP_COPY,
+                                 static_cast<DWORD>(static_cast<uint64_t>(alignedOffset) >> 32),
+                                 static_cast<DWORD>(alignedOffset & 0xffffffffu),
+                                 static_cast<SIZE_T>(mappedLength));
+  // The view keeps a reference to the mapping object.
+  CloseHandle(mapping);
+  if (address == nullptr)
+  {
+    itkExceptionMacro("Cannot map " << fileName << ": " << itksys::SystemTools::GetLastSystemError());
+  }
+#else
+  const int file = open(fileName.c_str(), O_RDONLY);
+  if (file == -1)
+  {
+    itkExceptionMacro("Cannot open " << fileName << " for mapping: " << itksys::SystemTools::GetLastSystemError());
+  }
+  struct stat fileStatus;
+  if (fstat(file, &fileStatus) != 0 || static_cast<SizeValueType>(fileStatus.st_size) < offset + numberOfBytes)
+  {
+    close(file);
+    itkExceptionMacro("The file " << fileName << " holds fewer than " << offset + numberOfBytes << " bytes");
+  }
+  void * address = (mode == MemoryMappingEnum::ReadOnly)
+                     ? mmap(nullptr, mappedLength, PROT_READ, MAP_SHARED, file, static_cast<off_t>(alignedOffset))
+                     : mmap(nullptr,
+                            mappedLength,
+                            PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE,
+                            file,
+                            static_cast<off_t>(alignedOffset));
+  // The mapping keeps a reference to the file.
+  close(file);
+  if (address == MAP_FAILED)
+  {
+    itkExceptionMacro("Cannot map " << fileName << ": " << itksys::SystemTools::GetLastSystemError());
+  }
+#endif
+
+  m_MappedAddress = address;
+  m_MappedLength = mappedLength;
+  m_Data = static_cast<char *>(address) + (offset - alignedOffset);
+  m_NumberOfBytes = numberOfBytes;
+  m_Mode = mode;
+}
+
+void
+MemoryMappedFile::Unmap()
+{
+  if (m_MappedAddress != nullptr)
+  {
+#if defined(_WIN32)
+    UnmapViewOfFile(m_MappedAddress);
+#else
+    munmap(m_MappedAddress, m_MappedLength);
+#endif
+  }
+  m_MappedAddress = nullptr;
+  m_MappedLength = 0;
+  m_Data = nullptr;
+  m_NumberOfBytes = 0;
+  m_Mode = MemoryMappingEnum::Off;
+}
+
+void
+MemoryMappedFile::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Data: " << m_Data << std::endl;
+  os << indent << "NumberOfBytes: " << m_NumberOfBytes << std::endl;
+  os << indent << "Mode: " << m_Mode << std::endl;
+}
+
+} // end namespace itk
@@ -0,0 +1,214 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkMemoryMappedImportImageContainer.h"
+#include "itkVectorImage.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#include <algorithm>
+#include <numeric>
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+struct ITKImageFileReaderMemoryMappingTest : public ::testing::Test
+{
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+  }
+
+  using ImageType = itk::Image<short, 3>;
+  using RegionType = ImageType::RegionType;
+  using MappedPixelContainerType =
+    itk::MemoryMappedImportImageContainer<itk::SizeValueType, ImageType::InternalPixelType>;
+  using MemoryMappingEnum = itk::IOCommonEnums::MemoryMapping;
+
+  static ImageType::Pointer
+  MakeImage()
+  {
+    auto image = ImageType::New();
+    image->SetRegions(RegionType(ImageType::SizeType{ { 7, 5, 4 } }));
+    image->Allocate();
+    std::iota(image->GetBufferPointer(), image->GetBufferPointer() + image->GetPixelContainer()->Size(), short{ 0 });
+    return image;
+  }
+
+  template <typename TImage>
+  static typename TImage::Pointer
+  Read(const std::string & fileName, MemoryMappingEnum mode)
+  {
+    const auto reader = itk::ImageFileReader<TImage>::New();
+    reader->SetFileName(fileName);
+    reader->SetMemoryMapping(mode);
+    reader->Update();
+    return reader->GetOutput();
+  }
+
+  static const MappedPixelContainerType *
+  GetMappedPixelContainer(const ImageType * image)
+  {
+    return dynamic_cast<const MappedPixelContainerType *>(image->GetPixelContainer());
+  }
+};
+
+} // namespace
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, ReadOnly)
+{
+  const std::string fileName = "itkImageFileReaderMemoryMappingReadOnly.mhd";
+  const auto        image = MakeImage();
+  itk::WriteImage(image, fileName);
+
+  const ImageType::Pointer mapped = Read<ImageType>(fileName, MemoryMappingEnum::ReadOnly);
+
+  const MappedPixelContainerType * const pixelContainer = GetMappedPixelContainer(mapped);
+  ASSERT_NE(pixelContainer, nullptr);
+  ASSERT_NE(pixelContainer->GetMappedFile(), nullptr);
+  EXPECT_EQ(pixelContainer->GetMappedFile()->GetMode(), MemoryMappingEnum::ReadOnly);
+  EXPECT_EQ(pixelContainer->Size(), image->GetBufferedRegion().GetNumberOfPixels());
+  EXPECT_EQ(*mapped, *image);
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, LocalHeader)
+{
+  // The pixels follow the header, at an offset which is only suitably
+  // aligned for pixels of a single byte.
+  using ByteImageType = itk::Image<unsigned char, 3>;
+  auto image = ByteImageType::New();
+  image->SetRegions(ByteImageType::RegionType(ByteImageType::SizeType{ { 7, 5, 4 } }));
+  image->Allocate();
+  std::iota(image->GetBufferPointer(), image->GetBufferPointer() + image->GetPixelContainer()->Size(), 0);
+
+  const std::string fileName = "itkImageFileReaderMemoryMappingLocalHeader.mha";
+  itk::WriteImage(image, fileName);
+
+  const ByteImageType::Pointer mapped = Read<ByteImageType>(fileName, MemoryMappingEnum::ReadOnly);
+  using BytePixelContainerType = itk::MemoryMappedImportImageContainer<itk::SizeValueType, unsigned char>;
+  EXPECT_NE(dynamic_cast<const BytePixelContainerType *>(mapped->GetPixelContainer()), nullptr);
+  EXPECT_EQ(*mapped, *image);
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, CopyOnWriteLeavesFileUnchanged)
+{
+  const std::string fileName = "itkImageFileReaderMemoryMappingCopyOnWrite.mhd";
+  const auto        image = MakeImage();
+  itk::WriteImage(image, fileName);
+
+  const ImageType::Pointer mapped = Read<ImageType>(fileName, MemoryMappingEnum::CopyOnWrite);
+  ASSERT_NE(GetMappedPixelContainer(mapped), nullptr);
+  EXPECT_EQ(*mapped, *image);
+
+  mapped->FillBuffer(-1);
+  EXPECT_EQ(mapped->GetPixel({ { 6, 4, 3 } }), -1);
+
+  EXPECT_EQ(*Read<ImageType>(fileName, MemoryMappingEnum::Off), *image);
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, RequestedRegion)
+{
+  const std::string fileName = "itkImageFileReaderMemoryMappingRequestedRegion.mhd";
+  const auto        image = MakeImage();
+  itk::WriteImage(image, fileName);
+
+  // A slab of slices is contiguous in the file.
+  const RegionType slab({ { 0, 0, 1 } }, { { 7, 5, 2 } });
+
+  const auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetMemoryMapping(MemoryMappingEnum::ReadOnly);
+  reader->GetOutput()->UpdateOutputInformation();
+  reader->GetOutput()->SetRequestedRegion(slab);
+  reader->GetOutput()->Update();
+
+  const ImageType * const output = reader->GetOutput();
+  ASSERT_NE(GetMappedPixelContainer(output), nullptr);
+  EXPECT_EQ(output->GetBufferedRegion(), slab);
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, slab); !it.IsAtEnd(); ++it)
+  {
+    EXPECT_EQ(it.Get(), image->GetPixel(it.GetIndex()));
+  }
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, FallsBackToReading)
+{
+  const auto image = MakeImage();
+
+  // Compressed pixels cannot be mapped.
+  const std::string compressedFileName = "itkImageFileReaderMemoryMappingCompressed.mha";
+  itk::WriteImage(image, compressedFileName, true);
+  const ImageType::Pointer compressed = Read<ImageType>(compressedFileName, MemoryMappingEnum::ReadOnly);
+  EXPECT_EQ(GetMappedPixelContainer(compressed), nullptr);
+  EXPECT_EQ(*compressed, *image);
+
+  // Pixels which are converted cannot be mapped.
+  const std::string fileName = "itkImageFileReaderMemoryMappingConverted.mha";
+  itk::WriteImage(image, fileName);
+  using FloatImageType = itk::Image<float, 3>;
+  const FloatImageType::Pointer converted = Read<FloatImageType>(fileName, MemoryMappingEnum::ReadOnly);
+  using FloatMappedPixelContainerType = itk::MemoryMappedImportImageContainer<itk::SizeValueType, float>;
+  EXPECT_EQ(dynamic_cast<const FloatMappedPixelContainerType *>(converted->GetPixelContainer()), nullptr);
+  EXPECT_EQ(converted->GetPixel({ { 6, 4, 3 } }), image->GetPixel({ { 6, 4, 3 } }));
+
+  // Mapping is disabled by default.
+  const auto reader = itk::ImageFileReader<ImageType>::New();
+  EXPECT_EQ(reader->GetMemoryMapping(), MemoryMappingEnum::Off);
+  reader->SetFileName(fileName);
+  reader->Update();
+  EXPECT_EQ(GetMappedPixelContainer(reader->GetOutput()), nullptr);
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, VectorImage)
+{
+  using VectorImageType = itk::VectorImage<float, 2>;
+  auto image = VectorImageType::New();
+  image->SetRegions(VectorImageType::RegionType(VectorImageType::SizeType{ { 4, 3 } }));
+  image->SetNumberOfComponentsPerPixel(3);
+  image->Allocate();
+  std::iota(image->GetBufferPointer(), image->GetBufferPointer() + image->GetPixelContainer()->Size(), 0.5f);
+
+  const std::string fileName = "itkImageFileReaderMemoryMappingVectorImage.mhd";
+  itk::WriteImage(image, fileName);
+
+  const VectorImageType::Pointer mapped = Read<VectorImageType>(fileName, MemoryMappingEnum::ReadOnly);
+  const auto * const             pixelContainer =
+    dynamic_cast<const itk::MemoryMappedImportImageContainer<itk::SizeValueType, float> *>(
+      mapped->GetPixelContainer());
+  ASSERT_NE(pixelContainer, nullptr);
+  ASSERT_EQ(pixelContainer->Size(), image->GetPixelContainer()->Size());
+  EXPECT_TRUE(std::equal(mapped->GetBufferPointer(),
+                         mapped->GetBufferPointer() + pixelContainer->Size(),
+                         image->GetBufferPointer()));
+  EXPECT_EQ(mapped->GetPixel({ { 3, 2 } }), image->GetPixel({ { 3, 2 } }));
+}
@@ -0,0 +1,175 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkMetaImageIO.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+// Streams an image from a file with the regions read ahead, and checks that
+// it equals the image written.
+
+namespace
+{
+
+// A MetaImageIO which counts its clones, and which may claim not to read
+// concurrently.
+class CloneCountingMetaImageIO : public itk::MetaImageIO
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CloneCountingMetaImageIO);
+
+  using Self = CloneCountingMetaImageIO;
+  using Superclass = itk::MetaImageIO;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(CloneCountingMetaImageIO);
+
+  bool
+  CanReadConcurrently() override
+  {
+    return m_CanReadConcurrently;
+  }
+
+  bool                m_CanReadConcurrently{ true };
+  static unsigned int m_NumberOfClones;
+
+protected:
+  CloneCountingMetaImageIO() = default;
+
+  itk::LightObject::Pointer
+  InternalClone() const override
+  {
+    ++m_NumberOfClones;
+    itk::LightObject::Pointer loPtr = Superclass::InternalClone();
+    dynamic_cast<Self &>(*loPtr).m_CanReadConcurrently = m_CanReadConcurrently;
+    return loPtr;
+  }
+};
+
+unsigned int CloneCountingMetaImageIO::m_NumberOfClones = 0;
+
+template <typename TImage, typename TFileImage>
+int
+itkImageFileReaderPrefetchTestHelper(const std::string &               fileName,
+                                     const typename TImage::SizeType & size,
+                                     unsigned int                      numberOfStreamDivisions,
+                                     unsigned int                      numberOfRegionsToPrefetch,
+                                     itk::ImageIOBase *                imageIO = nullptr)
+{
+  auto image = TFileImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  auto * const buffer = image->GetBufferPointer();
+  for (size_t i = 0; i < image->GetBufferedRegion().GetNumberOfPixels(); ++i)
+  {
+    buffer[i] = static_cast<typename TFileImage::PixelType>((i * 7) % 251);
+  }
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, fileName));
+
+  auto reader = itk::ImageFileReader<TImage>::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(reader, ImageFileReader, ImageSource);
+
+  reader->SetFileName(fileName);
+  if (imageIO)
+  {
+    reader->SetImageIO(imageIO);
+  }
+  ITK_TEST_SET_GET_VALUE(0, reader->GetNumberOfRegionsToPrefetch());
+  reader->SetNumberOfRegionsToPrefetch(numberOfRegionsToPrefetch);
+  ITK_TEST_SET_GET_VALUE(numberOfRegionsToPrefetch, reader->GetNumberOfRegionsToPrefetch());
+
+  auto streamer = itk::StreamingImageFilter<TImage, TImage>::New();
+  streamer->SetInput(reader->GetOutput());
+  streamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+
+  // The second update streams the image again, with other regions.
+  for (const unsigned int numberOfDivisions : { numberOfStreamDivisions, numberOfStreamDivisions + 2 })
+  {
+    streamer->SetNumberOfStreamDivisions(numberOfDivisions);
+    reader->Modified();
+    ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+    itk::ImageRegionConstIterator<TFileImage> it(image, image->GetBufferedRegion());
+    itk::ImageRegionConstIterator<TImage>     readIt(streamer->GetOutput(), image->GetBufferedRegion());
+    for (; !it.IsAtEnd(); ++it, ++readIt)
+    {
+      if (static_cast<typename TImage::PixelType>(it.Get()) != readIt.Get())
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error reading " << fileName << " in " << numberOfDivisions << " pieces at index "
+                  << it.GetIndex() << std::endl;
+        std::cerr << "Expected value " << it.Get() << ", but got " << readIt.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int
+itkImageFileReaderPrefetchTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  using Image3DType = itk::Image<unsigned short, 3>;
+  using Image2DType = itk::Image<unsigned char, 2>;
+  using FloatImage2DType = itk::Image<float, 2>;
+
+  int status = EXIT_SUCCESS;
+
+  status |= itkImageFileReaderPrefetchTestHelper<Image3DType, Image3DType>(
+    outputDirectory + "/itkImageFileReaderPrefetchTest3D.mha", { 40, 30, 23 }, 7, 3);
+
+  // With a pixel conversion
+  status |= itkImageFileReaderPrefetchTestHelper<FloatImage2DType, Image2DType>(
+    outputDirectory + "/itkImageFileReaderPrefetchTest2D.mha", { 50, 61 }, 5, 1);
+
+  // With more regions read ahead than there are pieces
+  status |= itkImageFileReaderPrefetchTestHelper<Image2DType, Image2DType>(
+    outputDirectory + "/itkImageFileReaderPrefetchTest2DAll.mha", { 50, 61 }, 3, 8);
+
+  // Each region read ahead is read by a clone of the ImageIO.
+  const auto imageIO = CloneCountingMetaImageIO::New();
+  status |= itkImageFileReaderPrefetchTestHelper<Image3DType, Image3DType>(
+    outputDirectory + "/itkImageFileReaderPrefetchTestClones.mha", { 40, 30, 23 }, 7, 3, imageIO);
+  ITK_TEST_EXPECT_TRUE(CloneCountingMetaImageIO::m_NumberOfClones > 0);
+
+  // An ImageIO which cannot read concurrently, as HDF5ImageIO, reads the
+  // pieces one at a time, when requested.
+  CloneCountingMetaImageIO::m_NumberOfClones = 0;
+  imageIO->m_CanReadConcurrently = false;
+  status |= itkImageFileReaderPrefetchTestHelper<Image3DType, Image3DType>(
+    outputDirectory + "/itkImageFileReaderPrefetchTestSerial.mha", { 40, 30, 23 }, 7, 3, imageIO);
+  ITK_TEST_EXPECT_EQUAL(CloneCountingMetaImageIO::m_NumberOfClones, 0u);
+
+  std::cout << "Test finished." << std::endl;
+  return status;
+}
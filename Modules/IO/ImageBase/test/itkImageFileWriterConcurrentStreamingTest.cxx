@@ -0,0 +1,132 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkMetaImageIO.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkTestingMacros.h"
+
+// Streams an image through a writer whose pieces are written in the
+// background, and checks that the file read back equals the image.
+
+namespace
+{
+
+// A MetaImageIO whose regions are written in order, one after another.
+class SerialMetaImageIO : public itk::MetaImageIO
+{
+public:
+  using Self = SerialMetaImageIO;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(SerialMetaImageIO);
+
+  bool
+  CanStreamWriteConcurrently() override
+  {
+    return false;
+  }
+};
+
+using ImageType = itk::Image<unsigned short, 3>;
+
+int
+itkImageFileWriterConcurrentStreamingTestHelper(const ImageType *   image,
+                                                const std::string & fileName,
+                                                itk::ImageIOBase *  imageIO,
+                                                unsigned int        numberOfStreamDivisions,
+                                                unsigned int        numberOfConcurrentWrites)
+{
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName + ".source.mha");
+  reader->UseStreamingOn();
+
+  auto monitor = itk::PipelineMonitorImageFilter<ImageType>::New();
+  monitor->SetInput(reader->GetOutput());
+
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(monitor->GetOutput());
+  writer->SetFileName(fileName);
+  writer->SetImageIO(imageIO);
+  writer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  ITK_TEST_SET_GET_VALUE(0, writer->GetNumberOfConcurrentWrites());
+  writer->SetNumberOfConcurrentWrites(numberOfConcurrentWrites);
+  ITK_TEST_SET_GET_VALUE(numberOfConcurrentWrites, writer->GetNumberOfConcurrentWrites());
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  ITK_TEST_EXPECT_EQUAL(monitor->GetNumberOfUpdates(), numberOfStreamDivisions);
+
+  const ImageType::Pointer written = itk::ReadImage<ImageType>(fileName);
+  ITK_TEST_EXPECT_EQUAL(written->GetLargestPossibleRegion(), image->GetLargestPossibleRegion());
+
+  itk::ImageRegionConstIterator<ImageType> it(image, image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> writtenIt(written, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it, ++writtenIt)
+  {
+    if (it.Get() != writtenIt.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error writing " << fileName << " at index " << it.GetIndex() << std::endl;
+      std::cerr << "Expected value " << it.Get() << ", but got " << writtenIt.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int
+itkImageFileWriterConcurrentStreamingTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 40, 30, 24 } });
+  image->Allocate();
+  auto * const buffer = image->GetBufferPointer();
+  for (size_t i = 0; i < image->GetBufferedRegion().GetNumberOfPixels(); ++i)
+  {
+    buffer[i] = static_cast<ImageType::PixelType>((i * 7) % 65521);
+  }
+
+  int status = EXIT_SUCCESS;
+
+  // The pieces after the first written concurrently
+  const std::string concurrentFileName = outputDirectory + "/itkImageFileWriterConcurrentStreamingTest.mha";
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, concurrentFileName + ".source.mha"));
+  status |= itkImageFileWriterConcurrentStreamingTestHelper(image, concurrentFileName, itk::MetaImageIO::New(), 6, 3);
+
+  // The pieces written in order
+  const std::string serialFileName = outputDirectory + "/itkImageFileWriterConcurrentStreamingTestSerial.mha";
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, serialFileName + ".source.mha"));
+  status |= itkImageFileWriterConcurrentStreamingTestHelper(image, serialFileName, SerialMetaImageIO::New(), 4, 2);
+
+  std::cout << "Test finished." << std::endl;
+  return status;
+}
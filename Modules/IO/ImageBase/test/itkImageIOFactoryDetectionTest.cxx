@@ -0,0 +1,92 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileWriter.h"
+#include "itkImageIOFactory.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+// Checks that the ImageIO reading a file is found from its extension, and
+// from the signature at its start when the extension is missing or
+// misleading.
+
+namespace
+{
+
+std::string
+GetReadingImageIOName(const std::string & fileName)
+{
+  const itk::ImageIOBase::Pointer io =
+    itk::ImageIOFactory::CreateImageIO(fileName.c_str(), itk::ImageIOFactory::IOFileModeEnum::ReadMode);
+  return io ? io->GetNameOfClass() : "";
+}
+
+} // namespace
+
+int
+itkImageIOFactoryDetectionTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  using ImageType = itk::Image<unsigned short, 2>;
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 16, 8 } });
+  image->AllocateInitialized();
+
+  const std::string metaFileName = outputDirectory + "/itkImageIOFactoryDetectionTest.mha";
+  const std::string dicomFileName = outputDirectory + "/itkImageIOFactoryDetectionTest.dcm";
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, metaFileName));
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, dicomFileName));
+
+  // From the extension
+  ITK_TEST_EXPECT_EQUAL(GetReadingImageIOName(metaFileName), std::string("MetaImageIO"));
+  ITK_TEST_EXPECT_EQUAL(GetReadingImageIOName(dicomFileName), std::string("GDCMImageIO"));
+
+  // A disabled ImageIO is no longer returned, even after it read a file
+  for (auto * factory : itk::ObjectFactoryBase::GetRegisteredFactories())
+  {
+    factory->SetEnableFlag(false, "itkImageIOBase", "itkMetaImageIO");
+  }
+  ITK_TEST_EXPECT_TRUE(GetReadingImageIOName(metaFileName) != "MetaImageIO");
+  for (auto * factory : itk::ObjectFactoryBase::GetRegisteredFactories())
+  {
+    factory->SetEnableFlag(true, "itkImageIOBase", "itkMetaImageIO");
+  }
+  ITK_TEST_EXPECT_EQUAL(GetReadingImageIOName(metaFileName), std::string("MetaImageIO"));
+
+  // From the signature, without or with a misleading extension
+  const std::string dicomNoExtensionFileName = outputDirectory + "/itkImageIOFactoryDetectionTestDICOM";
+  const std::string dicomMetaFileName = outputDirectory + "/itkImageIOFactoryDetectionTestDICOM.mha";
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::CopyFileAlways(dicomFileName, dicomNoExtensionFileName));
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::CopyFileAlways(dicomFileName, dicomMetaFileName));
+  ITK_TEST_EXPECT_EQUAL(GetReadingImageIOName(dicomNoExtensionFileName), std::string("GDCMImageIO"));
+  ITK_TEST_EXPECT_EQUAL(GetReadingImageIOName(dicomMetaFileName), std::string("GDCMImageIO"));
+
+  // No ImageIO
+  ITK_TEST_EXPECT_EQUAL(GetReadingImageIOName(outputDirectory + "/itkImageIOFactoryDetectionTestMissing.mha"),
+                        std::string(""));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,325 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageSeriesReader.h"
+#include "itkImageFileWriter.h"
+#include "itkMetaImageIO.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+// A MetaImageIO which counts its clones, and which may claim not to read
+// concurrently.
+class CloneCountingMetaImageIO : public itk::MetaImageIO
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CloneCountingMetaImageIO);
+
+  using Self = CloneCountingMetaImageIO;
+  using Superclass = itk::MetaImageIO;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(CloneCountingMetaImageIO);
+
+  bool
+  CanReadConcurrently() override
+  {
+    return m_CanReadConcurrently;
+  }
+
+  bool                             m_CanReadConcurrently{ true };
+  static std::atomic<unsigned int> m_NumberOfClones;
+
+protected:
+  CloneCountingMetaImageIO() = default;
+
+  itk::LightObject::Pointer
+  InternalClone() const override
+  {
+    ++m_NumberOfClones;
+    itk::LightObject::Pointer loPtr = Superclass::InternalClone();
+    dynamic_cast<Self &>(*loPtr).m_CanReadConcurrently = m_CanReadConcurrently;
+    return loPtr;
+  }
+};
+
+std::atomic<unsigned int> CloneCountingMetaImageIO::m_NumberOfClones{ 0 };
+
+struct ITKImageSeriesReaderParallelTest : public ::testing::Test
+{
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+    // The number of concurrent readers is bounded by the global default
+    // number of threads, whatever the number of processors.
+    m_GlobalDefaultNumberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(8);
+    CloneCountingMetaImageIO::m_NumberOfClones = 0;
+  }
+
+  void
+  TearDown() override
+  {
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(m_GlobalDefaultNumberOfThreads);
+  }
+
+  itk::ThreadIdType m_GlobalDefaultNumberOfThreads{ 1 };
+
+  using ImageType = itk::Image<short, 3>;
+  using ReaderType = itk::ImageSeriesReader<ImageType>;
+  using FileNamesContainer = ReaderType::FileNamesContainer;
+
+  /** Writes one file per slice of a 9x7x12 image, each with a dictionary
+   * entry of its own. */
+  static FileNamesContainer
+  WriteSlices(const std::string & prefix, const std::vector<double> & sliceOrigins, ImageType::Pointer & image)
+  {
+    const auto numberOfSlices = static_cast<itk::SizeValueType>(sliceOrigins.size());
+    image = ImageType::New();
+    image->SetRegions(ImageType::RegionType(ImageType::SizeType{ { 9, 7, numberOfSlices } }));
+    image->Allocate();
+    std::iota(image->GetBufferPointer(), image->GetBufferPointer() + image->GetPixelContainer()->Size(), short{ 0 });
+
+    FileNamesContainer fileNames;
+    for (itk::SizeValueType k = 0; k < numberOfSlices; ++k)
+    {
+      auto slice = ImageType::New();
+      slice->SetRegions(ImageType::RegionType(ImageType::SizeType{ { 9, 7, 1 } }));
+      slice->Allocate();
+      std::copy_n(image->GetBufferPointer() + k * 9 * 7, 9 * 7, slice->GetBufferPointer());
+      slice->SetOrigin(itk::MakePoint(0.0, 0.0, sliceOrigins[k]));
+      itk::EncapsulateMetaData<std::string>(slice->GetMetaDataDictionary(), "SliceNumber", std::to_string(k));
+
+      fileNames.push_back(prefix + std::to_string(k) + ".mha");
+      itk::WriteImage(slice, fileNames.back());
+    }
+    return fileNames;
+  }
+
+  static std::vector<double>
+  UniformSliceOrigins(unsigned int numberOfSlices)
+  {
+    std::vector<double> sliceOrigins(numberOfSlices);
+    std::iota(sliceOrigins.begin(), sliceOrigins.end(), 0.0);
+    return sliceOrigins;
+  }
+
+  static ReaderType::Pointer
+  MakeReader(const FileNamesContainer & fileNames, itk::ThreadIdType numberOfWorkUnits)
+  {
+    auto reader = ReaderType::New();
+    reader->SetFileNames(fileNames);
+    reader->SetImageIO(CloneCountingMetaImageIO::New());
+    reader->SetNumberOfWorkUnits(numberOfWorkUnits);
+    reader->ConcurrentSliceReadOn();
+    return reader;
+  }
+
+  static std::vector<std::string>
+  GetSliceNumbers(const ReaderType * reader)
+  {
+    std::vector<std::string> sliceNumbers;
+    for (const itk::MetaDataDictionary * dictionary : *reader->GetMetaDataDictionaryArray())
+    {
+      std::string sliceNumber;
+      itk::ExposeMetaData<std::string>(*dictionary, "SliceNumber", sliceNumber);
+      sliceNumbers.push_back(sliceNumber);
+    }
+    return sliceNumbers;
+  }
+};
+
+} // namespace
+
+
+TEST_F(ITKImageSeriesReaderParallelTest, MatchesSerialRead)
+{
+  ImageType::Pointer image;
+  const auto fileNames = WriteSlices("itkImageSeriesReaderParallel", UniformSliceOrigins(12), image);
+
+  const auto serialReader = MakeReader(fileNames, 1);
+  serialReader->Update();
+  EXPECT_EQ(*serialReader->GetOutput(), *image);
+
+  EXPECT_EQ(CloneCountingMetaImageIO::m_NumberOfClones, 0u);
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 2, 5, 64 })
+  {
+    CloneCountingMetaImageIO::m_NumberOfClones = 0;
+    const auto reader = MakeReader(fileNames, numberOfWorkUnits);
+    reader->Update();
+    EXPECT_EQ(*reader->GetOutput(), *image);
+    EXPECT_EQ(reader->GetOutput()->GetSpacing(), serialReader->GetOutput()->GetSpacing());
+    EXPECT_EQ(GetSliceNumbers(reader), GetSliceNumbers(serialReader));
+    // One clone per reader, at most the global default number of threads.
+    EXPECT_EQ(CloneCountingMetaImageIO::m_NumberOfClones, std::min(numberOfWorkUnits, 8u));
+    // The ImageIO is left as after a serial read.
+    EXPECT_EQ(reader->GetImageIO()->GetFileName(), fileNames.back());
+  }
+}
+
+
+TEST_F(ITKImageSeriesReaderParallelTest, ReadsSeriallyUnlessRequestedAndSupported)
+{
+  ImageType::Pointer image;
+  const auto fileNames = WriteSlices("itkImageSeriesReaderParallelSerial", UniformSliceOrigins(6), image);
+
+  auto reader = MakeReader(fileNames, 4);
+  reader->ConcurrentSliceReadOff();
+  reader->Update();
+  EXPECT_EQ(*reader->GetOutput(), *image);
+  EXPECT_EQ(CloneCountingMetaImageIO::m_NumberOfClones, 0u);
+
+  // Off by default.
+  EXPECT_FALSE(ReaderType::New()->GetConcurrentSliceRead());
+
+  // An ImageIO which cannot read concurrently reads the files one after
+  // another.
+  const auto imageIO = CloneCountingMetaImageIO::New();
+  imageIO->m_CanReadConcurrently = false;
+  reader = MakeReader(fileNames, 4);
+  reader->SetImageIO(imageIO);
+  reader->Update();
+  EXPECT_EQ(*reader->GetOutput(), *image);
+  EXPECT_EQ(CloneCountingMetaImageIO::m_NumberOfClones, 0u);
+  EXPECT_EQ(imageIO->GetFileName(), fileNames.back());
+
+  // Without an ImageIO, the MetaImageIO created for the first file is cloned.
+  EXPECT_TRUE(itk::MetaImageIO::New()->CanReadConcurrently());
+  reader = ReaderType::New();
+  reader->SetFileNames(fileNames);
+  reader->SetNumberOfWorkUnits(4);
+  reader->ConcurrentSliceReadOn();
+  reader->Update();
+  EXPECT_EQ(*reader->GetOutput(), *image);
+}
+
+
+TEST_F(ITKImageSeriesReaderParallelTest, ClonesImageIO)
+{
+  ImageType::Pointer image;
+  const auto fileNames = WriteSlices("itkImageSeriesReaderParallelImageIO", UniformSliceOrigins(6), image);
+
+  const auto imageIO = CloneCountingMetaImageIO::New();
+  imageIO->SetUseCompression(true);
+
+  const auto clone = imageIO->Clone();
+  ASSERT_NE(clone, nullptr);
+  EXPECT_NE(clone.GetPointer(), imageIO.GetPointer());
+  EXPECT_STREQ(clone->GetNameOfClass(), imageIO->GetNameOfClass());
+  EXPECT_TRUE(clone->GetUseCompression());
+  EXPECT_TRUE(clone->CanReadConcurrently());
+
+  const auto reader = MakeReader(fileNames, 3);
+  reader->SetImageIO(imageIO);
+  reader->Update();
+  EXPECT_EQ(*reader->GetOutput(), *image);
+  EXPECT_EQ(GetSliceNumbers(reader).size(), fileNames.size());
+}
+
+
+TEST_F(ITKImageSeriesReaderParallelTest, ReverseOrderAndRequestedRegion)
+{
+  ImageType::Pointer image;
+  const auto fileNames = WriteSlices("itkImageSeriesReaderParallelRegion", UniformSliceOrigins(12), image);
+
+  FileNamesContainer reversedFileNames(fileNames.rbegin(), fileNames.rend());
+  const auto         reader = MakeReader(reversedFileNames, 4);
+  reader->ReverseOrderOn();
+
+  const ImageType::RegionType slab({ { 0, 0, 3 } }, { { 9, 7, 5 } });
+  reader->GetOutput()->UpdateOutputInformation();
+  reader->GetOutput()->SetRequestedRegion(slab);
+  reader->GetOutput()->Update();
+
+  const ImageType * const output = reader->GetOutput();
+  EXPECT_EQ(output->GetBufferedRegion(), slab);
+  for (itk::IndexValueType k = 3; k < 8; ++k)
+  {
+    EXPECT_EQ(output->GetPixel({ { 8, 6, k } }), image->GetPixel({ { 8, 6, k } }));
+  }
+  // The dictionaries of all the slices are gathered, in order.
+  const std::vector<std::string> sliceNumbers = GetSliceNumbers(reader);
+  ASSERT_EQ(sliceNumbers.size(), fileNames.size());
+  for (size_t k = 0; k < sliceNumbers.size(); ++k)
+  {
+    EXPECT_EQ(sliceNumbers[k], std::to_string(k));
+  }
+}
+
+
+TEST_F(ITKImageSeriesReaderParallelTest, NonUniformSampling)
+{
+  // The slice at z = 5 is missing.
+  ImageType::Pointer image;
+  const auto         fileNames =
+    WriteSlices("itkImageSeriesReaderParallelSampling", { 0.0, 1.0, 2.0, 3.0, 4.0, 6.0, 7.0, 8.0, 9.0 }, image);
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 4 })
+  {
+    const auto reader = MakeReader(fileNames, numberOfWorkUnits);
+    reader->Update();
+    const ImageType * const output = reader->GetOutput();
+    EXPECT_TRUE(std::equal(image->GetBufferPointer(),
+                           image->GetBufferPointer() + image->GetPixelContainer()->Size(),
+                           output->GetBufferPointer()));
+
+    double maxSpacingDeviation = 0.0;
+    EXPECT_TRUE(itk::ExposeMetaData<double>(
+      output->GetMetaDataDictionary(), "ITK_non_uniform_sampling_deviation", maxSpacingDeviation));
+    EXPECT_GT(maxSpacingDeviation, 0.0);
+
+    const ReaderType::DictionaryArrayType & dictionaries = *reader->GetMetaDataDictionaryArray();
+    ASSERT_EQ(dictionaries.size(), fileNames.size());
+    EXPECT_FALSE(dictionaries[0]->HasKey("ITK_non_uniform_sampling_deviation"));
+    EXPECT_TRUE(dictionaries[5]->HasKey("ITK_non_uniform_sampling_deviation"));
+  }
+}
+
+
+TEST_F(ITKImageSeriesReaderParallelTest, ReportsErrorOfAnySlice)
+{
+  ImageType::Pointer image;
+  auto               fileNames = WriteSlices("itkImageSeriesReaderParallelError", UniformSliceOrigins(8), image);
+
+  // A slice of another size.
+  auto slice = ImageType::New();
+  slice->SetRegions(ImageType::RegionType(ImageType::SizeType{ { 5, 7, 1 } }));
+  slice->Allocate(true);
+  slice->SetOrigin(itk::MakePoint(0.0, 0.0, 5.0));
+  itk::WriteImage(slice, fileNames[5]);
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 4 })
+  {
+    const auto reader = MakeReader(fileNames, numberOfWorkUnits);
+    EXPECT_THROW(reader->Update(), itk::ExceptionObject);
+  }
+}
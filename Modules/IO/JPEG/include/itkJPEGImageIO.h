@@ -81,6 +81,13 @@ public:
   bool
   CanReadFile(const char *) override;
 
+  /** Several clones may read different files at the same time. */
+  bool
+  CanReadConcurrently() override
+  {
+    return true;
+  }
+
   /** Set the spacing and dimension information for the set filename. */
   void
   ReadImageInformation() override;
@@ -116,6 +123,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copies the settings of this ImageIO to a new one of the same class. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   WriteSlice(const std::string & fileName, const void * const buffer);
 
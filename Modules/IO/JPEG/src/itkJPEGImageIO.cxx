@@ -312,6 +312,21 @@ JPEGImageIO::JPEGImageIO()
 
 JPEGImageIO::~JPEGImageIO() = default;
 
+LightObject::Pointer
+JPEGImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const auto rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_Progressive = m_Progressive;
+  rval->m_CMYKtoRGB = m_CMYKtoRGB;
+  return loPtr;
+}
+
 void
 JPEGImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -74,6 +74,14 @@ extern ITKIOJPEG2000_EXPORT std::ostream &
  *  JPEG2000 offers a large collection of interesting features including:
  *  compression (lossless and lossy), streaming, multi-channel images.
  *
+ *  The wavelet transform of a codestream stores the image at several
+ *  resolution levels. SetReductionLevel() selects how many of the highest
+ *  levels are discarded when reading: the image is then read at 1/2^N of its
+ *  size, with a spacing of 2^N, for a fraction of the cost of decoding it at
+ *  full resolution. Only the tiles which intersect the IORegion are decoded,
+ *  on the threads of MultiThreaderBase::GetGlobalDefaultNumberOfThreads() when
+ *  OpenJPEG was built with thread support.
+ *
  *
  * This code was contributed in the Insight Journal paper:
  * "Support for Streaming the JPEG2000 File Format"
@@ -107,6 +115,13 @@ public:
   bool
   CanReadFile(const char *) override;
 
+  /** Several clones may read different files at the same time. */
+  bool
+  CanReadConcurrently() override
+  {
+    return true;
+  }
+
   /** Set the spacing and dimension information for the set filename. */
   void
   ReadImageInformation() override;
@@ -146,6 +161,16 @@ public:
   void
   SetTileSize(int x, int y);
 
+  /** Set/Get the number of highest resolution levels discarded when
+   * reading, 0 reading the image at full resolution. It must be lower than
+   * the number of resolution levels of the codestream. */
+  itkSetMacro(ReductionLevel, unsigned int);
+  itkGetConstMacro(ReductionLevel, unsigned int);
+
+  /** The number of resolution levels of the codestream, as reported by
+   * ReadImageInformation(). */
+  itkGetConstMacro(NumberOfResolutionLevels, unsigned int);
+
   /** Currently JPEG2000 does not support streamed writing
    *
    * These methods are re-overridden to not support streaming for
@@ -161,9 +186,16 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copies the reduction level, e.g. for reading a region in another thread. */
+  LightObject::Pointer
+  InternalClone() const override;
+
 private:
   std::unique_ptr<JPEG2000ImageIOInternal> m_Internal;
 
+  unsigned int m_ReductionLevel{ 0 };
+  unsigned int m_NumberOfResolutionLevels{ 0 };
+
   using SizeValueType = ImageIORegion::SizeValueType;
   using IndexValueType = ImageIORegion::IndexValueType;
 
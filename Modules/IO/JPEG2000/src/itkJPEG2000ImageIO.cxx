@@ -17,7 +17,9 @@
  *=========================================================================*/
 
 #include "itkJPEG2000ImageIO.h"
+#include "itkMultiThreaderBase.h"
 #include "itksys/SystemTools.hxx"
+#include <algorithm>
 
 // for memset
 // for malloc
@@ -109,6 +111,23 @@ void
 JPEG2000ImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  os << indent << "ReductionLevel: " << m_ReductionLevel << std::endl;
+  os << indent << "NumberOfResolutionLevels: " << m_NumberOfResolutionLevels << std::endl;
+}
+
+LightObject::Pointer
+JPEG2000ImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const auto rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_ReductionLevel = m_ReductionLevel;
+  return loPtr;
 }
 
 bool
@@ -291,11 +310,33 @@ JPEG2000ImageIO::ReadImageInformation()
   this->m_Internal->m_NumberOfTilesInX = cstr_info->tw;
   this->m_Internal->m_NumberOfTilesInY = cstr_info->th;
 
+  // The resolution levels common to all the components
+  this->m_NumberOfResolutionLevels = 0;
+  for (OPJ_UINT32 c = 0; cstr_info->m_default_tile_info.tccp_info && c < cstr_info->nbcomps; ++c)
+  {
+    const OPJ_UINT32 numberOfResolutions = cstr_info->m_default_tile_info.tccp_info[c].numresolutions;
+    this->m_NumberOfResolutionLevels =
+      c == 0 ? numberOfResolutions : std::min(this->m_NumberOfResolutionLevels, numberOfResolutions);
+  }
+
   if (cstr_info)
   {
     opj_destroy_cstr_info(&cstr_info);
   }
 
+  if (this->m_ReductionLevel >= this->m_NumberOfResolutionLevels)
+  {
+    opj_stream_destroy(cio);
+    opj_destroy_codec(this->m_Internal->m_Dinfo);
+    this->m_Internal->m_Dinfo = nullptr;
+    opj_image_destroy(l_image);
+    itkExceptionMacro("JPEG2000ImageIO failed to read file: "
+                      << this->GetFileName() << std::endl
+                      << "Reason: "
+                      << "Reduction level " << this->m_ReductionLevel << " requested, but the codestream has "
+                      << this->m_NumberOfResolutionLevels << " resolution levels");
+  }
+
 
   itkDebugMacro("Number of Components = " << l_image->numcomps);
   this->SetNumberOfComponents(l_image->numcomps);
@@ -345,11 +386,13 @@ JPEG2000ImageIO::ReadImageInformation()
   itkDebugMacro("image->x1 = " << l_image->x1);
   itkDebugMacro("image->y1 = " << l_image->y1);
 
-  this->SetDimensions(0, l_image->x1);
-  this->SetDimensions(1, l_image->y1);
+  // Each pixel of the resolution level read spans 2^N pixels of the full resolution along each dimension.
+  const OPJ_UINT32 reduction = this->m_ReductionLevel;
+  this->SetDimensions(0, (l_image->x1 + (1u << reduction) - 1) >> reduction);
+  this->SetDimensions(1, (l_image->y1 + (1u << reduction) - 1) >> reduction);
 
-  this->SetSpacing(0, 1.0); // FIXME : Get the real pixel resolution.
-  this->SetSpacing(1, 1.0); // FIXME : Get the real pixel resolution.
+  this->SetSpacing(0, static_cast<double>(1u << reduction)); // FIXME : Get the real pixel resolution.
+  this->SetSpacing(1, static_cast<double>(1u << reduction)); // FIXME : Get the real pixel resolution.
 
   /* close the byte stream */
   opj_stream_destroy(cio);
@@ -449,6 +492,24 @@ JPEG2000ImageIO::Read(void * buffer)
                                                               << "Reason: opj_read_header returns false");
   }
 
+  // Discard the highest resolution levels, and decode on several threads
+  if (this->m_ReductionLevel > 0 &&
+      !opj_set_decoded_resolution_factor(this->m_Internal->m_Dinfo, this->m_ReductionLevel))
+  {
+    opj_destroy_codec(this->m_Internal->m_Dinfo);
+    this->m_Internal->m_Dinfo = nullptr;
+    opj_stream_destroy(l_stream);
+    opj_image_destroy(l_image);
+    itkExceptionMacro("JPEG2000ImageIO failed to read file: "
+                      << this->GetFileName() << std::endl
+                      << "Reason: opj_set_decoded_resolution_factor returns false");
+  }
+  if (opj_has_thread_support())
+  {
+    opj_codec_set_threads(this->m_Internal->m_Dinfo,
+                          static_cast<int>(MultiThreaderBase::GetGlobalDefaultNumberOfThreads()));
+  }
+
   const ImageIORegion regionToRead = this->GetIORegion();
 
   ImageIORegion::SizeType  size = regionToRead.GetSize();
@@ -456,16 +517,17 @@ JPEG2000ImageIO::Read(void * buffer)
 
   const unsigned int sizex = size[0];
   const unsigned int sizey = size[1];
-  // const unsigned int sizez = size[2];
 
   const unsigned int startx = start[0];
   const unsigned int starty = start[1];
-  // const unsigned int startz = start[2];
 
-  auto p_start_x = static_cast<OPJ_INT32>(startx);
-  auto p_start_y = static_cast<OPJ_INT32>(starty);
-  auto p_end_x = static_cast<OPJ_INT32>(startx + sizex);
-  auto p_end_y = static_cast<OPJ_INT32>(starty + sizey);
+  // The decode area is expressed in the coordinates of the full resolution
+  const OPJ_UINT32 reduction = this->m_ReductionLevel;
+
+  auto p_start_x = static_cast<OPJ_INT32>(startx << reduction);
+  auto p_start_y = static_cast<OPJ_INT32>(starty << reduction);
+  auto p_end_x = static_cast<OPJ_INT32>(std::min<OPJ_UINT32>((startx + sizex) << reduction, l_image->x1));
+  auto p_end_y = static_cast<OPJ_INT32>(std::min<OPJ_UINT32>((starty + sizey) << reduction, l_image->y1));
 
   itkDebugMacro("opj_set_decode_area() before");
   itkDebugMacro("p_start_x = " << p_start_x);
@@ -482,161 +544,57 @@ JPEG2000ImageIO::Read(void * buffer)
     opj_destroy_codec(this->m_Internal->m_Dinfo);
     this->m_Internal->m_Dinfo = nullptr;
     opj_stream_destroy(l_stream);
+    opj_image_destroy(l_image);
     itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
                                                               << "Reason: opj_set_decode_area returns false");
   }
 
+  // Only the tiles which intersect the decode area are decoded, into
+  // components holding the area at the resolution level read.
+  if (!opj_decode(this->m_Internal->m_Dinfo, l_stream, l_image) ||
+      !opj_end_decompress(this->m_Internal->m_Dinfo, l_stream))
+  {
+    opj_destroy_codec(this->m_Internal->m_Dinfo);
+    this->m_Internal->m_Dinfo = nullptr;
+    opj_stream_destroy(l_stream);
+    opj_image_destroy(l_image);
+    itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
+                                                              << "Reason: opj_decode returns false");
+  }
 
-  OPJ_UINT32 l_max_data_size = 1000;
-
-  OPJ_BOOL l_go_on = true;
-
-  auto * l_data = (OPJ_BYTE *)opj_malloc(1000);
-
-  while (l_go_on)
+  const SizeValueType numberOfComponents = this->GetNumberOfComponents();
+  const SizeValueType numberOfPixels = SizeValueType(sizex) * SizeValueType(sizey);
+  for (unsigned int k = 0; k < numberOfComponents; ++k)
   {
-    OPJ_INT32 l_current_tile_x0;
-    OPJ_INT32 l_current_tile_y0;
-    OPJ_INT32 l_current_tile_x1;
-    OPJ_INT32 l_current_tile_y1;
-
-    OPJ_UINT32 l_tile_index;
-    OPJ_UINT32 l_data_size;
-
-    OPJ_UINT32     l_nb_comps;
-    const OPJ_BOOL tileHeaderRead = opj_read_tile_header(this->m_Internal->m_Dinfo,
-                                                         l_stream,
-                                                         &l_tile_index,
-                                                         &l_data_size,
-                                                         &l_current_tile_x0,
-                                                         &l_current_tile_y0,
-                                                         &l_current_tile_x1,
-                                                         &l_current_tile_y1,
-                                                         &l_nb_comps,
-                                                         &l_go_on);
-
-    if (!tileHeaderRead)
+    const opj_image_comp_t & component = l_image->comps[k];
+    if (!component.data || component.x0 != startx || component.y0 != starty || component.w != sizex ||
+        component.h != sizey)
     {
-      opj_free(l_data);
-      opj_stream_destroy(l_stream);
       opj_destroy_codec(this->m_Internal->m_Dinfo);
+      this->m_Internal->m_Dinfo = nullptr;
+      opj_stream_destroy(l_stream);
       opj_image_destroy(l_image);
-      itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
-                                                                << "Reason: opj_read_tile_header returns false");
+      itkExceptionMacro("JPEG2000ImageIO failed to read file: "
+                        << this->GetFileName() << std::endl
+                        << "Reason: unexpected decoded area of component " << k);
     }
 
-    itkDebugMacro("l_tile_index " << l_tile_index);
-    itkDebugMacro("l_data_size " << l_data_size);
-    itkDebugMacro("l_current_tile_x0 " << l_current_tile_x0);
-    itkDebugMacro("l_current_tile_y0 " << l_current_tile_y0);
-    itkDebugMacro("l_current_tile_x1 " << l_current_tile_x1);
-    itkDebugMacro("l_current_tile_y1 " << l_current_tile_y1);
-    itkDebugMacro("l_nb_comps " << l_nb_comps);
-    itkDebugMacro("l_go_on " << l_go_on);
-
-    if (l_go_on)
+    if (this->GetComponentType() == IOComponentEnum::UCHAR)
     {
-      if (l_data_size > l_max_data_size)
-      {
-        l_data = (OPJ_BYTE *)opj_realloc(l_data, l_data_size);
-
-        if (!l_data)
-        {
-          opj_stream_destroy(l_stream);
-          opj_destroy_codec(this->m_Internal->m_Dinfo);
-          opj_image_destroy(l_image);
-          itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
-                                                                    << "Reason: Error reallocating memory");
-        }
-
-        itkDebugMacro("reallocated for " << l_data_size);
-
-        l_max_data_size = l_data_size;
-      }
-
-      const bool decodeTileData =
-        opj_decode_tile_data(this->m_Internal->m_Dinfo, l_tile_index, l_data, l_data_size, l_stream);
-
-      if (!decodeTileData)
+      auto * charBuffer = static_cast<unsigned char *>(buffer) + k;
+      for (SizeValueType j = 0; j < numberOfPixels; ++j)
       {
-        opj_free(l_data);
-        opj_stream_destroy(l_stream);
-        opj_destroy_codec(this->m_Internal->m_Dinfo);
-        opj_image_destroy(l_image);
-        itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
-                                                                  << "Reason: opj_decode_tile_data returns false");
+        charBuffer[j * numberOfComponents] = static_cast<unsigned char>(component.data[j]);
       }
-
-      OPJ_BYTE * l_data_ptr = l_data;
-
-      const SizeValueType tsizex = l_current_tile_x1 - l_current_tile_x0;
-      const SizeValueType tsizey = l_current_tile_y1 - l_current_tile_y0;
-      const SizeValueType numberOfPixels = tsizex * tsizey;
-      const SizeValueType numberOfComponents = this->GetNumberOfComponents();
-      const SizeValueType sizePerComponentInBytes = l_data_size / (numberOfPixels * numberOfComponents);
-      const SizeValueType sizePerChannelInBytes = l_data_size / (numberOfComponents);
-
-      itkDebugMacro("sizePerComponentInBytes: " << sizePerComponentInBytes);
-      itkDebugMacro("sizePerChannelInBytes:   " << sizePerChannelInBytes);
-
-      const SizeValueType sizePerStrideXInBytes = sizePerChannelInBytes / tsizey;
-      const SizeValueType initialStrideInBytes =
-        (l_current_tile_y0 - p_start_y) * sizex * sizePerComponentInBytes * numberOfComponents;
-      const SizeValueType priorStrideInBytes =
-        (l_current_tile_x0 - p_start_x) * sizePerComponentInBytes * numberOfComponents;
-      const SizeValueType postStrideInBytes =
-        (p_end_x - l_current_tile_x1) * sizePerComponentInBytes * numberOfComponents;
-
-      itkDebugMacro("sizePerStrideYInBytes:   " << sizePerChannelInBytes / tsizex);
-      itkDebugMacro("sizePerStrideXInBytes:   " << sizePerStrideXInBytes);
-      itkDebugMacro("initialStrideInBytes:    " << initialStrideInBytes);
-      itkDebugMacro("priorStrideInBytes:      " << priorStrideInBytes);
-      itkDebugMacro("postStrideInBytes:       " << postStrideInBytes);
-
-
-      // TODO: Read the void buffer within the tile ROI. How do we specify the
-      // tile ROI iteration
-      for (unsigned int k = 0; k < numberOfComponents; ++k)
+    }
+    else
+    {
+      auto * shortBuffer = static_cast<unsigned short *>(buffer) + k;
+      for (SizeValueType j = 0; j < numberOfPixels; ++j)
       {
-        auto * charBuffer = (unsigned char *)buffer;
-        charBuffer += k * sizePerComponentInBytes;
-
-        charBuffer += initialStrideInBytes;
-
-        for (SizeValueType m = 0; m < tsizey; ++m)
-        {
-          charBuffer += priorStrideInBytes;
-          for (SizeValueType j = 0; j < sizePerStrideXInBytes; ++j)
-          {
-            *charBuffer = static_cast<unsigned char>(*l_data_ptr++);
-            charBuffer += numberOfComponents;
-          }
-          charBuffer += postStrideInBytes;
-        }
+        shortBuffer[j * numberOfComponents] = static_cast<unsigned short>(component.data[j]);
       }
     }
-    //       l_go_on = 0;
-  }
-
-  //  l_image = opj_decode( this->m_Dinfo, l_stream );
-
-  if (!opj_end_decompress(this->m_Internal->m_Dinfo, l_stream))
-  {
-    opj_free(l_data);
-    opj_stream_destroy(l_stream);
-    opj_destroy_codec(this->m_Internal->m_Dinfo);
-    opj_image_destroy(l_image);
-    itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
-                                                              << "Reason: opj_end_decompress returns false");
-  }
-
-  if (!l_image)
-  {
-    opj_destroy_codec(this->m_Internal->m_Dinfo);
-    this->m_Internal->m_Dinfo = nullptr;
-    opj_stream_destroy(l_stream);
-    itkExceptionMacro("JPEG2000ImageIO failed to read file: " << this->GetFileName() << std::endl
-                                                              << "Reason: error whle reading image");
   }
 
   /* close the byte stream */
@@ -648,15 +606,7 @@ JPEG2000ImageIO::Read(void * buffer)
     this->m_Internal->m_Dinfo = nullptr;
   }
 
-  if (l_image)
-  {
-    opj_image_destroy(l_image);
-  }
-
-  if (l_data)
-  {
-    opj_free(l_data);
-  }
+  opj_image_destroy(l_image);
 
   itkDebugMacro("JPEG2000ImageIO::Read() End");
 }
@@ -1031,8 +981,12 @@ JPEG2000ImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORe
   // Compute the required set of tiles that fully contain the requested region
   streamableRegion = requestedRegion;
 
-  this->ComputeRegionInTileBoundaries(0, this->m_Internal->m_TileWidth, streamableRegion);
-  this->ComputeRegionInTileBoundaries(1, this->m_Internal->m_TileHeight, streamableRegion);
+  // The tiles of the resolution level read
+  const OPJ_UINT32 reduction = this->m_ReductionLevel;
+  this->ComputeRegionInTileBoundaries(
+    0, std::max<SizeValueType>(this->m_Internal->m_TileWidth >> reduction, 1), streamableRegion);
+  this->ComputeRegionInTileBoundaries(
+    1, std::max<SizeValueType>(this->m_Internal->m_TileHeight >> reduction, 1), streamableRegion);
 
 
   itkDebugMacro("Streamable region = " << streamableRegion);
@@ -1062,7 +1016,7 @@ JPEG2000ImageIO::ComputeRegionInTileBoundaries(unsigned int    dimension,
 
   const IndexValueType endQuantizedInTileSize = startQuantizedInTileSize + sizeQuantizedInTileSize - 1;
 
-  if (endQuantizedInTileSize > static_cast<int>(this->GetDimensions(dimension)))
+  if (endQuantizedInTileSize >= static_cast<IndexValueType>(this->GetDimensions(dimension)))
   {
     sizeQuantizedInTileSize = this->GetDimensions(dimension) - startQuantizedInTileSize;
   }
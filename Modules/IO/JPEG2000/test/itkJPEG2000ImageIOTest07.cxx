@@ -0,0 +1,134 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkJPEG2000ImageIO.h"
+#include "itkTestingMacros.h"
+
+// Writes a tiled codestream, then reads it at reduced resolution levels,
+// as a whole and by regions.
+
+namespace
+{
+using ImageType = itk::Image<unsigned char, 2>;
+
+ImageType::Pointer
+itkJPEG2000ImageIOTest07Read(const std::string &         fileName,
+                             unsigned int                reductionLevel,
+                             const ImageType::RegionType & region)
+{
+  auto io = itk::JPEG2000ImageIO::New();
+  io->SetReductionLevel(reductionLevel);
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(io);
+  reader->SetUseStreaming(true);
+  reader->UpdateOutputInformation();
+  if (region.GetNumberOfPixels() > 0)
+  {
+    reader->GetOutput()->SetRequestedRegion(region);
+  }
+  reader->Update();
+  return reader->GetOutput();
+}
+
+} // namespace
+
+int
+itkJPEG2000ImageIOTest07(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv);
+    std::cerr << " outputdir" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = std::string(argv[1]) + "/itkJPEG2000ImageIOTest07.j2k";
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 300, 200 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<unsigned char>((index[0] * 3 + index[1] * 5) % 256));
+  }
+
+  auto writerIO = itk::JPEG2000ImageIO::New();
+  writerIO->SetTileSize(64, 64);
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetFileName(fileName);
+  writer->SetInput(image);
+  writer->SetImageIO(writerIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  // The full resolution, decoded losslessly.
+  const ImageType::Pointer full = itkJPEG2000ImageIOTest07Read(fileName, 0, ImageType::RegionType());
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(full, full->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ITK_TEST_EXPECT_EQUAL(static_cast<int>(it.Get()), static_cast<int>(image->GetPixel(it.GetIndex())));
+  }
+
+  auto readerIO = itk::JPEG2000ImageIO::New();
+  readerIO->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(readerIO->ReadImageInformation());
+  ITK_TEST_EXPECT_EQUAL(readerIO->GetNumberOfResolutionLevels(), 6);
+  readerIO->SetReductionLevel(6);
+  ITK_TRY_EXPECT_EXCEPTION(readerIO->ReadImageInformation());
+
+  // A reduced level, whose regions are decoded from the tiles which contain them.
+  readerIO->SetReductionLevel(2);
+  ITK_TRY_EXPECT_NO_EXCEPTION(readerIO->ReadImageInformation());
+  ITK_TEST_EXPECT_EQUAL(readerIO->GetDimensions(0), 75);
+  ITK_TEST_EXPECT_EQUAL(readerIO->GetDimensions(1), 50);
+  ITK_TEST_EXPECT_EQUAL(readerIO->GetSpacing(0), 4.0);
+  ITK_TEST_EXPECT_EQUAL(readerIO->GetSpacing(1), 4.0);
+
+  const ImageType::Pointer reduced = itkJPEG2000ImageIOTest07Read(fileName, 2, ImageType::RegionType());
+  ITK_TEST_EXPECT_EQUAL(reduced->GetLargestPossibleRegion().GetSize(), ImageType::SizeType({ { 75, 50 } }));
+  ITK_TEST_EXPECT_EQUAL(reduced->GetSpacing()[0], 4.0);
+
+  const ImageType::RegionType region({ { 13, 9 } }, { { 40, 30 } });
+  const ImageType::Pointer    part = itkJPEG2000ImageIOTest07Read(fileName, 2, region);
+  ITK_TEST_EXPECT_TRUE(part->GetBufferedRegion().IsInside(region));
+  ITK_TEST_EXPECT_TRUE(part->GetBufferedRegion() != reduced->GetBufferedRegion());
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(part, part->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ITK_TEST_EXPECT_EQUAL(static_cast<int>(it.Get()), static_cast<int>(reduced->GetPixel(it.GetIndex())));
+  }
+
+  // The lowest resolution of a constant image is the constant.
+  auto constant = ImageType::New();
+  constant->SetRegions(image->GetLargestPossibleRegion());
+  constant->Allocate();
+  constant->FillBuffer(77);
+  writer->SetInput(constant);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  const ImageType::Pointer lowest = itkJPEG2000ImageIOTest07Read(fileName, 5, ImageType::RegionType());
+  ITK_TEST_EXPECT_EQUAL(lowest->GetLargestPossibleRegion().GetSize(), ImageType::SizeType({ { 10, 7 } }));
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(lowest, lowest->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ITK_TEST_EXPECT_EQUAL(static_cast<int>(it.Get()), 77);
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
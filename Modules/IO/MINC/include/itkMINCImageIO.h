@@ -135,6 +135,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copies the settings of this ImageIO to a new one of the same class. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   WriteSlice(std::string & fileName, const void * buffer);
 
@@ -273,6 +273,20 @@ MINCImageIO::MINCImageIO()
 
 MINCImageIO::~MINCImageIO() { this->CloseVolume(); }
 
+LightObject::Pointer
+MINCImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const auto rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_RAStoLPS = m_RAStoLPS;
+  return loPtr;
+}
+
 void
 MINCImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -0,0 +1,238 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMeshASCIIParser_h
+#define itkMeshASCIIParser_h
+#include "ITKIOMeshBaseExport.h"
+
+#include "itkMacro.h"
+#include "itkMemoryMappedFile.h"
+#include "itkMultiThreaderBase.h"
+
+#include <atomic>
+#include <charconv>
+#include <numeric>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace itk
+{
+/** \class MeshASCIIParser
+ * \brief Parses the text of an ASCII mesh file mapped into memory.
+ *
+ * The file is mapped read-only (see MemoryMappedFile) instead of being read
+ * through a stream, and its numbers are converted in place: integers by
+ * std::from_chars, floating point numbers by double-conversion, which also
+ * accepts the "nan", "NaN", "inf", "Infinity" and "-Infinity" written by VTK.
+ * Sections holding many numbers are split into chunks, which are parsed
+ * concurrently on the threads of the multi-threader.
+ *
+ * \ingroup ITKIOMeshBase
+ */
+class ITKIOMeshBase_EXPORT MeshASCIIParser
+{
+public:
+  using TextType = std::string_view;
+
+  /** Maps the file. An exception is thrown when it cannot be opened. */
+  explicit MeshASCIIParser(const std::string & fileName);
+
+  /** The text of the whole file. */
+  TextType
+  GetText() const
+  {
+    return m_Text;
+  }
+
+  /** Removes the first line of the text, and returns it without its end of
+   * line. */
+  static TextType
+  GetLine(TextType & text);
+
+  /** Removes the first white space separated token of the text, and returns
+   * it, or an empty token at the end of the text. */
+  static TextType
+  GetToken(TextType & text);
+
+  /** Splits the text into chunks of whole lines, to be parsed concurrently. */
+  static std::vector<TextType>
+  SplitLines(TextType text);
+
+  /** Returns the number of white space separated tokens of the text. */
+  static SizeValueType
+  CountTokens(TextType text)
+  {
+    SizeValueType count = 0;
+    while (!GetToken(text).empty())
+    {
+      ++count;
+    }
+    return count;
+  }
+
+  /** Concurrently counts the values of each chunk with count(chunk), which
+   * must sum up to bufferSize, and then concurrently parses each chunk with
+   * parse(chunk, offset) into the buffer, starting at the sum of the counts of
+   * the previous chunks. parse returns false when the chunk is invalid, and
+   * an exception is thrown then. */
+  template <typename TCount, typename TParse>
+  static void
+  ParseChunks(const std::vector<TextType> & chunks, TCount count, TParse parse, SizeValueType bufferSize)
+  {
+    const auto                 multiThreader = MultiThreaderBase::New();
+    std::vector<SizeValueType> offsets(chunks.size() + 1, 0);
+    multiThreader->ParallelizeArray(
+      0, chunks.size(), [&](SizeValueType k) { offsets[k + 1] = count(chunks[k]); }, nullptr);
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    if (offsets.back() != bufferSize)
+    {
+      itkGenericExceptionMacro("Found " << offsets.back() << " values instead of " << bufferSize
+                                        << ", the file may have been modified after its information was read");
+    }
+
+    std::atomic<bool> valid{ true };
+    multiThreader->ParallelizeArray(
+      0,
+      chunks.size(),
+      [&](SizeValueType k) {
+        if (!parse(chunks[k], offsets[k]))
+        {
+          valid = false;
+        }
+      },
+      nullptr);
+    if (!valid)
+    {
+      itkGenericExceptionMacro("Failed to parse the numbers of an ASCII mesh file");
+    }
+  }
+
+  /** Converts a whole token into a number. Returns false when the token is
+   * not a number of this type. */
+  template <typename T>
+  static bool
+  ToNumber(TextType token, T & value)
+  {
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      double     number;
+      const bool converted = ToNumber(token, number);
+      value = static_cast<T>(number);
+      return converted;
+    }
+    else
+    {
+      if (!token.empty() && token.front() == '+')
+      {
+        token.remove_prefix(1);
+      }
+      const auto result = std::from_chars(token.data(), token.data() + token.size(), value);
+      return result.ec == std::errc() && result.ptr == token.data() + token.size();
+    }
+  }
+
+  static bool
+  ToNumber(TextType token, float & value);
+
+  static bool
+  ToNumber(TextType token, double & value);
+
+  /** Parses numberOfValues white space separated numbers from the start of
+   * the text into the buffer, and returns the text that follows them. The
+   * extent of the numbers is found first, and then they are converted
+   * concurrently. An exception is thrown when there are not enough numbers,
+   * or when one of them is invalid. */
+  template <typename T>
+  static TextType
+  ParseNumbers(TextType text, T * buffer, SizeValueType numberOfValues)
+  {
+    std::vector<TextType>      chunks;
+    std::vector<SizeValueType> chunkOffsets;
+    SizeValueType              count = 0;
+    size_t                     chunkStart = 0;
+    size_t                     position = 0;
+    while (count < numberOfValues)
+    {
+      while (position < text.size() && IsSpace(text[position]))
+      {
+        ++position;
+      }
+      if (position == text.size())
+      {
+        break;
+      }
+      if (chunks.size() == chunkOffsets.size())
+      {
+        chunkStart = position;
+        chunkOffsets.push_back(count);
+      }
+      ++count;
+      while (position < text.size() && !IsSpace(text[position]))
+      {
+        ++position;
+      }
+      if (position - chunkStart >= ChunkSize || count == numberOfValues)
+      {
+        chunks.push_back(text.substr(chunkStart, position - chunkStart));
+      }
+    }
+    if (count < numberOfValues)
+    {
+      itkGenericExceptionMacro("Expected " << numberOfValues << " numbers, but found only " << count);
+    }
+
+    std::atomic<bool> failed{ false };
+    MultiThreaderBase::New()->ParallelizeArray(
+      0,
+      chunks.size(),
+      [&](SizeValueType k) {
+        TextType chunk = chunks[k];
+        T *      values = buffer + chunkOffsets[k];
+        for (TextType token = GetToken(chunk); !token.empty(); token = GetToken(chunk))
+        {
+          if (!ToNumber(token, *values++))
+          {
+            failed = true;
+            return;
+          }
+        }
+      },
+      nullptr);
+    if (failed)
+    {
+      itkGenericExceptionMacro("Failed to parse the numbers of an ASCII mesh file");
+    }
+    return text.substr(position);
+  }
+
+  static bool
+  IsSpace(char c)
+  {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+  }
+
+private:
+  /** The approximate number of bytes of a chunk parsed by a thread. */
+  static constexpr size_t ChunkSize = 1 << 20;
+
+  MemoryMappedFile::Pointer m_File{};
+  TextType                  m_Text{};
+};
+} // end namespace itk
+
+#endif // itkMeshASCIIParser_h
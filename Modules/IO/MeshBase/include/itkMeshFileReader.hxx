@@ -28,8 +28,10 @@
 
 #include "itksys/SystemTools.hxx"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkVectorContainer.h"
 
 #include <fstream>
+#include <type_traits>
 
 namespace itk
 {
@@ -823,6 +825,24 @@ template <typename T>
 void
 MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::ReadPointsUsingMeshIO()
 {
+  using PointsContainer = typename TOutputMesh::PointsContainer;
+  if constexpr (std::is_same_v<T, OutputCoordinateType> &&
+                std::is_same_v<PointsContainer,
+                               detail::VectorContainer<typename PointsContainer::ElementIdentifier, OutputPointType>>)
+  {
+    // The points are stored contiguously, and have the coordinate type of the
+    // file, so they are read directly into the points container.
+    static_assert(sizeof(OutputPointType) == OutputPointDimension * sizeof(T));
+    if (m_MeshIO->GetPointDimension() == OutputPointDimension)
+    {
+      PointsContainer * const points = this->GetOutput()->GetPoints();
+      points->CastToSTLContainer().resize(m_MeshIO->GetNumberOfPoints());
+      m_MeshIO->ReadPoints(points->CastToSTLContainer().data());
+      points->Modified();
+      return;
+    }
+  }
+
   const auto buffer = make_unique_for_overwrite<T[]>(m_MeshIO->GetNumberOfPoints() * OutputPointDimension);
   m_MeshIO->ReadPoints(buffer.get());
   Self::ReadPoints(buffer.get());
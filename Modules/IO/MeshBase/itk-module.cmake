@@ -15,6 +15,8 @@ itk_module(
   ITKQuadEdgeMesh
   ITKMesh
   ITKVoronoi
+  PRIVATE_DEPENDS
+  ITKDoubleConversion
   TEST_DEPENDS
   ITKTestKernel
   DESCRIPTION
@@ -0,0 +1,141 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMeshASCIIParser.h"
+
+#include "itksys/SystemTools.hxx"
+
+#include <double-conversion/string-to-double.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace itk
+{
+MeshASCIIParser::MeshASCIIParser(const std::string & fileName)
+{
+  if (!itksys::SystemTools::FileExists(fileName, true))
+  {
+    itkGenericExceptionMacro("Cannot open file " << fileName);
+  }
+  const auto numberOfBytes = static_cast<SizeValueType>(itksys::SystemTools::FileLength(fileName));
+  if (numberOfBytes > 0)
+  {
+    m_File = MemoryMappedFile::New();
+    m_File->Map(fileName, 0, numberOfBytes, IOCommonEnums::MemoryMapping::ReadOnly);
+    m_Text = TextType(static_cast<const char *>(m_File->GetData()), numberOfBytes);
+  }
+}
+
+auto
+MeshASCIIParser::GetLine(TextType & text) -> TextType
+{
+  const size_t end = text.find('\n');
+  TextType     line = text.substr(0, end);
+  text.remove_prefix(end == TextType::npos ? text.size() : end + 1);
+  if (!line.empty() && line.back() == '\r')
+  {
+    line.remove_suffix(1);
+  }
+  return line;
+}
+
+auto
+MeshASCIIParser::GetToken(TextType & text) -> TextType
+{
+  size_t start = 0;
+  while (start < text.size() && IsSpace(text[start]))
+  {
+    ++start;
+  }
+  size_t end = start;
+  while (end < text.size() && !IsSpace(text[end]))
+  {
+    ++end;
+  }
+  const TextType token = text.substr(start, end - start);
+  text.remove_prefix(end);
+  return token;
+}
+
+auto
+MeshASCIIParser::SplitLines(TextType text) -> std::vector<TextType>
+{
+  const size_t maximumNumberOfChunks = 4 * size_t{ MultiThreaderBase::GetGlobalDefaultNumberOfThreads() };
+  const size_t numberOfChunks = std::clamp(text.size() / ChunkSize, size_t{ 1 }, maximumNumberOfChunks);
+  const size_t chunkSize = text.size() / numberOfChunks + 1;
+
+  std::vector<TextType> chunks;
+  while (!text.empty())
+  {
+    size_t end = text.find('\n', std::min(chunkSize, text.size()) - 1);
+    end = end == TextType::npos ? text.size() : end + 1;
+    chunks.push_back(text.substr(0, end));
+    text.remove_prefix(end);
+  }
+  return chunks;
+}
+
+namespace
+{
+// Same conventions as the ASCII reader of VTKPolyDataMeshIO.
+template <typename TFloatingPoint>
+bool
+ToFloatingPoint(std::string_view token, TFloatingPoint & value)
+{
+  using NumericLimits = std::numeric_limits<TFloatingPoint>;
+
+  if (token == "NaN")
+  {
+    value = NumericLimits::quiet_NaN();
+    return true;
+  }
+  if (token == "Infinity")
+  {
+    value = NumericLimits::infinity();
+    return true;
+  }
+  if (token == "-Infinity")
+  {
+    value = -NumericLimits::infinity();
+    return true;
+  }
+  if (token.empty())
+  {
+    return false;
+  }
+
+  constexpr auto double_NaN = std::numeric_limits<double>::quiet_NaN();
+  static const double_conversion::StringToDoubleConverter converter(0, double_NaN, double_NaN, "inf", "nan");
+  int                                                     processedCharCount{ 0 };
+  value = converter.StringTo<TFloatingPoint>(token.data(), static_cast<int>(token.size()), &processedCharCount);
+  return processedCharCount == static_cast<int>(token.size());
+}
+} // namespace
+
+bool
+MeshASCIIParser::ToNumber(TextType token, float & value)
+{
+  return ToFloatingPoint(token, value);
+}
+
+bool
+MeshASCIIParser::ToNumber(TextType token, double & value)
+{
+  return ToFloatingPoint(token, value);
+}
+} // end namespace itk
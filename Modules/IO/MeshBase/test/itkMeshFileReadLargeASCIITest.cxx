@@ -0,0 +1,110 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMeshFileReader.h"
+#include "itkMeshFileWriter.h"
+#include "itkMesh.h"
+#include "itkTriangleCell.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <array>
+
+// Writes a mesh that is large enough to be parsed in several chunks, and
+// reads it back.
+int
+itkMeshFileReadLargeASCIITest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters " << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputFileName" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension = 3;
+  using MeshType = itk::Mesh<float, Dimension>;
+  using CellType = MeshType::CellType;
+  using TriangleCellType = itk::TriangleCell<CellType>;
+
+  constexpr unsigned int size = 300;
+  auto                   mesh = MeshType::New();
+  for (unsigned int j = 0; j < size; ++j)
+  {
+    for (unsigned int i = 0; i < size; ++i)
+    {
+      MeshType::PointType point;
+      point[0] = 0.5f * i;
+      point[1] = -0.25f * j;
+      point[2] = 0.1f * static_cast<float>((i * j) % 7);
+      mesh->SetPoint(j * size + i, point);
+    }
+  }
+  MeshType::CellIdentifier cellId = 0;
+  for (unsigned int j = 0; j + 1 < size; ++j)
+  {
+    for (unsigned int i = 0; i + 1 < size; ++i)
+    {
+      const MeshType::PointIdentifier corner = j * size + i;
+      for (const auto & ids : { std::array{ corner, corner + 1, corner + size },
+                                std::array{ corner + 1, corner + size + 1, corner + size } })
+      {
+        CellType::CellAutoPointer cell;
+        cell.TakeOwnership(new TriangleCellType);
+        cell->SetPointIds(ids.data());
+        mesh->SetCell(cellId++, cell);
+      }
+    }
+  }
+
+  const std::string fileName = argv[1];
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteMesh(mesh, fileName));
+
+  MeshType::Pointer readMesh;
+  ITK_TRY_EXPECT_NO_EXCEPTION(readMesh = itk::ReadMesh<MeshType>(fileName));
+
+  ITK_TEST_EXPECT_EQUAL(readMesh->GetNumberOfPoints(), mesh->GetNumberOfPoints());
+  for (MeshType::PointIdentifier id = 0; id < mesh->GetNumberOfPoints(); ++id)
+  {
+    if (readMesh->GetPoint(id) != mesh->GetPoint(id))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in point " << id << ": expected " << mesh->GetPoint(id) << ", but got "
+                << readMesh->GetPoint(id) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  ITK_TEST_EXPECT_EQUAL(readMesh->GetNumberOfCells(), mesh->GetNumberOfCells());
+  auto readCell = readMesh->GetCells()->Begin();
+  for (auto cell = mesh->GetCells()->Begin(); cell != mesh->GetCells()->End(); ++cell, ++readCell)
+  {
+    const CellType * expected = cell.Value();
+    const CellType * actual = readCell.Value();
+    if (actual->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+        !std::equal(expected->PointIdsBegin(), expected->PointIdsEnd(), actual->PointIdsBegin()))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in the point ids of cell " << cell.Index() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -185,6 +185,10 @@ protected:
   CloseFile();
 
 private:
+  /** Read the vectors of the lines of the given type, "v" or "vn". */
+  void
+  ReadVectors(const char * lineType, float * buffer, SizeValueType numberOfVectors);
+
   std::ifstream  m_InputFile{};
   std::streampos m_PointsStartPosition{}; // file position for points relative to
                                           // std::ios::beg
@@ -19,13 +19,37 @@
 #include "itkOBJMeshIO.h"
 #include "itkNumericTraits.h"
 #include "itksys/SystemTools.hxx"
-#include "itkMakeUniqueForOverwrite.h"
+#include "itkMeshASCIIParser.h"
+#include "itkMultiThreaderBase.h"
 #include <locale>
 #include <vector>
 
 
 namespace itk
 {
+namespace
+{
+using TextType = MeshASCIIParser::TextType;
+
+// Calls function(type, content) for each line of the text which has some
+// content after its type.
+template <typename TFunction>
+void
+ForEachLine(TextType text, TFunction function)
+{
+  while (!text.empty())
+  {
+    TextType       content = MeshASCIIParser::GetLine(text);
+    const TextType type = MeshASCIIParser::GetToken(content);
+    if (!type.empty() && !content.empty())
+    {
+      function(type, content);
+    }
+  }
+}
+
+} // namespace
+
 OBJMeshIO::OBJMeshIO() { this->AddSupportedWriteExtension(".obj"); }
 
 OBJMeshIO::~OBJMeshIO() = default;
@@ -126,43 +150,54 @@ OBJMeshIO::SplitLine(const std::string & line, std::string & type, std::string &
 void
 OBJMeshIO::ReadMeshInformation()
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
+  const MeshASCIIParser parser(this->m_FileName);
+
+  // Count the lines of each type in concurrently parsed chunks of the file
+  struct LineCounts
+  {
+    SizeValueType points{};
+    SizeValueType cells{};
+    SizeValueType cellPoints{};
+    SizeValueType pointPixels{};
+  };
+  const std::vector<TextType> chunks = MeshASCIIParser::SplitLines(parser.GetText());
+  std::vector<LineCounts>     counts(chunks.size());
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    chunks.size(),
+    [&chunks, &counts](SizeValueType k) {
+      ForEachLine(chunks[k], [&count = counts[k]](TextType type, TextType content) {
+        if (type == "v")
+        {
+          ++count.points;
+        }
+        else if (type == "f")
+        {
+          ++count.cells;
+          count.cellPoints += MeshASCIIParser::CountTokens(content);
+        }
+        else if (type == "vn")
+        {
+          ++count.pointPixels;
+        }
+      });
+    },
+    nullptr);
 
-  // Read and analyze the first line in the file
   SizeValueType numberOfCellPoints = 0;
   this->m_NumberOfPoints = 0;
   this->m_NumberOfCells = 0;
   this->m_NumberOfPointPixels = 0;
-  std::string       line;
-  std::string       inputLine;
-  std::string       type;
-  const std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
+  for (const LineCounts & count : counts)
   {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "v")
-      {
-        this->m_NumberOfPoints++;
-      }
-      else if (type == "f")
-      {
-        this->m_NumberOfCells++;
-
-        std::stringstream ss(inputLine);
-        std::string       item;
-        while (ss >> item)
-        {
-          ++numberOfCellPoints;
-        }
-      }
-      else if (type == "vn")
-      {
-        this->m_NumberOfPointPixels++;
-        this->m_UpdatePointData = true;
-      }
-    }
+    this->m_NumberOfPoints += count.points;
+    this->m_NumberOfCells += count.cells;
+    numberOfCellPoints += count.cellPoints;
+    this->m_NumberOfPointPixels += count.pointPixels;
+  }
+  if (this->m_NumberOfPointPixels)
+  {
+    this->m_UpdatePointData = true;
   }
 
   this->m_PointDimension = 3;
@@ -205,130 +240,96 @@ OBJMeshIO::ReadMeshInformation()
   this->m_CellPixelType = IOPixelEnum::VECTOR;
   this->m_NumberOfCellPixelComponents = 3;
   this->m_UpdateCellData = false;
-
-  CloseFile();
 }
 
 void
 OBJMeshIO::ReadPoints(void * buffer)
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
-
-  // Number of data array
-  auto *        data = static_cast<float *>(buffer);
-  SizeValueType index = 0;
-
-  // Read and analyze the first line in the file
-  std::string       line;
-  std::string       inputLine;
-  std::string       type;
-  const std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
-  {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "v")
-      {
-        std::stringstream ss(inputLine);
-        for (unsigned int ii = 0; ii < this->m_PointDimension; ++ii)
-        {
-          ss >> data[index++];
-        }
-      }
-    }
-  }
-
-  CloseFile();
+  this->ReadVectors("v", static_cast<float *>(buffer), this->m_NumberOfPoints);
 }
 
 void
 OBJMeshIO::ReadCells(void * buffer)
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
-
-  // Read and analyze the first line in the file
-  const auto    data = make_unique_for_overwrite<long[]>(this->m_CellBufferSize - this->m_NumberOfCells);
-  SizeValueType index = 0;
-
-  std::string       line;
-  std::string       inputLine;
-  std::string       type;
-  const std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
-  {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "f")
-      {
-        std::stringstream ss(inputLine);
-        std::string       item;
-        std::vector<long> idList;
-        while (ss >> item)
+  const MeshASCIIParser parser(this->m_FileName);
+
+  // The polygons are written directly into the cells buffer, as
+  // [POLYGON_CELL, number of points, point ids...]
+  auto * data = static_cast<long *>(buffer);
+  MeshASCIIParser::ParseChunks(
+    MeshASCIIParser::SplitLines(parser.GetText()),
+    [](TextType chunk) {
+      SizeValueType size = 0;
+      ForEachLine(chunk, [&size](TextType type, TextType content) {
+        if (type == "f")
         {
-          long                   id;
-          std::string::size_type pos = item.find('/');
-          while (pos != std::string::npos)
-          {
-            item.replace(pos, 1, " ");
-            pos = item.find('/', pos);
-          }
-
-          std::stringstream st(item);
-          st >> id;
-
-          idList.push_back(id);
+          size += 2 + MeshASCIIParser::CountTokens(content);
         }
-
-        data[index++] = static_cast<long>(idList.size());
-        for (const long it : idList)
+      });
+      return size;
+    },
+    [data](TextType chunk, SizeValueType offset) {
+      bool valid = true;
+      long * cell = data + offset;
+      ForEachLine(chunk, [&valid, &cell](TextType type, TextType content) {
+        if (type == "f")
         {
-          data[index++] = (it - 1);
+          *cell++ = static_cast<long>(CellGeometryEnum::POLYGON_CELL);
+          *cell++ = static_cast<long>(MeshASCIIParser::CountTokens(content));
+          for (TextType item = MeshASCIIParser::GetToken(content); !item.empty();
+               item = MeshASCIIParser::GetToken(content))
+          {
+            // Only the vertex index of "v/vt/vn" is used
+            long id{};
+            valid = MeshASCIIParser::ToNumber(item.substr(0, item.find('/')), id) && valid;
+            *cell++ = id - 1;
+          }
         }
-      }
-    }
-  }
-
-  CloseFile();
-
-  this->WriteCellsBuffer(
-    data.get(), static_cast<long *>(buffer), CellGeometryEnum::POLYGON_CELL, this->m_NumberOfCells);
-  // this->WriteCellsBuffer(data, static_cast<unsigned int *>(buffer),
-  // CellGeometryEnum::TRIANGLE_CELL, 3, this->m_NumberOfCells);
+      });
+      return valid;
+    },
+    this->m_CellBufferSize);
 }
 
 void
 OBJMeshIO::ReadPointData(void * buffer)
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
-
-  // Number of data array
-  auto *        data = static_cast<float *>(buffer);
-  SizeValueType index = 0;
-
-  // Read and analyze the first line in the file
-  std::string       line;
-  std::string       inputLine;
-  std::string       type;
-  const std::locale loc;
-  while (std::getline(m_InputFile, line, '\n'))
-  {
-    if (SplitLine(line, type, inputLine) && !inputLine.empty())
-    {
-      if (type == "vn")
-      {
-        std::stringstream ss(inputLine);
-        for (unsigned int ii = 0; ii < this->m_PointDimension; ++ii)
+  this->ReadVectors("vn", static_cast<float *>(buffer), this->m_NumberOfPointPixels);
+}
+
+void
+OBJMeshIO::ReadVectors(const char * lineType, float * buffer, SizeValueType numberOfVectors)
+{
+  const MeshASCIIParser parser(this->m_FileName);
+
+  const unsigned int dimension = this->m_PointDimension;
+  MeshASCIIParser::ParseChunks(
+    MeshASCIIParser::SplitLines(parser.GetText()),
+    [lineType, dimension](TextType chunk) {
+      SizeValueType size = 0;
+      ForEachLine(chunk, [lineType, dimension, &size](TextType type, TextType) {
+        if (type == lineType)
         {
-          ss >> data[index++];
+          size += dimension;
         }
-      }
-    }
-  }
-
-  CloseFile();
+      });
+      return size;
+    },
+    [lineType, dimension, buffer](TextType chunk, SizeValueType offset) {
+      bool    valid = true;
+      float * values = buffer + offset;
+      ForEachLine(chunk, [lineType, dimension, &valid, &values](TextType type, TextType content) {
+        if (type == lineType)
+        {
+          for (unsigned int ii = 0; ii < dimension; ++ii)
+          {
+            valid = MeshASCIIParser::ToNumber(MeshASCIIParser::GetToken(content), *values++) && valid;
+          }
+        }
+      });
+      return valid;
+    },
+    numberOfVectors * dimension);
 }
 
 void
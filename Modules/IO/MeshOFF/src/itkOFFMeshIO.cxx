@@ -20,9 +20,59 @@
 
 #include "itksys/SystemTools.hxx"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMeshASCIIParser.h"
+#include "itkMultiThreaderBase.h"
 
 namespace itk
 {
+namespace
+{
+using TextType = MeshASCIIParser::TextType;
+
+// Returns the lines of the cells, which follow the lines of the points.
+TextType
+GetCellLines(TextType text, SizeValueType numberOfPoints, SizeValueType numberOfCells)
+{
+  for (SizeValueType id = 0; id < numberOfPoints; ++id)
+  {
+    MeshASCIIParser::GetLine(text);
+  }
+  const TextType cellLines = text;
+  for (SizeValueType id = 0; id < numberOfCells && !text.empty();)
+  {
+    TextType line = MeshASCIIParser::GetLine(text);
+    if (!MeshASCIIParser::GetToken(line).empty())
+    {
+      ++id;
+    }
+  }
+  return cellLines.substr(0, cellLines.size() - text.size());
+}
+
+// Calls function(numberOfCellPoints, ids) for each cell line of the text,
+// until it returns false. Returns false when a cell line is invalid.
+template <typename TFunction>
+bool
+ForEachCell(TextType text, TFunction function)
+{
+  while (!text.empty())
+  {
+    TextType       ids = MeshASCIIParser::GetLine(text);
+    const TextType token = MeshASCIIParser::GetToken(ids);
+    if (token.empty())
+    {
+      continue;
+    }
+    unsigned int numberOfCellPoints{};
+    if (!MeshASCIIParser::ToNumber(token, numberOfCellPoints) || !function(numberOfCellPoints, ids))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 OFFMeshIO::OFFMeshIO()
 {
   this->AddSupportedWriteExtension(".off");
@@ -162,27 +212,55 @@ OFFMeshIO::ReadMeshInformation()
     // Read points start position in the file
     m_PointsStartPosition = m_InputFile.tellg();
 
-    for (SizeValueType id = 0; id < this->m_NumberOfPoints; ++id)
+    // Count the points of the cells in concurrently parsed chunks of the
+    // memory mapped file
+    const MeshASCIIParser       parser(this->m_FileName);
+    const std::vector<TextType> chunks = MeshASCIIParser::SplitLines(
+      GetCellLines(parser.GetText().substr(m_PointsStartPosition), this->m_NumberOfPoints, this->m_NumberOfCells));
+    struct CellCounts
     {
-      std::getline(m_InputFile, line, '\n');
-    }
+      SizeValueType cells{};
+      SizeValueType cellPoints{};
+      bool          triangles{ true };
+      bool          valid{ true };
+    };
+    std::vector<CellCounts> counts(chunks.size());
+    MultiThreaderBase::New()->ParallelizeArray(
+      0,
+      chunks.size(),
+      [&chunks, &counts](SizeValueType k) {
+        CellCounts & count = counts[k];
+        count.valid = ForEachCell(chunks[k], [&count](unsigned int numberOfCellPoints, TextType) {
+          ++count.cells;
+          count.cellPoints += numberOfCellPoints;
+          count.triangles = count.triangles && numberOfCellPoints == 3;
+          return true;
+        });
+      },
+      nullptr);
 
     // Set default cell component type
     this->m_CellBufferSize = this->m_NumberOfCells * 2;
 
-    // Read each ecll's number of points and put them to cell buffer size
-    unsigned int numberOfCellPoints = 0;
-    for (SizeValueType id = 0; id < this->m_NumberOfCells; ++id)
+    SizeValueType numberOfCells = 0;
+    for (const CellCounts & count : counts)
     {
-      m_InputFile >> numberOfCellPoints;
-      this->m_CellBufferSize += numberOfCellPoints;
-      std::getline(m_InputFile, line, '\n');
-
-      if (numberOfCellPoints != 3)
+      if (!count.valid)
+      {
+        itkExceptionMacro("Invalid number of points of a cell in file " << this->m_FileName);
+      }
+      numberOfCells += count.cells;
+      this->m_CellBufferSize += count.cellPoints;
+      if (!count.triangles)
       {
         m_TriangleCellType = false;
       }
     }
+    if (numberOfCells != this->m_NumberOfCells)
+    {
+      itkExceptionMacro("The file " << this->m_FileName << " holds " << numberOfCells << " cells instead of "
+                                    << this->m_NumberOfCells);
+    }
   }
   // Read points and cells information from binary mesh
   else if (this->m_FileType == IOFileEnum::BINARY)
@@ -268,7 +346,10 @@ OFFMeshIO::ReadPoints(void * buffer)
   // Read file according to ASCII or BINARY
   if (this->m_FileType == IOFileEnum::ASCII)
   {
-    this->ReadBufferAsAscii(static_cast<float *>(buffer), m_InputFile, this->m_NumberOfPoints * this->m_PointDimension);
+    const MeshASCIIParser parser(this->m_FileName);
+    MeshASCIIParser::ParseNumbers(parser.GetText().substr(m_PointsStartPosition),
+                                  static_cast<float *>(buffer),
+                                  this->m_NumberOfPoints * this->m_PointDimension);
   }
   else if (this->m_FileType == IOFileEnum::BINARY)
   {
@@ -284,32 +365,54 @@ OFFMeshIO::ReadPoints(void * buffer)
 void
 OFFMeshIO::ReadCells(void * buffer)
 {
-  const auto data = make_unique_for_overwrite<itk::uint32_t[]>(this->m_CellBufferSize - this->m_NumberOfCells);
+  const CellGeometryEnum cellType =
+    m_TriangleCellType ? CellGeometryEnum::TRIANGLE_CELL : CellGeometryEnum::POLYGON_CELL;
 
   if (this->m_FileType == IOFileEnum::ASCII)
   {
-    this->ReadCellsBufferAsAscii(data.get(), m_InputFile);
+    CloseFile();
+
+    // The cells are parsed concurrently, directly into the cells buffer
+    const MeshASCIIParser parser(this->m_FileName);
+    auto *                data = static_cast<unsigned int *>(buffer);
+    MeshASCIIParser::ParseChunks(
+      MeshASCIIParser::SplitLines(
+        GetCellLines(parser.GetText().substr(m_PointsStartPosition), this->m_NumberOfPoints, this->m_NumberOfCells)),
+      [](TextType chunk) {
+        SizeValueType size = 0;
+        ForEachCell(chunk, [&size](unsigned int numberOfCellPoints, TextType) {
+          size += 2 + numberOfCellPoints;
+          return true;
+        });
+        return size;
+      },
+      [cellType, data](TextType chunk, SizeValueType offset) {
+        unsigned int * cell = data + offset;
+        return ForEachCell(chunk, [cellType, &cell](unsigned int numberOfCellPoints, TextType ids) {
+          *cell++ = static_cast<unsigned int>(cellType);
+          *cell++ = numberOfCellPoints;
+          bool valid = true;
+          for (unsigned int ii = 0; ii < numberOfCellPoints; ++ii)
+          {
+            valid = MeshASCIIParser::ToNumber(MeshASCIIParser::GetToken(ids), *cell++) && valid;
+          }
+          return valid;
+        });
+      },
+      this->m_CellBufferSize);
   }
   else if (this->m_FileType == IOFileEnum::BINARY)
   {
+    const auto data = make_unique_for_overwrite<itk::uint32_t[]>(this->m_CellBufferSize - this->m_NumberOfCells);
     this->ReadBufferAsBinary(data.get(), m_InputFile, this->m_CellBufferSize - this->m_NumberOfCells);
-  }
-  else
-  {
-    itkExceptionMacro("Invalid file type (not ASCII or BINARY)");
-  }
 
-  CloseFile();
+    CloseFile();
 
-  if (m_TriangleCellType)
-  {
-    this->WriteCellsBuffer(
-      data.get(), static_cast<unsigned int *>(buffer), CellGeometryEnum::TRIANGLE_CELL, this->m_NumberOfCells);
+    this->WriteCellsBuffer(data.get(), static_cast<unsigned int *>(buffer), cellType, this->m_NumberOfCells);
   }
   else
   {
-    this->WriteCellsBuffer(
-      data.get(), static_cast<unsigned int *>(buffer), CellGeometryEnum::POLYGON_CELL, this->m_NumberOfCells);
+    itkExceptionMacro("Invalid file type (not ASCII or BINARY)");
   }
 }
 
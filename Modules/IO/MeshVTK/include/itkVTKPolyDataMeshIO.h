@@ -22,6 +22,7 @@
 #include "itkByteSwapper.h"
 #include "itkMetaDataObject.h"
 #include "itkMeshIOBase.h"
+#include "itkMeshASCIIParser.h"
 #include "itkVectorContainer.h"
 #include "itkNumberToString.h"
 #include "itkMakeUniqueForOverwrite.h"
@@ -195,18 +196,15 @@ protected:
 
   template <typename T>
   void
-  ReadPointsBufferAsASCII(std::ifstream & inputFile, T * buffer)
+  ReadPointsBufferAsASCII(MeshASCIIParser::TextType text, T * buffer)
   {
-    std::string line;
-
-    while (!inputFile.eof())
+    while (!text.empty())
     {
-      std::getline(inputFile, line, '\n');
-
-      if (line.find("POINTS") != std::string::npos)
+      if (MeshASCIIParser::GetLine(text).find("POINTS") != MeshASCIIParser::TextType::npos)
       {
-        /**  Load the point coordinates into the itk::Mesh */
-        Self::ReadComponentsAsASCII(inputFile, buffer, this->m_NumberOfPoints * this->m_PointDimension);
+        /**  Load the point coordinates into the itk::Mesh, parsing them concurrently */
+        MeshASCIIParser::ParseNumbers(text, buffer, this->m_NumberOfPoints * this->m_PointDimension);
+        return;
       }
     }
   }
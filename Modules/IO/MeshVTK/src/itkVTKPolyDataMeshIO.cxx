@@ -890,13 +890,25 @@ VTKPolyDataMeshIO::ReadMeshInformation()
 void
 VTKPolyDataMeshIO::ReadPoints(void * buffer)
 {
-  std::ifstream inputFile;
-
   if (this->m_FileType == IOFileEnum::ASCII)
   {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
+    // The text is memory mapped instead of being read through a stream
+    const MeshASCIIParser parser(this->m_FileName);
+    switch (this->m_PointComponentType)
+    {
+      CASE_INVOKE_BY_TYPE(ReadPointsBufferAsASCII, parser.GetText())
+
+      default:
+      {
+        itkExceptionMacro("Unknown point component type");
+      }
+    }
+    return;
   }
-  else if (m_FileType == IOFileEnum::BINARY)
+
+  std::ifstream inputFile;
+
+  if (m_FileType == IOFileEnum::BINARY)
   {
     inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
   }
@@ -909,19 +921,7 @@ VTKPolyDataMeshIO::ReadPoints(void * buffer)
   }
 
 
-  if (this->m_FileType == IOFileEnum::ASCII)
-  {
-    switch (this->m_PointComponentType)
-    {
-      CASE_INVOKE_BY_TYPE(ReadPointsBufferAsASCII, inputFile)
-
-      default:
-      {
-        itkExceptionMacro("Unknown point component type");
-      }
-    }
-  }
-  else if (this->m_FileType == IOFileEnum::BINARY)
+  if (this->m_FileType == IOFileEnum::BINARY)
   {
     switch (this->m_PointComponentType)
     {
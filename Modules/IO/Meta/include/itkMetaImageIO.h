@@ -74,6 +74,13 @@ public:
   bool
   CanReadFile(const char *) override;
 
+  /** Several clones may read different files at the same time. */
+  bool
+  CanReadConcurrently() override
+  {
+    return true;
+  }
+
   /** Set the spacing and dimension information for the set filename. */
   void
   ReadImageInformation() override;
@@ -82,6 +89,11 @@ public:
   void
   Read(void * buffer) override;
 
+  /** The pixels are stored raw unless they are compressed, stored as text,
+   * split over several files, or in a byte order foreign to this machine. */
+  bool
+  GetRawPixelDataLocation(std::string & fileName, SizeType & offset) override;
+
   MetaImage *
   GetMetaImagePointer();
 
@@ -134,12 +146,13 @@ public:
                            const ImageIORegion & largestPossibleRegion) override;
 
   /** Determine if the ImageIO can stream reading from this
-   *  file. Only time cannot stream read/write is if compression is used.
+   *  file. Only time cannot stream read is if compression is used without
+   *  a table of compressed data blocks.
    *  CanRead must be called prior to this function. */
   bool
   CanStreamRead() override
   {
-    if (m_MetaImage.CompressedData())
+    if (m_MetaImage.CompressedData() && m_ReadCompressedDataBlockLengths.empty())
     {
       return false;
     }
@@ -161,6 +174,25 @@ public:
     return true;
   }
 
+  /** The regions of an uncompressed file are written in place, once the
+   * first one has written the header and allocated the file. */
+  bool
+  CanStreamWriteConcurrently() override
+  {
+    return this->CanStreamWrite();
+  }
+
+  /** Set/Get the number of bytes of pixel data compressed together, when
+   * compression is used. Zero, the default, compresses all the pixel data at
+   * once. Otherwise the blocks are compressed independently, on the threads
+   * of the multi-threader, and their lengths are listed in the header. The
+   * data remains a single zlib stream, readable by any MetaImage reader,
+   * while this reader decompresses the blocks in parallel and, when
+   * streaming, only those holding the requested region. The block size is
+   * increased for large images, so that the table fits in the header. */
+  itkSetMacro(CompressedDataBlockSize, SizeValueType);
+  itkGetConstMacro(CompressedDataBlockSize, SizeValueType);
+
   /** Determining the subsampling factor in case
    *  we want a coarse version of the image/
    * \warning this is only used when streaming is on. */
@@ -187,6 +219,11 @@ protected:
   ~MetaImageIO() override;
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Copies the settings of this ImageIO to a new one of the same class. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   template <unsigned int VNRows, unsigned int VNColumns = VNRows>
   bool
   WriteMatrixInMetaData(std::ostringstream &       strs,
@@ -197,10 +234,26 @@ private:
   /** Only used to synchronize the global variable across static libraries.*/
   itkGetGlobalDeclarationMacro(unsigned int, DefaultDoublePrecision);
 
+  /** Name of the file holding the pixel data, relative to the working directory. */
+  std::string
+  GetPixelDataFileName() const;
+
+  void
+  WriteCompressedDataBlocks(const void * buffer);
+
+  void
+  ReadCompressedDataBlocks(void * buffer, const ImageIORegion & region);
+
   MetaImage m_MetaImage{};
 
   unsigned int m_SubSamplingFactor{};
 
+  SizeValueType m_CompressedDataBlockSize{ 0 };
+
+  /** Table of compressed data blocks of the file read, if any. */
+  SizeValueType              m_ReadCompressedDataBlockSize{ 0 };
+  std::vector<SizeValueType> m_ReadCompressedDataBlockLengths{};
+
   static unsigned int * m_DefaultDoublePrecision;
 };
 
@@ -11,6 +11,8 @@ itk_module(
   DEPENDS
   ITKMetaIO
   ITKIOImageBase
+  PRIVATE_DEPENDS
+  ITKZLIB
   TEST_DEPENDS
   ITKTestKernel
   ITKSmoothing
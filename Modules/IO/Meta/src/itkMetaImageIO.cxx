@@ -23,7 +23,12 @@
 #include "itkMath.h"
 #include "itkSingleton.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMultiThreaderBase.h"
 #include "metaImageUtils.h"
+#include "itk_zlib.h"
+
+#include <atomic>
+#include <iterator>
 
 // Function to join strings with a delimiter similar to python's ' '.join([1, 2, 3 ])
 template <typename ContainerType, typename DelimiterType, typename StreamType>
@@ -48,6 +53,19 @@ itkGetGlobalValueMacro(MetaImageIO, unsigned int, DefaultDoublePrecision, 17);
 
 unsigned int * MetaImageIO::m_DefaultDoublePrecision;
 
+namespace
+{
+// Header fields listing the blocks of compressed data.
+constexpr const char * CompressedDataBlockSizeField = "CompressedDataBlockSize";
+constexpr const char * CompressedDataBlockLengthsField = "CompressedDataBlockLengths";
+
+// MetaIO reads at most 32 kB of a field value, enough for the lengths of as many blocks.
+constexpr SizeValueType MaximumNumberOfCompressedDataBlocks = 2048;
+
+// Each block is handed to zlib at once.
+constexpr SizeValueType MaximumCompressedDataBlockSize = SizeValueType{ 1 } << 30;
+} // namespace
+
 MetaImageIO::MetaImageIO()
 {
   itkInitGlobalsMacro(DefaultDoublePrecision);
@@ -77,12 +95,29 @@ MetaImageIO::MetaImageIO()
 
 MetaImageIO::~MetaImageIO() = default;
 
+LightObject::Pointer
+MetaImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const auto rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->SetDoublePrecision(m_MetaImage.GetDoublePrecision());
+  rval->m_SubSamplingFactor = m_SubSamplingFactor;
+  rval->m_CompressedDataBlockSize = m_CompressedDataBlockSize;
+  return loPtr;
+}
+
 void
 MetaImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
   m_MetaImage.PrintInfo();
   os << indent << "SubSamplingFactor: " << m_SubSamplingFactor << '\n';
+  os << indent << "CompressedDataBlockSize: " << m_CompressedDataBlockSize << '\n';
 }
 
 void
@@ -112,6 +147,9 @@ MetaImageIO::CanReadFile(const char * filename)
 void
 MetaImageIO::ReadImageInformation()
 {
+  m_ReadCompressedDataBlockSize = 0;
+  m_ReadCompressedDataBlockLengths.clear();
+
   if (!m_MetaImage.Read(m_FileName.c_str(), false))
   {
     itkExceptionMacro("File cannot be read: " << this->GetFileName() << " for reading." << std::endl
@@ -434,7 +472,38 @@ MetaImageIO::ReadImageInformation()
   {
     const std::string key(m_MetaImage.GetAdditionalReadFieldName(f));
     const std::string value(m_MetaImage.GetAdditionalReadFieldValue(f));
-    EncapsulateMetaData<std::string>(thisMetaDict, key, value);
+    // The table of compressed data blocks describes the file, not the image.
+    if (key == CompressedDataBlockSizeField)
+    {
+      std::istringstream(value) >> m_ReadCompressedDataBlockSize;
+    }
+    else if (key == CompressedDataBlockLengthsField)
+    {
+      std::istringstream lengths(value);
+      SizeValueType      length = 0;
+      while (lengths >> length)
+      {
+        m_ReadCompressedDataBlockLengths.push_back(length);
+      }
+    }
+    else
+    {
+      EncapsulateMetaData<std::string>(thisMetaDict, key, value);
+    }
+  }
+
+  // A table of blocks that does not match the pixel data is ignored, and the data decompressed at once.
+  if (!m_ReadCompressedDataBlockLengths.empty())
+  {
+    const SizeValueType numberOfBytes = this->GetImageSizeInBytes();
+    const SizeValueType blockSize = m_ReadCompressedDataBlockSize;
+    if (!m_MetaImage.BinaryData() || !m_MetaImage.CompressedData() || blockSize == 0 ||
+        m_ReadCompressedDataBlockLengths.size() !=
+          std::max<SizeValueType>((numberOfBytes + blockSize - 1) / blockSize, 1))
+    {
+      m_ReadCompressedDataBlockSize = 0;
+      m_ReadCompressedDataBlockLengths.clear();
+    }
   }
 
   //
@@ -471,7 +540,23 @@ MetaImageIO::Read(void * buffer)
     largestRegion.SetSize(i, this->GetDimensions(i));
   }
 
-  if (largestRegion != m_IORegion)
+  if (!m_ReadCompressedDataBlockLengths.empty() && m_SubSamplingFactor == 1)
+  {
+    ImageIORegion region(largestRegion);
+    if (largestRegion != m_IORegion)
+    {
+      for (unsigned int i = 0; i < nDims; ++i)
+      {
+        region.SetIndex(i, i < m_IORegion.GetImageDimension() ? m_IORegion.GetIndex(i) : 0);
+        region.SetSize(i, i < m_IORegion.GetImageDimension() ? m_IORegion.GetSize(i) : 1);
+      }
+    }
+    this->ReadCompressedDataBlocks(buffer, region);
+
+    m_MetaImage.ElementData(buffer, false);
+    m_MetaImage.ElementByteOrderFix(region.GetNumberOfPixels());
+  }
+  else if (largestRegion != m_IORegion)
   {
     const auto indexMin = make_unique_for_overwrite<int[]>(nDims);
     const auto indexMax = make_unique_for_overwrite<int[]>(nDims);
@@ -511,6 +596,231 @@ MetaImageIO::Read(void * buffer)
   }
 }
 
+bool
+MetaImageIO::GetRawPixelDataLocation(std::string & fileName, SizeType & offset)
+{
+  if (!m_MetaImage.BinaryData() || m_MetaImage.CompressedData() ||
+      (m_MetaImage.BinaryDataByteOrderMSB() != MET_SystemByteOrderMSB() && this->GetComponentSize() > 1))
+  {
+    return false;
+  }
+
+  // A list of files, or a pattern of file names, holds the pixels in several files.
+  const std::string dataFileName = m_MetaImage.ElementDataFileName();
+  if (dataFileName.empty() || dataFileName.compare(0, 4, "LIST") == 0 || dataFileName.find('%') != std::string::npos)
+  {
+    return false;
+  }
+
+  const bool local = itksys::SystemTools::Strucmp(dataFileName.c_str(), "LOCAL") == 0;
+  fileName = this->GetPixelDataFileName();
+
+  const auto fileSize = static_cast<SizeType>(itksys::SystemTools::FileLength(fileName));
+  const auto dataSize = static_cast<SizeType>(this->GetImageSizeInBytes());
+  if (fileSize < dataSize)
+  {
+    return false;
+  }
+
+  // The pixels follow the header of the given size. Otherwise, as MetaImage
+  // writes them, the pixels are at the end of a file with a local header.
+  if (m_MetaImage.HeaderSize() > 0)
+  {
+    offset = m_MetaImage.HeaderSize();
+  }
+  else if (m_MetaImage.HeaderSize() == -1 || local)
+  {
+    offset = fileSize - dataSize;
+  }
+  else
+  {
+    offset = 0;
+  }
+  return offset + dataSize <= fileSize;
+}
+
+std::string
+MetaImageIO::GetPixelDataFileName() const
+{
+  const std::string dataFileName = m_MetaImage.ElementDataFileName();
+  if (itksys::SystemTools::Strucmp(dataFileName.c_str(), "LOCAL") == 0)
+  {
+    return m_FileName;
+  }
+  if (itksys::SystemTools::FileIsFullPath(dataFileName))
+  {
+    return dataFileName;
+  }
+  // A data file is relative to the header.
+  const std::string path = itksys::SystemTools::GetFilenamePath(m_FileName);
+  return path.empty() ? dataFileName : path + '/' + dataFileName;
+}
+
+void
+MetaImageIO::ReadCompressedDataBlocks(void * buffer, const ImageIORegion & region)
+{
+  const SizeValueType                blockSize = m_ReadCompressedDataBlockSize;
+  const std::vector<SizeValueType> & lengths = m_ReadCompressedDataBlockLengths;
+  const SizeValueType                numberOfBlocks = lengths.size();
+  const SizeValueType                numberOfBytes = this->GetImageSizeInBytes();
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // The blocks follow the two bytes of the zlib header, and the four bytes of
+  // its checksum end the compressed data, which end the data file.
+  std::vector<SizeValueType> offsets(numberOfBlocks + 1, 2);
+  for (SizeValueType i = 0; i < numberOfBlocks; ++i)
+  {
+    offsets[i + 1] = offsets[i] + lengths[i];
+  }
+  const std::string   dataFileName = this->GetPixelDataFileName();
+  const auto          fileSize = static_cast<SizeValueType>(itksys::SystemTools::FileLength(dataFileName));
+  const SizeValueType compressedDataSize = offsets.back() + 4;
+  if (compressedDataSize > fileSize)
+  {
+    itkExceptionMacro("The compressed data blocks do not match the data file " << dataFileName);
+  }
+  const SizeValueType dataOffset = fileSize - compressedDataSize;
+
+  // The region is read in runs of bytes contiguous in the file, as long as the
+  // region spans the image along the lower dimensions.
+  const unsigned int  nDims = region.GetImageDimension();
+  const SizeValueType pixelSize = this->GetPixelSize();
+  SizeValueType       runSize = region.GetSize(0);
+  unsigned int        runDimension = 1;
+  while (runDimension < nDims && region.GetSize(runDimension - 1) == this->GetDimensions(runDimension - 1))
+  {
+    runSize *= region.GetSize(runDimension);
+    ++runDimension;
+  }
+  const SizeValueType runBytes = runSize * pixelSize;
+  const SizeValueType numberOfRuns = region.GetNumberOfPixels() / runSize;
+
+  std::vector<SizeValueType> runOffsets(numberOfRuns);
+  ImageIORegion::IndexType   index = region.GetIndex();
+  for (SizeValueType run = 0; run < numberOfRuns; ++run)
+  {
+    SizeValueType offset = 0;
+    SizeValueType stride = pixelSize;
+    for (unsigned int i = 0; i < nDims; ++i)
+    {
+      offset += static_cast<SizeValueType>(index[i]) * stride;
+      stride *= this->GetDimensions(i);
+    }
+    runOffsets[run] = offset;
+
+    for (unsigned int i = runDimension; i < nDims; ++i)
+    {
+      if (++index[i] < region.GetIndex(i) + static_cast<IndexValueType>(region.GetSize(i)))
+      {
+        break;
+      }
+      index[i] = region.GetIndex(i);
+    }
+  }
+
+  std::vector<bool> blockIsNeeded(numberOfBlocks, false);
+  for (const SizeValueType offset : runOffsets)
+  {
+    for (SizeValueType i = offset / blockSize; i <= (offset + runBytes - 1) / blockSize; ++i)
+    {
+      blockIsNeeded[i] = true;
+    }
+  }
+  std::vector<SizeValueType> neededBlocks;
+  for (SizeValueType i = 0; i < numberOfBlocks; ++i)
+  {
+    if (blockIsNeeded[i])
+    {
+      neededBlocks.push_back(i);
+    }
+  }
+
+  // The compressed blocks are read in order, then decompressed in parallel.
+  std::ifstream file;
+  this->OpenFileForReading(file, dataFileName);
+  std::vector<std::vector<Bytef>> compressedBlocks(numberOfBlocks);
+  for (const SizeValueType i : neededBlocks)
+  {
+    compressedBlocks[i].resize(lengths[i]);
+    file.seekg(static_cast<std::streamoff>(dataOffset + offsets[i]));
+    file.read(reinterpret_cast<char *>(compressedBlocks[i].data()), static_cast<std::streamsize>(lengths[i]));
+  }
+  if (!file)
+  {
+    itkExceptionMacro("Could not read the compressed data blocks from " << dataFileName);
+  }
+  file.close();
+
+  // When the whole image is read, the blocks are decompressed in place.
+  auto *     data = static_cast<Bytef *>(buffer);
+  const bool inPlace = numberOfRuns == 1 && runBytes == numberOfBytes;
+
+  std::vector<std::vector<Bytef>> blocks(inPlace ? 0 : numberOfBlocks);
+  std::atomic<bool>               failed{ false };
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    neededBlocks.size(),
+    [&](SizeValueType j) {
+      const SizeValueType i = neededBlocks[j];
+      const SizeValueType length = std::min(blockSize, numberOfBytes - i * blockSize);
+      Bytef *             block = data + i * blockSize;
+      if (!inPlace)
+      {
+        blocks[i].resize(length);
+        block = blocks[i].data();
+      }
+
+      z_stream stream{};
+      if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+      {
+        failed = true;
+        return;
+      }
+      stream.next_in = compressedBlocks[i].data();
+      stream.avail_in = static_cast<uInt>(compressedBlocks[i].size());
+      stream.next_out = block;
+      stream.avail_out = static_cast<uInt>(length);
+      const int result = inflate(&stream, Z_SYNC_FLUSH);
+      if ((result != Z_OK && result != Z_STREAM_END) || stream.total_out != length)
+      {
+        failed = true;
+      }
+      inflateEnd(&stream);
+      compressedBlocks[i] = std::vector<Bytef>();
+    },
+    nullptr);
+  if (failed)
+  {
+    itkExceptionMacro("Could not decompress the compressed data blocks of " << dataFileName);
+  }
+  if (inPlace)
+  {
+    return;
+  }
+
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfRuns,
+    [&](SizeValueType run) {
+      Bytef *       out = data + run * runBytes;
+      SizeValueType offset = runOffsets[run];
+      SizeValueType remaining = runBytes;
+      while (remaining > 0)
+      {
+        const SizeValueType i = offset / blockSize;
+        const SizeValueType count = std::min(remaining, (i + 1) * blockSize - offset);
+        std::copy_n(blocks[i].data() + (offset - i * blockSize), count, out);
+        out += count;
+        offset += count;
+        remaining -= count;
+      }
+    },
+    nullptr);
+}
+
 MetaImage *
 MetaImageIO::GetMetaImagePointer()
 {
@@ -874,6 +1184,11 @@ MetaImageIO::Write(const void * buffer)
   {
     std::cout << "Compression in use: cannot stream the file writing" << std::endl;
   }
+  else if (m_UseCompression && binaryData && m_CompressedDataBlockSize > 0 &&
+           std::string(m_MetaImage.ElementDataFileName()).find('%') == std::string::npos)
+  {
+    this->WriteCompressedDataBlocks(buffer);
+  }
   else if (largestRegion != m_IORegion)
   {
     const auto indexMin = make_unique_for_overwrite<int[]>(numberOfDimensions);
@@ -903,6 +1218,149 @@ MetaImageIO::Write(const void * buffer)
   }
 }
 
+void
+MetaImageIO::WriteCompressedDataBlocks(const void * buffer)
+{
+  const auto *        data = static_cast<const Bytef *>(buffer);
+  const SizeValueType numberOfBytes = this->GetImageSizeInBytes();
+  const SizeValueType blockSize =
+    std::max(std::min(m_CompressedDataBlockSize, MaximumCompressedDataBlockSize),
+             (numberOfBytes + MaximumNumberOfCompressedDataBlocks - 1) / MaximumNumberOfCompressedDataBlocks);
+  const SizeValueType numberOfBlocks = std::max<SizeValueType>((numberOfBytes + blockSize - 1) / blockSize, 1);
+  const int           level = this->GetCompressionLevel();
+
+  // Each block is a raw deflate stream of its own. All but the last end with a
+  // sync flush instead of a final block, so that together they make one stream.
+  std::vector<std::vector<Bytef>> blocks(numberOfBlocks);
+  std::vector<uLong>              checksums(numberOfBlocks);
+  std::atomic<bool>               failed{ false };
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType i) {
+      const Bytef * block = data + i * blockSize;
+      const auto    length = static_cast<uInt>(std::min(blockSize, numberOfBytes - i * blockSize));
+      const bool    last = i + 1 == numberOfBlocks;
+
+      z_stream stream{};
+      if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+      {
+        failed = true;
+        return;
+      }
+      // The bound of a complete stream, plus room for the marker of the sync flush.
+      blocks[i].resize(deflateBound(&stream, length) + 16);
+      stream.next_in = const_cast<Bytef *>(block);
+      stream.avail_in = length;
+      stream.next_out = blocks[i].data();
+      stream.avail_out = static_cast<uInt>(blocks[i].size());
+      const int result = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+      if (result != (last ? Z_STREAM_END : Z_OK) || stream.avail_in != 0 || stream.avail_out == 0)
+      {
+        failed = true;
+      }
+      blocks[i].resize(stream.total_out);
+      deflateEnd(&stream);
+      checksums[i] = adler32(adler32(0, nullptr, 0), block, length);
+    },
+    nullptr);
+  if (failed)
+  {
+    itkExceptionMacro("Could not compress the pixel data of " << m_FileName);
+  }
+
+  // The zlib header, as zlib writes it for the compression level.
+  const int    levelFlags = level < 2 ? 0 : (level < 6 ? 1 : (level == 6 ? 2 : 3));
+  unsigned int zlibHeader = (0x78u << 8) | (static_cast<unsigned int>(levelFlags) << 6);
+  zlibHeader += 31 - zlibHeader % 31;
+  const Bytef zlibHeaderBytes[2] = { static_cast<Bytef>(zlibHeader >> 8), static_cast<Bytef>(zlibHeader & 0xff) };
+
+  uLong              checksum = adler32(0, nullptr, 0);
+  SizeValueType      compressedDataSize = 2 + 4;
+  std::ostringstream lengths;
+  for (SizeValueType i = 0; i < numberOfBlocks; ++i)
+  {
+    const SizeValueType length = std::min(blockSize, numberOfBytes - i * blockSize);
+    checksum = adler32_combine(checksum, checksums[i], static_cast<z_off_t>(length));
+    compressedDataSize += blocks[i].size();
+    lengths << (i == 0 ? "" : " ") << blocks[i].size();
+  }
+  const Bytef checksumBytes[4] = { static_cast<Bytef>(checksum >> 24),
+                                   static_cast<Bytef>(checksum >> 16),
+                                   static_cast<Bytef>(checksum >> 8),
+                                   static_cast<Bytef>(checksum) };
+
+  // MetaIO writes the header as if the data were not compressed: it would
+  // otherwise compress them once more, to write their size. The compression
+  // fields and the table of blocks are then inserted in the header.
+  const bool defaultDataFileName = std::string(m_MetaImage.ElementDataFileName()).empty();
+  if (defaultDataFileName)
+  {
+    // As MetaIO names the data file of compressed data.
+    if (itksys::SystemTools::GetFilenameLastExtension(m_FileName) == ".mha")
+    {
+      m_MetaImage.ElementDataFileName("LOCAL");
+    }
+    else
+    {
+      m_MetaImage.ElementDataFileName(
+        (itksys::SystemTools::GetFilenameWithoutLastExtension(m_FileName) + ".zraw").c_str());
+    }
+  }
+  const std::string dataFileName = this->GetPixelDataFileName();
+  const bool        local = dataFileName == m_FileName;
+  m_MetaImage.CompressedData(false);
+  const bool headerWritten = m_MetaImage.Write(m_FileName.c_str(), nullptr, false);
+  m_MetaImage.CompressedData(true);
+  if (defaultDataFileName)
+  {
+    m_MetaImage.ElementDataFileName("");
+  }
+  if (!headerWritten)
+  {
+    itkExceptionMacro("File cannot be written: " << this->GetFileName() << std::endl
+                                                 << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+
+  std::string header;
+  {
+    std::ifstream headerFile;
+    this->OpenFileForReading(headerFile, m_FileName);
+    header.assign(std::istreambuf_iterator<char>(headerFile), std::istreambuf_iterator<char>());
+  }
+  const std::string uncompressedField = "\nCompressedData = False\n";
+  const size_t      uncompressedFieldPosition = header.find(uncompressedField);
+  if (uncompressedFieldPosition == std::string::npos)
+  {
+    itkExceptionMacro("Unexpected header written by MetaIO in " << m_FileName);
+  }
+  header.replace(uncompressedFieldPosition,
+                 uncompressedField.size(),
+                 "\nCompressedData = True\nCompressedDataSize = " + std::to_string(compressedDataSize) + '\n' +
+                   CompressedDataBlockSizeField + " = " + std::to_string(blockSize) + '\n' +
+                   CompressedDataBlockLengthsField + " = " + lengths.str() + '\n');
+
+  std::ofstream file;
+  this->OpenFileForWriting(file, m_FileName);
+  file.write(header.data(), static_cast<std::streamsize>(header.size()));
+  if (!local)
+  {
+    file.close();
+    this->OpenFileForWriting(file, dataFileName);
+  }
+  file.write(reinterpret_cast<const char *>(zlibHeaderBytes), sizeof(zlibHeaderBytes));
+  for (const std::vector<Bytef> & block : blocks)
+  {
+    file.write(reinterpret_cast<const char *>(block.data()), static_cast<std::streamsize>(block.size()));
+  }
+  file.write(reinterpret_cast<const char *>(checksumBytes), sizeof(checksumBytes));
+  if (!file)
+  {
+    itkExceptionMacro("File cannot be written: " << dataFileName << std::endl
+                                                 << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+}
+
 /** Given a requested region, determine what could be the region that we can
  * read from the file. This is called the streamable region, which will be
  * smaller than the LargestPossibleRegion and greater or equal to the
@@ -0,0 +1,177 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaImageIO.h"
+#include "itkTestingMacros.h"
+#include <fstream>
+#include <iterator>
+
+
+namespace
+{
+using PixelType = unsigned short;
+using ImageType = itk::Image<PixelType, 3>;
+
+PixelType
+ExpectedPixel(const ImageType::IndexType & index)
+{
+  return static_cast<PixelType>(index[0] * 7 + index[1] * 131 + index[2] * 1031);
+}
+
+bool
+CheckRegion(const ImageType * image, const ImageType::RegionType & region)
+{
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != ExpectedPixel(it.GetIndex()))
+    {
+      std::cerr << "Wrong pixel " << it.Get() << " at " << it.GetIndex() << ", expected "
+                << ExpectedPixel(it.GetIndex()) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+HeaderListsBlocks(const std::string & fileName)
+{
+  std::ifstream     file(fileName, std::ios::binary);
+  const std::string content{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+  return content.find("CompressedDataBlock") != std::string::npos;
+}
+
+int
+TestBlockCompression(const std::string & fileName)
+{
+  std::cout << "Test block compression with " << fileName << std::endl;
+
+  auto                     image = ImageType::New();
+  const ImageType::SizeType size = { { 37, 29, 23 } };
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(ExpectedPixel(it.GetIndex()));
+  }
+
+  auto writerIO = itk::MetaImageIO::New();
+  writerIO->SetCompressedDataBlockSize(1000);
+  ITK_TEST_SET_GET_VALUE(itk::SizeValueType{ 1000 }, writerIO->GetCompressedDataBlockSize());
+
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(writerIO);
+  writer->UseCompressionOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  ITK_TEST_EXPECT_TRUE(HeaderListsBlocks(fileName));
+
+  // The pixel data remain a single zlib stream, readable by MetaIO alone.
+  MetaImage metaImage;
+  ITK_TEST_EXPECT_TRUE(metaImage.Read(fileName.c_str()));
+  ITK_TEST_EXPECT_TRUE(metaImage.CompressedData());
+  const auto * metaImageData = static_cast<const PixelType *>(metaImage.ElementData());
+  ITK_TEST_EXPECT_TRUE(std::equal(metaImageData, metaImageData + image->GetLargestPossibleRegion().GetNumberOfPixels(),
+                                  image->GetBufferPointer()));
+
+  // The whole image.
+  auto readerIO = itk::MetaImageIO::New();
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(readerIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_TRUE(readerIO->CanStreamRead());
+  ITK_TEST_EXPECT_TRUE(!readerIO->GetMetaDataDictionary().HasKey("CompressedDataBlockSize"));
+  ITK_TEST_EXPECT_TRUE(!readerIO->GetMetaDataDictionary().HasKey("CompressedDataBlockLengths"));
+  if (!CheckRegion(reader->GetOutput(), reader->GetOutput()->GetLargestPossibleRegion()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Streamed regions, contiguous in the file or not.
+  const ImageType::RegionType regions[] = { ImageType::RegionType({ { 0, 0, 5 } }, { { 37, 29, 3 } }),
+                                            ImageType::RegionType({ { 0, 3, 7 } }, { { 37, 11, 4 } }),
+                                            ImageType::RegionType({ { 4, 9, 2 } }, { { 13, 1, 17 } }),
+                                            ImageType::RegionType({ { 36, 28, 22 } }, { { 1, 1, 1 } }) };
+  for (const ImageType::RegionType & region : regions)
+  {
+    reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetFileName(fileName);
+    reader->SetImageIO(itk::MetaImageIO::New());
+    reader->SetUseStreaming(true);
+    reader->GetOutput()->SetRequestedRegion(region);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetBufferedRegion(), region);
+    if (!CheckRegion(reader->GetOutput(), region))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Later writes with the same ImageIO, without blocks, list no blocks.
+  writerIO->SetCompressedDataBlockSize(0);
+  writer->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  ITK_TEST_EXPECT_TRUE(!HeaderListsBlocks(fileName));
+
+  writerIO->SetCompressedDataBlockSize(1000);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  writer->UseCompressionOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  ITK_TEST_EXPECT_TRUE(!HeaderListsBlocks(fileName));
+
+  reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(itk::MetaImageIO::New());
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  if (!CheckRegion(reader->GetOutput(), reader->GetOutput()->GetLargestPossibleRegion()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+
+int
+itkMetaImageIOBlockCompressionTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = argv[1];
+
+  int result = EXIT_SUCCESS;
+  if (TestBlockCompression(directory + "/MetaImageIOBlockCompressionTest.mha") != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+  if (TestBlockCompression(directory + "/MetaImageIOBlockCompressionTest.mhd") != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+  return result;
+}
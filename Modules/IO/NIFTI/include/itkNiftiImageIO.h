@@ -141,6 +141,13 @@ public:
   bool
   CanReadFile(const char * FileNameToRead) override;
 
+  /** Several clones may read different files at the same time. */
+  bool
+  CanReadConcurrently() override
+  {
+    return true;
+  }
+
   /** Set the spacing and dimension information for the set filename. */
   void
   ReadImageInformation() override;
@@ -149,6 +156,12 @@ public:
   void
   Read(void * buffer) override;
 
+  /** The pixels are stored raw unless they are compressed, rescaled, in a
+   * byte order foreign to this machine, or vectors, whose components are
+   * stored in separate volumes. */
+  bool
+  GetRawPixelDataLocation(std::string & fileName, SizeType & offset) override;
+
   //-------- This part of the interfaces deals with writing data. -----
 
   /** Determine if the file can be written with this ImageIO implementation.
@@ -230,6 +243,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copies the settings of this ImageIO to a new one of the same class. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   virtual bool
   GetUseLegacyModeForTwoFileWriting() const
   {
@@ -439,6 +439,25 @@ NiftiImageIO::NiftiImageIO()
 
 NiftiImageIO::~NiftiImageIO() { nifti_image_free(this->m_NiftiImage); }
 
+LightObject::Pointer
+NiftiImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const auto rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_RescaleSlope = m_RescaleSlope;
+  rval->m_RescaleIntercept = m_RescaleIntercept;
+  rval->m_ConvertRASVectors = m_ConvertRASVectors;
+  rval->m_ConvertRASDisplacementVectors = m_ConvertRASDisplacementVectors;
+  rval->m_LegacyAnalyze75Mode = m_LegacyAnalyze75Mode;
+  rval->m_SFORM_Permissive = m_SFORM_Permissive;
+  return loPtr;
+}
+
 void
 NiftiImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -826,6 +845,35 @@ NiftiImageIO::Read(void * buffer)
   }
 }
 
+bool
+NiftiImageIO::GetRawPixelDataLocation(std::string & fileName, SizeType & offset)
+{
+  // The components of vector pixels are interleaved, and rescaled pixels
+  // converted, while being read.
+  const IOPixelEnum pixelType = this->GetPixelType();
+  if ((this->GetNumberOfComponents() > 1 && pixelType != IOPixelEnum::COMPLEX && pixelType != IOPixelEnum::RGB &&
+       pixelType != IOPixelEnum::RGBA) ||
+      this->MustRescale() || this->m_ConvertRAS)
+  {
+    return false;
+  }
+
+  nifti_image * header = nifti_image_read(this->GetFileName(), false);
+  if (header == nullptr)
+  {
+    return false;
+  }
+  const bool raw = header->iname != nullptr && nifti_is_gzfile(header->iname) == 0 && header->iname_offset >= 0 &&
+                   (header->swapsize <= 1 || header->byteorder == nifti_short_order());
+  if (raw)
+  {
+    fileName = header->iname;
+    offset = static_cast<SizeType>(header->iname_offset);
+  }
+  nifti_image_free(header);
+  return raw;
+}
+
 NiftiImageIOEnums::NiftiFileEnum
 NiftiImageIO::DetermineFileType(const char * FileNameToRead)
 {
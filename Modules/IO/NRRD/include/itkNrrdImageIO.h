@@ -78,6 +78,12 @@ public:
   void
   Read(void * buffer) override;
 
+  /** The pixels are stored raw when they are attached to the header, or
+   * detached to a single file, with the raw encoding and in the byte order
+   * of this machine. */
+  bool
+  GetRawPixelDataLocation(std::string & fileName, SizeType & offset) override;
+
   /** Determine the file type. Returns true if this ImageIO can write the
    * file specified. */
   bool
@@ -22,6 +22,7 @@
 #include "itkMetaDataObject.h"
 #include "itkIOCommon.h"
 #include "itkFloatingPointExceptions.h"
+#include "itksys/SystemTools.hxx"
 
 #include <sstream>
 
@@ -852,6 +853,85 @@ NrrdImageIO::Read(void * buffer)
   }
 }
 
+bool
+NrrdImageIO::GetRawPixelDataLocation(std::string & fileName, SizeType & offset)
+{
+  // Masked tensors are cropped while being read.
+  if (IOPixelEnum::SYMMETRICSECONDRANKTENSOR == this->GetPixelType())
+  {
+    return false;
+  }
+
+  Nrrd *        nrrd = nrrdNew();
+  NrrdIoState * nio = nrrdIoStateNew();
+
+  // Read just the header, and keep the data file open at the first pixel.
+  nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+  nrrdIoStateSet(nio, nrrdIoStateKeepNrrdDataFileOpen, 1);
+
+  // nrrd causes exceptions on purpose, so mask them
+  bool saveFPEState(false);
+  if (FloatingPointExceptions::HasFloatingPointExceptionsSupport())
+  {
+    saveFPEState = FloatingPointExceptions::GetEnabled();
+    FloatingPointExceptions::Disable();
+  }
+  const bool loaded = nrrdLoad(nrrd, this->GetFileName(), nio) == 0;
+  if (FloatingPointExceptions::HasFloatingPointExceptionsSupport())
+  {
+    FloatingPointExceptions::SetEnabled(saveFPEState);
+  }
+
+  bool raw = false;
+  if (loaded)
+  {
+    unsigned int       rangeAxisIdx[NRRD_DIM_MAX];
+    const unsigned int rangeAxisNum = nrrdRangeAxesGet(nrrd, rangeAxisIdx);
+
+    // The pixels are stored in a single file, and their components are on
+    // the fastest axis, so that Read() does not need to permute them.
+    raw = nrrdFormatNRRD == nio->format && nrrdEncodingRaw == nio->encoding && nio->dataFile != nullptr &&
+          nio->dataFile != stdin && nio->dataFNFormat == nullptr && nio->dataFNArr->len <= 1 &&
+          (0 == rangeAxisNum || (1 == rangeAxisNum && 0 == rangeAxisIdx[0])) &&
+          (1 == nrrdElementSize(nrrd) || airMyEndian() == nio->endian);
+    if (raw)
+    {
+#if defined(_WIN32)
+      const auto position = _ftelli64(nio->dataFile);
+#else
+      const auto position = ftello(nio->dataFile);
+#endif
+      raw = position >= 0;
+      offset = static_cast<SizeType>(position);
+
+      if (nio->dataFNArr->len == 0)
+      {
+        fileName = this->GetFileName();
+      }
+      else
+      {
+        // A data file name is relative to the header, unless it is absolute.
+        const std::string dataFileName = nio->dataFN[0];
+        fileName = itksys::SystemTools::FileIsFullPath(dataFileName) || airStrlen(nio->path) == 0
+                     ? dataFileName
+                     : std::string(nio->path) + '/' + dataFileName;
+      }
+    }
+  }
+  else
+  {
+    free(biffGetDone(NRRD));
+  }
+
+  if (nio->dataFile != nullptr)
+  {
+    airFclose(nio->dataFile);
+  }
+  nrrdNix(nrrd);
+  nrrdIoStateNix(nio);
+  return raw;
+}
+
 bool
 NrrdImageIO::CanWriteFile(const char * name)
 {
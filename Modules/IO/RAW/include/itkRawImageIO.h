@@ -111,6 +111,13 @@ public:
     return false;
   }
 
+  /** Several clones may read different files at the same time. */
+  bool
+  CanReadConcurrently() override
+  {
+    return true;
+  }
+
   /** Binary files have no image information to read. This must be set by the
    * user of the class. */
   void
@@ -166,6 +173,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copies the settings of this ImageIO to a new one of the same class. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   // void ComputeInternalFileName(unsigned long slice);
 
 private:
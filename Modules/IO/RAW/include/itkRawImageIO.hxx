@@ -65,6 +65,24 @@ RawImageIO<TPixel, VImageDimension>::RawImageIO()
   m_FileType = IOFileEnum::Binary;
 }
 
+template <typename TPixel, unsigned int VImageDimension>
+LightObject::Pointer
+RawImageIO<TPixel, VImageDimension>::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const auto rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_FileDimensionality = m_FileDimensionality;
+  rval->m_ManualHeaderSize = m_ManualHeaderSize;
+  rval->m_HeaderSize = m_HeaderSize;
+  rval->m_ImageMask = m_ImageMask;
+  return loPtr;
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 void
 RawImageIO<TPixel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent) const
@@ -38,6 +38,15 @@ class TIFFReaderInternal;
  * supports the compression level for JPEG quality parameter in the
  * range 0-100.
  *
+ * Grayscale and RGB images whose samples are 8, 16 or 32 bits wide,
+ * stored contiguously in strips or tiles, are read by decoding only the
+ * strips or tiles which intersect the requested region, on several
+ * threads at once; such images can be streamed. Other images, e.g. those
+ * with a palette or in the YCbCr color space, are read whole.
+ *
+ * The images are written in strips by default, or in square tiles when a
+ * TileSize is set. Images larger than 2 GiB are written as BigTIFF.
+ *
  * \ingroup IOFilters
  * \ingroup ITKIOTIFF
  *
@@ -71,6 +80,13 @@ public:
   bool
   CanReadFile(const char *) override;
 
+  /** Several clones may read different files at the same time. */
+  bool
+  CanReadConcurrently() override
+  {
+    return true;
+  }
+
   /** Set the spacing and dimension information for the set filename. */
   void
   ReadImageInformation() override;
@@ -83,6 +99,20 @@ public:
   virtual void
   ReadVolume(void * buffer);
 
+  /** Returns true when the image of the file can be read by strips or
+   * tiles, which is known after ReadImageInformation(). */
+  bool
+  CanStreamRead() override
+  {
+    return m_ReadByBlocks;
+  }
+
+  /** When streaming is enabled and the image can be read by strips or
+   * tiles, the requested region is read as is. Otherwise the whole image
+   * is read. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const override;
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -172,6 +202,12 @@ public:
   }
 
 
+  /** Set/Get the width and height, in pixels, of the tiles of the written
+   * images. The size is rounded up to a multiple of 16, as required by the
+   * TIFF specification. The default, 0, writes the images in strips. */
+  itkSetMacro(TileSize, unsigned int);
+  itkGetConstMacro(TileSize, unsigned int);
+
   /** Get a const ref to the palette of the image. In the case of non palette
    * image or ExpandRGBPalette set to true, a vector of size
    * 0 is returned.
@@ -199,6 +235,9 @@ protected:
   void
   InternalSetCompressor(const std::string & _compressor) override;
 
+  LightObject::Pointer
+  InternalClone() const override;
+
   // This method is protected because it does not keep
   // ImageIO::m_Compressor and TIFFImageIO::m_Compression in sync.
   void
@@ -252,6 +291,15 @@ private:
   void
   AllocateTiffPalette(uint16_t bps);
 
+  /** Whether the pixels of the current image can be copied as they are
+   * from its strips or tiles. */
+  bool
+  CanReadByBlocks();
+
+  /** Reads the IO region by decoding the strips or tiles which intersect it. */
+  void
+  ReadRegionByBlocks(void * buffer);
+
   void
   ReadCurrentPage(void * buffer, size_t pixelOffset);
 
@@ -309,6 +357,8 @@ private:
   uint16_t *   m_ColorBlue{};
   uint64_t     m_TotalColors{ 0 };
   unsigned int m_ImageFormat{ TIFFImageIO::NOFORMAT };
+  unsigned int m_TileSize{ 0 };
+  bool         m_ReadByBlocks{ false };
 };
 } // end namespace itk
 
@@ -21,8 +21,11 @@
 #include "itksys/SystemTools.hxx"
 #include "itkMetaDataObject.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMultiThreaderBase.h"
 
 #include "itk_tiff.h"
+#include <algorithm>
+#include <atomic>
 
 namespace itk
 {
@@ -188,9 +191,13 @@ TIFFImageIO::Read(void * buffer)
     }
   }
 
+  if (m_ReadByBlocks)
+  {
+    this->ReadRegionByBlocks(buffer);
+  }
   // The IO region should be of dimensions 3 otherwise we read only the first
   // page
-  if (m_InternalImage->m_NumberOfPages > 0 && this->GetIORegion().GetImageDimension() > 2)
+  else if (m_InternalImage->m_NumberOfPages > 0 && this->GetIORegion().GetImageDimension() > 2)
   {
     this->ReadVolume(buffer);
   }
@@ -202,6 +209,217 @@ TIFFImageIO::Read(void * buffer)
   m_InternalImage->Clean();
 }
 
+ImageIORegion
+TIFFImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const
+{
+  if (!m_UseStreamedReading || !m_ReadByBlocks)
+  {
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requested);
+  }
+  return requested;
+}
+
+bool
+TIFFImageIO::CanReadByBlocks()
+{
+  const TIFFReaderInternal & image = *m_InternalImage;
+  if (!image.m_Image || image.m_Width == 0 || image.m_Height == 0 || !image.m_HasValidPhotometricInterpretation ||
+      TIFFIsCODECConfigured(image.m_Compression) != 1)
+  {
+    return false;
+  }
+  const bool grayscale = this->GetFormat() == TIFFImageIO::GRAYSCALE && image.m_SamplesPerPixel == 1;
+  const bool rgb = image.m_Photometrics == PHOTOMETRIC_RGB && image.m_PlanarConfig == PLANARCONFIG_CONTIG;
+  const bool oriented = image.m_Orientation == ORIENTATION_TOPLEFT || image.m_Orientation == ORIENTATION_BOTLEFT;
+  return (grayscale || rgb) && oriented && image.m_BitsPerSample == 8 * this->GetComponentSize();
+}
+
+namespace
+{
+/** A strip or a tile of a page, and the part of it which lies in the IO region. */
+struct TIFFBlock
+{
+  uint16_t Directory;
+  bool     Tiled;
+  uint32_t Index;
+  uint32_t Column; // first column of the block in the page
+  uint32_t Row;    // first row of the block in the file
+  uint32_t Width;
+  uint32_t Height;
+  size_t   Page; // page of the block in the IO region
+};
+} // namespace
+
+void
+TIFFImageIO::ReadRegionByBlocks(void * buffer)
+{
+  const ImageIORegion & region = this->GetIORegion();
+  const uint32_t        width = m_InternalImage->m_Width;
+  const uint32_t        height = m_InternalImage->m_Height;
+  const auto            x0 = static_cast<uint32_t>(region.GetIndex(0));
+  const auto            x1 = static_cast<uint32_t>(x0 + region.GetSize(0));
+  const auto            y0 = static_cast<uint32_t>(region.GetIndex(1));
+  const auto            y1 = static_cast<uint32_t>(y0 + region.GetSize(1));
+  size_t                z0 = 0;
+  size_t                pages = 1;
+  if (m_NumberOfDimensions > 2 && region.GetImageDimension() > 2)
+  {
+    z0 = region.GetIndex(2);
+    pages = region.GetSize(2);
+  }
+  if (x1 > width || y1 > height)
+  {
+    itkExceptionMacro("The IO region " << region << " lies outside of the image of " << m_FileName);
+  }
+
+  // The rows of the region in the file, which are flipped in bottom-left images.
+  const bool     bottomLeft = m_InternalImage->m_Orientation == ORIENTATION_BOTLEFT;
+  const uint32_t firstRow = bottomLeft ? height - y1 : y0;
+  const uint32_t lastRow = bottomLeft ? height - y0 : y1;
+
+  // The directories of the pages, skipping reduced images and masks as ReadVolume() does.
+  TIFF *                tif = m_InternalImage->m_Image;
+  std::vector<uint16_t> directories;
+  for (uint16_t d = 0; d < m_InternalImage->m_NumberOfPages && directories.size() < z0 + pages; ++d)
+  {
+    int32_t subfiletype = 0;
+    if (m_InternalImage->m_IgnoredSubFiles > 0 && TIFFSetDirectory(tif, d) &&
+        TIFFGetField(tif, TIFFTAG_SUBFILETYPE, &subfiletype) &&
+        (subfiletype & FILETYPE_REDUCEDIMAGE || subfiletype & FILETYPE_MASK))
+    {
+      continue;
+    }
+    directories.push_back(d);
+  }
+  if (directories.size() < z0 + pages)
+  {
+    itkExceptionMacro("The IO region " << region << " has more pages than the image of " << m_FileName);
+  }
+
+  // The strips or tiles which intersect the region.
+  std::vector<TIFFBlock> blocks;
+  for (size_t page = 0; page < pages; ++page)
+  {
+    const uint16_t directory = directories[z0 + page];
+    if (!TIFFSetDirectory(tif, directory))
+    {
+      itkExceptionMacro("Cannot read the directory " << directory << " of " << m_FileName);
+    }
+    const bool tiled = TIFFIsTiled(tif);
+    uint32_t   blockWidth = width;
+    uint32_t   blockHeight = height;
+    if (tiled)
+    {
+      TIFFGetField(tif, TIFFTAG_TILEWIDTH, &blockWidth);
+      TIFFGetField(tif, TIFFTAG_TILELENGTH, &blockHeight);
+    }
+    else
+    {
+      TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &blockHeight);
+      blockHeight = std::min(blockHeight, height);
+    }
+    if (blockWidth == 0 || blockHeight == 0)
+    {
+      itkExceptionMacro("Invalid strip or tile size in " << m_FileName);
+    }
+    for (uint32_t row = firstRow / blockHeight * blockHeight; row < lastRow; row += blockHeight)
+    {
+      for (uint32_t column = x0 / blockWidth * blockWidth; column < x1; column += blockWidth)
+      {
+        const uint32_t index = tiled ? TIFFComputeTile(tif, column, row, 0, 0) : TIFFComputeStrip(tif, row, 0);
+        blocks.push_back({ directory, tiled, index, column, row, blockWidth, blockHeight, page });
+      }
+    }
+  }
+
+  // Copies the rows of the decoded blocks which lie in the region.
+  const size_t pixelSize = this->GetComponentSize() * this->GetNumberOfComponents();
+  auto * const out = static_cast<char *>(buffer);
+  const auto   readBlocks = [&](TIFF * image, size_t first, size_t last) -> bool {
+    std::vector<char> data;
+    for (size_t i = first; i < last; ++i)
+    {
+      const TIFFBlock & block = blocks[i];
+      if (TIFFCurrentDirectory(image) != block.Directory && !TIFFSetDirectory(image, block.Directory))
+      {
+        return false;
+      }
+      const tmsize_t size = block.Tiled ? TIFFTileSize(image) : TIFFStripSize(image);
+      data.resize(static_cast<size_t>(size));
+      const tmsize_t read = block.Tiled ? TIFFReadEncodedTile(image, block.Index, data.data(), size)
+                                        : TIFFReadEncodedStrip(image, block.Index, data.data(), size);
+      if (read < 0)
+      {
+        return false;
+      }
+      const uint32_t columnBegin = std::max(block.Column, x0);
+      const uint32_t columnEnd = std::min(block.Column + block.Width, x1);
+      const uint32_t rowEnd = std::min(block.Row + block.Height, lastRow);
+      for (uint32_t row = std::max(block.Row, firstRow); row < rowEnd; ++row)
+      {
+        const uint32_t y = bottomLeft ? height - 1 - row : row;
+        const size_t   source = (row - block.Row) * size_t{ block.Width } + (columnBegin - block.Column);
+        const size_t   destination = (block.Page * (y1 - y0) + (y - y0)) * (x1 - x0) + (columnBegin - x0);
+        std::copy_n(
+          data.data() + source * pixelSize, (columnEnd - columnBegin) * pixelSize, out + destination * pixelSize);
+      }
+    }
+    return true;
+  };
+
+  // Each thread decodes a contiguous run of blocks with its own handle on the file.
+  const auto   threader = MultiThreaderBase::New();
+  const size_t numberOfRuns = std::min<size_t>(blocks.size(), threader->GetNumberOfWorkUnits());
+  if (numberOfRuns <= 1)
+  {
+    if (!readBlocks(tif, 0, blocks.size()))
+    {
+      itkExceptionMacro("Cannot read the strips or tiles of " << m_FileName);
+    }
+    return;
+  }
+  std::atomic<bool> failed{ false };
+  threader->ParallelizeArray(
+    0,
+    numberOfRuns,
+    [&](SizeValueType run) {
+      const size_t first = run * blocks.size() / numberOfRuns;
+      const size_t last = (run + 1) * blocks.size() / numberOfRuns;
+      TIFFReaderInternal reader;
+      TIFF *             image = tif;
+      if (run > 0)
+      {
+        image = reader.Open(m_FileName.c_str()) ? reader.m_Image : nullptr;
+      }
+      if (image == nullptr || !readBlocks(image, first, last))
+      {
+        failed = true;
+      }
+      reader.Clean();
+    },
+    nullptr);
+  if (failed)
+  {
+    itkExceptionMacro("Cannot read the strips or tiles of " << m_FileName);
+  }
+}
+
+LightObject::Pointer
+TIFFImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const auto rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_Compression = m_Compression;
+  rval->m_ColorPalette = m_ColorPalette;
+  rval->m_TileSize = m_TileSize;
+  return loPtr;
+}
+
 TIFFImageIO::TIFFImageIO()
   : m_ColorPalette(0)
 
@@ -247,6 +465,8 @@ TIFFImageIO::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "Compression: " << m_Compression << std::endl;
   os << indent << "JPEGQuality: " << this->GetJPEGQuality() << std::endl;
+  os << indent << "TileSize: " << m_TileSize << std::endl;
+  os << indent << "ReadByBlocks: " << (m_ReadByBlocks ? "On" : "Off") << std::endl;
   if (!m_ColorPalette.empty())
   {
     os << indent << "Image RGB palette:" << '\n';
@@ -488,7 +708,9 @@ TIFFImageIO::ReadImageInformation()
   }
 
 
-  if (!m_InternalImage->CanRead())
+  m_ReadByBlocks = this->CanReadByBlocks();
+
+  if (!m_ReadByBlocks && !m_InternalImage->CanRead())
   {
     //  exception if compression is not supported
     if (TIFFIsCODECConfigured(this->m_InternalImage->m_Compression) != 1)
@@ -750,38 +972,49 @@ TIFFImageIO::InternalWrite(const void * buffer)
     }
 
 
-    // Previously, rowsperstrip was set to a default value so that it would be calculated using
-    // the STRIP_SIZE_DEFAULT defined to be 8 kB in tiffiop.h.
-    // However, this a very conservative small number, and it leads to very small strips resulting
-    // in many io operations, which can be slow when written over networks that require
-    // encryption/decryption of each packet (such as sshfs).
-    // Conversely, if the value is too high, a lot of extra memory is required to store the strips
-    // before they are written out.
-    // Experiments writing TIFF images to drives mapped by sshfs showed that a good tradeoff is
-    // achieved when the STRIP_SIZE_DEFAULT is increased to 1 MB.
-    // This results in an increase in memory usage but no increase in writing time when writing
-    // locally and significant writing time improvement when writing over sshfs.
-    // For example, writing a 2048x2048 uint16_t image with 8 kB per strip leads to 2 rows per strip
-    // and takes about 120 seconds writing over sshfs.
-    // Using 1 MB per strip leads to 256 rows per strip, which takes only 4 seconds to write over sshfs.
-    // Rather than change that value in the third party libtiff library, we instead compute the
-    // rowsperstrip here to lead to this same value.
-#ifdef TIFF_INT64_T // detect if libtiff4
-    uint64_t const scanlinesize = TIFFScanlineSize64(tif);
-#else
-    tsize_t scanlinesize = TIFFScanlineSize(tif);
-#endif
-    if (scanlinesize == 0)
+    // The tiles are square, their size being rounded up to a multiple of 16
+    // as required by the TIFF specification.
+    const auto tileSize = static_cast<uint32_t>((m_TileSize + 15) / 16 * 16);
+    if (tileSize > 0)
     {
-      itkExceptionMacro("TIFFScanlineSize returned 0");
+      TIFFSetField(tif, TIFFTAG_TILEWIDTH, tileSize);
+      TIFFSetField(tif, TIFFTAG_TILELENGTH, tileSize);
     }
-    rowsperstrip = static_cast<uint32_t>(1024 * 1024 / scanlinesize);
-    if (rowsperstrip < 1)
+    else
     {
-      rowsperstrip = 1;
-    }
+      // Previously, rowsperstrip was set to a default value so that it would be calculated using
+      // the STRIP_SIZE_DEFAULT defined to be 8 kB in tiffiop.h.
+      // However, this a very conservative small number, and it leads to very small strips resulting
+      // in many io operations, which can be slow when written over networks that require
+      // encryption/decryption of each packet (such as sshfs).
+      // Conversely, if the value is too high, a lot of extra memory is required to store the strips
+      // before they are written out.
+      // Experiments writing TIFF images to drives mapped by sshfs showed that a good tradeoff is
+      // achieved when the STRIP_SIZE_DEFAULT is increased to 1 MB.
+      // This results in an increase in memory usage but no increase in writing time when writing
+      // locally and significant writing time improvement when writing over sshfs.
+      // For example, writing a 2048x2048 uint16_t image with 8 kB per strip leads to 2 rows per strip
+      // and takes about 120 seconds writing over sshfs.
+      // Using 1 MB per strip leads to 256 rows per strip, which takes only 4 seconds to write over sshfs.
+      // Rather than change that value in the third party libtiff library, we instead compute the
+      // rowsperstrip here to lead to this same value.
+#ifdef TIFF_INT64_T // detect if libtiff4
+      uint64_t const scanlinesize = TIFFScanlineSize64(tif);
+#else
+      tsize_t scanlinesize = TIFFScanlineSize(tif);
+#endif
+      if (scanlinesize == 0)
+      {
+        itkExceptionMacro("TIFFScanlineSize returned 0");
+      }
+      rowsperstrip = static_cast<uint32_t>(1024 * 1024 / scanlinesize);
+      if (rowsperstrip < 1)
+      {
+        rowsperstrip = 1;
+      }
 
-    TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, TIFFDefaultStripSize(tif, rowsperstrip));
+      TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, TIFFDefaultStripSize(tif, rowsperstrip));
+    }
 
     if (resolution_x > 0 && resolution_y > 0)
     {
@@ -823,15 +1056,48 @@ TIFFImageIO::InternalWrite(const void * buffer)
     rowLength *= this->GetNumberOfComponents();
     rowLength *= width;
 
-    uint32_t row = 0;
-    for (unsigned int idx2 = 0; idx2 < height; ++idx2)
+    if (tileSize > 0)
     {
-      if (TIFFWriteScanline(tif, const_cast<char *>(outPtr), row, 0) < 0)
+      // The tiles crossing the right and bottom borders are padded with zeros.
+      const SizeValueType pixelLength = rowLength / width;
+      const tmsize_t      tileLength = TIFFTileSize(tif);
+      std::vector<char>   tile(static_cast<size_t>(tileLength));
+      for (uint32_t y = 0; y < h; y += tileSize)
       {
-        itkExceptionMacro("TIFFImageIO: error out of disk space");
+        const uint32_t tileRows = std::min(tileSize, h - y);
+        for (uint32_t x = 0; x < w; x += tileSize)
+        {
+          const uint32_t tileColumns = std::min(tileSize, w - x);
+          if (tileRows < tileSize || tileColumns < tileSize)
+          {
+            std::fill(tile.begin(), tile.end(), char{ 0 });
+          }
+          for (uint32_t r = 0; r < tileRows; ++r)
+          {
+            std::copy_n(outPtr + (y + r) * rowLength + x * pixelLength,
+                        tileColumns * pixelLength,
+                        tile.data() + r * tileSize * pixelLength);
+          }
+          if (TIFFWriteEncodedTile(tif, TIFFComputeTile(tif, x, y, 0, 0), tile.data(), tileLength) < 0)
+          {
+            itkExceptionMacro("TIFFImageIO: error out of disk space");
+          }
+        }
+      }
+      outPtr += height * rowLength;
+    }
+    else
+    {
+      uint32_t row = 0;
+      for (unsigned int idx2 = 0; idx2 < height; ++idx2)
+      {
+        if (TIFFWriteScanline(tif, const_cast<char *>(outPtr), row, 0) < 0)
+        {
+          itkExceptionMacro("TIFFImageIO: error out of disk space");
+        }
+        outPtr += rowLength;
+        ++row;
       }
-      outPtr += rowLength;
-      ++row;
     }
 
     if (m_NumberOfDimensions == 3)
@@ -0,0 +1,142 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkRGBPixel.h"
+#include "itkTIFFImageIO.h"
+#include "itkTestingMacros.h"
+
+// Writes an image in strips or tiles, then checks that a region of it is
+// streamed from the file and equals the same region of the image.
+
+namespace
+{
+
+template <typename TImage>
+int
+itkTIFFImageIOStreamingTestHelper(const std::string &                 fileName,
+                                  unsigned int                        tileSize,
+                                  const std::string &                 compressor,
+                                  const typename TImage::RegionType & requestedRegion)
+{
+  using ImageType = TImage;
+  using PixelType = typename ImageType::PixelType;
+  using ComponentType = typename itk::NumericTraits<PixelType>::ValueType;
+
+  typename ImageType::SizeType size;
+  size.Fill(5);
+  size[0] = 100;
+  size[1] = 75;
+
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  auto * const components = reinterpret_cast<ComponentType *>(image->GetBufferPointer());
+  const size_t numberOfComponents = image->GetPixelContainer()->Size() * sizeof(PixelType) / sizeof(ComponentType);
+  for (size_t i = 0; i < numberOfComponents; ++i)
+  {
+    components[i] = static_cast<ComponentType>((i * 7) % 251);
+  }
+
+  auto writerIO = itk::TIFFImageIO::New();
+  ITK_TEST_SET_GET_VALUE(0, writerIO->GetTileSize());
+  writerIO->SetTileSize(tileSize);
+  ITK_TEST_SET_GET_VALUE(tileSize, writerIO->GetTileSize());
+  if (!compressor.empty())
+  {
+    writerIO->UseCompressionOn();
+    writerIO->SetCompressor(compressor);
+  }
+
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetFileName(fileName);
+  writer->SetInput(image);
+  writer->SetImageIO(writerIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  auto readerIO = itk::TIFFImageIO::New();
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(readerIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->UpdateOutputInformation());
+  ITK_TEST_EXPECT_TRUE(readerIO->CanStreamRead());
+
+  reader->GetOutput()->SetRequestedRegion(requestedRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetBufferedRegion(), requestedRegion);
+
+  itk::ImageRegionConstIterator<ImageType> it(image, requestedRegion);
+  itk::ImageRegionConstIterator<ImageType> readIt(reader->GetOutput(), requestedRegion);
+  for (; !it.IsAtEnd(); ++it, ++readIt)
+  {
+    if (it.Get() != readIt.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error reading " << fileName << " at index " << it.GetIndex() << std::endl;
+      std::cerr << "Expected value " << it.Get() << ", but got " << readIt.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int
+itkTIFFImageIOStreamingTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  using Image2DType = itk::Image<unsigned char, 2>;
+  using Image3DType = itk::Image<unsigned short, 3>;
+  using RGBImageType = itk::Image<itk::RGBPixel<unsigned char>, 2>;
+  using FloatImageType = itk::Image<float, 3>;
+
+  const Image2DType::RegionType region2D({ 13, 21 }, { 40, 30 });
+  const Image3DType::RegionType region3D({ 13, 21, 1 }, { 40, 30, 3 });
+
+  int status = EXIT_SUCCESS;
+
+  // Strips
+  status |= itkTIFFImageIOStreamingTestHelper<Image2DType>(
+    outputDirectory + "/itkTIFFImageIOStreamingTest_strips.tif", 0, "", region2D);
+  status |= itkTIFFImageIOStreamingTestHelper<Image3DType>(
+    outputDirectory + "/itkTIFFImageIOStreamingTest_strips3D.tif", 0, "Deflate", region3D);
+
+  // Tiles, the tile size being rounded up to 32
+  status |= itkTIFFImageIOStreamingTestHelper<Image2DType>(
+    outputDirectory + "/itkTIFFImageIOStreamingTest_tiles.tif", 20, "", region2D);
+  status |= itkTIFFImageIOStreamingTestHelper<Image3DType>(
+    outputDirectory + "/itkTIFFImageIOStreamingTest_tiles3D.tif", 16, "PackBits", region3D);
+  status |= itkTIFFImageIOStreamingTestHelper<RGBImageType>(
+    outputDirectory + "/itkTIFFImageIOStreamingTest_tilesRGB.tif", 32, "LZW", region2D);
+  status |= itkTIFFImageIOStreamingTestHelper<FloatImageType>(
+    outputDirectory + "/itkTIFFImageIOStreamingTest_tilesFloat.tif", 48, "Deflate", region3D);
+
+  std::cout << "Test finished." << std::endl;
+  return status;
+}
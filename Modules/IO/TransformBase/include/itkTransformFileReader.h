@@ -53,6 +53,7 @@ public:
   using TransformIOType = TransformIOBaseTemplate<ParametersValueType>;
   using TransformPointer = typename TransformIOType::TransformPointer;
   using TransformListType = typename TransformIOType::TransformListType;
+  using MemoryMappingEnum = typename TransformIOType::MemoryMappingEnum;
 
   /** Method for creation through the object factory */
   itkNewMacro(Self);
@@ -66,6 +67,13 @@ public:
   /** Get the filename */
   itkGetStringMacro(FileName);
 
+  /** Set/Get whether the displacement field of a DisplacementFieldTransform
+   * is mapped into memory instead of being read, so that only the parts of
+   * the field which are used are loaded.
+   * \sa TransformIOBaseTemplate::SetMemoryMapping() */
+  itkSetEnumMacro(MemoryMapping, MemoryMappingEnum);
+  itkGetEnumMacro(MemoryMapping, MemoryMappingEnum);
+
   /** Read the transforms */
   virtual void
   Update();
@@ -108,6 +116,7 @@ protected:
   TransformListType                 m_TransformList{};
   typename TransformIOType::Pointer m_TransformIO{};
   std::string                       m_FileName{};
+  MemoryMappingEnum                 m_MemoryMapping{ MemoryMappingEnum::Off };
 };
 
 /** This helps to meet backward compatibility */
@@ -23,6 +23,7 @@
 #include "itkLightProcessObject.h"
 #include "itkTransformBase.h"
 #include "itkCommonEnums.h"
+#include "itkIOCommon.h"
 #include <list>
 #include <iostream>
 #include <fstream>
@@ -72,6 +73,9 @@ public:
   using FixedParametersValueType = double;
 
   using TransformType = TransformBaseTemplate<ParametersValueType>;
+  using FixedParametersType = typename TransformType::FixedParametersType;
+
+  using MemoryMappingEnum = IOCommonEnums::MemoryMapping;
 
   /** For writing, a const transform list gets passed in, for
    * reading, a non-const transform list is created from the file.
@@ -134,6 +138,18 @@ public:
   itkGetConstMacro(UseCompression, bool);
   itkBooleanMacro(UseCompression);
 
+  /** Set/Get how the displacement field of a DisplacementFieldTransform is
+   * loaded. When it is not MemoryMappingEnum::Off, and the file stores the
+   * parameters as one contiguous block of raw values of ParametersValueType,
+   * the field is a memory mapping of the file instead of being read: its
+   * pages are only loaded when they are used, e.g. by the requested region of
+   * a streamed ResampleImageFilter. With MemoryMappingEnum::ReadOnly the
+   * parameters of the transform must not be modified. Transform IOs which do
+   * not support mapping ignore it. Default is MemoryMappingEnum::Off.
+   * \sa ImageFileReader::SetMemoryMapping() */
+  itkSetEnumMacro(MemoryMapping, MemoryMappingEnum);
+  itkGetEnumMacro(MemoryMapping, MemoryMappingEnum);
+
   /** The transform type has a string representation used when reading
    * and writing transform files.  In the case where a double-precision
    * transform is to be written as float, or vice versa, the transform
@@ -160,6 +176,18 @@ protected:
   void
   CreateTransform(TransformPointer & ptr, const std::string & ClassName);
 
+  /** Make the displacement field of transform a mapping of the
+   * numberOfParameters values stored at offset in fileName, with the geometry
+   * given by fixedParameters, according to the MemoryMapping mode. Returns
+   * false, leaving the transform unchanged, when the transform is not a
+   * DisplacementFieldTransform or when the values cannot be mapped. */
+  bool
+  MapDisplacementField(TransformType *             transform,
+                       const FixedParametersType & fixedParameters,
+                       const std::string &         fileName,
+                       SizeValueType               offset,
+                       SizeValueType               numberOfParameters) const;
+
   /* The following struct returns the string name of computation type */
   /* default implementation */
   static inline std::string
@@ -174,7 +202,8 @@ private:
   ConstTransformListType m_WriteTransformList{};
   bool                   m_AppendMode{ false };
   /** Should we compress the data? */
-  bool m_UseCompression{ false };
+  bool              m_UseCompression{ false };
+  MemoryMappingEnum m_MemoryMapping{ MemoryMappingEnum::Off };
 };
 
 
@@ -6,6 +6,7 @@ itk_module(
   ENABLE_SHARED
   DEPENDS
   ITKCommon
+  ITKIOImageBase
   ITKTransform
   ITKTransformFactory
   COMPILE_DEPENDS
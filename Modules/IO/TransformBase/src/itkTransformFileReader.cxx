@@ -133,6 +133,7 @@ TransformFileReaderTemplate<TParametersValueType>::Update()
   ioTransformList.clear();
 
   m_TransformIO->SetFileName(m_FileName);
+  m_TransformIO->SetMemoryMapping(m_MemoryMapping);
   m_TransformIO->Read();
 
   if (ioTransformList.empty())
@@ -197,6 +198,7 @@ TransformFileReaderTemplate<TParametersValueType>::PrintSelf(std::ostream & os,
   Superclass::PrintSelf(os, indent);
 
   os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "MemoryMapping: " << m_MemoryMapping << std::endl;
 }
 
 ITK_GCC_PRAGMA_DIAG_PUSH()
@@ -19,11 +19,82 @@
 #define ITK_TEMPLATE_EXPLICIT_TransformIOBase
 #include "itkTransformIOBase.h"
 #include "itkTransformFactoryBase.h"
+#include "itkDisplacementFieldTransform.h"
+#include "itkMemoryMappedImportImageContainer.h"
 #include <iostream>
 #include <fstream>
 
 namespace itk
 {
+namespace
+{
+template <typename TParametersValueType, unsigned int VDimension>
+bool
+MapDisplacementFieldOfDimension(
+  TransformBaseTemplate<TParametersValueType> *                                     transform,
+  const typename TransformBaseTemplate<TParametersValueType>::FixedParametersType & fixedParameters,
+  const std::string &                                                               fileName,
+  SizeValueType                                                                     offset,
+  SizeValueType                                                                     numberOfParameters,
+  IOCommonEnums::MemoryMapping                                                      mode)
+{
+  using DisplacementFieldTransformType = DisplacementFieldTransform<TParametersValueType, VDimension>;
+  using DisplacementFieldType = typename DisplacementFieldTransformType::DisplacementFieldType;
+  using PixelType = typename DisplacementFieldType::PixelType;
+  using PixelContainerType = MemoryMappedImportImageContainer<SizeValueType, PixelType>;
+  static_assert(sizeof(PixelType) == VDimension * sizeof(TParametersValueType));
+
+  auto * displacementFieldTransform = dynamic_cast<DisplacementFieldTransformType *>(transform);
+  if (displacementFieldTransform == nullptr || fixedParameters.Size() != VDimension * (VDimension + 3))
+  {
+    return false;
+  }
+
+  // The geometry of the field is stored as by DisplacementFieldTransform::SetFixedParameters()
+  typename DisplacementFieldType::SizeType      size;
+  typename DisplacementFieldType::PointType     origin;
+  typename DisplacementFieldType::SpacingType   spacing;
+  typename DisplacementFieldType::DirectionType direction;
+  SizeValueType                                 numberOfPixels = 1;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    size[d] = static_cast<SizeValueType>(fixedParameters[d]);
+    origin[d] = fixedParameters[d + VDimension];
+    spacing[d] = fixedParameters[d + 2 * VDimension];
+    for (unsigned int dj = 0; dj < VDimension; ++dj)
+    {
+      direction[d][dj] = fixedParameters[3 * VDimension + (d * VDimension + dj)];
+    }
+    numberOfPixels *= size[d];
+  }
+  if (numberOfPixels == 0 || numberOfPixels * VDimension != numberOfParameters || offset % alignof(PixelType) != 0)
+  {
+    return false;
+  }
+
+  const auto mappedFile = MemoryMappedFile::New();
+  try
+  {
+    mappedFile->Map(fileName, offset, numberOfPixels * sizeof(PixelType), mode);
+  }
+  catch (const ExceptionObject &)
+  {
+    return false;
+  }
+  const auto pixelContainer = PixelContainerType::New();
+  pixelContainer->SetMappedFile(mappedFile);
+
+  const auto displacementField = DisplacementFieldType::New();
+  displacementField->SetSpacing(spacing);
+  displacementField->SetOrigin(origin);
+  displacementField->SetDirection(direction);
+  displacementField->SetRegions(size);
+  displacementField->SetPixelContainer(pixelContainer);
+
+  displacementFieldTransform->SetDisplacementField(displacementField);
+  return true;
+}
+} // namespace
 
 template <typename TParametersValueType>
 TransformIOBaseTemplate<TParametersValueType>::TransformIOBaseTemplate()
@@ -65,6 +136,40 @@ TransformIOBaseTemplate<TParametersValueType>::CreateTransform(TransformPointer
   ptr->UnRegister();
 }
 
+template <typename TParametersValueType>
+bool
+TransformIOBaseTemplate<TParametersValueType>::MapDisplacementField(TransformType *             transform,
+                                                                    const FixedParametersType & fixedParameters,
+                                                                    const std::string &         fileName,
+                                                                    SizeValueType               offset,
+                                                                    SizeValueType numberOfParameters) const
+{
+  if (m_MemoryMapping == MemoryMappingEnum::Off || transform == nullptr)
+  {
+    return false;
+  }
+
+  bool mapped = false;
+  switch (transform->GetInputSpaceDimension())
+  {
+    case 2:
+      mapped = MapDisplacementFieldOfDimension<TParametersValueType, 2>(
+        transform, fixedParameters, fileName, offset, numberOfParameters, m_MemoryMapping);
+      break;
+    case 3:
+      mapped = MapDisplacementFieldOfDimension<TParametersValueType, 3>(
+        transform, fixedParameters, fileName, offset, numberOfParameters, m_MemoryMapping);
+      break;
+    default:
+      break;
+  }
+  if (mapped)
+  {
+    itkDebugMacro("Mapping " << numberOfParameters << " parameters at offset " << offset << " of " << fileName);
+  }
+  return mapped;
+}
+
 template <typename TParametersValueType>
 void
 TransformIOBaseTemplate<TParametersValueType>::OpenStream(std::ofstream & outputStream, bool binary)
@@ -104,6 +209,7 @@ TransformIOBaseTemplate<TParametersValueType>::PrintSelf(std::ostream & os, Inde
 
   os << indent << "FileName: " << m_FileName << std::endl;
   os << indent << "AppendMode: " << (m_AppendMode ? "true" : "false") << std::endl;
+  os << indent << "MemoryMapping: " << m_MemoryMapping << std::endl;
   if (!m_ReadTransformList.empty())
   {
     os << indent << "ReadTransformList: " << std::endl;
@@ -136,6 +136,14 @@ private:
   FixedParametersType
   ReadFixedParameters(const std::string & DataSetName) const;
 
+  /** Get the location in the file of the values of a parameter array, when
+   * they are stored as one contiguous block of native ParametersValueType
+   * values. Returns false otherwise. */
+  bool
+  GetRawParametersLocation(const std::string & DataSetName,
+                           SizeValueType &     offset,
+                           SizeValueType &     numberOfParameters) const;
+
   /** Write a parameter array to the file location name */
   void
   WriteParameters(const std::string & name, const ParametersType & parameters);
@@ -26,6 +26,7 @@
 #include "itkVersion.h"
 #include "itkMakeUniqueForOverwrite.h"
 #include <sstream>
+#include <type_traits>
 
 namespace itk
 {
@@ -250,6 +251,42 @@ HDF5TransformIOTemplate<TParametersValueType>::ReadFixedParameters(const std::st
   return FixedParameterArray;
 }
 
+template <typename TParametersValueType>
+bool
+HDF5TransformIOTemplate<TParametersValueType>::GetRawParametersLocation(const std::string & DataSetName,
+                                                                        SizeValueType &     offset,
+                                                                        SizeValueType &     numberOfParameters) const
+{
+  const H5::DataSet paramSet = this->m_H5File->openDataSet(DataSetName);
+
+  // Compressed or chunked parameters are not stored as one block.
+  const H5::DSetCreatPropList plist = paramSet.getCreatePlist();
+  if (plist.getLayout() != H5D_CONTIGUOUS || plist.getNfilters() != 0)
+  {
+    return false;
+  }
+
+  const H5::PredType nativeType =
+    std::is_same_v<ParametersValueType, double> ? H5::PredType::NATIVE_DOUBLE : H5::PredType::NATIVE_FLOAT;
+  const H5::DataSpace space = paramSet.getSpace();
+  if (!(paramSet.getDataType() == nativeType) || space.getSimpleExtentNdims() != 1)
+  {
+    return false;
+  }
+
+  const haddr_t address = paramSet.getOffset();
+  if (address == HADDR_UNDEF)
+  {
+    return false;
+  }
+
+  // Addresses are relative to the end of the user block.
+  hsize_t dim;
+  space.getSimpleExtentDims(&dim, nullptr);
+  offset = static_cast<SizeValueType>(this->m_H5File->getCreatePlist().getUserblock() + address);
+  numberOfParameters = static_cast<SizeValueType>(dim);
+  return true;
+}
 
 template <typename TParametersValueType>
 void
@@ -336,7 +373,6 @@ HDF5TransformIOTemplate<TParametersValueType>::Read()
           fixedParamsName = transformName + transformFixedNameMisspelled;
         }
         const FixedParametersType fixedparams(this->ReadFixedParameters(fixedParamsName));
-        transform->SetFixedParameters(fixedparams);
 
         std::string paramsName(transformName + transformParamsName);
 #if (H5_VERS_MAJOR == 1) && (H5_VERS_MINOR < 10)
@@ -349,8 +385,22 @@ HDF5TransformIOTemplate<TParametersValueType>::Read()
 #endif
           paramsName = transformName + transformParamsNameMisspelled;
         }
-        const ParametersType params = this->ReadParameters(paramsName);
-        transform->SetParametersByValue(params);
+
+        // The displacement field of a DisplacementFieldTransform may be
+        // mapped instead of being read, and then converted and copied.
+        SizeValueType parametersOffset = 0;
+        SizeValueType numberOfParameters = 0;
+        const bool    mapped = this->GetMemoryMapping() != Superclass::MemoryMappingEnum::Off &&
+                            transformType.find("DisplacementFieldTransform") != std::string::npos &&
+                            this->GetRawParametersLocation(paramsName, parametersOffset, numberOfParameters) &&
+                            this->MapDisplacementField(
+                              transform, fixedparams, this->GetFileName(), parametersOffset, numberOfParameters);
+        if (!mapped)
+        {
+          transform->SetFixedParameters(fixedparams);
+          const ParametersType params = this->ReadParameters(paramsName);
+          transform->SetParametersByValue(params);
+        }
       }
       currentTransformGroup.close();
     }
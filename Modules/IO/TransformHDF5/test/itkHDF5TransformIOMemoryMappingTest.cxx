@@ -0,0 +1,129 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkTransformFileWriter.h"
+#include "itkTransformFileReader.h"
+#include "itkDisplacementFieldTransform.h"
+#include "itkHDF5TransformIOFactory.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMemoryMappedImportImageContainer.h"
+#include "itkTestingMacros.h"
+
+// Writes a DisplacementFieldTransform, and reads it back with and without
+// memory mapping of its displacement field.
+template <typename TParametersValueType>
+static int
+MemoryMappingTest(const std::string & fileName, bool useCompression)
+{
+  constexpr unsigned int Dimension = 3;
+  using TransformType = itk::DisplacementFieldTransform<TParametersValueType, Dimension>;
+  using DisplacementFieldType = typename TransformType::DisplacementFieldType;
+  using MappedPixelContainerType =
+    itk::MemoryMappedImportImageContainer<itk::SizeValueType, typename DisplacementFieldType::PixelType>;
+  using ReaderType = itk::TransformFileReaderTemplate<TParametersValueType>;
+
+  auto displacementField = DisplacementFieldType::New();
+  displacementField->SetRegions(typename DisplacementFieldType::SizeType{ { 20, 16, 12 } });
+  displacementField->SetSpacing(typename DisplacementFieldType::SpacingType(1.5));
+  displacementField->SetOrigin(typename DisplacementFieldType::PointType(-4.0));
+  displacementField->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<DisplacementFieldType> it(displacementField,
+                                                                   displacementField->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    typename DisplacementFieldType::PixelType displacement;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      displacement[d] = static_cast<TParametersValueType>(0.25 * it.GetIndex()[d] - 0.125 * d);
+    }
+    it.Set(displacement);
+  }
+  auto transform = TransformType::New();
+  transform->SetDisplacementField(displacementField);
+
+  auto writer = itk::TransformFileWriterTemplate<TParametersValueType>::New();
+  writer->SetFileName(fileName);
+  writer->SetUseCompression(useCompression);
+  writer->AddTransform(transform);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  for (const auto memoryMapping : { ReaderType::MemoryMappingEnum::Off,
+                                    ReaderType::MemoryMappingEnum::ReadOnly,
+                                    ReaderType::MemoryMappingEnum::CopyOnWrite })
+  {
+    auto reader = ReaderType::New();
+    reader->SetFileName(fileName);
+    reader->SetMemoryMapping(memoryMapping);
+    ITK_TEST_SET_GET_VALUE(memoryMapping, reader->GetMemoryMapping());
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+    auto * readTransform = dynamic_cast<TransformType *>(reader->GetTransformList()->front().GetPointer());
+    ITK_TEST_EXPECT_TRUE(readTransform != nullptr);
+    const DisplacementFieldType * readField = readTransform->GetDisplacementField();
+
+    // Only the uncompressed parameters are stored as one block
+    const bool expectMapped = memoryMapping != ReaderType::MemoryMappingEnum::Off && !useCompression;
+    const bool mapped = dynamic_cast<const MappedPixelContainerType *>(readField->GetPixelContainer()) != nullptr;
+    ITK_TEST_EXPECT_EQUAL(mapped, expectMapped);
+
+    ITK_TEST_EXPECT_EQUAL(readField->GetLargestPossibleRegion(), displacementField->GetLargestPossibleRegion());
+    ITK_TEST_EXPECT_EQUAL(readField->GetOrigin(), displacementField->GetOrigin());
+    ITK_TEST_EXPECT_EQUAL(readField->GetSpacing(), displacementField->GetSpacing());
+    ITK_TEST_EXPECT_TRUE(std::equal(displacementField->GetBufferPointer(),
+                                    displacementField->GetBufferPointer() +
+                                      displacementField->GetBufferedRegion().GetNumberOfPixels(),
+                                    readField->GetBufferPointer()));
+
+    typename TransformType::InputPointType point;
+    point[0] = 3.3;
+    point[1] = 5.1;
+    point[2] = 2.7;
+    ITK_TEST_EXPECT_EQUAL(readTransform->TransformPoint(point), transform->TransformPoint(point));
+  }
+  return EXIT_SUCCESS;
+}
+
+int
+itkHDF5TransformIOMemoryMappingTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  itk::HDF5TransformIOFactory::RegisterOneFactory();
+
+  const std::string directory = argv[1];
+  int               result = EXIT_SUCCESS;
+  for (const bool useCompression : { false, true })
+  {
+    const std::string suffix = useCompression ? "Compressed.h5" : ".h5";
+    if (MemoryMappingTest<double>(directory + "/itkHDF5TransformIOMemoryMappingTestDouble" + suffix,
+                                  useCompression) != EXIT_SUCCESS ||
+        MemoryMappingTest<float>(directory + "/itkHDF5TransformIOMemoryMappingTestFloat" + suffix, useCompression) !=
+          EXIT_SUCCESS)
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
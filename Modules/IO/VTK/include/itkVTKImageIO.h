@@ -70,6 +70,16 @@ public:
   bool
   CanStreamWrite() override;
 
+  // see super class for documentation
+  //
+  // overridden to return true when streamed writing is supported, the
+  // regions being written in place in the file
+  bool
+  CanStreamWriteConcurrently() override
+  {
+    return this->CanStreamWrite();
+  }
+
   // see super class for documentation
   //
   // overridden to return true only when supported
@@ -0,0 +1,192 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkZarrImageIO_h
+#define itkZarrImageIO_h
+#include "ITKIOZarrExport.h"
+
+#include "itkStreamingImageIOBase.h"
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class ZarrImageIO
+ *
+ * \brief ImageIO for multiscale chunked images stored as OME-Zarr directories.
+ *
+ * The image is stored as a Zarr (version 2) group on the local file
+ * system, following the OME-NGFF 0.4 layout:
+ * \li \<name\>.zarr\/.zgroup                the Zarr group
+ * \li \<name\>.zarr\/.zattrs                the "multiscales" metadata: the
+ *                                           axes, and the path, scale and
+ *                                           translation of each level
+ * \li \<name\>.zarr\/\<level\>\/.zarray        the shape, chunks, data type
+ *                                           and compressor of a level
+ * \li \<name\>.zarr\/\<level\>\/\<i\>\/\<j\>\/... one file per chunk
+ *
+ * Level 0 holds the image at full resolution and each following level
+ * halves the size of the previous one along the spatial dimensions. The
+ * components of the pixels are stored along a "c" axis of type "channel"
+ * placed, as required by OME-NGFF, before the spatial axes, and the
+ * direction cosines, which OME-NGFF lacks, under an "itk" attribute.
+ * The chunks are compressed with zlib when UseCompression is on.
+ *
+ * Only the chunks which intersect the IORegion are read or written, on
+ * several threads at once, so that images can be streamed in both
+ * directions; the levels of a streamed image are updated from the pieces
+ * as they are written. SetLevel() selects the level read, whose size,
+ * spacing and origin are then reported by ReadImageInformation().
+ *
+ * Stores written by other applications can be read when their chunks are
+ * uncompressed, or compressed with zlib or gzip, in C order.
+ *
+ * \ingroup IOFilters
+ * \ingroup ITKIOZarr
+ */
+class ITKIOZarr_EXPORT ZarrImageIO : public StreamingImageIOBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ZarrImageIO);
+
+  /** Standard class type aliases. */
+  using Self = ZarrImageIO;
+  using Superclass = StreamingImageIOBase;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ZarrImageIO);
+
+  /** Size of the chunks, fastest moving dimension first, not including the
+   * pixel components. */
+  using ChunkSizeType = std::vector<SizeValueType>;
+
+  /*-------- This part of the interface deals with reading data. ------ */
+
+  /** Determine the file type. Returns true if the directory is a Zarr
+   * group with multiscales metadata, or a Zarr array. */
+  bool
+  CanReadFile(const char *) override;
+
+  /** Several clones may read different files at the same time. */
+  bool
+  CanReadConcurrently() override
+  {
+    return true;
+  }
+
+  /** Set the spacing and dimension information of the selected level. */
+  void
+  ReadImageInformation() override;
+
+  /** Reads the IORegion of the selected level into the memory buffer
+   * provided. */
+  void
+  Read(void * buffer) override;
+
+  /** Set/Get the resolution level to read, 0 being the full resolution. */
+  itkSetMacro(Level, unsigned int);
+  itkGetConstMacro(Level, unsigned int);
+
+  /*-------- This part of the interfaces deals with writing data. ----- */
+
+  /** Determine the file type. Returns true if the file name ends with
+   * ".zarr". */
+  bool
+  CanWriteFile(const char *) override;
+
+  /** Writes the metadata of the group and of its levels. */
+  void
+  WriteImageInformation() override;
+
+  /** Writes the IORegion of the image and of its levels from the memory
+   * buffer provided. */
+  void
+  Write(const void * buffer) override;
+
+  /** Replaces an existing store when the whole image is written, then
+   * behaves as the superclass. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
+  /** Set/Get the number of resolution levels. When writing, the levels
+   * after the first are computed by averaging blocks of two pixels along
+   * each spatial dimension of the previous level. When reading, the number
+   * of levels of the store is reported by ReadImageInformation(). */
+  itkSetClampMacro(NumberOfLevels, unsigned int, 1, 32);
+  itkGetConstMacro(NumberOfLevels, unsigned int);
+
+  /** Set/Get the size of the chunks of the written image. Missing or zero
+   * entries default to 64 pixels along the spatial dimensions, or 256 for
+   * two-dimensional images, and to 1 along the others. The chunks of each
+   * level are clamped to its size. When reading, the chunk size of the
+   * selected level is reported. */
+  void
+  SetChunkSize(const ChunkSizeType & chunkSize)
+  {
+    if (m_ChunkSize != chunkSize)
+    {
+      m_ChunkSize = chunkSize;
+      this->Modified();
+    }
+  }
+  const ChunkSizeType &
+  GetChunkSize() const
+  {
+    return m_ChunkSize;
+  }
+
+protected:
+  ZarrImageIO();
+  ~ZarrImageIO() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  LightObject::Pointer
+  InternalClone() const override;
+
+  /** The chunks hold the pixels, so there is no header. */
+  SizeType
+  GetHeaderSize() const override
+  {
+    return 0;
+  }
+
+private:
+  /** The file name without trailing separators. */
+  std::string
+  GetStorePath() const;
+
+  unsigned int  m_Level{ 0 };
+  unsigned int  m_NumberOfLevels{ 1 };
+  ChunkSizeType m_ChunkSize{};
+
+  /** The array of the level read, and the position of its channel axis,
+   * negative when the pixels are scalars. */
+  std::string m_ArrayPath{};
+  int         m_ChannelAxis{ -1 };
+};
+} // end namespace itk
+
+#endif // itkZarrImageIO_h
@@ -0,0 +1,20 @@
+set(DOCUMENTATION
+    "This module contains an ImageIO class for reading and writing
+ITK Images stored as multiscale, chunked <a href=\"https://ngff.openmicroscopy.org/\">OME-Zarr</a>
+directories.")
+
+itk_module(
+  ITKIOZarr
+  ENABLE_SHARED
+  DEPENDS
+  ITKIOImageBase
+  PRIVATE_DEPENDS
+  ITKDoubleConversion
+  ITKZLIB
+  TEST_DEPENDS
+  ITKTestKernel
+  ITKImageSources
+  FACTORY_NAMES
+  ImageIO::Zarr
+  DESCRIPTION
+  "${DOCUMENTATION}")
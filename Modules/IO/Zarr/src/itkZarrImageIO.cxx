@@ -0,0 +1,1561 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkZarrImageIO.h"
+#include "itkByteSwapper.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNumberToString.h"
+#include "itksys/SystemTools.hxx"
+#include "itk_zlib.h"
+#include <double-conversion/string-to-double.h>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <type_traits>
+
+namespace itk
+{
+namespace
+{
+/** A JSON value of the metadata of a store. */
+struct JSONValue
+{
+  enum class Kind
+  {
+    Null,
+    Boolean,
+    Number,
+    String,
+    Array,
+    Object
+  };
+
+  Kind                                           Type{ Kind::Null };
+  bool                                           Boolean{ false };
+  double                                         Number{ 0.0 };
+  std::string                                    String{};
+  std::vector<JSONValue>                         Array{};
+  std::vector<std::pair<std::string, JSONValue>> Object{};
+
+  /** The member of an object, or nullptr. */
+  const JSONValue *
+  Find(const std::string & key) const
+  {
+    for (const auto & member : Object)
+    {
+      if (member.first == key)
+      {
+        return &member.second;
+      }
+    }
+    return nullptr;
+  }
+};
+
+/** A recursive descent parser of JSON documents. */
+class JSONParser
+{
+public:
+  explicit JSONParser(const std::string & text)
+    : m_Text(text)
+  {}
+
+  JSONValue
+  Parse()
+  {
+    JSONValue value = this->ParseValue();
+    this->SkipSpaces();
+    if (m_Position != m_Text.size())
+    {
+      this->Fail();
+    }
+    return value;
+  }
+
+private:
+  [[noreturn]] void
+  Fail() const
+  {
+    itkGenericExceptionMacro("Invalid JSON at offset " << m_Position);
+  }
+
+  void
+  SkipSpaces()
+  {
+    while (m_Position < m_Text.size() && std::isspace(static_cast<unsigned char>(m_Text[m_Position])))
+    {
+      ++m_Position;
+    }
+  }
+
+  bool
+  Accept(const char * token)
+  {
+    this->SkipSpaces();
+    const size_t length = std::strlen(token);
+    if (m_Text.compare(m_Position, length, token) == 0)
+    {
+      m_Position += length;
+      return true;
+    }
+    return false;
+  }
+
+  void
+  Expect(const char * token)
+  {
+    if (!this->Accept(token))
+    {
+      this->Fail();
+    }
+  }
+
+  JSONValue
+  ParseValue()
+  {
+    JSONValue value;
+    if (this->Accept("{"))
+    {
+      value.Type = JSONValue::Kind::Object;
+      if (!this->Accept("}"))
+      {
+        do
+        {
+          this->SkipSpaces();
+          std::string key = this->ParseString();
+          this->Expect(":");
+          value.Object.emplace_back(std::move(key), this->ParseValue());
+        } while (this->Accept(","));
+        this->Expect("}");
+      }
+    }
+    else if (this->Accept("["))
+    {
+      value.Type = JSONValue::Kind::Array;
+      if (!this->Accept("]"))
+      {
+        do
+        {
+          value.Array.push_back(this->ParseValue());
+        } while (this->Accept(","));
+        this->Expect("]");
+      }
+    }
+    else if (this->Accept("true"))
+    {
+      value.Type = JSONValue::Kind::Boolean;
+      value.Boolean = true;
+    }
+    else if (this->Accept("false"))
+    {
+      value.Type = JSONValue::Kind::Boolean;
+    }
+    else if (this->Accept("null"))
+    {
+      value.Type = JSONValue::Kind::Null;
+    }
+    else if (m_Position < m_Text.size() && m_Text[m_Position] == '"')
+    {
+      value.Type = JSONValue::Kind::String;
+      value.String = this->ParseString();
+    }
+    else
+    {
+      // Independent of the locale, unlike std::strtod
+      constexpr auto double_NaN = std::numeric_limits<double>::quiet_NaN();
+      static const double_conversion::StringToDoubleConverter converter(
+        double_conversion::StringToDoubleConverter::ALLOW_TRAILING_JUNK, double_NaN, double_NaN, nullptr, nullptr);
+      int processedCharCount{ 0 };
+      value.Type = JSONValue::Kind::Number;
+      value.Number = converter.StringToDouble(
+        m_Text.c_str() + m_Position, static_cast<int>(m_Text.size() - m_Position), &processedCharCount);
+      if (processedCharCount == 0)
+      {
+        this->Fail();
+      }
+      m_Position += processedCharCount;
+    }
+    return value;
+  }
+
+  std::string
+  ParseString()
+  {
+    if (m_Position >= m_Text.size() || m_Text[m_Position] != '"')
+    {
+      this->Fail();
+    }
+    ++m_Position;
+    std::string value;
+    while (m_Position < m_Text.size())
+    {
+      const char c = m_Text[m_Position++];
+      if (c == '"')
+      {
+        return value;
+      }
+      if (c != '\\')
+      {
+        value += c;
+        continue;
+      }
+      if (m_Position >= m_Text.size())
+      {
+        break;
+      }
+      const char escaped = m_Text[m_Position++];
+      switch (escaped)
+      {
+        case 'b':
+          value += '\b';
+          break;
+        case 'f':
+          value += '\f';
+          break;
+        case 'n':
+          value += '\n';
+          break;
+        case 'r':
+          value += '\r';
+          break;
+        case 't':
+          value += '\t';
+          break;
+        case 'u':
+        {
+          // Code points of the basic multilingual plane, encoded in UTF-8
+          if (m_Position + 4 > m_Text.size() ||
+              !std::all_of(m_Text.begin() + m_Position, m_Text.begin() + m_Position + 4, [](char digit) {
+                return std::isxdigit(static_cast<unsigned char>(digit)) != 0;
+              }))
+          {
+            this->Fail();
+          }
+          const auto code = static_cast<unsigned int>(std::stoul(m_Text.substr(m_Position, 4), nullptr, 16));
+          m_Position += 4;
+          if (code < 0x80)
+          {
+            value += static_cast<char>(code);
+          }
+          else if (code < 0x800)
+          {
+            value += static_cast<char>(0xC0 | (code >> 6));
+            value += static_cast<char>(0x80 | (code & 0x3F));
+          }
+          else
+          {
+            value += static_cast<char>(0xE0 | (code >> 12));
+            value += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            value += static_cast<char>(0x80 | (code & 0x3F));
+          }
+          break;
+        }
+        default:
+          value += escaped;
+      }
+    }
+    this->Fail();
+  }
+
+  const std::string & m_Text;
+  size_t              m_Position{ 0 };
+};
+
+bool
+ReadFileContents(const std::string & fileName, std::vector<char> & contents)
+{
+  std::ifstream file(fileName, std::ios::in | std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+  file.seekg(0, std::ios::end);
+  contents.resize(static_cast<size_t>(file.tellg()));
+  file.seekg(0, std::ios::beg);
+  return static_cast<bool>(file.read(contents.data(), static_cast<std::streamsize>(contents.size())));
+}
+
+JSONValue
+ReadJSONFile(const std::string & fileName)
+{
+  std::vector<char> contents;
+  if (!ReadFileContents(fileName, contents))
+  {
+    itkGenericExceptionMacro("Cannot read " << fileName);
+  }
+  const std::string text(contents.begin(), contents.end());
+  try
+  {
+    return JSONParser(text).Parse();
+  }
+  catch (const ExceptionObject & e)
+  {
+    itkGenericExceptionMacro("Cannot parse " << fileName << ": " << e.GetDescription());
+  }
+}
+
+void
+WriteTextFile(const std::string & fileName, const std::string & text)
+{
+  std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+  if (!(file << text))
+  {
+    itkGenericExceptionMacro("Cannot write " << fileName);
+  }
+}
+
+template <typename TValue>
+std::string
+ToJSON(const std::vector<TValue> & values)
+{
+  std::string json = "[";
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    json += (i == 0 ? "" : ", ") + ConvertNumberToString(values[i]);
+  }
+  return json + "]";
+}
+
+/** The metadata of a Zarr array, its dimensions being listed slowest moving first. */
+struct ZarrArray
+{
+  std::string                Path{};
+  std::vector<SizeValueType> Shape{};
+  std::vector<SizeValueType> Chunks{};
+  IOComponentEnum            ComponentType{ IOComponentEnum::UNKNOWNCOMPONENTTYPE };
+  size_t                     ComponentSize{ 0 };
+  bool                       SwapBytes{ false };
+  bool                       Compressed{ false };
+  int                        CompressionLevel{ Z_DEFAULT_COMPRESSION };
+  double                     FillValue{ 0.0 };
+  char                       Separator{ '.' };
+
+  size_t
+  GetChunkBytes() const
+  {
+    size_t bytes = ComponentSize;
+    for (const auto chunk : Chunks)
+    {
+      bytes *= chunk;
+    }
+    return bytes;
+  }
+
+  std::string
+  GetChunkFileName(const std::vector<SizeValueType> & chunkIndex) const
+  {
+    std::string fileName = Path;
+    for (size_t i = 0; i < chunkIndex.size(); ++i)
+    {
+      fileName += (i == 0 ? '/' : Separator) + std::to_string(chunkIndex[i]);
+    }
+    return fileName;
+  }
+};
+
+
+/** Calls function with a null pointer to the type of the components. */
+template <typename TFunction>
+void
+DispatchComponentType(IOComponentEnum componentType, TFunction && function)
+{
+  switch (componentType)
+  {
+    case IOComponentEnum::UCHAR:
+      function(static_cast<unsigned char *>(nullptr));
+      break;
+    case IOComponentEnum::CHAR:
+      function(static_cast<signed char *>(nullptr));
+      break;
+    case IOComponentEnum::USHORT:
+      function(static_cast<unsigned short *>(nullptr));
+      break;
+    case IOComponentEnum::SHORT:
+      function(static_cast<short *>(nullptr));
+      break;
+    case IOComponentEnum::UINT:
+      function(static_cast<unsigned int *>(nullptr));
+      break;
+    case IOComponentEnum::INT:
+      function(static_cast<int *>(nullptr));
+      break;
+    case IOComponentEnum::ULONG:
+      function(static_cast<unsigned long *>(nullptr));
+      break;
+    case IOComponentEnum::LONG:
+      function(static_cast<long *>(nullptr));
+      break;
+    case IOComponentEnum::ULONGLONG:
+      function(static_cast<unsigned long long *>(nullptr));
+      break;
+    case IOComponentEnum::LONGLONG:
+      function(static_cast<long long *>(nullptr));
+      break;
+    case IOComponentEnum::FLOAT:
+      function(static_cast<float *>(nullptr));
+      break;
+    case IOComponentEnum::DOUBLE:
+      function(static_cast<double *>(nullptr));
+      break;
+    default:
+      itkGenericExceptionMacro("Unsupported component type: " << componentType);
+  }
+}
+
+/** The Zarr data type of the components, in the byte order of the system. */
+std::string
+ToDataType(IOComponentEnum componentType, size_t componentSize)
+{
+  char kind = 'u';
+  switch (componentType)
+  {
+    case IOComponentEnum::CHAR:
+    case IOComponentEnum::SHORT:
+    case IOComponentEnum::INT:
+    case IOComponentEnum::LONG:
+    case IOComponentEnum::LONGLONG:
+      kind = 'i';
+      break;
+    case IOComponentEnum::FLOAT:
+    case IOComponentEnum::DOUBLE:
+      kind = 'f';
+      break;
+    default:
+      break;
+  }
+  const char byteOrder = componentSize == 1 ? '|' : (ByteSwapper<int>::SystemIsBigEndian() ? '>' : '<');
+  return byteOrder + (kind + std::to_string(componentSize));
+}
+
+/** Reads the metadata of the Zarr array stored in path. */
+ZarrArray
+ReadArray(const std::string & path)
+{
+  const std::string fileName = path + "/.zarray";
+  const JSONValue   json = ReadJSONFile(fileName);
+  const auto        member = [&json, &fileName](const char * key) -> const JSONValue & {
+    const JSONValue * value = json.Find(key);
+    if (value == nullptr)
+    {
+      itkGenericExceptionMacro("Missing \"" << key << "\" in " << fileName);
+    }
+    return *value;
+  };
+
+  ZarrArray array;
+  array.Path = path;
+  if (member("zarr_format").Number != 2.0)
+  {
+    itkGenericExceptionMacro("Unsupported Zarr format in " << fileName);
+  }
+  const JSONValue & shape = member("shape");
+  const JSONValue & chunks = member("chunks");
+  if (shape.Array.empty() || shape.Array.size() != chunks.Array.size())
+  {
+    itkGenericExceptionMacro("Invalid shape or chunks in " << fileName);
+  }
+  for (size_t i = 0; i < shape.Array.size(); ++i)
+  {
+    array.Shape.push_back(static_cast<SizeValueType>(shape.Array[i].Number));
+    array.Chunks.push_back(std::max<SizeValueType>(static_cast<SizeValueType>(chunks.Array[i].Number), 1));
+  }
+
+  const std::string & dataType = member("dtype").String;
+  const char          kind = dataType.size() > 2 ? dataType[1] : '\0';
+  array.ComponentSize = kind == '\0' ? 0 : std::strtoul(dataType.c_str() + 2, nullptr, 10);
+  if (kind == 'u' || kind == 'b')
+  {
+    const IOComponentEnum types[] = { IOComponentEnum::UCHAR,
+                                      IOComponentEnum::USHORT,
+                                      IOComponentEnum::UINT,
+                                      IOComponentEnum::ULONGLONG };
+    for (size_t i = 0; i < 4; ++i)
+    {
+      array.ComponentType = array.ComponentSize == (size_t{ 1 } << i) ? types[i] : array.ComponentType;
+    }
+  }
+  else if (kind == 'i')
+  {
+    const IOComponentEnum types[] = { IOComponentEnum::CHAR,
+                                      IOComponentEnum::SHORT,
+                                      IOComponentEnum::INT,
+                                      IOComponentEnum::LONGLONG };
+    for (size_t i = 0; i < 4; ++i)
+    {
+      array.ComponentType = array.ComponentSize == (size_t{ 1 } << i) ? types[i] : array.ComponentType;
+    }
+  }
+  else if (kind == 'f')
+  {
+    array.ComponentType = array.ComponentSize == 4   ? IOComponentEnum::FLOAT
+                          : array.ComponentSize == 8 ? IOComponentEnum::DOUBLE
+                                                     : array.ComponentType;
+  }
+  if (array.ComponentType == IOComponentEnum::UNKNOWNCOMPONENTTYPE)
+  {
+    itkGenericExceptionMacro("Unsupported data type \"" << dataType << "\" in " << fileName);
+  }
+  array.SwapBytes = array.ComponentSize > 1 && (dataType[0] == '>') != ByteSwapper<int>::SystemIsBigEndian();
+
+  const JSONValue & compressor = member("compressor");
+  if (compressor.Type == JSONValue::Kind::Object)
+  {
+    const JSONValue * id = compressor.Find("id");
+    if (id == nullptr || (id->String != "zlib" && id->String != "gzip"))
+    {
+      itkGenericExceptionMacro("Unsupported compressor in " << fileName);
+    }
+    array.Compressed = true;
+    if (const JSONValue * level = compressor.Find("level"))
+    {
+      array.CompressionLevel = static_cast<int>(level->Number);
+    }
+  }
+
+  const JSONValue & fillValue = member("fill_value");
+  if (fillValue.Type == JSONValue::Kind::Number)
+  {
+    array.FillValue = fillValue.Number;
+  }
+  else if (fillValue.Type == JSONValue::Kind::String && fillValue.String == "NaN")
+  {
+    array.FillValue = std::numeric_limits<double>::quiet_NaN();
+  }
+
+  const JSONValue * filters = json.Find("filters");
+  if (member("order").String != "C" || (filters != nullptr && !filters->Array.empty()))
+  {
+    itkGenericExceptionMacro("Only C ordered arrays without filters are supported: " << fileName);
+  }
+  const JSONValue * separator = json.Find("dimension_separator");
+  if (separator != nullptr && separator->String == "/")
+  {
+    array.Separator = '/';
+  }
+  return array;
+}
+
+void
+SwapBytes(std::vector<char> & data, size_t componentSize)
+{
+  for (size_t i = 0; i + componentSize <= data.size(); i += componentSize)
+  {
+    std::reverse(data.begin() + i, data.begin() + i + componentSize);
+  }
+}
+
+void
+FillChunk(const ZarrArray & array, std::vector<char> & chunk)
+{
+  DispatchComponentType(array.ComponentType, [&array, &chunk](auto * tag) {
+    using ComponentType = std::remove_pointer_t<decltype(tag)>;
+    const bool          integralNaN = std::is_integral_v<ComponentType> && std::isnan(array.FillValue);
+    const ComponentType value = integralNaN ? ComponentType{} : static_cast<ComponentType>(array.FillValue);
+    std::fill_n(reinterpret_cast<ComponentType *>(chunk.data()), chunk.size() / sizeof(ComponentType), value);
+  });
+}
+
+/** Reads a chunk in the byte order of the system, or returns false when its file does not exist. */
+bool
+LoadChunk(const ZarrArray & array, const std::string & fileName, std::vector<char> & chunk)
+{
+  std::vector<char> contents;
+  if (!ReadFileContents(fileName, contents))
+  {
+    return false;
+  }
+  if (array.Compressed)
+  {
+    z_stream stream{};
+    if (inflateInit2(&stream, MAX_WBITS + 32) != Z_OK)
+    {
+      itkGenericExceptionMacro("Cannot decompress " << fileName);
+    }
+    stream.next_in = reinterpret_cast<Bytef *>(contents.data());
+    stream.avail_in = static_cast<uInt>(contents.size());
+    stream.next_out = reinterpret_cast<Bytef *>(chunk.data());
+    stream.avail_out = static_cast<uInt>(chunk.size());
+    const int result = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+    if (result != Z_STREAM_END || stream.total_out != chunk.size())
+    {
+      itkGenericExceptionMacro("Cannot decompress " << fileName);
+    }
+  }
+  else if (contents.size() == chunk.size())
+  {
+    chunk.swap(contents);
+  }
+  else
+  {
+    itkGenericExceptionMacro("Unexpected size of " << fileName);
+  }
+  if (array.SwapBytes)
+  {
+    SwapBytes(chunk, array.ComponentSize);
+  }
+  return true;
+}
+
+void
+StoreChunk(const ZarrArray & array, const std::string & fileName, std::vector<char> & chunk)
+{
+  if (array.SwapBytes)
+  {
+    SwapBytes(chunk, array.ComponentSize);
+  }
+  std::vector<Bytef> compressed;
+  const char *       data = chunk.data();
+  size_t             size = chunk.size();
+  if (array.Compressed)
+  {
+    auto compressedSize = compressBound(static_cast<uLong>(chunk.size()));
+    compressed.resize(compressedSize);
+    if (compress2(compressed.data(),
+                  &compressedSize,
+                  reinterpret_cast<const Bytef *>(chunk.data()),
+                  static_cast<uLong>(chunk.size()),
+                  array.CompressionLevel) != Z_OK)
+    {
+      itkGenericExceptionMacro("Cannot compress " << fileName);
+    }
+    data = reinterpret_cast<const char *>(compressed.data());
+    size = compressedSize;
+  }
+  std::ofstream file(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.write(data, static_cast<std::streamsize>(size)))
+  {
+    itkGenericExceptionMacro("Cannot write " << fileName);
+  }
+}
+
+/** Copies a box of elements between two C ordered arrays. */
+void
+CopyBox(size_t                             elementSize,
+        const std::vector<SizeValueType> & boxSize,
+        const char *                       source,
+        const std::vector<SizeValueType> & sourceShape,
+        const std::vector<SizeValueType> & sourceStart,
+        char *                             destination,
+        const std::vector<SizeValueType> & destinationShape,
+        const std::vector<SizeValueType> & destinationStart)
+{
+  const size_t n = boxSize.size();
+  if (std::find(boxSize.begin(), boxSize.end(), 0) != boxSize.end())
+  {
+    return;
+  }
+  const size_t               rowBytes = boxSize[n - 1] * elementSize;
+  std::vector<SizeValueType> position(n, 0);
+  while (true)
+  {
+    size_t sourceOffset = 0;
+    size_t destinationOffset = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      sourceOffset = sourceOffset * sourceShape[i] + sourceStart[i] + position[i];
+      destinationOffset = destinationOffset * destinationShape[i] + destinationStart[i] + position[i];
+    }
+    std::memcpy(destination + destinationOffset * elementSize, source + sourceOffset * elementSize, rowBytes);
+
+    size_t i = n - 1;
+    for (; i > 0; --i)
+    {
+      if (++position[i - 1] < boxSize[i - 1])
+      {
+        break;
+      }
+      position[i - 1] = 0;
+    }
+    if (i == 0)
+    {
+      return;
+    }
+  }
+}
+
+/** The indices of the chunks which intersect a box. */
+std::vector<std::vector<SizeValueType>>
+GetChunkIndices(const ZarrArray &                  array,
+                const std::vector<SizeValueType> & start,
+                const std::vector<SizeValueType> & size)
+{
+  std::vector<std::vector<SizeValueType>> chunkIndices(1);
+  for (size_t i = 0; i < array.Shape.size(); ++i)
+  {
+    if (size[i] == 0)
+    {
+      return {};
+    }
+    std::vector<std::vector<SizeValueType>> indices;
+    for (const auto & index : chunkIndices)
+    {
+      for (SizeValueType c = start[i] / array.Chunks[i]; c <= (start[i] + size[i] - 1) / array.Chunks[i]; ++c)
+      {
+        indices.push_back(index);
+        indices.back().push_back(c);
+      }
+    }
+    chunkIndices.swap(indices);
+  }
+  return chunkIndices;
+}
+
+/** Calls function for each chunk which intersects the box, with the file name of the chunk, the part of the box
+ * within the chunk, and the start of this part in the chunk and in the box. The chunks are processed in parallel. */
+template <typename TFunction>
+void
+ForEachChunk(const ZarrArray &                  array,
+             const std::vector<SizeValueType> & start,
+             const std::vector<SizeValueType> & size,
+             TFunction &&                       function)
+{
+  const size_t                                  n = array.Shape.size();
+  const std::vector<std::vector<SizeValueType>> chunkIndices = GetChunkIndices(array, start, size);
+
+  std::string errorMessage;
+  std::mutex  errorMutex;
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    chunkIndices.size(),
+    [&](SizeValueType k) {
+      const std::vector<SizeValueType> & chunkIndex = chunkIndices[k];
+      std::vector<SizeValueType>         boxSize(n);
+      std::vector<SizeValueType>         chunkStart(n);
+      std::vector<SizeValueType>         boxStart(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        const SizeValueType first = std::max(start[i], chunkIndex[i] * array.Chunks[i]);
+        const SizeValueType last = std::min(start[i] + size[i], (chunkIndex[i] + 1) * array.Chunks[i]);
+        boxSize[i] = last - first;
+        chunkStart[i] = first - chunkIndex[i] * array.Chunks[i];
+        boxStart[i] = first - start[i];
+      }
+      try
+      {
+        function(array.GetChunkFileName(chunkIndex), boxSize, chunkStart, boxStart);
+      }
+      catch (const ExceptionObject & e)
+      {
+        const std::lock_guard<std::mutex> lock(errorMutex);
+        errorMessage = e.GetDescription();
+      }
+    },
+    nullptr);
+  if (!errorMessage.empty())
+  {
+    itkGenericExceptionMacro(<< errorMessage);
+  }
+}
+
+/** Reads a box of a Zarr array into a C ordered buffer. */
+void
+ReadArrayRegion(const ZarrArray &                  array,
+                const std::vector<SizeValueType> & start,
+                const std::vector<SizeValueType> & size,
+                void *                             buffer)
+{
+  ForEachChunk(array,
+               start,
+               size,
+               [&](const std::string &                fileName,
+                   const std::vector<SizeValueType> & boxSize,
+                   const std::vector<SizeValueType> & chunkStart,
+                   const std::vector<SizeValueType> & boxStart) {
+                 std::vector<char> chunk(array.GetChunkBytes());
+                 if (!LoadChunk(array, fileName, chunk))
+                 {
+                   FillChunk(array, chunk);
+                 }
+                 CopyBox(array.ComponentSize,
+                         boxSize,
+                         chunk.data(),
+                         array.Chunks,
+                         chunkStart,
+                         static_cast<char *>(buffer),
+                         size,
+                         boxStart);
+               });
+}
+
+/** Writes a box of a Zarr array from a C ordered buffer, updating the chunks it partially covers. */
+void
+WriteArrayRegion(const ZarrArray &                  array,
+                 const std::vector<SizeValueType> & start,
+                 const std::vector<SizeValueType> & size,
+                 const void *                       buffer)
+{
+  if (array.Separator == '/')
+  {
+    // The directories of the chunks are created before writing them concurrently.
+    std::set<std::string> directories;
+    for (const auto & chunkIndex : GetChunkIndices(array, start, size))
+    {
+      directories.insert(itksys::SystemTools::GetFilenamePath(array.GetChunkFileName(chunkIndex)));
+    }
+    for (const auto & directory : directories)
+    {
+      if (!itksys::SystemTools::MakeDirectory(directory))
+      {
+        itkGenericExceptionMacro("Cannot create directory " << directory);
+      }
+    }
+  }
+
+  ForEachChunk(array,
+               start,
+               size,
+               [&](const std::string &                fileName,
+                   const std::vector<SizeValueType> & boxSize,
+                   const std::vector<SizeValueType> & chunkStart,
+                   const std::vector<SizeValueType> & boxStart) {
+                 bool covered = true;
+                 for (size_t i = 0; i < array.Shape.size(); ++i)
+                 {
+                   const SizeValueType chunkFirst = start[i] + boxStart[i] - chunkStart[i];
+                   covered = covered && chunkStart[i] == 0 &&
+                             boxSize[i] == std::min(array.Chunks[i], array.Shape[i] - chunkFirst);
+                 }
+                 std::vector<char> chunk(array.GetChunkBytes());
+                 if (covered || !LoadChunk(array, fileName, chunk))
+                 {
+                   FillChunk(array, chunk);
+                 }
+                 CopyBox(array.ComponentSize,
+                         boxSize,
+                         static_cast<const char *>(buffer),
+                         size,
+                         boxStart,
+                         chunk.data(),
+                         array.Chunks,
+                         chunkStart);
+                 StoreChunk(array, fileName, chunk);
+               });
+}
+
+/** The box of the Zarr array of an ITK region, the components being stored along the channel axis. */
+void
+ToArrayBox(const ImageIORegion &        region,
+           unsigned int                 numberOfComponents,
+           int                          channelAxis,
+           std::vector<SizeValueType> & start,
+           std::vector<SizeValueType> & size)
+{
+  const unsigned int dimension = region.GetImageDimension();
+  start.clear();
+  size.clear();
+  for (int d = static_cast<int>(dimension) - 1; d >= 0; --d)
+  {
+    if (static_cast<int>(start.size()) == channelAxis)
+    {
+      start.push_back(0);
+      size.push_back(numberOfComponents);
+    }
+    start.push_back(static_cast<SizeValueType>(region.GetIndex(d)));
+    size.push_back(region.GetSize(d));
+  }
+  if (static_cast<int>(start.size()) == channelAxis)
+  {
+    start.push_back(0);
+    size.push_back(numberOfComponents);
+  }
+}
+
+/** Moves the components of the pixels from the channel axis of a box to the end of it, or back. */
+void
+InterleaveComponents(const std::vector<SizeValueType> & size,
+                     int                                channelAxis,
+                     size_t                             componentSize,
+                     bool                               toPixels,
+                     const char *                       source,
+                     char *                             destination)
+{
+  size_t outer = 1;
+  size_t inner = 1;
+  for (size_t i = 0; i < size.size(); ++i)
+  {
+    if (static_cast<int>(i) < channelAxis)
+    {
+      outer *= size[i];
+    }
+    else if (static_cast<int>(i) > channelAxis)
+    {
+      inner *= size[i];
+    }
+  }
+  const size_t components = size[channelAxis];
+  for (size_t o = 0; o < outer; ++o)
+  {
+    for (size_t c = 0; c < components; ++c)
+    {
+      for (size_t i = 0; i < inner; ++i)
+      {
+        const size_t planar = (o * components + c) * inner + i;
+        const size_t interleaved = (o * inner + i) * components + c;
+        std::memcpy(destination + (toPixels ? interleaved : planar) * componentSize,
+                    source + (toPixels ? planar : interleaved) * componentSize,
+                    componentSize);
+      }
+    }
+  }
+}
+
+/** Reads an ITK region of an array into a buffer of pixels. */
+void
+ReadRegion(const ZarrArray &     array,
+           int                   channelAxis,
+           unsigned int          numberOfComponents,
+           const ImageIORegion & region,
+           void *                buffer)
+{
+  std::vector<SizeValueType> start;
+  std::vector<SizeValueType> size;
+  ToArrayBox(region, numberOfComponents, channelAxis, start, size);
+  if (start.size() != array.Shape.size())
+  {
+    itkGenericExceptionMacro("Unexpected number of dimensions of " << array.Path);
+  }
+  if (channelAxis < 0 || channelAxis + 1 == static_cast<int>(size.size()))
+  {
+    ReadArrayRegion(array, start, size, buffer);
+    return;
+  }
+  std::vector<char> planar(region.GetNumberOfPixels() * numberOfComponents * array.ComponentSize);
+  ReadArrayRegion(array, start, size, planar.data());
+  InterleaveComponents(size, channelAxis, array.ComponentSize, true, planar.data(), static_cast<char *>(buffer));
+}
+
+/** Writes an ITK region of an array from a buffer of pixels. */
+void
+WriteRegion(const ZarrArray &     array,
+            int                   channelAxis,
+            unsigned int          numberOfComponents,
+            const ImageIORegion & region,
+            const void *          buffer)
+{
+  std::vector<SizeValueType> start;
+  std::vector<SizeValueType> size;
+  ToArrayBox(region, numberOfComponents, channelAxis, start, size);
+  if (channelAxis < 0 || channelAxis + 1 == static_cast<int>(size.size()))
+  {
+    WriteArrayRegion(array, start, size, buffer);
+    return;
+  }
+  std::vector<char> planar(region.GetNumberOfPixels() * numberOfComponents * array.ComponentSize);
+  InterleaveComponents(size, channelAxis, array.ComponentSize, false, static_cast<const char *>(buffer), planar.data());
+  WriteArrayRegion(array, start, size, planar.data());
+}
+
+/** The size of each level, and its sampling factor relative to the previous level. */
+struct ZarrLevel
+{
+  std::vector<SizeValueType> Size{};
+  std::vector<SizeValueType> Factor{};
+};
+
+std::vector<ZarrLevel>
+ComputeLevels(const std::vector<SizeValueType> & size, unsigned int numberOfLevels)
+{
+  std::vector<ZarrLevel> levels(numberOfLevels);
+  levels[0].Size = size;
+  levels[0].Factor.assign(size.size(), 1);
+  for (unsigned int l = 1; l < numberOfLevels; ++l)
+  {
+    for (size_t d = 0; d < size.size(); ++d)
+    {
+      const SizeValueType previous = levels[l - 1].Size[d];
+      const SizeValueType factor = d < 3 && previous > 1 ? 2 : 1;
+      levels[l].Factor.push_back(factor);
+      levels[l].Size.push_back((previous + factor - 1) / factor);
+    }
+  }
+  return levels;
+}
+
+/** Averages the blocks of pixels of the source region, sampled by factor, into the destination region. */
+template <typename TComponent>
+void
+DownsampleBlocks(const ImageIORegion &              sourceRegion,
+                 const ImageIORegion &              destinationRegion,
+                 const std::vector<SizeValueType> & factor,
+                 unsigned int                       numberOfComponents,
+                 const TComponent *                 source,
+                 TComponent *                       destination)
+{
+  const unsigned int  dimension = sourceRegion.GetImageDimension();
+  const SizeValueType numberOfPixels = destinationRegion.GetNumberOfPixels();
+  unsigned int        blockPixels = 1;
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    blockPixels *= static_cast<unsigned int>(factor[d]);
+  }
+
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    destinationRegion.GetSize(dimension - 1),
+    [&](SizeValueType slice) {
+      const SizeValueType sliceSize = numberOfPixels / destinationRegion.GetSize(dimension - 1);
+      std::vector<double> sum(numberOfComponents);
+      for (SizeValueType p = slice * sliceSize; p < (slice + 1) * sliceSize; ++p)
+      {
+        std::fill(sum.begin(), sum.end(), 0.0);
+        unsigned int count = 0;
+        for (unsigned int b = 0; b < blockPixels; ++b)
+        {
+          SizeValueType remaining = p;
+          SizeValueType block = b;
+          SizeValueType offset = 0;
+          SizeValueType stride = 1;
+          bool          inside = true;
+          for (unsigned int d = 0; d < dimension; ++d)
+          {
+            const SizeValueType index = (remaining % destinationRegion.GetSize(d)) * factor[d] + block % factor[d];
+            remaining /= destinationRegion.GetSize(d);
+            block /= factor[d];
+            inside = inside && index < sourceRegion.GetSize(d);
+            offset += index * stride;
+            stride *= sourceRegion.GetSize(d);
+          }
+          if (inside)
+          {
+            for (unsigned int c = 0; c < numberOfComponents; ++c)
+            {
+              sum[c] += static_cast<double>(source[offset * numberOfComponents + c]);
+            }
+            ++count;
+          }
+        }
+        for (unsigned int c = 0; c < numberOfComponents; ++c)
+        {
+          const double mean = sum[c] / count;
+          destination[p * numberOfComponents + c] =
+            static_cast<TComponent>(std::is_integral_v<TComponent> ? std::floor(mean + 0.5) : mean);
+        }
+      }
+    },
+    nullptr);
+}
+} // namespace
+
+ZarrImageIO::ZarrImageIO()
+{
+  this->AddSupportedWriteExtension(".zarr");
+  this->AddSupportedReadExtension(".zarr");
+
+  this->Self::SetMaximumCompressionLevel(9);
+  this->Self::SetCompressionLevel(6);
+}
+
+ZarrImageIO::~ZarrImageIO() = default;
+
+std::string
+ZarrImageIO::GetStorePath() const
+{
+  std::string path = m_FileName;
+  while (path.size() > 1 && (path.back() == '/' || path.back() == '\\'))
+  {
+    path.pop_back();
+  }
+  return path;
+}
+
+bool
+ZarrImageIO::CanReadFile(const char * fileName)
+{
+  std::string path = fileName;
+  if (path.empty() || !itksys::SystemTools::FileIsDirectory(path))
+  {
+    return false;
+  }
+  if (itksys::SystemTools::FileExists(path + "/.zarray", true))
+  {
+    return true;
+  }
+  try
+  {
+    const JSONValue attributes = ReadJSONFile(path + "/.zattrs");
+    return attributes.Find("multiscales") != nullptr;
+  }
+  catch (const ExceptionObject &)
+  {
+    return false;
+  }
+}
+
+void
+ZarrImageIO::ReadImageInformation()
+{
+  const std::string path = this->GetStorePath();
+
+  // The levels, their axes and their coordinate transformations.
+  std::vector<std::string>         levelPaths;
+  std::vector<std::string>         axisNames;
+  std::vector<std::string>         axisTypes;
+  std::vector<std::vector<double>> scales;
+  std::vector<std::vector<double>> translations;
+  JSONValue                        attributes;
+  const JSONValue *                multiscale = nullptr;
+  if (itksys::SystemTools::FileExists(path + "/.zattrs", true))
+  {
+    attributes = ReadJSONFile(path + "/.zattrs");
+    const JSONValue * multiscales = attributes.Find("multiscales");
+    if (multiscales != nullptr && !multiscales->Array.empty())
+    {
+      multiscale = &multiscales->Array[0];
+    }
+  }
+
+  if (multiscale != nullptr)
+  {
+    const auto readTransformations = [](const JSONValue * transformations,
+                                        std::vector<double> & scale,
+                                        std::vector<double> & translation) {
+      if (transformations == nullptr)
+      {
+        return;
+      }
+      for (const auto & transformation : transformations->Array)
+      {
+        const JSONValue * type = transformation.Find("type");
+        const JSONValue * values = type == nullptr ? nullptr : transformation.Find(type->String);
+        if (values != nullptr)
+        {
+          auto & target = type->String == "scale" ? scale : translation;
+          target.clear();
+          for (const auto & value : values->Array)
+          {
+            target.push_back(value.Number);
+          }
+        }
+      }
+    };
+
+    if (const JSONValue * axes = multiscale->Find("axes"))
+    {
+      for (const auto & axis : axes->Array)
+      {
+        const JSONValue * name = axis.Find("name");
+        const JSONValue * type = axis.Find("type");
+        axisNames.push_back(axis.Type == JSONValue::Kind::String ? axis.String : (name ? name->String : ""));
+        axisTypes.push_back(type ? type->String : "");
+      }
+    }
+    std::vector<double> globalScale;
+    std::vector<double> globalTranslation;
+    readTransformations(multiscale->Find("coordinateTransformations"), globalScale, globalTranslation);
+    if (const JSONValue * datasets = multiscale->Find("datasets"))
+    {
+      for (const auto & dataset : datasets->Array)
+      {
+        const JSONValue * datasetPath = dataset.Find("path");
+        levelPaths.push_back(datasetPath ? datasetPath->String : "");
+        scales.emplace_back();
+        translations.emplace_back();
+        readTransformations(dataset.Find("coordinateTransformations"), scales.back(), translations.back());
+        for (size_t i = 0; i < globalScale.size(); ++i)
+        {
+          if (i < scales.back().size())
+          {
+            scales.back()[i] *= globalScale[i];
+          }
+          if (i < translations.back().size())
+          {
+            translations.back()[i] *= globalScale[i];
+          }
+        }
+        for (size_t i = 0; i < globalTranslation.size() && i < translations.back().size(); ++i)
+        {
+          translations.back()[i] += globalTranslation[i];
+        }
+      }
+    }
+  }
+  else if (itksys::SystemTools::FileExists(path + "/.zarray", true))
+  {
+    levelPaths.emplace_back();
+    scales.emplace_back();
+    translations.emplace_back();
+  }
+  if (levelPaths.empty())
+  {
+    itkExceptionMacro("No multiscales image or array found in " << m_FileName);
+  }
+  if (m_Level >= levelPaths.size())
+  {
+    itkExceptionMacro("Level " << m_Level << " requested, but " << m_FileName << " has " << levelPaths.size()
+                               << " levels");
+  }
+  m_NumberOfLevels = static_cast<unsigned int>(levelPaths.size());
+  m_ArrayPath = levelPaths[m_Level].empty() ? path : path + '/' + levelPaths[m_Level];
+
+  const ZarrArray    array = ReadArray(m_ArrayPath);
+  const unsigned int numberOfAxes = static_cast<unsigned int>(array.Shape.size());
+  if (axisNames.empty() && numberOfAxes == 5)
+  {
+    // OME-NGFF 0.1 and 0.2 images are five-dimensional, without axes metadata.
+    axisNames = { "t", "c", "z", "y", "x" };
+  }
+  axisNames.resize(numberOfAxes);
+  axisTypes.resize(numberOfAxes);
+  m_ChannelAxis = -1;
+  for (unsigned int i = 0; i < numberOfAxes && m_ChannelAxis < 0; ++i)
+  {
+    if (axisTypes[i] == "channel" || (axisTypes[i].empty() && axisNames[i] == "c"))
+    {
+      m_ChannelAxis = static_cast<int>(i);
+    }
+  }
+  if (m_ChannelAxis >= 0 && numberOfAxes == 1)
+  {
+    itkExceptionMacro("No spatial axes in " << m_ArrayPath);
+  }
+
+  const unsigned int dimension = m_ChannelAxis < 0 ? numberOfAxes : numberOfAxes - 1;
+  std::vector<double> scale = scales[m_Level];
+  std::vector<double> translation = translations[m_Level];
+  scale.resize(numberOfAxes, 1.0);
+  translation.resize(numberOfAxes, 0.0);
+  this->SetNumberOfDimensions(dimension);
+  m_ChunkSize.assign(dimension, 1);
+  for (unsigned int a = 0, d = dimension; a < numberOfAxes; ++a)
+  {
+    if (static_cast<int>(a) == m_ChannelAxis)
+    {
+      continue;
+    }
+    --d;
+    this->SetDimensions(d, array.Shape[a]);
+    this->SetSpacing(d, scale[a]);
+    this->SetOrigin(d, translation[a]);
+    m_ChunkSize[d] = array.Chunks[a];
+  }
+
+  this->SetComponentType(array.ComponentType);
+  this->SetNumberOfComponents(m_ChannelAxis < 0 ? 1 : static_cast<unsigned int>(array.Shape[m_ChannelAxis]));
+  this->SetPixelType(this->GetNumberOfComponents() > 1 ? IOPixelEnum::VECTOR : IOPixelEnum::SCALAR);
+  this->SetByteOrder(ByteSwapper<int>::SystemIsBigEndian() ? IOByteOrderEnum::BigEndian
+                                                            : IOByteOrderEnum::LittleEndian);
+
+  // The pixel type, component type and direction cosines written by ITK.
+  const JSONValue * itkAttributes = attributes.Find("itk");
+  if (itkAttributes != nullptr)
+  {
+    const JSONValue * componentType = itkAttributes->Find("componentType");
+    if (componentType != nullptr &&
+        ToDataType(ImageIOBase::GetComponentTypeFromString(componentType->String), array.ComponentSize) ==
+          ToDataType(array.ComponentType, array.ComponentSize))
+    {
+      this->SetComponentType(ImageIOBase::GetComponentTypeFromString(componentType->String));
+    }
+    const JSONValue * pixelType = itkAttributes->Find("pixelType");
+    if (pixelType != nullptr && ImageIOBase::GetPixelTypeFromString(pixelType->String) != IOPixelEnum::UNKNOWNPIXELTYPE)
+    {
+      this->SetPixelType(ImageIOBase::GetPixelTypeFromString(pixelType->String));
+    }
+    const JSONValue * direction = itkAttributes->Find("direction");
+    if (direction != nullptr && direction->Array.size() == dimension * dimension)
+    {
+      for (unsigned int i = 0; i < dimension; ++i)
+      {
+        std::vector<double> column(dimension);
+        for (unsigned int j = 0; j < dimension; ++j)
+        {
+          column[j] = direction->Array[j * dimension + i].Number;
+        }
+        this->SetDirection(i, column);
+      }
+    }
+  }
+}
+
+void
+ZarrImageIO::Read(void * buffer)
+{
+  const ZarrArray array = ReadArray(m_ArrayPath);
+  ReadRegion(array, m_ChannelAxis, this->GetNumberOfComponents(), m_IORegion, buffer);
+}
+
+bool
+ZarrImageIO::CanWriteFile(const char * fileName)
+{
+  std::string path = fileName;
+  while (path.size() > 1 && (path.back() == '/' || path.back() == '\\'))
+  {
+    path.pop_back();
+  }
+  return itksys::SystemTools::LowerCase(itksys::SystemTools::GetFilenameLastExtension(path)) == ".zarr";
+}
+
+void
+ZarrImageIO::WriteImageInformation()
+{
+  const std::string  path = this->GetStorePath();
+  const unsigned int dimension = this->GetNumberOfDimensions();
+  const unsigned int numberOfComponents = this->GetNumberOfComponents();
+  const int          channelAxis = numberOfComponents > 1 ? (dimension > 3 ? static_cast<int>(dimension) - 3 : 0) : -1;
+
+  std::vector<SizeValueType> size(dimension);
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    size[d] = this->GetDimensions(d);
+  }
+  const std::vector<ZarrLevel> levels = ComputeLevels(size, m_NumberOfLevels);
+
+  if (!itksys::SystemTools::MakeDirectory(path))
+  {
+    itkExceptionMacro("Cannot create directory " << path);
+  }
+  WriteTextFile(path + "/.zgroup", "{\n  \"zarr_format\": 2\n}\n");
+
+  // The values of each axis, listed slowest moving first.
+  const auto toArrayOrder = [dimension, channelAxis](auto values, auto channelValue) {
+    std::reverse(values.begin(), values.end());
+    if (channelAxis >= 0)
+    {
+      values.insert(values.begin() + channelAxis, channelValue);
+    }
+    return values;
+  };
+
+  std::vector<std::string> axisEntries;
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    const char * spatialNames[] = { "x", "y", "z" };
+    axisEntries.push_back(d < 3   ? std::string("{\"name\": \"") + spatialNames[d] + "\", \"type\": \"space\"}"
+                          : d == 3 ? std::string("{\"name\": \"t\", \"type\": \"time\"}")
+                                   : "{\"name\": \"d" + std::to_string(d) + "\"}");
+  }
+  axisEntries = toArrayOrder(axisEntries, std::string("{\"name\": \"c\", \"type\": \"channel\"}"));
+
+  std::string attributes = "{\n  \"multiscales\": [\n    {\n      \"version\": \"0.4\",\n      \"name\": \"" +
+                           itksys::SystemTools::GetFilenameWithoutLastExtension(path) + "\",\n      \"axes\": [";
+  for (size_t i = 0; i < axisEntries.size(); ++i)
+  {
+    attributes += (i == 0 ? "\n        " : ",\n        ") + axisEntries[i];
+  }
+  attributes += "\n      ],\n      \"datasets\": [";
+
+  std::vector<double> factor(dimension, 1.0);
+  for (unsigned int l = 0; l < m_NumberOfLevels; ++l)
+  {
+    // The pixels of a level are centered on the blocks of pixels of the first level they average.
+    std::vector<double> spacing(dimension);
+    std::vector<double> origin(dimension);
+    for (unsigned int i = 0; i < dimension; ++i)
+    {
+      factor[i] *= static_cast<double>(levels[l].Factor[i]);
+      spacing[i] = this->GetSpacing(i) * factor[i];
+      origin[i] = this->GetOrigin(i);
+    }
+    for (unsigned int i = 0; i < dimension; ++i)
+    {
+      for (unsigned int j = 0; j < dimension; ++j)
+      {
+        origin[i] += this->GetDirection(j)[i] * (factor[j] - 1.0) / 2.0 * this->GetSpacing(j);
+      }
+    }
+    attributes += std::string(l == 0 ? "" : ",") + "\n        {\n          \"path\": \"" + std::to_string(l) +
+                  "\",\n          \"coordinateTransformations\": [\n            {\"type\": \"scale\", \"scale\": " +
+                  ToJSON(toArrayOrder(spacing, 1.0)) +
+                  "},\n            {\"type\": \"translation\", \"translation\": " +
+                  ToJSON(toArrayOrder(origin, 0.0)) + "}\n          ]\n        }";
+
+    // The array of the level.
+    std::vector<SizeValueType> chunks(dimension);
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      const SizeValueType defaultChunk = d < 3 ? (dimension == 2 ? 256 : 64) : 1;
+      const SizeValueType chunk = d < m_ChunkSize.size() && m_ChunkSize[d] > 0 ? m_ChunkSize[d] : defaultChunk;
+      chunks[d] = std::max<SizeValueType>(std::min(chunk, levels[l].Size[d]), 1);
+    }
+    const std::string levelPath = path + '/' + std::to_string(l);
+    if (!itksys::SystemTools::MakeDirectory(levelPath))
+    {
+      itkExceptionMacro("Cannot create directory " << levelPath);
+    }
+    const std::string compressor =
+      m_UseCompression ? "{\"id\": \"zlib\", \"level\": " + std::to_string(this->GetCompressionLevel()) + "}" : "null";
+    WriteTextFile(levelPath + "/.zarray",
+                  "{\n  \"zarr_format\": 2,\n  \"shape\": " +
+                    ToJSON(toArrayOrder(levels[l].Size, SizeValueType{ numberOfComponents })) +
+                    ",\n  \"chunks\": " + ToJSON(toArrayOrder(chunks, SizeValueType{ numberOfComponents })) +
+                    ",\n  \"dtype\": \"" + ToDataType(this->GetComponentType(), this->GetComponentSize()) +
+                    "\",\n  \"compressor\": " + compressor +
+                    ",\n  \"fill_value\": 0,\n  \"order\": \"C\",\n  \"filters\": null,\n"
+                    "  \"dimension_separator\": \"/\"\n}\n");
+  }
+  attributes += "\n      ],\n      \"type\": \"mean\"\n    }\n  ],\n";
+
+  // OME-NGFF has no direction cosines, which are kept with the pixel and component types.
+  std::vector<double> direction;
+  for (unsigned int i = 0; i < dimension; ++i)
+  {
+    for (unsigned int j = 0; j < dimension; ++j)
+    {
+      direction.push_back(this->GetDirection(j)[i]);
+    }
+  }
+  attributes += "  \"itk\": {\n    \"pixelType\": \"" + ImageIOBase::GetPixelTypeAsString(this->GetPixelType()) +
+                "\",\n    \"componentType\": \"" + ImageIOBase::GetComponentTypeAsString(this->GetComponentType()) +
+                "\",\n    \"direction\": " + ToJSON(direction) + "\n  }\n}\n";
+  WriteTextFile(path + "/.zattrs", attributes);
+}
+
+void
+ZarrImageIO::Write(const void * buffer)
+{
+  const std::string path = this->GetStorePath();
+  if (!this->RequestedToStream() || !itksys::SystemTools::FileExists(path + "/.zattrs", true))
+  {
+    this->WriteImageInformation();
+  }
+
+  // The arrays of the levels of the store, which may have been written before when pasting.
+  const unsigned int         dimension = this->GetNumberOfDimensions();
+  const unsigned int         numberOfComponents = this->GetNumberOfComponents();
+  std::vector<SizeValueType> size(dimension);
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    size[d] = this->GetDimensions(d);
+  }
+  const auto store = Self::New();
+  store->SetFileName(m_FileName);
+  store->ReadImageInformation();
+  const std::vector<ZarrLevel> levels = ComputeLevels(size, store->GetNumberOfLevels());
+  std::vector<ZarrArray>       arrays;
+  for (unsigned int l = 0; l < levels.size(); ++l)
+  {
+    store->SetLevel(l);
+    store->ReadImageInformation();
+    bool matches = store->GetNumberOfDimensions() == dimension &&
+                   store->GetNumberOfComponents() == numberOfComponents &&
+                   store->GetComponentType() == this->GetComponentType();
+    for (unsigned int d = 0; matches && d < dimension; ++d)
+    {
+      matches = store->GetDimensions(d) == levels[l].Size[d];
+    }
+    if (!matches)
+    {
+      itkExceptionMacro("Level " << l << " of " << m_FileName << " does not match the image written");
+    }
+    arrays.push_back(ReadArray(store->m_ArrayPath));
+  }
+  const int channelAxis = store->m_ChannelAxis;
+
+  WriteRegion(arrays[0], channelAxis, numberOfComponents, m_IORegion, buffer);
+
+  // Each level is updated from the region of the previous level which covers the blocks it averages.
+  const size_t      pixelSize = this->GetComponentSize() * numberOfComponents;
+  ImageIORegion     previousRegion = m_IORegion;
+  const void *      previousBuffer = buffer;
+  std::vector<char> previous;
+  for (unsigned int l = 1; l < levels.size(); ++l)
+  {
+    ImageIORegion region(dimension);
+    ImageIORegion sourceRegion(dimension);
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      const SizeValueType factor = levels[l].Factor[d];
+      const auto          first = static_cast<SizeValueType>(previousRegion.GetIndex(d)) / factor;
+      const SizeValueType last =
+        (static_cast<SizeValueType>(previousRegion.GetIndex(d)) + previousRegion.GetSize(d) + factor - 1) / factor;
+      region.SetIndex(d, static_cast<IndexValueType>(first));
+      region.SetSize(d, last - first);
+      sourceRegion.SetIndex(d, static_cast<IndexValueType>(first * factor));
+      sourceRegion.SetSize(d, std::min(last * factor, levels[l - 1].Size[d]) - first * factor);
+    }
+
+    std::vector<char> source;
+    if (sourceRegion != previousRegion)
+    {
+      source.resize(sourceRegion.GetNumberOfPixels() * pixelSize);
+      ReadRegion(arrays[l - 1], channelAxis, numberOfComponents, sourceRegion, source.data());
+      previousBuffer = source.data();
+    }
+    std::vector<char> current(region.GetNumberOfPixels() * pixelSize);
+    DispatchComponentType(this->GetComponentType(), [&](auto * tag) {
+      using ComponentType = std::remove_pointer_t<decltype(tag)>;
+      DownsampleBlocks(sourceRegion,
+                       region,
+                       levels[l].Factor,
+                       numberOfComponents,
+                       static_cast<const ComponentType *>(previousBuffer),
+                       reinterpret_cast<ComponentType *>(current.data()));
+    });
+    WriteRegion(arrays[l], channelAxis, numberOfComponents, region, current.data());
+
+    previous.swap(current);
+    previousBuffer = previous.data();
+    previousRegion = region;
+  }
+}
+
+unsigned int
+ZarrImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                               const ImageIORegion & pasteRegion,
+                                               const ImageIORegion & largestPossibleRegion)
+{
+  // The chunks and levels of a previous image would otherwise be left in the store.
+  const std::string path = this->GetStorePath();
+  if (pasteRegion == largestPossibleRegion && itksys::SystemTools::FileIsDirectory(path) &&
+      this->CanReadFile(path.c_str()) && !itksys::SystemTools::RemoveADirectory(path))
+  {
+    itkExceptionMacro("Unable to remove " << path << " for writing");
+  }
+  return Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+}
+
+void
+ZarrImageIO::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Level: " << m_Level << std::endl;
+  os << indent << "NumberOfLevels: " << m_NumberOfLevels << std::endl;
+  os << indent << "ChunkSize:";
+  for (const auto chunk : m_ChunkSize)
+  {
+    os << ' ' << chunk;
+  }
+  os << std::endl;
+  os << indent << "ArrayPath: " << m_ArrayPath << std::endl;
+  os << indent << "ChannelAxis: " << m_ChannelAxis << std::endl;
+}
+
+LightObject::Pointer
+ZarrImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const auto rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval == nullptr)
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_Level = m_Level;
+  rval->m_NumberOfLevels = m_NumberOfLevels;
+  rval->m_ChunkSize = m_ChunkSize;
+  rval->m_ArrayPath = m_ArrayPath;
+  rval->m_ChannelAxis = m_ChannelAxis;
+  return loPtr;
+}
+} // end namespace itk
@@ -0,0 +1,278 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkRGBPixel.h"
+#include "itkZarrImageIO.h"
+#include "itkZarrImageIOFactory.h"
+#include "itkTestingMacros.h"
+#include <clocale>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+// Writes multiscale images in streamed pieces, then checks that the levels,
+// and a region of the first level, are read back as written.
+
+namespace
+{
+
+template <typename TImage>
+typename TImage::Pointer
+itkZarrImageIOTestRead(const std::string & fileName, unsigned int level, const typename TImage::RegionType & region)
+{
+  auto io = itk::ZarrImageIO::New();
+  io->SetLevel(level);
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(io);
+  reader->UpdateOutputInformation();
+  if (region.GetNumberOfPixels() > 0)
+  {
+    reader->GetOutput()->SetRequestedRegion(region);
+  }
+  reader->Update();
+  return reader->GetOutput();
+}
+
+// Checks that each pixel of a level is the rounded mean of its block of the previous level.
+template <typename TImage>
+bool
+itkZarrImageIOTestCheckLevel(const TImage * previous, const TImage * level)
+{
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+  const auto &           previousRegion = previous->GetLargestPossibleRegion();
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    const auto expectedSize = (previousRegion.GetSize(d) + 1) / 2;
+    if (level->GetLargestPossibleRegion().GetSize(d) != expectedSize ||
+        itk::Math::NotAlmostEquals(level->GetSpacing()[d], 2.0 * previous->GetSpacing()[d]))
+    {
+      std::cerr << "Unexpected size or spacing of level: " << level << std::endl;
+      return false;
+    }
+  }
+
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(level, level->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    double       sum = 0.0;
+    unsigned int count = 0;
+    for (unsigned int b = 0; b < (1u << Dimension); ++b)
+    {
+      typename TImage::IndexType index;
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        index[d] = 2 * it.GetIndex()[d] + ((b >> d) & 1);
+      }
+      if (previousRegion.IsInside(index))
+      {
+        sum += previous->GetPixel(index);
+        ++count;
+      }
+    }
+    const auto expected = static_cast<typename TImage::PixelType>(std::floor(sum / count + 0.5));
+    if (it.Get() != expected)
+    {
+      std::cerr << "Pixel " << it.GetIndex() << " of level is " << it.Get() << " instead of " << expected << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TImage>
+bool
+itkZarrImageIOTestCompare(const TImage * image, const TImage * read, const typename TImage::RegionType & region)
+{
+  if (read->GetBufferedRegion() != region)
+  {
+    std::cerr << "Read region " << read->GetBufferedRegion() << " instead of " << region << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(read, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != image->GetPixel(it.GetIndex()))
+    {
+      std::cerr << "Pixel " << it.GetIndex() << " is " << it.Get() << " instead of " << image->GetPixel(it.GetIndex())
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkZarrImageIOTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  itk::ZarrImageIOFactory::RegisterOneFactory();
+
+  // A scalar volume, written in slabs which do not align with the blocks of the levels.
+  using ImageType = itk::Image<unsigned short, 3>;
+  const std::string fileName = std::string(argv[1]) + "/itkZarrImageIOTest.zarr";
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 37, 29, 11 } });
+  image->Allocate();
+  image->SetSpacing(itk::MakeVector(0.5, 0.75, 2.0));
+  image->SetOrigin(itk::MakePoint(1.0, -2.0, 3.0));
+  ImageType::DirectionType direction;
+  direction.Fill(0.0);
+  direction[0][1] = 1.0;
+  direction[1][0] = -1.0;
+  direction[2][2] = 1.0;
+  image->SetDirection(direction);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<unsigned short>((index[0] * 7 + index[1] * 131 + index[2] * 1009) % 65521));
+  }
+
+  auto writerIO = itk::ZarrImageIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(writerIO, ZarrImageIO, StreamingImageIOBase);
+  ITK_TEST_EXPECT_TRUE(writerIO->CanWriteFile(fileName.c_str()));
+  ITK_TEST_EXPECT_TRUE(!writerIO->CanWriteFile("image.nrrd"));
+  writerIO->SetNumberOfLevels(3);
+  writerIO->SetChunkSize({ 8, 8, 4 });
+
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetFileName(fileName);
+  writer->SetInput(image);
+  writer->SetImageIO(writerIO);
+  writer->SetNumberOfStreamDivisions(4);
+  writer->UseCompressionOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  auto readerIO = itk::ZarrImageIO::New();
+  ITK_TEST_EXPECT_TRUE(readerIO->CanReadFile(fileName.c_str()));
+  ITK_TEST_EXPECT_TRUE(!readerIO->CanReadFile(argv[1]));
+
+  // The whole image, through the object factory, then a streamed region.
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  const ImageType * read = reader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(std::string(reader->GetImageIO()->GetNameOfClass()), "ZarrImageIO");
+  ITK_TEST_EXPECT_TRUE(read->GetSpacing() == image->GetSpacing());
+  ITK_TEST_EXPECT_TRUE(read->GetOrigin() == image->GetOrigin());
+  ITK_TEST_EXPECT_TRUE(read->GetDirection() == image->GetDirection());
+  ITK_TEST_EXPECT_TRUE(itkZarrImageIOTestCompare(image.GetPointer(), read, image->GetLargestPossibleRegion()));
+
+  const ImageType::RegionType region({ { 5, 9, 3 } }, { { 20, 13, 5 } });
+  ITK_TEST_EXPECT_TRUE(itkZarrImageIOTestCompare(
+    image.GetPointer(), itkZarrImageIOTestRead<ImageType>(fileName, 0, region).GetPointer(), region));
+
+  // The levels, whose pixels are centered on the blocks they average.
+  ImageType::ConstPointer previous = image;
+  for (unsigned int level = 1; level < 3; ++level)
+  {
+    const ImageType::Pointer levelImage = itkZarrImageIOTestRead<ImageType>(fileName, level, ImageType::RegionType());
+    ITK_TEST_EXPECT_TRUE(itkZarrImageIOTestCheckLevel(previous.GetPointer(), levelImage.GetPointer()));
+    ITK_TEST_EXPECT_TRUE(levelImage->GetDirection() == image->GetDirection());
+    const auto           center = previous->GetOrigin() + (previous->GetDirection() * previous->GetSpacing()) * 0.5;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(levelImage->GetOrigin()[d], center[d], 4, 1e-9));
+    }
+    previous = levelImage;
+  }
+  readerIO->SetFileName(fileName);
+  readerIO->SetLevel(3);
+  ITK_TRY_EXPECT_EXCEPTION(readerIO->ReadImageInformation());
+  readerIO->SetLevel(0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(readerIO->ReadImageInformation());
+  ITK_TEST_EXPECT_EQUAL(readerIO->GetNumberOfLevels(), 3);
+  ITK_TEST_EXPECT_TRUE(readerIO->GetChunkSize() == itk::ZarrImageIO::ChunkSizeType({ 8, 8, 4 }));
+
+  // Numbers are read independently of the locale, e.g. of a decimal comma.
+  if (std::setlocale(LC_NUMERIC, "de_DE.UTF-8") != nullptr || std::setlocale(LC_NUMERIC, "de_DE") != nullptr)
+  {
+    ITK_TRY_EXPECT_NO_EXCEPTION(readerIO->ReadImageInformation());
+    ITK_TEST_EXPECT_EQUAL(readerIO->GetSpacing(0), 0.5);
+    ITK_TEST_EXPECT_EQUAL(readerIO->GetOrigin(1), -2.0);
+    std::setlocale(LC_NUMERIC, "C");
+  }
+
+  // Unicode escapes in the metadata, of which only complete ones are valid.
+  const std::string attributesFileName = fileName + "/.zattrs";
+  std::string       attributes;
+  {
+    std::ifstream attributesFile(attributesFileName);
+    attributes.assign(std::istreambuf_iterator<char>(attributesFile), std::istreambuf_iterator<char>());
+  }
+  for (const char * escape : { "\\u00e9", "\\uZZZZ", "\\u12G4", "\\u12" })
+  {
+    std::ofstream(attributesFileName) << "{ \"comment\": \"" << escape << "\"," << attributes.substr(1);
+    if (std::string(escape) == "\\u00e9")
+    {
+      ITK_TRY_EXPECT_NO_EXCEPTION(readerIO->ReadImageInformation());
+    }
+    else
+    {
+      ITK_TRY_EXPECT_EXCEPTION(readerIO->ReadImageInformation());
+    }
+  }
+  std::ofstream(attributesFileName) << attributes;
+
+  // An RGB image, whose components are stored along the channel axis.
+  using RGBImageType = itk::Image<itk::RGBPixel<unsigned char>, 2>;
+  const std::string rgbFileName = std::string(argv[1]) + "/itkZarrImageIOTestRGB.zarr";
+
+  auto rgbImage = RGBImageType::New();
+  rgbImage->SetRegions(RGBImageType::SizeType{ { 300, 70 } });
+  rgbImage->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<RGBImageType> it(rgbImage, rgbImage->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    const RGBImageType::IndexType index = it.GetIndex();
+    RGBImageType::PixelType       pixel;
+    pixel.Set(static_cast<unsigned char>(index[0]), static_cast<unsigned char>(index[1]), 200);
+    it.Set(pixel);
+  }
+
+  auto rgbWriterIO = itk::ZarrImageIO::New();
+  rgbWriterIO->SetNumberOfLevels(2);
+  auto rgbWriter = itk::ImageFileWriter<RGBImageType>::New();
+  rgbWriter->SetFileName(rgbFileName);
+  rgbWriter->SetInput(rgbImage);
+  rgbWriter->SetImageIO(rgbWriterIO);
+  ITK_TRY_EXPECT_NO_EXCEPTION(rgbWriter->Update());
+
+  const RGBImageType::RegionType rgbRegion({ { 250, 3 } }, { { 50, 60 } });
+  ITK_TEST_EXPECT_TRUE(itkZarrImageIOTestCompare(
+    rgbImage.GetPointer(), itkZarrImageIOTestRead<RGBImageType>(rgbFileName, 0, rgbRegion).GetPointer(), rgbRegion));
+  const RGBImageType::Pointer rgbLevel =
+    itkZarrImageIOTestRead<RGBImageType>(rgbFileName, 1, RGBImageType::RegionType());
+  ITK_TEST_EXPECT_EQUAL(rgbLevel->GetLargestPossibleRegion().GetSize(), RGBImageType::SizeType({ { 150, 35 } }));
+  RGBImageType::PixelType expected;
+  expected.Set(21, 7, 200); // the rounded mean of 20, 21 and of 6, 7
+  ITK_TEST_EXPECT_EQUAL(rgbLevel->GetPixel({ { 10, 3 } }), expected);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,30 @@
+set(DOCUMENTATION "This module contains a suite of timed benchmarks of the
+toolkit's most used image IO, filtering, registration metric and level set
+classes. Each benchmark runs over several image sizes and numbers of threads,
+and the results are written as JSON so that they can be compared across
+versions and machines.")
+
+itk_module(
+  ITKBenchmarks
+  DEPENDS
+  ITKCommon
+  ITKBinaryMathematicalMorphology
+  ITKConnectedComponents
+  ITKDistanceMap
+  ITKImageGrid
+  ITKImageIntensity
+  ITKIOHDF5
+  ITKIOImageBase
+  ITKIOMeta
+  ITKIONIFTI
+  ITKIONRRD
+  ITKIOTIFF
+  ITKLevelSets
+  ITKMathematicalMorphology
+  ITKMetricsv4
+  ITKSmoothing
+  ITKThresholding
+  ITKTransform
+  EXCLUDE_FROM_DEFAULT
+  DESCRIPTION
+  "${DOCUMENTATION}")
@@ -0,0 +1,185 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBenchmarkSuite.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <random>
+
+namespace itk
+{
+
+void
+BenchmarkSuite::Add(const std::string & name, BenchmarkFunction benchmark)
+{
+  const auto sameName = [&name](const Benchmark & existing) { return existing.Name == name; };
+  if (std::any_of(m_Benchmarks.cbegin(), m_Benchmarks.cend(), sameName))
+  {
+    itkGenericExceptionMacro("A benchmark named " << name << " has already been added.");
+  }
+  m_Benchmarks.push_back({ name, std::move(benchmark) });
+}
+
+
+std::vector<std::string>
+BenchmarkSuite::GetSelectedBenchmarkNames() const
+{
+  std::vector<std::string> names;
+  for (const auto & benchmark : m_Benchmarks)
+  {
+    if (benchmark.Name.find(m_Filter) != std::string::npos)
+    {
+      names.push_back(benchmark.Name);
+    }
+  }
+  return names;
+}
+
+
+unsigned int
+BenchmarkSuite::Execute(std::ostream & report, std::ostream & log)
+{
+  const ThreadIdType originalNumberOfThreads = MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+
+  std::vector<unsigned int> numbersOfThreads = m_NumbersOfThreads;
+  if (numbersOfThreads.empty())
+  {
+    numbersOfThreads.push_back(1);
+    if (originalNumberOfThreads > 1)
+    {
+      numbersOfThreads.push_back(originalNumberOfThreads);
+    }
+  }
+
+  report << "{\n  \"SystemInformation\": ";
+  TimeProbe().PrintJSONSystemInformation(report);
+  report << ",\n  \"Benchmarks\": [";
+
+  unsigned int failures = 0;
+  bool         first = true;
+  for (const auto & benchmark : m_Benchmarks)
+  {
+    if (benchmark.Name.find(m_Filter) == std::string::npos)
+    {
+      continue;
+    }
+    for (const unsigned int size : m_Sizes)
+    {
+      for (const unsigned int threads : numbersOfThreads)
+      {
+        MultiThreaderBase::SetGlobalDefaultNumberOfThreads(threads);
+
+        Run run(size, threads, m_NumberOfIterations, m_TemporaryDirectory);
+        const std::string runName =
+          benchmark.Name + " size=" + std::to_string(size) + " threads=" + std::to_string(threads);
+        run.GetProbe().SetNameOfProbe(runName.c_str());
+        try
+        {
+          benchmark.Function(run);
+        }
+        catch (const std::exception & e)
+        {
+          log << runName << ": failed: " << e.what() << std::endl;
+          ++failures;
+          continue;
+        }
+        if (run.GetProbe().GetNumberOfStops() == 0)
+        {
+          log << runName << ": nothing measured" << std::endl;
+          continue;
+        }
+        log << runName << ": " << run.GetProbe().GetMean() << ' ' << run.GetProbe().GetUnit() << std::endl;
+
+        const SizeValueType numberOfPixels = SizeValueType{ size } * size * size;
+        report << (first ? "\n" : ",\n");
+        report << "  {\n";
+        report << "    \"Benchmark\": \"" << benchmark.Name << "\",\n";
+        report << "    \"Size\": " << size << ",\n";
+        report << "    \"NumberOfPixels\": " << numberOfPixels << ",\n";
+        report << "    \"Threads\": " << threads << ",\n";
+        report << "    \"Time\":\n";
+        run.GetProbe().JSONReport(report);
+        report << "\n  }";
+        first = false;
+      }
+    }
+  }
+  report << "\n  ]\n}" << std::endl;
+
+  MultiThreaderBase::SetGlobalDefaultNumberOfThreads(originalNumberOfThreads);
+  return failures;
+}
+
+
+BenchmarkSuite::ImageType::Pointer
+BenchmarkSuite::CreateImage(unsigned int size, unsigned int seed)
+{
+  auto                  image = ImageType::New();
+  ImageType::RegionType region;
+  region.SetSize(ImageType::SizeType::Filled(size));
+  image->SetRegions(region);
+  image->Allocate();
+
+  struct Sphere
+  {
+    double Center[3];
+    double RadiusSquared;
+    float  Value;
+  };
+
+  std::mt19937                           generator(seed);
+  std::uniform_real_distribution<double> position(0.25 * size, 0.75 * size);
+  std::uniform_real_distribution<double> radius(0.08 * size, 0.2 * size);
+  std::vector<Sphere>                    spheres(4);
+  for (auto & sphere : spheres)
+  {
+    for (double & coordinate : sphere.Center)
+    {
+      coordinate = position(generator);
+    }
+    const double r = radius(generator);
+    sphere.RadiusSquared = r * r;
+    sphere.Value = static_cast<float>(150 + 25 * (&sphere - spheres.data()));
+  }
+
+  std::normal_distribution<float> noise(0.0f, 10.0f);
+  for (ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType & index = it.GetIndex();
+    float                        value = 50.0f;
+    for (const auto & sphere : spheres)
+    {
+      double distanceSquared = 0.0;
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        const double difference = index[d] - sphere.Center[d];
+        distanceSquared += difference * difference;
+      }
+      if (distanceSquared < sphere.RadiusSquared)
+      {
+        value = sphere.Value;
+      }
+    }
+    it.Set(value + noise(generator));
+  }
+  return image;
+}
+
+} // end namespace itk
@@ -0,0 +1,218 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkSuite_h
+#define itkBenchmarkSuite_h
+
+#include "itkImage.h"
+#include "itkTimeProbe.h"
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/** \class BenchmarkSuite
+ *
+ * \brief Runs named benchmarks over image sizes and numbers of threads, and
+ * reports their timings as JSON.
+ *
+ * A benchmark is a function given a BenchmarkSuite::Run. It prepares its
+ * input for the image size of the run, and passes the part to be timed to
+ * Run::Measure(). Each benchmark is run once for each combination of the
+ * sizes and numbers of threads of the suite; the global default number of
+ * threads of the MultiThreaderBase is set for the duration of each run.
+ *
+ * The report holds the system information and one entry per run:
+ *
+ * \code
+ * {
+ *   "SystemInformation": { ... },
+ *   "Benchmarks": [
+ *     { "Benchmark": "SmoothingRecursiveGaussianImageFilter", "Size": 128, "NumberOfPixels": 2097152,
+ *       "Threads": 8, "Time": { "Name": ..., "Mean": ..., "Minimum": ..., ... } },
+ *     ...
+ *   ]
+ * }
+ * \endcode
+ *
+ * where "Time" is the TimeProbe::JSONReport() of the measured iterations.
+ *
+ * \ingroup ITKBenchmarks
+ */
+class BenchmarkSuite
+{
+public:
+  /** The image type most benchmarks operate on. */
+  using ImageType = Image<float, 3>;
+
+  class Run
+  {
+  public:
+    Run(unsigned int size,
+        unsigned int numberOfThreads,
+        unsigned int numberOfIterations,
+        std::string  temporaryDirectory)
+      : m_Size(size)
+      , m_NumberOfThreads(numberOfThreads)
+      , m_NumberOfIterations(numberOfIterations)
+      , m_TemporaryDirectory(std::move(temporaryDirectory))
+    {}
+
+    /** Edge length, in pixels, of the images of this run. */
+    unsigned int
+    GetSize() const
+    {
+      return m_Size;
+    }
+
+    unsigned int
+    GetNumberOfThreads() const
+    {
+      return m_NumberOfThreads;
+    }
+
+    /** Directory in which benchmarks may write their temporary files. */
+    const std::string &
+    GetTemporaryDirectory() const
+    {
+      return m_TemporaryDirectory;
+    }
+
+    /** Times function: it is called once untimed, to warm up caches and
+     * lazily allocated buffers, and then once per iteration. */
+    template <typename TFunction>
+    void
+    Measure(TFunction function)
+    {
+      function();
+      for (unsigned int i = 0; i < m_NumberOfIterations; ++i)
+      {
+        m_Probe.Start();
+        function();
+        m_Probe.Stop();
+      }
+    }
+
+    TimeProbe &
+    GetProbe()
+    {
+      return m_Probe;
+    }
+
+  private:
+    unsigned int m_Size;
+    unsigned int m_NumberOfThreads;
+    unsigned int m_NumberOfIterations;
+    std::string  m_TemporaryDirectory;
+    TimeProbe    m_Probe{};
+  };
+
+  using BenchmarkFunction = std::function<void(Run &)>;
+
+  /** Adds a benchmark. Names are unique and run in the order they are added. */
+  void
+  Add(const std::string & name, BenchmarkFunction benchmark);
+
+  /** Names of the benchmarks that Execute() would execute. */
+  std::vector<std::string>
+  GetSelectedBenchmarkNames() const;
+
+  void
+  SetSizes(const std::vector<unsigned int> & sizes)
+  {
+    m_Sizes = sizes;
+  }
+
+  void
+  SetNumbersOfThreads(const std::vector<unsigned int> & numbersOfThreads)
+  {
+    m_NumbersOfThreads = numbersOfThreads;
+  }
+
+  void
+  SetNumberOfIterations(unsigned int numberOfIterations)
+  {
+    m_NumberOfIterations = numberOfIterations;
+  }
+
+  /** Only benchmarks whose name contains filter are run. */
+  void
+  SetFilter(const std::string & filter)
+  {
+    m_Filter = filter;
+  }
+
+  void
+  SetTemporaryDirectory(const std::string & temporaryDirectory)
+  {
+    m_TemporaryDirectory = temporaryDirectory;
+  }
+
+  /** Runs the selected benchmarks, writing the JSON report to report and
+   * one line of progress per run to log. Returns the number of runs that
+   * failed with an exception. */
+  unsigned int
+  Execute(std::ostream & report, std::ostream & log);
+
+  /** Creates a deterministic image of size^3 pixels: a few bright spheres
+   * on a darker background, with Gaussian noise. Different seeds move the
+   * spheres and change the noise. */
+  static ImageType::Pointer
+  CreateImage(unsigned int size, unsigned int seed = 0);
+
+private:
+  struct Benchmark
+  {
+    std::string       Name;
+    BenchmarkFunction Function;
+  };
+
+  std::vector<Benchmark>    m_Benchmarks{};
+  std::vector<unsigned int> m_Sizes{ 64, 128 };
+  std::vector<unsigned int> m_NumbersOfThreads{};
+  unsigned int              m_NumberOfIterations{ 3 };
+  std::string               m_Filter{};
+  std::string               m_TemporaryDirectory{ "." };
+};
+
+/** Image file reading and writing, per format and compressor. */
+void
+AddImageIOBenchmarks(BenchmarkSuite & suite);
+
+/** Resampling, Gaussian smoothing, morphology, connected components,
+ * distance maps, and pixel-wise functor filters with and without the SIMD
+ * pixel kernels. */
+void
+AddImageFilterBenchmarks(BenchmarkSuite & suite);
+
+/** Value and derivative of the Mattes mutual information and ANTS
+ * neighborhood correlation metrics. */
+void
+AddRegistrationMetricBenchmarks(BenchmarkSuite & suite);
+
+/** A fixed number of iterations of sparse field and of narrow band level set
+ * segmentation. */
+void
+AddLevelSetBenchmarks(BenchmarkSuite & suite);
+
+} // end namespace itk
+
+#endif
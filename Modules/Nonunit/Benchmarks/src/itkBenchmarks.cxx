@@ -0,0 +1,146 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBenchmarkSuite.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+void
+PrintUsage(const char * program)
+{
+  std::cerr << "Usage: " << program << " [options]\n"
+            << "  --sizes N[,N...]            edge lengths of the benchmark images (default: 64,128)\n"
+            << "  --threads N[,N...]          numbers of threads (default: 1 and the global default)\n"
+            << "  --iterations N              measured iterations per run (default: 3)\n"
+            << "  --filter TEXT               only run the benchmarks whose name contains TEXT\n"
+            << "  --output FILE               write the JSON report to FILE instead of the standard output\n"
+            << "  --temporary-directory DIR   where image IO benchmarks write their files (default: .)\n"
+            << "  --list                      print the names of the selected benchmarks and exit\n";
+}
+
+bool
+ParseNumbers(const std::string & text, std::vector<unsigned int> & numbers)
+{
+  numbers.clear();
+  std::istringstream stream(text);
+  std::string        item;
+  while (std::getline(stream, item, ','))
+  {
+    char *              end = nullptr;
+    const unsigned long number = std::strtoul(item.c_str(), &end, 10);
+    if (item.empty() || *end != '\0' || number == 0)
+    {
+      return false;
+    }
+    numbers.push_back(static_cast<unsigned int>(number));
+  }
+  return !numbers.empty();
+}
+} // namespace
+
+
+int
+main(int argc, char * argv[])
+{
+  itk::BenchmarkSuite suite;
+  itk::AddImageIOBenchmarks(suite);
+  itk::AddImageFilterBenchmarks(suite);
+  itk::AddRegistrationMetricBenchmarks(suite);
+  itk::AddLevelSetBenchmarks(suite);
+
+  std::string outputFileName;
+  bool        list = false;
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string option = argv[i];
+    if (option == "--list")
+    {
+      list = true;
+      continue;
+    }
+    if (option == "--help" || i + 1 == argc)
+    {
+      PrintUsage(argv[0]);
+      return option == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    const std::string         value = argv[++i];
+    std::vector<unsigned int> numbers;
+    if (option == "--sizes" && ParseNumbers(value, numbers))
+    {
+      suite.SetSizes(numbers);
+    }
+    else if (option == "--threads" && ParseNumbers(value, numbers))
+    {
+      suite.SetNumbersOfThreads(numbers);
+    }
+    else if (option == "--iterations" && ParseNumbers(value, numbers) && numbers.size() == 1)
+    {
+      suite.SetNumberOfIterations(numbers.front());
+    }
+    else if (option == "--filter")
+    {
+      suite.SetFilter(value);
+    }
+    else if (option == "--output")
+    {
+      outputFileName = value;
+    }
+    else if (option == "--temporary-directory")
+    {
+      suite.SetTemporaryDirectory(value);
+    }
+    else
+    {
+      std::cerr << "Invalid option: " << option << ' ' << value << std::endl;
+      PrintUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (list)
+  {
+    for (const auto & name : suite.GetSelectedBenchmarkNames())
+    {
+      std::cout << name << '\n';
+    }
+    return EXIT_SUCCESS;
+  }
+
+  unsigned int failures = 0;
+  if (outputFileName.empty())
+  {
+    failures = suite.Execute(std::cout, std::cerr);
+  }
+  else
+  {
+    std::ofstream report(outputFileName);
+    if (!report)
+    {
+      std::cerr << "Cannot write " << outputFileName << std::endl;
+      return EXIT_FAILURE;
+    }
+    failures = suite.Execute(report, std::cerr);
+  }
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,208 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBenchmarkSuite.h"
+#include "itkAddImageFilter.h"
+#include "itkBinaryDilateImageFilter.h"
+#include "itkBinaryThresholdImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkConnectedComponentImageFilter.h"
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkEuler3DTransform.h"
+#include "itkFlatStructuringElement.h"
+#include "itkGrayscaleDilateImageFilter.h"
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkResampleImageFilter.h"
+#include "itkShiftScaleImageFilter.h"
+#include "itkSignedMaurerDistanceMapImageFilter.h"
+#include "itkSIMDPixelKernel.h"
+#include "itkSmoothingRecursiveGaussianImageFilter.h"
+
+namespace itk
+{
+namespace
+{
+using ImageType = BenchmarkSuite::ImageType;
+using MaskType = Image<unsigned char, 3>;
+using LabelImageType = Image<unsigned int, 3>;
+using StructuringElementType = FlatStructuringElement<3>;
+
+/** Times the update of filter alone, its inputs being brought up to date
+ * beforehand. */
+template <typename TFilter>
+void
+MeasureUpdate(BenchmarkSuite::Run & run, TFilter * filter)
+{
+  run.Measure([filter] {
+    filter->Modified();
+    filter->Update();
+  });
+}
+
+/** Times the update of a pixel-wise functor filter, with or without the
+ * SIMD pixel kernels. */
+template <typename TFilter>
+void
+MeasurePixelwiseUpdate(BenchmarkSuite::Run & run, TFilter * filter, bool simdPixelKernels)
+{
+  const bool enabled = SIMDPixelKernel::IsEnabled();
+  SIMDPixelKernel::SetEnabled(simdPixelKernels);
+  MeasureUpdate(run, filter);
+  SIMDPixelKernel::SetEnabled(enabled);
+}
+
+MaskType::Pointer
+CreateMask(unsigned int size)
+{
+  auto threshold = BinaryThresholdImageFilter<ImageType, MaskType>::New();
+  threshold->SetInput(BenchmarkSuite::CreateImage(size));
+  threshold->SetLowerThreshold(125.0f);
+  threshold->SetInsideValue(1);
+  threshold->SetOutsideValue(0);
+  threshold->Update();
+  return threshold->GetOutput();
+}
+
+void
+AddImages(BenchmarkSuite::Run & run, bool simdPixelKernels)
+{
+  auto add = AddImageFilter<ImageType, ImageType, ImageType>::New();
+  add->SetInput1(BenchmarkSuite::CreateImage(run.GetSize()));
+  add->SetInput2(BenchmarkSuite::CreateImage(run.GetSize(), 1));
+  MeasurePixelwiseUpdate(run, add.GetPointer(), simdPixelKernels);
+}
+
+void
+ShiftScaleImage(BenchmarkSuite::Run & run, bool simdPixelKernels)
+{
+  auto shiftScale = ShiftScaleImageFilter<ImageType, MaskType>::New();
+  shiftScale->SetInput(BenchmarkSuite::CreateImage(run.GetSize()));
+  shiftScale->SetScale(0.25);
+  MeasurePixelwiseUpdate(run, shiftScale.GetPointer(), simdPixelKernels);
+}
+
+void
+ClampImage(BenchmarkSuite::Run & run, bool simdPixelKernels)
+{
+  auto clamp = ClampImageFilter<ImageType, MaskType>::New();
+  clamp->SetInput(BenchmarkSuite::CreateImage(run.GetSize()));
+  MeasurePixelwiseUpdate(run, clamp.GetPointer(), simdPixelKernels);
+}
+
+void
+ResampleImage(BenchmarkSuite::Run & run)
+{
+  const auto image = BenchmarkSuite::CreateImage(run.GetSize());
+
+  auto                                     transform = Euler3DTransform<double>::New();
+  Euler3DTransform<double>::InputPointType center;
+  center.Fill(0.5 * (run.GetSize() - 1));
+  transform->SetCenter(center);
+  transform->SetRotation(0.1, 0.2, 0.3);
+
+  auto resample = ResampleImageFilter<ImageType, ImageType>::New();
+  resample->SetInput(image);
+  resample->SetTransform(transform);
+  resample->SetInterpolator(LinearInterpolateImageFunction<ImageType, double>::New());
+  resample->SetOutputParametersFromImage(image);
+  MeasureUpdate(run, resample.GetPointer());
+}
+
+void
+SmoothImageRecursively(BenchmarkSuite::Run & run)
+{
+  auto smooth = SmoothingRecursiveGaussianImageFilter<ImageType, ImageType>::New();
+  smooth->SetInput(BenchmarkSuite::CreateImage(run.GetSize()));
+  smooth->SetSigma(2.0);
+  MeasureUpdate(run, smooth.GetPointer());
+}
+
+void
+SmoothImageDiscretely(BenchmarkSuite::Run & run)
+{
+  auto smooth = DiscreteGaussianImageFilter<ImageType, ImageType>::New();
+  smooth->SetInput(BenchmarkSuite::CreateImage(run.GetSize()));
+  smooth->SetVariance(4.0);
+  MeasureUpdate(run, smooth.GetPointer());
+}
+
+void
+DilateGrayscaleImage(BenchmarkSuite::Run & run)
+{
+  auto dilate = GrayscaleDilateImageFilter<ImageType, ImageType, StructuringElementType>::New();
+  dilate->SetInput(BenchmarkSuite::CreateImage(run.GetSize()));
+  dilate->SetKernel(StructuringElementType::Ball(StructuringElementType::RadiusType::Filled(2)));
+  MeasureUpdate(run, dilate.GetPointer());
+}
+
+void
+DilateBinaryImage(BenchmarkSuite::Run & run)
+{
+  auto dilate = BinaryDilateImageFilter<MaskType, MaskType, StructuringElementType>::New();
+  dilate->SetInput(CreateMask(run.GetSize()));
+  dilate->SetKernel(StructuringElementType::Ball(StructuringElementType::RadiusType::Filled(2)));
+  dilate->SetForegroundValue(1);
+  MeasureUpdate(run, dilate.GetPointer());
+}
+
+void
+LabelConnectedComponents(BenchmarkSuite::Run & run)
+{
+  auto connectedComponents = ConnectedComponentImageFilter<MaskType, LabelImageType>::New();
+  connectedComponents->SetInput(CreateMask(run.GetSize()));
+  MeasureUpdate(run, connectedComponents.GetPointer());
+}
+
+void
+ComputeDistanceMap(BenchmarkSuite::Run & run)
+{
+  auto distanceMap = SignedMaurerDistanceMapImageFilter<MaskType, ImageType>::New();
+  distanceMap->SetInput(CreateMask(run.GetSize()));
+  distanceMap->SetSquaredDistance(false);
+  distanceMap->SetUseImageSpacing(true);
+  MeasureUpdate(run, distanceMap.GetPointer());
+}
+} // namespace
+
+
+void
+AddImageFilterBenchmarks(BenchmarkSuite & suite)
+{
+  suite.Add("ResampleImageFilter", ResampleImage);
+  suite.Add("SmoothingRecursiveGaussianImageFilter", SmoothImageRecursively);
+  suite.Add("DiscreteGaussianImageFilter", SmoothImageDiscretely);
+  suite.Add("GrayscaleDilateImageFilter", DilateGrayscaleImage);
+  suite.Add("BinaryDilateImageFilter", DilateBinaryImage);
+  suite.Add("ConnectedComponentImageFilter", LabelConnectedComponents);
+  suite.Add("SignedMaurerDistanceMapImageFilter", ComputeDistanceMap);
+  for (const bool simdPixelKernels : { true, false })
+  {
+    const std::string suffix = simdPixelKernels ? "" : "WithoutSIMDPixelKernel";
+    suite.Add("AddImageFilter" + suffix, [simdPixelKernels](BenchmarkSuite::Run & run) {
+      AddImages(run, simdPixelKernels);
+    });
+    suite.Add("ShiftScaleImageFilter" + suffix, [simdPixelKernels](BenchmarkSuite::Run & run) {
+      ShiftScaleImage(run, simdPixelKernels);
+    });
+    suite.Add("ClampImageFilter" + suffix, [simdPixelKernels](BenchmarkSuite::Run & run) {
+      ClampImage(run, simdPixelKernels);
+    });
+  }
+}
+
+} // end namespace itk
@@ -0,0 +1,116 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBenchmarkSuite.h"
+#include "itkHDF5ImageIO.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkMetaImageIO.h"
+#include "itkNiftiImageIO.h"
+#include "itkNrrdImageIO.h"
+#include "itkTIFFImageIO.h"
+#include "itksys/SystemTools.hxx"
+
+namespace itk
+{
+namespace
+{
+struct ImageIOFormat
+{
+  const char *                          Name;
+  const char *                          Extension;
+  bool                                  UseCompression;
+  const char *                          Compressor;
+  std::function<ImageIOBase::Pointer()> CreateImageIO;
+};
+
+template <typename TImageIO>
+ImageIOBase::Pointer
+CreateImageIO()
+{
+  return TImageIO::New().GetPointer();
+}
+
+std::string
+GetFileName(const BenchmarkSuite::Run & run, const ImageIOFormat & format)
+{
+  return run.GetTemporaryDirectory() + "/ITKBenchmark" + format.Name + format.Extension;
+}
+
+void
+WriteImage(const BenchmarkSuite::ImageType * image, const std::string & fileName, const ImageIOFormat & format)
+{
+  ImageIOBase::Pointer imageIO = format.CreateImageIO();
+  if (*format.Compressor != '\0')
+  {
+    imageIO->SetCompressor(format.Compressor);
+  }
+
+  auto writer = ImageFileWriter<BenchmarkSuite::ImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(imageIO);
+  writer->SetUseCompression(format.UseCompression);
+  writer->Write();
+}
+} // namespace
+
+
+void
+AddImageIOBenchmarks(BenchmarkSuite & suite)
+{
+  // NIfTI compression follows the file name extension.
+  const ImageIOFormat formats[] = {
+    { "MetaImage", ".mha", false, "", CreateImageIO<MetaImageIO> },
+    { "MetaImageZLib", ".mha", true, "", CreateImageIO<MetaImageIO> },
+    { "NRRD", ".nrrd", false, "", CreateImageIO<NrrdImageIO> },
+    { "NRRDGZip", ".nrrd", true, "GZIP", CreateImageIO<NrrdImageIO> },
+    { "NIfTI", ".nii", false, "", CreateImageIO<NiftiImageIO> },
+    { "NIfTIGZip", ".nii.gz", true, "", CreateImageIO<NiftiImageIO> },
+    { "TIFF", ".tif", false, "", CreateImageIO<TIFFImageIO> },
+    { "TIFFLZW", ".tif", true, "LZW", CreateImageIO<TIFFImageIO> },
+    { "HDF5", ".h5", false, "", CreateImageIO<HDF5ImageIO> },
+    { "HDF5Deflate", ".h5", true, "", CreateImageIO<HDF5ImageIO> },
+  };
+
+  for (const ImageIOFormat & format : formats)
+  {
+    suite.Add(std::string("ImageFileWriter/") + format.Name, [format](BenchmarkSuite::Run & run) {
+      const auto        image = BenchmarkSuite::CreateImage(run.GetSize());
+      const std::string fileName = GetFileName(run, format);
+      run.Measure([&] { WriteImage(image, fileName, format); });
+      itksys::SystemTools::RemoveFile(fileName);
+    });
+
+    suite.Add(std::string("ImageFileReader/") + format.Name, [format](BenchmarkSuite::Run & run) {
+      const std::string fileName = GetFileName(run, format);
+      WriteImage(BenchmarkSuite::CreateImage(run.GetSize()), fileName, format);
+
+      auto reader = ImageFileReader<BenchmarkSuite::ImageType>::New();
+      reader->SetFileName(fileName);
+      reader->SetImageIO(format.CreateImageIO());
+      run.Measure([&] {
+        reader->Modified();
+        reader->Update();
+      });
+      itksys::SystemTools::RemoveFile(fileName);
+    });
+  }
+}
+
+} // end namespace itk
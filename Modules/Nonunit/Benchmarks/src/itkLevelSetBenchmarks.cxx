@@ -0,0 +1,101 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBenchmarkSuite.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNarrowBandThresholdSegmentationLevelSetImageFilter.h"
+#include "itkThresholdSegmentationLevelSetImageFilter.h"
+
+#include <cmath>
+
+namespace itk
+{
+namespace
+{
+using ImageType = BenchmarkSuite::ImageType;
+
+/** Signed distance to a sphere in the middle of the image, negative inside. */
+ImageType::Pointer
+CreateInitialLevelSet(unsigned int size)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(size));
+  image->Allocate();
+
+  const double center = 0.5 * (size - 1);
+  const double radius = 0.1 * size;
+  for (ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    double distanceSquared = 0.0;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      const double difference = it.GetIndex()[d] - center;
+      distanceSquared += difference * difference;
+    }
+    it.Set(static_cast<float>(std::sqrt(distanceSquared) - radius));
+  }
+  return image;
+}
+
+/** Times a fixed number of iterations of filter, growing the initial sphere
+ * into the bright regions of the benchmark image. */
+template <typename TFilter>
+void
+MeasureSegmentation(BenchmarkSuite::Run & run, TFilter * filter)
+{
+  filter->SetInput(CreateInitialLevelSet(run.GetSize()));
+  filter->SetFeatureImage(BenchmarkSuite::CreateImage(run.GetSize()));
+  filter->SetLowerThreshold(125.0);
+  filter->SetUpperThreshold(300.0);
+  filter->SetPropagationScaling(1.0);
+  filter->SetCurvatureScaling(1.0);
+  filter->SetNumberOfIterations(20);
+  run.Measure([filter] {
+    filter->Modified();
+    filter->Update();
+  });
+}
+
+void
+SegmentWithSparseField(BenchmarkSuite::Run & run)
+{
+  auto filter = ThresholdSegmentationLevelSetImageFilter<ImageType, ImageType>::New();
+  // Run all the iterations, whatever the change of the level set.
+  filter->SetMaximumRMSError(0.0);
+  MeasureSegmentation(run, filter.GetPointer());
+}
+
+void
+SegmentWithNarrowBand(BenchmarkSuite::Run & run)
+{
+  auto filter = NarrowBandThresholdSegmentationLevelSetImageFilter<ImageType, ImageType>::New();
+  // Runs all the iterations as well: this solver does not compute the RMS
+  // change, so it only halts on the number of iterations.
+  MeasureSegmentation(run, filter.GetPointer());
+}
+} // namespace
+
+
+void
+AddLevelSetBenchmarks(BenchmarkSuite & suite)
+{
+  suite.Add("ThresholdSegmentationLevelSetImageFilter", SegmentWithSparseField);
+  suite.Add("NarrowBandThresholdSegmentationLevelSetImageFilter", SegmentWithNarrowBand);
+}
+
+} // end namespace itk
@@ -0,0 +1,72 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkANTSNeighborhoodCorrelationImageToImageMetricv4.h"
+#include "itkBenchmarkSuite.h"
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkTranslationTransform.h"
+
+namespace itk
+{
+namespace
+{
+using ImageType = BenchmarkSuite::ImageType;
+
+/** Times the value and derivative of metric between two different images,
+ * at the identity translation. */
+template <typename TMetric>
+void
+MeasureValueAndDerivative(BenchmarkSuite::Run & run, TMetric * metric)
+{
+  metric->SetFixedImage(BenchmarkSuite::CreateImage(run.GetSize(), 0));
+  metric->SetMovingImage(BenchmarkSuite::CreateImage(run.GetSize(), 1));
+  metric->SetMovingTransform(TranslationTransform<double, 3>::New());
+  metric->Initialize();
+
+  typename TMetric::MeasureType    value;
+  typename TMetric::DerivativeType derivative;
+  run.Measure([&] { metric->GetValueAndDerivative(value, derivative); });
+}
+
+void
+ComputeMattesMutualInformation(BenchmarkSuite::Run & run)
+{
+  auto metric = MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>::New();
+  metric->SetNumberOfHistogramBins(32);
+  MeasureValueAndDerivative(run, metric.GetPointer());
+}
+
+void
+ComputeNeighborhoodCorrelation(BenchmarkSuite::Run & run)
+{
+  using MetricType = ANTSNeighborhoodCorrelationImageToImageMetricv4<ImageType, ImageType>;
+  auto metric = MetricType::New();
+  metric->SetRadius(MetricType::RadiusType::Filled(2));
+  MeasureValueAndDerivative(run, metric.GetPointer());
+}
+} // namespace
+
+
+void
+AddRegistrationMetricBenchmarks(BenchmarkSuite & suite)
+{
+  suite.Add("MattesMutualInformationImageToImageMetricv4", ComputeMattesMutualInformation);
+  suite.Add("ANTSNeighborhoodCorrelationImageToImageMetricv4", ComputeNeighborhoodCorrelation);
+}
+
+} // end namespace itk
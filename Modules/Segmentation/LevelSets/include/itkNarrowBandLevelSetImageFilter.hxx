@@ -51,9 +51,8 @@ NarrowBandLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType, TOut
   m_IsoFilter = IsoFilterType::New();
   m_ChamferFilter = ChamferFilterType::New();
 
-  // Provide some reasonable defaults which will at least prevent infinite
-  // looping.
-  this->SetMaximumRMSError(0.02);
+  // Provide a reasonable default which will at least prevent infinite
+  // looping. The maximum RMS error is not used by this solver.
   this->SetNumberOfIterations(1000);
   m_ReverseExpansionDirection = false;
 }